@@ -0,0 +1,1169 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: rk_burst_synth.cpp
+// Desc: Synthetic RAW10 burst with ground-truth motion, runs & scores
+//       RK_MFNR_Processor
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// Every frame is rendered from one procedural scene through a known
+// homography, then gets local moving objects and shot/read noise. Frames
+// are packed RAW10 with the MFNR_Init() stride, ALIGN_4PIXEL_WIDTH*5/4;
+// thumbnails are the 16bit sums of the 8x8 raw blocks (1/8 scale), the
+// range the WDR statistics expect (prefilter >>6, 9 bins of 2048).
+//
+// Build (add -DMFNR_C_MODEL=1 for the C models, -DMFNR_DMA_STATS=1 for
+// the DDR traffic report, -DMFNR_TRACE=1 for -trace):
+//   g++ -O2 -mavx2 -DDSP_MEM_SIZE=262144 -Imfnr/host -Imfnr
+//       mfnr/host/bench/rk_burst_synth.cpp mfnr/rk_mfnr.cpp
+//       mfnr/rk_register.cpp mfnr/rk_denoiser.cpp mfnr/rk_bayerwdr.cpp
+//       mfnr/host/dma/dma.cpp -lpthread
+// A 6-frame 4000x3000 burst needs ~168KB of g_DspBuf, more than the
+// default 128KB; RK_MFNR_Processor() then returns MFNR_ERR_DSP_MEM_OVERFLOW
+// and this tool prints the DSP memory map and exits. The vector TemporalDenoise_Modify() is written for
+// exactly 6 frames, -n is checked against it.
+//
+// Usage: rk_burst_synth [-w wid] [-h hgt] [-n frames] [-seed n]
+//                       [-gain g] [-shot k] [-read s]
+//                       [-shift px] [-rot deg] [-zoom f] [-persp f]
+//                       [-obj n] [-speed px] [-o dir] [-memmap] [-dma]
+//                       [-trace file] [-engines n] [-repeat n] [-session] [-tile HxW]
+//                       [-band] [-thumbstrip] [-rawthumb] [-fastmatch]
+//                       [-pyramid]
+//   -w -h    raw size (default 4000x3000)
+//   -n       frames in the burst (default 6, vector build: 6 only),
+//            frame 0 is the BaseFrame
+//   -seed    scene, motion & noise seed (default 1)
+//   -gain    fIspGain; the scene is exposed 1/gain (default 4)
+//   -shot    shot noise, variance per DN of signal (default 1.0)
+//   -read    read noise sigma in DN (default 2.0)
+//   -shift   max translation per frame in Luma pixels (default 6)
+//   -rot     max rotation per frame in degrees (default 0.3)
+//   -zoom    max scale deviation per frame (default 0.003)
+//   -persp   max perspective shift at the image corner, Luma px (default 1)
+//   -obj     moving objects (default 3)
+//   -speed   max object speed in Raw pixels per frame (default 24)
+//   -o       write the burst & results to dir:
+//            frame<k>.raw10, thumb<k>.raw16, clean.raw10, output.raw10,
+//            truth.txt (one 3x3 homography per frame)
+//   -memmap  print the DSP memory map of the noisy burst before the scores
+//   -dma     print the DDR traffic of the noisy burst before the scores
+//            (MFNR_DMA_STATS builds)
+//   -trace   write the trace-event JSON of the noisy burst to file, open it
+//            in ui.perfetto.dev (MFNR_TRACE builds)
+//   -engines run the noisy burst once more on n engines (n threads, each
+//            with its own classMFNR & DSP Memory) at the same time; every
+//            output must match the single run
+//   -repeat  run the noisy burst n more times on the same engine; every
+//            output must be bit-identical to the first run
+//   -session run the noisy, clean & single bursts as one session
+//            (RK_MFNR_SessionOpen once, RK_MFNR_SessionProcess per burst);
+//            the scores must not change
+//   -tile    Enhancer tile Hgt x Wid, 32/64/128/256 each (default 0x0:
+//            picked from the L2 & frame count within DSP_MEM_SIZE); every
+//            tile gives the same output, unless a Ref window outgrows its
+//            chunk (wrong Homography) and the Base Block stands in for it
+//   -band    Enhancer RawSrcs from row-band rings (useRowBand), every Raw
+//            row unpacked once; ~1.2MB of DSP_MEM_SIZE per frame at 4000
+//            wide, same output
+//   -thumbstrip  Register coarse matching on one Thumb strip per
+//            FeatureDetect strip & frame (useThumbStrip); ~100KB of
+//            DSP_MEM_SIZE per frame at 4000 wide, same output
+//   -rawthumb    no pThumbSrcs given, the engine builds the Thumbs from the
+//            RawSrcs (ThumbBuild); same output
+//   -fastmatch   early-terminating Coarse & Fine Matching (useFastMatch);
+//            same output
+//   -pyramid     Register coarse matching 1/32 top +-6, then Thumb +-3
+//            (usePyramidMatch): Raw motion up to ~200 px instead of ~64
+//
+// Homographies follow pHomographyMatrix: BaseFrame Luma (row,col,1) ->
+// RefFrame Luma, Luma = Raw/2.
+//
+// Scores, one JSON object on stdout:
+//   psnr            output vs the reference: the clean BaseFrame run through
+//                   RK_MFNR_Processor as a static burst, so the WDR tone
+//                   curve is applied to both sides
+//   psnr_single     noisy BaseFrame alone (static burst) vs the reference
+//   psnr_static     psnr outside the moving objects
+//   psnr_motion     psnr inside the moving objects (ghosting)
+//   h_err_mean/max  |H*p - Htrue*p| in Luma px over a 16x16 point grid
+//   h_err           h_err_mean per RefFrame
+//   ms              RK_MFNR_Processor time of the noisy burst
+//   dsp_peak        g_DspBuf high-water mark of the noisy burst (Bytes)
+//   tile            Enhancer tile of the noisy burst, Hgt x Wid
+//   band            1: the Enhancer ran on row-band rings
+//   dma_read, dma_amp  DDR bytes read by the noisy burst and reads per
+//                   input byte (MFNR_DMA_STATS builds)
+//   engines, engines_ms  -engines n: n and the wall time of the n bursts
+// PSNR is 10bit (peak 1023) and skips a SYNTH_PSNR_BORDER frame border.
+//
+#include <math.h>
+#include <chrono>
+#include <thread>
+
+#include "rk_mfnr.h"                    // MFNR
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Macro Definition
+//
+#define     SYNTH_SCENE_SCALE       4               // Raw pixels per scene raster pixel
+#define     SYNTH_SCENE_MARGIN      64              // scene raster border for pixels warped outside
+#define     SYNTH_RECT_AREA         1024            // scene pixels per random rectangle
+#define     SYNTH_CELL_SIZE         (DIV_FIXED_WIN_SIZE * SCALER_FACTOR_R2T / SYNTH_SCENE_SCALE) // thumb segment in the scene
+#define     SYNTH_MAX_OBJECT        16              // max moving objects
+#define     SYNTH_WHITE_LEVEL       1023            // 10bit
+#define     SYNTH_BLACK_LEVEL       64              // nBlackLevel of every channel
+#define     SYNTH_PSNR_BORDER       32              // Raw border skipped by the PSNR
+#define     SYNTH_GRID_NUM          16              // h_err grid: 16x16 points
+#define     SYNTH_BUF_TAIL          64              // packed rows are read in 16Byte loads
+#ifdef CEVA_CHIP_CODE_DENOISER
+#define     SYNTH_VEC_FRAMES        6               // TemporalDenoise_Modify() vector branch
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Type Defines
+//
+////---- struct SynthParams
+typedef struct tag_SynthParams
+{
+    int             nRawWid;            // Raw size
+    int             nRawHgt;
+    int             nFrames;            // burst length
+    RK_U32          nSeed;              // LCG seed
+    RK_F32          fIspGain;           // ISP Gain
+    RK_F32          fShot;              // noise variance per DN
+    RK_F32          fRead;              // noise sigma at black
+    RK_F32          fShift;             // max translation (Luma)
+    RK_F32          fRotate;            // max rotation (degree)
+    RK_F32          fZoom;              // max scale - 1
+    RK_F32          fPersp;             // max perspective shift (Luma)
+    int             nObjects;           // moving objects
+    RK_F32          fSpeed;             // max object speed (Raw)
+    const char*     pOutDir;            // NULL: no files
+    int             nMemMap;            // 1: RK_MFNR_DumpDspMem() after the noisy burst
+    int             nDmaStats;          // 1: RK_MFNR_DumpDmaStats() after the noisy burst
+    const char*     pTraceFile;         // NULL: no trace
+    int             nEngines;           // >1: concurrent engines run of the noisy burst
+    int             nRepeat;            // >0: the noisy burst run again, output bit-identical
+    int             nSession;           // 1: the bursts on g_mfnrProcessor share one session
+    int             nTileHgt;           // Enhancer tile, 0: picked
+    int             nTileWid;
+    int             nRowBand;           // 1: Enhancer row-band rings
+    int             nThumbStrip;        // 1: Register coarse matching on Thumb strips
+    int             nRawThumb;          // 1: pThumbSrcs NULL, Thumbs built by the engine
+    int             nFastMatch;         // 1: early-terminating Register matching
+    int             nPyramid;           // 1: Register coarse matching on the 1/32 Pyramid top first
+}SynthParams;
+
+////---- struct SynthObject: disc moving linearly in frame coordinates
+typedef struct tag_SynthObject
+{
+    RK_F32          fRow;               // center in BaseFrame (Raw)
+    RK_F32          fCol;
+    RK_F32          fRadius;
+    RK_F32          fVelRow;            // Raw pixels per frame
+    RK_F32          fVelCol;
+    RK_F32          fLevel;             // 0..1 of the scene range
+}SynthObject;
+
+////---- struct SynthScene
+typedef struct tag_SynthScene
+{
+    int             nWid;               // raster size
+    int             nHgt;
+    RK_F32*         pData;              // 0..1
+    int             nObjects;
+    SynthObject     objects[SYNTH_MAX_OBJECT];
+}SynthScene;
+
+////---- struct SynthBurst
+typedef struct tag_SynthBurst
+{
+    int             nRawStride;         // Byte, as MFNR_Init()
+    int             nRawSize;
+    int             nThumbWid;
+    int             nThumbHgt;
+    int             nThumbStride;       // Byte
+    int             nThumbSize;
+    RK_D64          homography[RK_MAX_FILE_NUM][9];     // truth, BaseFrame Luma -> Frame#k Luma
+    RK_U16*         pClean;             // clean BaseFrame, 16bit
+    RK_U8*          pMotionMask;        // 1 inside a moving object in any frame
+    RK_U8*          pRaws[RK_MAX_FILE_NUM];             // packed RAW10
+    RK_U16*         pThumbs[RK_MAX_FILE_NUM];           // 16bit thumbs
+}SynthBurst;
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Global Variables
+//
+static RK_U32 g_SynthSeed = 1;          // LCG state
+static int    g_SynthSessionOpen = 0;   // -session: RK_MFNR_SessionOpen done
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Functions Definition
+//
+/************************************************************************/
+// Func: SynthRand() / SynthUniform() / SynthGauss()
+// Desc: LCG, uniform in [-1,1], N(0,1) by Box-Muller
+/*************************************************************************/
+static RK_U32 SynthRand(void)
+{
+    g_SynthSeed = g_SynthSeed * 1664525 + 1013904223;
+    return g_SynthSeed >> 8;
+} // SynthRand()
+
+static RK_D64 SynthUniform(void)
+{
+    return (SynthRand() & 0xFFFFFF) / (RK_D64)0x800000 - 1.0;
+} // SynthUniform()
+
+static RK_D64 SynthGauss(void)
+{
+    RK_D64 u1 = ((SynthRand() & 0xFFFFFF) + 1.0) / (RK_D64)0x1000001;
+    RK_D64 u2 = (SynthRand() & 0xFFFFFF) / (RK_D64)0x1000000;
+    return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+} // SynthGauss()
+
+
+/************************************************************************/
+// Func: SynthAlloc()
+// Desc: zeroed buffer, exits on failure
+/*************************************************************************/
+static void* SynthAlloc(size_t nSize)
+{
+    void* p = calloc(1, nSize + SYNTH_BUF_TAIL);
+    if (p == NULL)
+    {
+        fprintf(stderr, "rk_burst_synth: out of memory (%lu Byte)\n", (unsigned long)nSize);
+        exit(1);
+    }
+    return p;
+} // SynthAlloc()
+
+
+/************************************************************************/
+// Func: SynthMatMul() / SynthMatInv()
+// Desc: 3x3 row-major helpers
+/*************************************************************************/
+static void SynthMatMul(const RK_D64* pA, const RK_D64* pB, RK_D64* pC)
+{
+    RK_D64 c[9];
+    for (int r=0; r < 3; r++)
+    {
+        for (int k=0; k < 3; k++)
+        {
+            c[r*3+k] = pA[r*3+0] * pB[0*3+k] + pA[r*3+1] * pB[1*3+k] + pA[r*3+2] * pB[2*3+k];
+        }
+    }
+    memcpy(pC, c, sizeof(c));
+} // SynthMatMul()
+
+static void SynthMatInv(const RK_D64* m, RK_D64* pInv)
+{
+    RK_D64 det = m[0] * (m[4]*m[8] - m[5]*m[7])
+               - m[1] * (m[3]*m[8] - m[5]*m[6])
+               + m[2] * (m[3]*m[7] - m[4]*m[6]);
+    RK_D64 inv[9];
+    inv[0] =  (m[4]*m[8] - m[5]*m[7]) / det;
+    inv[1] = -(m[1]*m[8] - m[2]*m[7]) / det;
+    inv[2] =  (m[1]*m[5] - m[2]*m[4]) / det;
+    inv[3] = -(m[3]*m[8] - m[5]*m[6]) / det;
+    inv[4] =  (m[0]*m[8] - m[2]*m[6]) / det;
+    inv[5] = -(m[0]*m[5] - m[2]*m[3]) / det;
+    inv[6] =  (m[3]*m[7] - m[4]*m[6]) / det;
+    inv[7] = -(m[0]*m[7] - m[1]*m[6]) / det;
+    inv[8] =  (m[0]*m[4] - m[1]*m[3]) / det;
+    memcpy(pInv, inv, sizeof(inv));
+} // SynthMatInv()
+
+
+/************************************************************************/
+// Func: SynthMakeHomography()
+// Desc: random rotation, zoom & perspective about the image center plus a
+//       translation, BaseFrame Luma (row,col) -> RefFrame Luma
+/*************************************************************************/
+static void SynthMakeHomography(const SynthParams* pParams, RK_D64* pH)
+{
+    RK_D64 cy    = pParams->nRawHgt / 4.0;             // Luma center
+    RK_D64 cx    = pParams->nRawWid / 4.0;
+    RK_D64 angle = SynthUniform() * pParams->fRotate * 3.141592653589793 / 180.0;
+    RK_D64 zoom  = 1.0 + SynthUniform() * pParams->fZoom;
+    RK_D64 ty    = SynthUniform() * pParams->fShift;
+    RK_D64 tx    = SynthUniform() * pParams->fShift;
+    // perspective terms: fPersp Luma px of extra shift at the corner
+    RK_D64 py    = SynthUniform() * pParams->fPersp / (cy * cy);
+    RK_D64 px    = SynthUniform() * pParams->fPersp / (cx * cx);
+
+    RK_D64 toCenter[9]   = { 1, 0, -cy,  0, 1, -cx,  0, 0, 1 };
+    RK_D64 fromCenter[9] = { 1, 0, cy + ty,  0, 1, cx + tx,  0, 0, 1 };
+    RK_D64 affine[9]     = { zoom * cos(angle), -zoom * sin(angle), 0,
+                             zoom * sin(angle),  zoom * cos(angle), 0,
+                             0, 0, 1 };
+    RK_D64 persp[9]      = { 1, 0, 0,  0, 1, 0,  py, px, 1 };
+
+    SynthMatMul(affine, toCenter, pH);
+    SynthMatMul(persp, pH, pH);
+    SynthMatMul(fromCenter, pH, pH);
+    for (int i=0; i < 9; i++)
+    {
+        pH[i] /= pH[8];
+    }
+} // SynthMakeHomography()
+
+
+/************************************************************************/
+// Func: SynthMakeScene()
+// Desc: scene raster (1/SYNTH_SCENE_SCALE of Raw, with margin): gradient,
+//       random rectangles for corners, fine hash texture; moving objects
+/*************************************************************************/
+static void SynthMakeScene(const SynthParams* pParams, SynthScene* pScene)
+{
+    int nWid = pParams->nRawWid / SYNTH_SCENE_SCALE + 2 * SYNTH_SCENE_MARGIN;
+    int nHgt = pParams->nRawHgt / SYNTH_SCENE_SCALE + 2 * SYNTH_SCENE_MARGIN;
+    pScene->nWid  = nWid;
+    pScene->nHgt  = nHgt;
+    pScene->pData = (RK_F32*)SynthAlloc(sizeof(RK_F32) * nWid * nHgt);
+
+    for (int r=0; r < nHgt; r++)
+    {
+        for (int c=0; c < nWid; c++)
+        {
+            pScene->pData[r * nWid + c] = (RK_F32)(0.15 + 0.3 * (r + c) / (nWid + nHgt));
+        }
+    }
+
+    // contrast per thumb segment, FeatureFilter() keeps the segments
+    // sharper than its two least sharp ones, as on real scenes
+    int     nCellCol  = nWid / SYNTH_CELL_SIZE + 1;
+    int     nCellRow  = nHgt / SYNTH_CELL_SIZE + 1;
+    RK_F32* pContrast = (RK_F32*)SynthAlloc(sizeof(RK_F32) * nCellCol * nCellRow);
+    for (int i=0; i < nCellCol * nCellRow; i++)
+    {
+        pContrast[i] = (RK_F32)(0.05 + 0.95 * (SynthRand() & 0xFFFF) / 65536.0);
+    }
+
+    int nRects = nWid * nHgt / SYNTH_RECT_AREA;
+    for (int i=0; i < nRects; i++)
+    {
+        int    rectHgt = 4 + SynthRand() % 37;
+        int    rectWid = 4 + SynthRand() % 37;
+        int    row     = SynthRand() % (nHgt - rectHgt);
+        int    col     = SynthRand() % (nWid - rectWid);
+        RK_F32 level   = (RK_F32)(0.05 + 0.85 * (SynthRand() & 0xFFFF) / 65536.0);
+        RK_F32 scale   = pContrast[(row / SYNTH_CELL_SIZE) * nCellCol + col / SYNTH_CELL_SIZE];
+        for (int r=row; r < row + rectHgt; r++)
+        {
+            for (int c=col; c < col + rectWid; c++)
+            {
+                RK_F32* p = &pScene->pData[r * nWid + c];
+                *p += (level - *p) * scale;
+            }
+        }
+    }
+    free(pContrast);
+
+    for (int i=0; i < nWid * nHgt; i++)
+    {
+        pScene->pData[i] += (RK_F32)(0.03 * SynthUniform());
+    }
+
+    pScene->nObjects = MIN(pParams->nObjects, SYNTH_MAX_OBJECT);
+    for (int i=0; i < pScene->nObjects; i++)
+    {
+        SynthObject* pObj = &pScene->objects[i];
+        pObj->fRadius = (RK_F32)(pParams->nRawHgt / 40 + SynthRand() % (pParams->nRawHgt / 20 + 1));
+        pObj->fRow    = (RK_F32)(pObj->fRadius + SynthRand() % (int)(pParams->nRawHgt - 2 * pObj->fRadius));
+        pObj->fCol    = (RK_F32)(pObj->fRadius + SynthRand() % (int)(pParams->nRawWid - 2 * pObj->fRadius));
+        pObj->fVelRow = (RK_F32)(SynthUniform() * pParams->fSpeed);
+        pObj->fVelCol = (RK_F32)(SynthUniform() * pParams->fSpeed);
+        pObj->fLevel  = (RK_F32)(0.2 + 0.7 * (SynthRand() & 0xFFFF) / 65536.0);
+    }
+} // SynthMakeScene()
+
+
+/************************************************************************/
+// Func: SynthSample()
+// Desc: bilinear scene value at BaseFrame Raw (row,col), clamped
+/*************************************************************************/
+static RK_F32 SynthSample(const SynthScene* pScene, RK_D64 row, RK_D64 col)
+{
+    RK_D64 y = row / SYNTH_SCENE_SCALE + SYNTH_SCENE_MARGIN;
+    RK_D64 x = col / SYNTH_SCENE_SCALE + SYNTH_SCENE_MARGIN;
+    y = MIN(MAX(y, 0.0), pScene->nHgt - 1.001);
+    x = MIN(MAX(x, 0.0), pScene->nWid - 1.001);
+    int    y0 = (int)y;
+    int    x0 = (int)x;
+    RK_F32 fy = (RK_F32)(y - y0);
+    RK_F32 fx = (RK_F32)(x - x0);
+    const RK_F32* p = pScene->pData + y0 * pScene->nWid + x0;
+    return (p[0] * (1 - fx) + p[1] * fx) * (1 - fy)
+         + (p[pScene->nWid] * (1 - fx) + p[pScene->nWid + 1] * fx) * fy;
+} // SynthSample()
+
+
+/************************************************************************/
+// Func: SynthObjectAt()
+// Desc: index of the moving object covering Frame#k Raw (row,col), or -1
+/*************************************************************************/
+static int SynthObjectAt(const SynthScene* pScene, int k, int row, int col)
+{
+    for (int i=pScene->nObjects - 1; i >= 0; i--)
+    {
+        const SynthObject* pObj = &pScene->objects[i];
+        RK_F32 dy = row - (pObj->fRow + k * pObj->fVelRow);
+        RK_F32 dx = col - (pObj->fCol + k * pObj->fVelCol);
+        if (dy * dy + dx * dx <= pObj->fRadius * pObj->fRadius)
+        {
+            return i;
+        }
+    }
+    return -1;
+} // SynthObjectAt()
+
+
+/************************************************************************/
+// Func: SynthRenderFrame()
+// Desc: Frame#k, 16bit: scene through Htrue^-1, moving objects, Bayer
+//       RGGB channel response, exposure 1/fIspGain, then noise
+//   In: bNoise         - 0 for the clean frame
+//  Out: pDst           - nRawWid x nRawHgt
+/*************************************************************************/
+static void SynthRenderFrame(const SynthParams* pParams, const SynthScene* pScene, const RK_D64* pH,
+    int k, int bNoise, RK_U16* pDst)
+{
+    static const RK_F32 chanGain[4] = { 0.55f, 1.0f, 1.0f, 0.65f }; // R Gr Gb B
+    RK_D64  hInv[9];
+    RK_F32  range = (SYNTH_WHITE_LEVEL - SYNTH_BLACK_LEVEL) / pParams->fIspGain;
+
+    SynthMatInv(pH, hInv);
+    for (int r=0; r < pParams->nRawHgt; r++)
+    {
+        for (int c=0; c < pParams->nRawWid; c++)
+        {
+            RK_F32 level;
+            int    obj = SynthObjectAt(pScene, k, r, c);
+            if (obj >= 0)
+            {
+                // checker texture in object coordinates
+                const SynthObject* pObj = &pScene->objects[obj];
+                int oy = (int)(r - k * pObj->fVelRow + 4096) >> 4;
+                int ox = (int)(c - k * pObj->fVelCol + 4096) >> 4;
+                level  = pObj->fLevel * (((oy + ox) & 1) ? 1.0f : 0.6f);
+            }
+            else
+            {
+                // Frame Luma -> BaseFrame Luma -> BaseFrame Raw
+                RK_D64 ly = r * 0.5;
+                RK_D64 lx = c * 0.5;
+                RK_D64 z  = hInv[6] * ly + hInv[7] * lx + hInv[8];
+                RK_D64 by = (hInv[0] * ly + hInv[1] * lx + hInv[2]) / z;
+                RK_D64 bx = (hInv[3] * ly + hInv[4] * lx + hInv[5]) / z;
+                level     = SynthSample(pScene, by * 2, bx * 2);
+            }
+
+            RK_F32 signal = MAX(level, 0.0f) * chanGain[(r & 1) * 2 + (c & 1)] * range;
+            if (bNoise)
+            {
+                signal += (RK_F32)(SynthGauss() * sqrt(pParams->fShot * signal + pParams->fRead * pParams->fRead));
+            }
+            int v = (int)(signal + SYNTH_BLACK_LEVEL + 0.5f);
+            pDst[r * pParams->nRawWid + c] = (RK_U16)MIN(MAX(v, 0), SYNTH_WHITE_LEVEL);
+        }
+    }
+} // SynthRenderFrame()
+
+
+/************************************************************************/
+// Func: SynthPackRaw10() / SynthUnpackRaw10()
+// Desc: 16bit frame <-> packed RAW10 rows of nRawStride Byte
+/*************************************************************************/
+static void SynthPackRaw10(const RK_U16* pSrc, int nWid, int nHgt, int nRawStride, RK_U8* pDst)
+{
+    for (int r=0; r < nHgt; r++)
+    {
+        rdma_pack_raw10(pSrc + r * nWid, pDst + r * nRawStride, 0, nWid, 0);
+    }
+} // SynthPackRaw10()
+
+static void SynthUnpackRaw10(const RK_U8* pSrc, int nWid, int nHgt, int nRawStride, RK_U16* pDst)
+{
+    for (int r=0; r < nHgt; r++)
+    {
+        rdma_unpack_raw10(pSrc + r * nRawStride, 0, pDst + r * nWid, nWid, 0);
+    }
+} // SynthUnpackRaw10()
+
+
+/************************************************************************/
+// Func: SynthMakeThumb()
+// Desc: 1/8 thumbnail: sum of every 8x8 raw block (max 64*1023 < 65536)
+/*************************************************************************/
+static void SynthMakeThumb(const RK_U16* pRaw, int nRawWid, int nThumbWid, int nThumbHgt, int nThumbStride, RK_U16* pThumb)
+{
+    for (int i=0; i < nThumbHgt; i++)
+    {
+        for (int j=0; j < nThumbWid; j++)
+        {
+            RK_U32 sum = 0;
+            for (int y=0; y < SCALER_FACTOR_R2T; y++)
+            {
+                const RK_U16* p = pRaw + (i * SCALER_FACTOR_R2T + y) * nRawWid + j * SCALER_FACTOR_R2T;
+                for (int x=0; x < SCALER_FACTOR_R2T; x++)
+                {
+                    sum += p[x];
+                }
+            }
+            pThumb[i * (nThumbStride / sizeof(RK_U16)) + j] = (RK_U16)sum;
+        }
+    }
+} // SynthMakeThumb()
+
+
+/************************************************************************/
+// Func: SynthMakeBurst()
+// Desc: truth homographies, packed frames, thumbnails, clean BaseFrame &
+//       motion mask
+/*************************************************************************/
+static void SynthMakeBurst(const SynthParams* pParams, const SynthScene* pScene, SynthBurst* pBurst)
+{
+    int     nWid    = pParams->nRawWid;
+    int     nHgt    = pParams->nRawHgt;
+    RK_U16* pFrame  = (RK_U16*)SynthAlloc(sizeof(RK_U16) * nWid * nHgt);
+
+    // same derivation as MFNR_Init()
+    pBurst->nRawStride   = ALIGN_4PIXEL_WIDTH(nWid) * 5 / 4;
+    pBurst->nRawSize     = nHgt * pBurst->nRawStride;
+    pBurst->nThumbWid    = nWid / SCALER_FACTOR_R2T;
+    pBurst->nThumbHgt    = nHgt / SCALER_FACTOR_R2T;
+    pBurst->nThumbStride = ALIGN_4BYTE_WIDTH(pBurst->nThumbWid, THUMB_BIT_COUNT);
+    pBurst->nThumbSize   = pBurst->nThumbHgt * pBurst->nThumbStride;
+
+    for (int k=0; k < pParams->nFrames; k++)
+    {
+        RK_D64* pH = pBurst->homography[k];
+        if (k == BASE_PIC_NUM)
+        {
+            memset(pH, 0, sizeof(RK_D64) * 9);
+            pH[0] = pH[4] = pH[8] = 1;
+        }
+        else
+        {
+            SynthMakeHomography(pParams, pH);
+        }
+
+        SynthRenderFrame(pParams, pScene, pH, k, 1, pFrame);
+        pBurst->pRaws[k]   = (RK_U8*)SynthAlloc(pBurst->nRawSize);
+        pBurst->pThumbs[k] = (RK_U16*)SynthAlloc(pBurst->nThumbSize);
+        SynthPackRaw10(pFrame, nWid, nHgt, pBurst->nRawStride, pBurst->pRaws[k]);
+        SynthMakeThumb(pFrame, nWid, pBurst->nThumbWid, pBurst->nThumbHgt, pBurst->nThumbStride, pBurst->pThumbs[k]);
+    }
+
+    pBurst->pClean = (RK_U16*)SynthAlloc(sizeof(RK_U16) * nWid * nHgt);
+    SynthRenderFrame(pParams, pScene, pBurst->homography[BASE_PIC_NUM], BASE_PIC_NUM, 0, pBurst->pClean);
+
+    pBurst->pMotionMask = (RK_U8*)SynthAlloc(nWid * nHgt);
+    for (int r=0; r < nHgt; r++)
+    {
+        for (int c=0; c < nWid; c++)
+        {
+            for (int k=0; k < pParams->nFrames; k++)
+            {
+                if (SynthObjectAt(pScene, k, r, c) >= 0)
+                {
+                    pBurst->pMotionMask[r * nWid + c] = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    free(pFrame);
+} // SynthMakeBurst()
+
+
+/************************************************************************/
+// Func: SynthFreeBurst()
+// Desc: buffers of SynthMakeScene() & SynthMakeBurst()
+/*************************************************************************/
+static void SynthFreeBurst(const SynthParams* pParams, SynthScene* pScene, SynthBurst* pBurst)
+{
+    for (int k=0; k < pParams->nFrames; k++)
+    {
+        free(pBurst->pRaws[k]);
+        free(pBurst->pThumbs[k]);
+    }
+    free(pBurst->pClean);
+    free(pBurst->pMotionMask);
+    free(pScene->pData);
+} // SynthFreeBurst()
+
+
+/************************************************************************/
+// Func: SynthRun()
+// Desc: RK_MFNR_Processor on nFrames packed frames & thumbnails,
+//       RK_MFNR_SessionProcess with -session, or RK_MFNR_EngineProcess
+//       when pEngine is given
+//  Out: pRawDst        - packed RAW10 result
+//       return         - ms of the call, exits when the call fails
+/*************************************************************************/
+static double SynthRun(const SynthParams* pParams, const SynthBurst* pBurst,
+    RK_U8* const pRaws[], RK_U16* const pThumbs[], RK_U8* pRawDst,
+    classMFNR* pEngine = NULL, RK_U8* pDspMem = NULL)
+{
+    typedef std::chrono::steady_clock Clock;
+    RK_RawInfo          rawInfo;
+    RK_InputParams      inParams;
+    RK_ControlParams    ctrlParams;
+
+    memset(&rawInfo, 0, sizeof(rawInfo));
+    memset(&inParams, 0, sizeof(inParams));
+    memset(&ctrlParams, 0, sizeof(ctrlParams));
+    strcpy(rawInfo.sBayerType, "RGGB");
+    rawInfo.fRedGain    = 1.0f / 0.55f;
+    rawInfo.fBlueGain   = 1.0f / 0.65f;
+    rawInfo.fSensorGain = 1.0f;
+    rawInfo.fIspGain    = pParams->fIspGain;
+    for (int i=0; i < 4; i++)
+    {
+        rawInfo.nBlackLevel[i] = SYNTH_BLACK_LEVEL;
+    }
+
+    inParams.nRawWid     = (RK_U16)pParams->nRawWid;
+    inParams.nRawHgt     = (RK_U16)pParams->nRawHgt;
+    inParams.nRawStride  = pBurst->nRawStride;
+    inParams.nRawSize    = pBurst->nRawSize;
+    inParams.nRawFileNum = (RK_U16)pParams->nFrames;
+    inParams.pRawInfo    = &rawInfo;
+    for (int k=0; k < pParams->nFrames; k++)
+    {
+        inParams.pRawSrcs[k]   = pRaws[k];
+        inParams.pThumbSrcs[k] = pParams->nRawThumb ? NULL : pThumbs[k];
+    }
+    ctrlParams.setNumFrameCompose = (RK_F32)pParams->nFrames;
+    ctrlParams.useRegister        = 1;
+    ctrlParams.nTileHgt           = (RK_U16)pParams->nTileHgt;
+    ctrlParams.nTileWid           = (RK_U16)pParams->nTileWid;
+    ctrlParams.useRowBand         = (RK_Char)pParams->nRowBand;
+    ctrlParams.useThumbStrip      = (RK_Char)pParams->nThumbStrip;
+    ctrlParams.useFastMatch       = (RK_Char)pParams->nFastMatch;
+    ctrlParams.usePyramidMatch    = (RK_Char)pParams->nPyramid;
+
+    Clock::time_point t0 = Clock::now();
+    int ret = 0;
+    if (pEngine != NULL)
+    {
+        ret = RK_MFNR_EngineProcess(pEngine, pDspMem, DSP_MEM_SIZE, &inParams, &ctrlParams, pRawDst);
+    }
+    else if (pParams->nSession)
+    {
+        if (!g_SynthSessionOpen)
+        {
+            ret = RK_MFNR_SessionOpen(&g_mfnrProcessor, g_DspBuf, DSP_MEM_SIZE, &inParams, &ctrlParams);
+            g_SynthSessionOpen = (ret == 0);
+        }
+        if (ret == 0)
+        {
+            ret = RK_MFNR_SessionProcess(&g_mfnrProcessor, &inParams, &ctrlParams, pRawDst);
+        }
+    }
+    else
+    {
+        ret = RK_MFNR_Processor(&inParams, &ctrlParams, pRawDst);
+    }
+    double ms = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count() / 1000.0;
+    if (ret == MFNR_ERR_DSP_MEM_OVERFLOW)
+    {
+        RK_DspMemStats dspMem;
+        classMFNR*     pStatsEngine = (pEngine != NULL) ? pEngine : &g_mfnrProcessor;
+        if (pEngine == NULL)
+        {
+            RK_MFNR_EngineDumpDspMem(pStatsEngine);
+        }
+        RK_MFNR_EngineGetDspMemStats(pStatsEngine, &dspMem);
+        if (dspMem.nOverrunBlock >= 0)
+        {
+            fprintf(stderr, "rk_burst_synth: a Tile window %s its DSP chunk\n",
+                dspMem.nOverrunGuard ? "was written past" : "of the Homography spread outgrew");
+            exit(1);
+        }
+        fprintf(stderr, "rk_burst_synth: DSP_MEM_SIZE %d too small, rebuild with -DDSP_MEM_SIZE=...\n", DSP_MEM_SIZE);
+        exit(1);
+    }
+    if (ret == MFNR_ERR_TILE)
+    {
+        fprintf(stderr, "rk_burst_synth: tile %dx%d not supported by this build\n", pParams->nTileHgt, pParams->nTileWid);
+        exit(1);
+    }
+    if (ret)
+    {
+        fprintf(stderr, "rk_burst_synth: RK_MFNR_Processor failed (%d)\n", ret);
+        exit(1);
+    }
+
+    return ms;
+} // SynthRun()
+
+
+/************************************************************************/
+// Func: SynthRunEngines()
+// Desc: the noisy burst on nEngines engines, one thread each, at once;
+//       exits when an output differs from pRawExpect or the DSP Memory
+//       peak of an engine from nDspPeakExpect
+//  Out: return         - ms until the last engine is done
+/*************************************************************************/
+static double SynthRunEngines(const SynthParams* pParams, const SynthBurst* pBurst, const RK_U8* pRawExpect,
+    RK_U32 nDspPeakExpect)
+{
+    typedef std::chrono::steady_clock Clock;
+    int             nEngines = pParams->nEngines;
+    classMFNR*      pEngines = new classMFNR[nEngines];
+    std::thread*    pThreads = new std::thread[nEngines];
+    RK_U8*          pDspMems = (RK_U8*)aligned_alloc(DSPMEM_ALIGN, (size_t)DSP_MEM_SIZE * nEngines);
+    RK_U8**         pRawDsts = (RK_U8**)SynthAlloc(sizeof(RK_U8*) * nEngines);
+    if (pDspMems == NULL)
+    {
+        fprintf(stderr, "rk_burst_synth: out of memory\n");
+        exit(1);
+    }
+
+    Clock::time_point t0 = Clock::now();
+    for (int e=0; e < nEngines; e++)
+    {
+        pRawDsts[e] = (RK_U8*)SynthAlloc(pBurst->nRawSize);
+        pThreads[e] = std::thread(SynthRun, pParams, pBurst, pBurst->pRaws, pBurst->pThumbs, pRawDsts[e],
+            &pEngines[e], pDspMems + (size_t)DSP_MEM_SIZE * e);
+    }
+    for (int e=0; e < nEngines; e++)
+    {
+        pThreads[e].join();
+    }
+    double ms = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count() / 1000.0;
+
+    for (int e=0; e < nEngines; e++)
+    {
+        if (memcmp(pRawDsts[e], pRawExpect, pBurst->nRawSize) != 0)
+        {
+            fprintf(stderr, "rk_burst_synth: engine %d output differs from the single run\n", e);
+            exit(1);
+        }
+        RK_DspMemStats dspMem;
+        RK_MFNR_EngineGetDspMemStats(&pEngines[e], &dspMem);
+        if (dspMem.nPeak != nDspPeakExpect)
+        {
+            fprintf(stderr, "rk_burst_synth: engine %d DSP peak %u, single run %u\n", e, dspMem.nPeak, nDspPeakExpect);
+            exit(1);
+        }
+        free(pRawDsts[e]);
+    }
+    free(pRawDsts);
+    free(pDspMems);
+    delete[] pThreads;
+    delete[] pEngines;
+
+    return ms;
+} // SynthRunEngines()
+
+
+/************************************************************************/
+// Func: SynthPsnr()
+// Desc: 10bit PSNR of two frames over the pixels whose mask equals
+//       nMaskValue (-1: all), SYNTH_PSNR_BORDER excluded
+/*************************************************************************/
+static double SynthPsnr(const RK_U16* pA, const RK_U16* pB, const RK_U8* pMask, int nMaskValue, int nWid, int nHgt)
+{
+    double  sse = 0;
+    long    num = 0;
+    for (int r=SYNTH_PSNR_BORDER; r < nHgt - SYNTH_PSNR_BORDER; r++)
+    {
+        for (int c=SYNTH_PSNR_BORDER; c < nWid - SYNTH_PSNR_BORDER; c++)
+        {
+            int i = r * nWid + c;
+            if (nMaskValue >= 0 && pMask[i] != nMaskValue)
+            {
+                continue;
+            }
+            double d = (double)pA[i] - pB[i];
+            sse += d * d;
+            num++;
+        }
+    }
+    if (num == 0)
+    {
+        return 0;
+    }
+    if (sse == 0)
+    {
+        return 99.0;
+    }
+    return 10.0 * log10((double)SYNTH_WHITE_LEVEL * SYNTH_WHITE_LEVEL * num / sse);
+} // SynthPsnr()
+
+
+/************************************************************************/
+// Func: SynthHomographyError()
+// Desc: mean & max |H*p - Htrue*p| over a SYNTH_GRID_NUM^2 Luma grid
+/*************************************************************************/
+static void SynthHomographyError(const RK_F32* pH, const RK_D64* pTrue, int nRawWid, int nRawHgt,
+    double* pMean, double* pMax)
+{
+    double  sum = 0;
+    double  max = 0;
+    for (int i=0; i < SYNTH_GRID_NUM; i++)
+    {
+        for (int j=0; j < SYNTH_GRID_NUM; j++)
+        {
+            double y  = (i + 0.5) * nRawHgt / 2 / SYNTH_GRID_NUM;
+            double x  = (j + 0.5) * nRawWid / 2 / SYNTH_GRID_NUM;
+            double z0 = pH[6] * y + pH[7] * x + pH[8];
+            double z1 = pTrue[6] * y + pTrue[7] * x + pTrue[8];
+            double dy = (pH[0] * y + pH[1] * x + pH[2]) / z0 - (pTrue[0] * y + pTrue[1] * x + pTrue[2]) / z1;
+            double dx = (pH[3] * y + pH[4] * x + pH[5]) / z0 - (pTrue[3] * y + pTrue[4] * x + pTrue[5]) / z1;
+            double e  = sqrt(dy * dy + dx * dx);
+            sum += e;
+            max  = MAX(max, e);
+        }
+    }
+    *pMean = sum / (SYNTH_GRID_NUM * SYNTH_GRID_NUM);
+    *pMax  = max;
+} // SynthHomographyError()
+
+
+/************************************************************************/
+// Func: SynthWriteFile()
+// Desc: raw dump to dir/name
+/*************************************************************************/
+static void SynthWriteFile(const char* pDir, const char* pName, const void* pData, size_t nSize)
+{
+    char    fileName[1024];
+    FILE*   fp;
+    snprintf(fileName, sizeof(fileName), "%s/%s", pDir, pName);
+    fp = fopen(fileName, "wb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "rk_burst_synth: can not write %s\n", fileName);
+        exit(1);
+    }
+    fwrite(pData, 1, nSize, fp);
+    fclose(fp);
+} // SynthWriteFile()
+
+
+/************************************************************************/
+// Func: SynthWriteBurst()
+// Desc: frames, thumbnails, clean BaseFrame, truth & output to pOutDir
+/*************************************************************************/
+static void SynthWriteBurst(const SynthParams* pParams, const SynthBurst* pBurst, const RK_U8* pRawDst)
+{
+    char    name[64];
+    char    fileName[1024];
+    RK_U8*  pClean = (RK_U8*)SynthAlloc(pBurst->nRawSize);
+    FILE*   fp;
+
+    for (int k=0; k < pParams->nFrames; k++)
+    {
+        sprintf(name, "frame%d.raw10", k);
+        SynthWriteFile(pParams->pOutDir, name, pBurst->pRaws[k], pBurst->nRawSize);
+        sprintf(name, "thumb%d.raw16", k);
+        SynthWriteFile(pParams->pOutDir, name, pBurst->pThumbs[k], pBurst->nThumbSize);
+    }
+    SynthPackRaw10(pBurst->pClean, pParams->nRawWid, pParams->nRawHgt, pBurst->nRawStride, pClean);
+    SynthWriteFile(pParams->pOutDir, "clean.raw10", pClean, pBurst->nRawSize);
+    SynthWriteFile(pParams->pOutDir, "output.raw10", pRawDst, pBurst->nRawSize);
+    free(pClean);
+
+    snprintf(fileName, sizeof(fileName), "%s/truth.txt", pParams->pOutDir);
+    fp = fopen(fileName, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "rk_burst_synth: can not write %s\n", fileName);
+        exit(1);
+    }
+    fprintf(fp, "# %dx%d stride %d, BaseFrame Luma (row,col,1) -> Frame#k Luma\n",
+        pParams->nRawWid, pParams->nRawHgt, pBurst->nRawStride);
+    for (int k=0; k < pParams->nFrames; k++)
+    {
+        const RK_D64* pH = pBurst->homography[k];
+        fprintf(fp, "%d", k);
+        for (int i=0; i < 9; i++)
+        {
+            fprintf(fp, " %.9g", pH[i]);
+        }
+        fprintf(fp, "\n");
+    }
+    fclose(fp);
+} // SynthWriteBurst()
+
+
+int main(int argc, char* argv[])
+{
+    SynthParams params;
+    SynthScene  scene;
+    SynthBurst  burst;
+
+    params.nRawWid  = 4000;
+    params.nRawHgt  = 3000;
+    params.nFrames  = 6;
+    params.nSeed    = 1;
+    params.fIspGain = 4.0f;
+    params.fShot    = 1.0f;
+    params.fRead    = 2.0f;
+    params.fShift   = 6.0f;
+    params.fRotate  = 0.3f;
+    params.fZoom    = 0.003f;
+    params.fPersp   = 1.0f;
+    params.nObjects = 3;
+    params.fSpeed   = 24.0f;
+    params.pOutDir  = NULL;
+    params.nMemMap  = 0;
+    params.nDmaStats = 0;
+    params.pTraceFile = NULL;
+    params.nEngines = 1;
+    params.nRepeat  = 0;
+    params.nSession = 0;
+    params.nTileHgt = 0;
+    params.nTileWid = 0;
+    params.nRowBand = 0;
+    params.nThumbStrip = 0;
+    params.nRawThumb = 0;
+    params.nFastMatch = 0;
+    params.nPyramid = 0;
+
+    for (int i=1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(arg, "-memmap") == 0)
+        {
+            params.nMemMap = 1;
+            continue;
+        }
+        if (strcmp(arg, "-dma") == 0)
+        {
+            params.nDmaStats = 1;
+            continue;
+        }
+        if (strcmp(arg, "-session") == 0)
+        {
+            params.nSession = 1;
+            continue;
+        }
+        if (strcmp(arg, "-band") == 0)
+        {
+            params.nRowBand = 1;
+            continue;
+        }
+        if (strcmp(arg, "-thumbstrip") == 0)
+        {
+            params.nThumbStrip = 1;
+            continue;
+        }
+        if (strcmp(arg, "-rawthumb") == 0)
+        {
+            params.nRawThumb = 1;
+            continue;
+        }
+        if (strcmp(arg, "-fastmatch") == 0)
+        {
+            params.nFastMatch = 1;
+            continue;
+        }
+        if (strcmp(arg, "-pyramid") == 0)
+        {
+            params.nPyramid = 1;
+            continue;
+        }
+        if (val == NULL)                    { arg = ""; }
+        if      (strcmp(arg, "-w") == 0)     { params.nRawWid  = atoi(val); }
+        else if (strcmp(arg, "-h") == 0)     { params.nRawHgt  = atoi(val); }
+        else if (strcmp(arg, "-n") == 0)     { params.nFrames  = atoi(val); }
+        else if (strcmp(arg, "-seed") == 0)  { params.nSeed    = (RK_U32)atoi(val); }
+        else if (strcmp(arg, "-gain") == 0)  { params.fIspGain = (RK_F32)atof(val); }
+        else if (strcmp(arg, "-shot") == 0)  { params.fShot    = (RK_F32)atof(val); }
+        else if (strcmp(arg, "-read") == 0)  { params.fRead    = (RK_F32)atof(val); }
+        else if (strcmp(arg, "-shift") == 0) { params.fShift   = (RK_F32)atof(val); }
+        else if (strcmp(arg, "-rot") == 0)   { params.fRotate  = (RK_F32)atof(val); }
+        else if (strcmp(arg, "-zoom") == 0)  { params.fZoom    = (RK_F32)atof(val); }
+        else if (strcmp(arg, "-persp") == 0) { params.fPersp   = (RK_F32)atof(val); }
+        else if (strcmp(arg, "-obj") == 0)   { params.nObjects = atoi(val); }
+        else if (strcmp(arg, "-speed") == 0) { params.fSpeed   = (RK_F32)atof(val); }
+        else if (strcmp(arg, "-o") == 0)     { params.pOutDir  = val; }
+        else if (strcmp(arg, "-trace") == 0) { params.pTraceFile = val; }
+        else if (strcmp(arg, "-engines") == 0) { params.nEngines = atoi(val); }
+        else if (strcmp(arg, "-repeat") == 0) { params.nRepeat = atoi(val); }
+        else if (strcmp(arg, "-tile") == 0)  { sscanf(val, "%dx%d", &params.nTileHgt, &params.nTileWid); }
+        else
+        {
+            fprintf(stderr, "usage: %s [-w wid] [-h hgt] [-n frames] [-seed n] [-gain g] [-shot k] [-read s]\n"
+                            "       [-shift px] [-rot deg] [-zoom f] [-persp f] [-obj n] [-speed px] [-o dir] [-memmap] [-dma]\n"
+                            "       [-trace file] [-engines n] [-repeat n] [-session] [-tile HxW] [-band] [-thumbstrip] [-rawthumb] [-fastmatch]\n"
+                            "       [-pyramid]\n", argv[0]);
+            return 1;
+        }
+        i++;
+    }
+    if (params.nFrames < 2 || params.nFrames > RK_MAX_FILE_NUM
+        || params.nRawWid < 512 || params.nRawHgt < 512 || params.fIspGain < 1.0f || params.nEngines < 1
+        || params.nRepeat < 0)
+    {
+        fprintf(stderr, "rk_burst_synth: frames 2..%d, raw size >= 512, gain >= 1, engines >= 1, repeat >= 0\n", RK_MAX_FILE_NUM);
+        return 1;
+    }
+#ifdef SYNTH_VEC_FRAMES
+    if (params.nFrames != SYNTH_VEC_FRAMES)
+    {
+        fprintf(stderr, "rk_burst_synth: vector Denoiser needs %d frames, build with -DMFNR_C_MODEL=1\n", SYNTH_VEC_FRAMES);
+        return 1;
+    }
+#endif
+
+    //// Burst
+    g_SynthSeed = params.nSeed;
+    SynthMakeScene(&params, &scene);
+    SynthMakeBurst(&params, &scene, &burst);
+
+    int      nPixels   = params.nRawWid * params.nRawHgt;
+    RK_U8*   pRawDst   = (RK_U8*)SynthAlloc(burst.nRawSize);
+    RK_U8*   pRawRef   = (RK_U8*)SynthAlloc(burst.nRawSize);
+    RK_U16*  pOutput   = (RK_U16*)SynthAlloc(sizeof(RK_U16) * nPixels);
+    RK_U16*  pRef      = (RK_U16*)SynthAlloc(sizeof(RK_U16) * nPixels);
+    RK_U16*  pSingle   = (RK_U16*)SynthAlloc(sizeof(RK_U16) * nPixels);
+    RK_U8*   pStaticRaws[RK_MAX_FILE_NUM];
+    RK_U16*  pStaticThumbs[RK_MAX_FILE_NUM];
+    double   hErr[RK_MAX_FILE_NUM];
+    double   hErrMean = 0;
+    double   hErrMax  = 0;
+
+    //// Noisy burst: output & registration error
+    RK_DspMemStats dspMem;
+    RK_DmaStats    dmaStats;
+    double ms = SynthRun(&params, &burst, burst.pRaws, burst.pThumbs, pRawDst);
+    RK_MFNR_GetDspMemStats(&dspMem);
+    int nDmaRet = RK_MFNR_GetDmaStats(&dmaStats);
+    if (params.nMemMap)
+    {
+        RK_MFNR_DumpDspMem();
+    }
+    if (params.nDmaStats)
+    {
+        RK_MFNR_DumpDmaStats();
+    }
+    if (params.pTraceFile != NULL && RK_MFNR_WriteTrace(params.pTraceFile))
+    {
+        fprintf(stderr, "rk_burst_synth: no trace written to %s (build with -DMFNR_TRACE=1)\n", params.pTraceFile);
+    }
+    SynthUnpackRaw10(pRawDst, params.nRawWid, params.nRawHgt, burst.nRawStride, pOutput);
+    for (int k=0; k < params.nFrames; k++)
+    {
+        double e, eMax;
+        if (k == BASE_PIC_NUM)
+        {
+            continue;
+        }
+        SynthHomographyError(g_mfnrProcessor.pHomographyMatrix[k], burst.homography[k],
+            params.nRawWid, params.nRawHgt, &e, &eMax);
+        hErr[k]   = e;
+        hErrMean += e / (params.nFrames - 1);
+        hErrMax   = MAX(hErrMax, eMax);
+    }
+    if (params.pOutDir != NULL)
+    {
+        SynthWriteBurst(&params, &burst, pRawDst);
+    }
+    double msEngines = 0;
+    if (params.nEngines > 1)
+    {
+        msEngines = SynthRunEngines(&params, &burst, pRawDst, dspMem.nPeak);
+    }
+    for (int n=0; n < params.nRepeat; n++)
+    {
+        SynthRun(&params, &burst, burst.pRaws, burst.pThumbs, pRawRef);
+        if (memcmp(pRawRef, pRawDst, burst.nRawSize) != 0)
+        {
+            fprintf(stderr, "rk_burst_synth: repeat %d output differs from the first run\n", n + 1);
+            exit(1);
+        }
+    }
+
+    //// Reference: clean BaseFrame as a static burst
+    RK_U8*  pCleanRaw   = (RK_U8*)SynthAlloc(burst.nRawSize);
+    RK_U16* pCleanThumb = (RK_U16*)SynthAlloc(burst.nThumbSize);
+    SynthPackRaw10(burst.pClean, params.nRawWid, params.nRawHgt, burst.nRawStride, pCleanRaw);
+    SynthMakeThumb(burst.pClean, params.nRawWid, burst.nThumbWid, burst.nThumbHgt, burst.nThumbStride, pCleanThumb);
+    for (int k=0; k < params.nFrames; k++)
+    {
+        pStaticRaws[k]   = pCleanRaw;
+        pStaticThumbs[k] = pCleanThumb;
+    }
+    SynthRun(&params, &burst, pStaticRaws, pStaticThumbs, pRawRef);
+    SynthUnpackRaw10(pRawRef, params.nRawWid, params.nRawHgt, burst.nRawStride, pRef);
+
+    //// Single frame: noisy BaseFrame as a static burst
+    for (int k=0; k < params.nFrames; k++)
+    {
+        pStaticRaws[k]   = burst.pRaws[BASE_PIC_NUM];
+        pStaticThumbs[k] = burst.pThumbs[BASE_PIC_NUM];
+    }
+    SynthRun(&params, &burst, pStaticRaws, pStaticThumbs, pRawRef);
+    SynthUnpackRaw10(pRawRef, params.nRawWid, params.nRawHgt, burst.nRawStride, pSingle);
+    if (g_SynthSessionOpen)
+    {
+        RK_MFNR_SessionClose(&g_mfnrProcessor);
+    }
+
+    //// Scores
+    printf("{\"width\":%d,\"height\":%d,\"frames\":%d,\"seed\":%u,\"gain\":%.2f,\"shot\":%.2f,\"read\":%.2f,\"objects\":%d,"
+        "\"psnr\":%.3f,\"psnr_single\":%.3f,\"psnr_static\":%.3f,\"psnr_motion\":%.3f,"
+        "\"h_err_mean\":%.4f,\"h_err_max\":%.4f,\"h_err\":[",
+        params.nRawWid, params.nRawHgt, params.nFrames, params.nSeed, params.fIspGain, params.fShot, params.fRead,
+        scene.nObjects,
+        SynthPsnr(pOutput, pRef, NULL, -1, params.nRawWid, params.nRawHgt),
+        SynthPsnr(pSingle, pRef, NULL, -1, params.nRawWid, params.nRawHgt),
+        SynthPsnr(pOutput, pRef, burst.pMotionMask, 0, params.nRawWid, params.nRawHgt),
+        SynthPsnr(pOutput, pRef, burst.pMotionMask, 1, params.nRawWid, params.nRawHgt),
+        hErrMean, hErrMax);
+    for (int k=0, n=0; k < params.nFrames; k++)
+    {
+        if (k != BASE_PIC_NUM)
+        {
+            printf("%s%.4f", n++ ? "," : "", hErr[k]);
+        }
+    }
+    printf("],\"ms\":%.1f,\"dsp_peak\":%u,\"tile\":\"%dx%d\",\"band\":%d", ms, dspMem.nPeak,
+        g_mfnrProcessor.mTileHgt, g_mfnrProcessor.mTileWid, g_mfnrProcessor.mUseRowBand);
+    if (nDmaRet == 0)
+    {
+        double nRead  = 0;
+        double nInput = (double)(dmaStats.nRawFrameSize + dmaStats.nThumbFrameSize) * dmaStats.nFrames;
+        for (int k=0; k < dmaStats.nFrames; k++)
+        {
+            nRead += (double)(dmaStats.nRawFetched[k] + dmaStats.nThumbFetched[k]);
+        }
+        printf(",\"dma_read\":%.0f,\"dma_amp\":%.3f", nRead, nRead / nInput);
+    }
+    if (params.nEngines > 1)
+    {
+        printf(",\"engines\":%d,\"engines_ms\":%.1f", params.nEngines, msEngines);
+    }
+    if (params.nRepeat > 0)
+    {
+        printf(",\"repeat\":%d", params.nRepeat);
+    }
+    printf("}\n");
+
+    free(pCleanRaw);
+    free(pCleanThumb);
+    free(pRawDst);
+    free(pRawRef);
+    free(pOutput);
+    free(pRef);
+    free(pSingle);
+    SynthFreeBurst(&params, &scene, &burst);
+
+    return 0;
+
+} // main()
@@ -0,0 +1,993 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: rk_kernel_bench.cpp
+// Desc: Host microbenchmark of the Register, Denoiser & BayerWDR kernels
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// Every kernel runs in isolation on synthetic data, on the buffer shapes
+// MFNR_Process hands it. Each call is timed, then scaled by the number of
+// calls one burst of that geometry makes.
+//
+// Build (vector variants, add -DMFNR_C_MODEL=1 for the C models):
+//   g++ -O2 -mavx2 -Imfnr/host -Imfnr mfnr/host/bench/rk_kernel_bench.cpp
+//       mfnr/rk_mfnr.cpp mfnr/rk_register.cpp mfnr/rk_denoiser.cpp
+//       mfnr/rk_bayerwdr.cpp mfnr/host/dma/dma.cpp -lpthread
+//
+// Usage: rk_kernel_bench [-g 12|48|108] [-n frames] [-k kernel] [-t ms]
+//   -g  one geometry (default 12MP 4000x3000, 48MP 8000x6000, 108MP 12000x9000)
+//   -n  one frame count (default 2..RK_MAX_FILE_NUM)
+//   -k  kernels whose name starts with this string
+//   -t  time budget per kernel & geometry in ms (default 50)
+//
+// Output: one JSON object per line
+//   kernel, variant     kernel name, "c" or "vec"
+//   mp, width, height   geometry of the burst
+//   frames              frames in the burst
+//   calls               calls of the kernel in one burst
+//   ns_call, bytes_call time & operand bytes (read + written) of one call
+//   ns_px, bytes_px     ns_call*calls & bytes_call*calls per output pixel
+//   stat_overflow       1 if the 256-cell WDR statistic tables can not
+//                       hold this geometry (timing is still valid)
+//
+// Burst call counts follow Register()/Enhancer_Modify(): numValidFeature
+// is taken as half of the feature segments (FeatureFilter keeps those above
+// the mean), homography kernels as NUM_HOMOGRAPHY tries per RefFrame.
+// MotionDetectFilter is only timed in C-model builds, its vector branch is
+// empty; it runs in Enhancer() once per tile & frame.
+// CalcuHist_Vec is skipped beyond ThumbWid 527 (its idx_pre[] table).
+// Feature*MatchingFast runs on the inputs of the exhaustive kernel, whose
+// match is 3 rows & 5 cols (Fine: 1 row) off the predicted position.
+// FeaturePyramidMatching times both levels of one Feature & RefFrame a
+// call (usePyramidMatch), each match 1 row & 2 cols off the prediction.
+//
+#include <chrono>
+
+#include "rk_register.h"                // Register
+#include "rk_denoiser.h"                // Denoiser
+#include "rk_bayerwdr.h"                // BayerWDR
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Macro Definition
+//
+#ifdef CEVA_CHIP_CODE_REGISTER
+#define     VARIANT_REGISTER        "vec"           // FeatureDetect, Coarse/FineMatching, Scaler
+#else
+#define     VARIANT_REGISTER        "c"
+#endif
+#if !defined(CEVA_CHIP_CODE_REGISTER) || defined(VEC_C_HOST)
+#define     VARIANT_HOMOGRAPHY      "c"             // ComputePerspectMatrix, ComputeHomographyError
+#else
+#define     VARIANT_HOMOGRAPHY      "vec"
+#endif
+#ifdef CEVA_CHIP_CODE_DENOISER
+#define     VARIANT_DENOISER        "vec"           // TemporalDenoise_Modify
+#else
+#define     VARIANT_DENOISER        "c"
+#endif
+#if WDR_VECC
+#define     VARIANT_WDR             "vec"           // wdr_process_block
+#else
+#define     VARIANT_WDR             "c"
+#endif
+
+#define     BENCH_NUM_GEOMETRY      3               // 12MP, 48MP, 108MP
+#define     BENCH_NUM_BATCH         5               // timed batches, best one is reported
+#define     BENCH_TIME_MS           50              // default time budget per kernel
+#define     WDR_STAT_CELLS          256             // cells of one bin plane in the WDR statistic tables
+#define     WDR_STAT_BINS           16              // bin planes allocated (9 used)
+#define     CALCUHIST_VEC_MAX_WID   527             // idx_pre[17] of CalcuHist_Vec
+#define     BENCH_BUF_TAIL          16384           // vector kernels load up to 2 rows past the chunk end, as in g_DspBuf
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Type Defines
+//
+////---- struct BenchGeometry
+typedef struct tag_BenchGeometry
+{
+    int             nMegaPixel;         // 12, 48, 108
+    int             nRawWid;            // Raw width
+    int             nRawHgt;            // Raw height
+}BenchGeometry;
+
+////---- struct BenchContext: shapes & burst call counts of one geometry
+typedef struct tag_BenchContext
+{
+    int             nRawWid;            // Raw
+    int             nRawHgt;
+    int             nThumbWid;          // Thumb 1/8
+    int             nThumbHgt;
+    int             nThumbStride;       // Thumb stride in Byte
+    int             nSegCol;            // 32x32 segments in Thumb
+    int             nSegRow;
+    int             nValidFeature;      // estimated numValidFeature
+    int             nTiles;             // 32x64 Enhancer tiles
+    int             nStatWid;           // WDR statistic grid
+    int             nStatHgt;
+    int             nFrames;            // current frame count
+    int             nTimeMs;            // time budget per kernel
+}BenchContext;
+
+////---- kernel call
+typedef void (*BenchFunc)(void* pArgs);
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Global Variables
+//
+static const BenchGeometry g_BenchGeometry[BENCH_NUM_GEOMETRY] = {
+    {  12,  4000, 3000 },
+    {  48,  8000, 6000 },
+    { 108, 12000, 9000 },
+};
+
+static RK_U32 g_BenchSeed = 0x12345678;     // synthetic data LCG
+static volatile RK_U32 g_BenchSink = 0;     // keeps results alive
+
+extern unsigned short cure_table[24][961];  // rk_bayerwdr.cpp: WDR scale tables
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Functions Definition
+//
+/************************************************************************/
+// Func: BenchRand()
+// Desc: LCG for synthetic data, same sequence on every run
+/*************************************************************************/
+static RK_U32 BenchRand(void)
+{
+    g_BenchSeed = g_BenchSeed * 1664525 + 1013904223;
+    return g_BenchSeed >> 8;
+} // BenchRand()
+
+
+/************************************************************************/
+// Func: BenchFillImage()
+// Desc: Smooth gradient + noise, so SAD minima and gradient maxima are
+//       found at data dependent positions like on real frames
+//   In: nWid, nHgt, nStride  - size in pixels
+//       nMax                 - max value: 0x3FF raw, 0xFFFF thumb
+//       nShift               - spatial shift of the pattern (frame motion)
+//  Out: pDst                 - image
+/*************************************************************************/
+static void BenchFillImage(RK_U16* pDst, int nWid, int nHgt, int nStride, int nMax, int nShift)
+{
+    for (int r=0; r < nHgt; r++)
+    {
+        for (int c=0; c < nWid; c++)
+        {
+            int v = ((r + nShift) * 7 + (c + nShift) * 5) % (nMax / 2) + (int)(BenchRand() % 32);
+            pDst[r * nStride + c] = (RK_U16)MIN(v, nMax);
+        }
+    }
+} // BenchFillImage()
+
+
+/************************************************************************/
+// Func: BenchAlloc()
+// Desc: zeroed buffer with BENCH_BUF_TAIL slack, exits on failure
+/*************************************************************************/
+static void* BenchAlloc(size_t nSize)
+{
+    void* p = calloc(1, nSize + BENCH_BUF_TAIL);
+    if (p == NULL)
+    {
+        fprintf(stderr, "rk_kernel_bench: out of memory (%lu Byte)\n", (unsigned long)nSize);
+        exit(1);
+    }
+    return p;
+} // BenchAlloc()
+
+
+/************************************************************************/
+// Func: BenchTime()
+// Desc: ns of one call: best average over BENCH_NUM_BATCH batches, each
+//       batch sized to ~1/BENCH_NUM_BATCH of the time budget
+/*************************************************************************/
+static double BenchTime(BenchFunc func, void* pArgs, int nTimeMs)
+{
+    typedef std::chrono::steady_clock Clock;
+    double  nsBudget = nTimeMs * 1e6 / BENCH_NUM_BATCH;
+    double  nsBest   = 0;
+    long    nReps    = 1;
+
+    // warm-up & batch size
+    Clock::time_point t0 = Clock::now();
+    func(pArgs);
+    double nsOne = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+    if (nsOne < nsBudget)
+    {
+        nReps = (long)(nsBudget / MAX(nsOne, 1.0));
+    }
+
+    for (int b=0; b < BENCH_NUM_BATCH; b++)
+    {
+        t0 = Clock::now();
+        for (long i=0; i < nReps; i++)
+        {
+            func(pArgs);
+        }
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count() / nReps;
+        if (b == 0 || ns < nsBest)
+        {
+            nsBest = ns;
+        }
+    }
+    return nsBest;
+} // BenchTime()
+
+
+/************************************************************************/
+// Func: BenchReport()
+// Desc: one JSON line
+/*************************************************************************/
+static void BenchReport(const char* kernel, const char* variant, const BenchGeometry* geo, const BenchContext* ctx,
+    double calls, double nsCall, double bytesCall, int statOverflow)
+{
+    double pixels = (double)ctx->nRawWid * ctx->nRawHgt;
+    printf("{\"kernel\":\"%s\",\"variant\":\"%s\",\"mp\":%d,\"width\":%d,\"height\":%d,\"frames\":%d,"
+        "\"calls\":%.0f,\"ns_call\":%.1f,\"bytes_call\":%.0f,\"ns_px\":%.6f,\"bytes_px\":%.6f,\"stat_overflow\":%d}\n",
+        kernel, variant, geo->nMegaPixel, ctx->nRawWid, ctx->nRawHgt, ctx->nFrames,
+        calls, nsCall, bytesCall, nsCall * calls / pixels, bytesCall * calls / pixels, statOverflow);
+    fflush(stdout);
+} // BenchReport()
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Kernels
+//
+////---- FeatureDetect: ThumbChunk (ThumbWid+2)x(32+2)
+typedef struct tag_ArgsFeatureDetect
+{
+    RK_U16*         pChunk;
+    int             nWid;
+    int             nStride;
+    int             numFeature;
+    RK_U16*         pFeatPoints[2];
+    RK_U16*         pFeatValues;
+}ArgsFeatureDetect;
+
+static void CallFeatureDetect(void* pArgs)
+{
+    ArgsFeatureDetect* a = (ArgsFeatureDetect*)pArgs;
+    FeatureDetect(a->pChunk, a->nWid, NUM_LINE_DDR2DSP_THUMB+2, a->nStride, 0, a->numFeature, a->pFeatPoints, a->pFeatValues);
+    g_BenchSink += a->pFeatValues[0];
+}
+
+////---- FeatureCoarseMatching: 16x16 ThumbBase in (16+2r)x(16+2r) ThumbRef
+typedef struct tag_ArgsCoarse
+{
+    RK_U16*         pBase;
+    RK_U16*         pRef;
+    RK_U16          nRefSize;
+}ArgsCoarse;
+
+static void CallFeatureCoarseMatching(void* pArgs)
+{
+    ArgsCoarse* a = (ArgsCoarse*)pArgs;
+    RK_U16      row, col, cost;
+    FeatureCoarseMatching(a->pBase, COARSE_MATCH_WIN_SIZE, COARSE_MATCH_WIN_SIZE,
+        a->pRef, a->nRefSize, a->nRefSize, a->nRefSize, row, col, cost);
+    g_BenchSink += row + col + cost;
+}
+
+static void CallFeatureCoarseMatchingFast(void* pArgs)
+{
+    ArgsCoarse* a = (ArgsCoarse*)pArgs;
+    RK_U16      row, col, cost;
+    FeatureCoarseMatchingFast(a->pBase, COARSE_MATCH_WIN_SIZE, COARSE_MATCH_WIN_SIZE,
+        a->pRef, a->nRefSize, a->nRefSize, a->nRefSize, row, col, cost);
+    g_BenchSink += row + col + cost;
+}
+
+////---- Scaler_Raw2Luma: RawRef block (64+2r)x(64+2r), 4-pixel aligned
+typedef struct tag_ArgsScaler
+{
+    RK_U16*         pRaw;
+    int             nWid;
+    int             nHgt;
+    RK_U16*         pLuma;
+}ArgsScaler;
+
+static void CallScaler_Raw2Luma(void* pArgs)
+{
+    ArgsScaler* a = (ArgsScaler*)pArgs;
+    Scaler_Raw2Luma(a->pRaw, a->nWid, a->nHgt, a->nWid/2, a->nHgt/2, a->pLuma);
+    g_BenchSink += a->pLuma[0];
+}
+
+////---- FeatureFineMatching: 32x32 LumaBase in LumaRef
+typedef struct tag_ArgsFine
+{
+    RK_U16*         pBase;
+    RK_U16*         pRef;
+    RK_U16          nRefHgt;
+    RK_U16          nRefWid4p;
+    RK_U16          nColSt;
+    RK_U16          nRefWid;
+}ArgsFine;
+
+static void CallFeatureFineMatching(void* pArgs)
+{
+    ArgsFine*   a = (ArgsFine*)pArgs;
+    RK_U16      row, col, cost;
+    FeatureFineMatching(a->pBase, FINE_MATCH_WIN_SIZE/2, FINE_MATCH_WIN_SIZE/2,
+        a->pRef, a->nRefHgt, a->nRefWid4p, a->nColSt, a->nRefWid, row, col, cost);
+    g_BenchSink += row + col + cost;
+}
+
+static void CallFeatureFineMatchingFast(void* pArgs)
+{
+    ArgsFine*   a = (ArgsFine*)pArgs;
+    RK_U16      row, col, cost;
+    FeatureFineMatchingFast(a->pBase, FINE_MATCH_WIN_SIZE/2, FINE_MATCH_WIN_SIZE/2,
+        a->pRef, a->nRefHgt, a->nRefWid4p, a->nColSt, a->nRefWid, row, col, cost);
+    g_BenchSink += row + col + cost;
+}
+
+////---- ThumbPyramidBox: 4 Thumb rows -> one Pyramid top row
+typedef struct tag_ArgsPyramidBox
+{
+    RK_U16*         pThumb;
+    int             nStride;
+    int             nPyrWid;
+    RK_U16*         pPyr;
+}ArgsPyramidBox;
+
+static void CallThumbPyramidBox(void* pArgs)
+{
+    ArgsPyramidBox* a = (ArgsPyramidBox*)pArgs;
+    ThumbPyramidBox(a->pThumb, a->nStride, a->nPyrWid, a->pPyr);
+    g_BenchSink += a->pPyr[0];
+}
+
+////---- FeaturePyramidMatching: both levels, 16x16 in (16+2*6)^2 top & (16+2*3)^2 Thumb windows
+typedef struct tag_ArgsPyramid
+{
+    RK_U16*         pBase[2];
+    RK_U16*         pRef[2];
+    RK_U16          nRefSize[2];
+    RK_U16          nRadius[2];
+}ArgsPyramid;
+
+static void CallFeaturePyramidMatching(void* pArgs)
+{
+    ArgsPyramid* a = (ArgsPyramid*)pArgs;
+    RK_U16      row, col, cost;
+    for (int l=0; l < 2; l++)
+    {
+        FeaturePyramidMatching(a->pBase[l], PYR_MATCH_WIN_SIZE, PYR_MATCH_WIN_SIZE,
+            a->pRef[l], a->nRefSize[l], a->nRefSize[l], a->nRefSize[l], a->nRadius[l], a->nRadius[l], row, col, cost);
+        g_BenchSink += row + col + cost;
+    }
+}
+
+////---- ComputePerspectMatrix: 8x8 system of 4 point pairs
+typedef struct tag_ArgsPerspect
+{
+    RK_F32          matA[64];
+    RK_F32          vecB[8];
+    RK_F32          vecX[9];
+}ArgsPerspect;
+
+static void CallComputePerspectMatrix(void* pArgs)
+{
+    ArgsPerspect* a = (ArgsPerspect*)pArgs;
+    RK_F32      matA[64], vecB[8];
+    memcpy(matA, a->matA, sizeof(matA)); // solved in place
+    memcpy(vecB, a->vecB, sizeof(vecB));
+    a->vecX[8] = 1;
+    g_BenchSink += ComputePerspectMatrix(matA, vecB, a->vecX);
+}
+
+////---- ComputeHomographyError: type=1 over all valid features
+typedef struct tag_ArgsHomoError
+{
+    RK_U8*          pMarks;
+    int             numFeature;
+    RK_U16*         pPointYs[2];
+    RK_U16*         pPointXs[2];
+    RK_F32          vecX[9];
+}ArgsHomoError;
+
+static void CallComputeHomographyError(void* pArgs)
+{
+    ArgsHomoError* a = (ArgsHomoError*)pArgs;
+    RK_F32      basePoint[3], projPoint[3], refPoint[3];
+    RK_U32      error = 0;
+    ComputeHomographyError(1, a->pMarks, a->numFeature, a->pPointYs, a->pPointXs, 0, 1,
+        a->vecX, basePoint, projPoint, refPoint, error);
+    g_BenchSink += error;
+}
+
+////---- MotionDetectFilter / TemporalDenoise_Modify: one 32x64 tile
+typedef struct tag_ArgsDenoise
+{
+    RK_U16*         pBlocks[RK_MAX_FILE_NUM];
+    RK_F32*         pPoints[RK_MAX_FILE_NUM];
+    RK_RectExt      rects[RK_MAX_FILE_NUM];
+    int             nFrames;
+    RK_U16*         pTable;
+    RK_S16          nBlackLevel[4];
+    RK_U16*         pDst;
+}ArgsDenoise;
+
+#ifndef CEVA_CHIP_CODE_DENOISER
+static void CallMotionDetectFilter(void* pArgs)
+{
+    ArgsDenoise* a = (ArgsDenoise*)pArgs;
+    MotionDetectFilter(a->pBlocks[0], a->rects[0], a->pDst);
+    g_BenchSink += a->pDst[0];
+}
+#endif
+
+static void CallTemporalDenoise_Modify(void* pArgs)
+{
+    ArgsDenoise* a = (ArgsDenoise*)pArgs;
+    TemporalDenoise_Modify(a->pBlocks, RAW_WIN_NUM, a->rects, a->nFrames, 0, a->pPoints,
+        a->pTable, 1.0f, a->nBlackLevel, a->pDst, RAW_BLK_SIZE * RAW_WIN_NUM);
+    g_BenchSink += a->pDst[0];
+}
+
+////---- wdrPreFilterBlock / CalcuHist / HistFilter: ThumbChunk (ThumbWid+2)x(32+2)
+typedef struct tag_ArgsWdrStat
+{
+    RK_U16*         pChunk;
+    RK_U16*         pFilter;
+    RK_U16*         pCount;
+    RK_U32*         pWeight;
+    int             nWid;
+    int             nStatWid;
+    int             nStatHgt;
+}ArgsWdrStat;
+
+static void CallWdrPreFilterBlock(void* pArgs)
+{
+    ArgsWdrStat* a = (ArgsWdrStat*)pArgs;
+    wdrPreFilterBlock(a->pChunk, a->pFilter, NUM_LINE_DDR2DSP_THUMB+2, a->nWid);
+    g_BenchSink += a->pFilter[0];
+}
+
+static void CallWdrPreFilterBlock_Vec(void* pArgs)
+{
+    ArgsWdrStat* a = (ArgsWdrStat*)pArgs;
+    wdrPreFilterBlock_Vec(a->pChunk, a->pFilter, NUM_LINE_DDR2DSP_THUMB, a->nWid - 2, a->nWid);
+    g_BenchSink += a->pFilter[0];
+}
+
+static void CallCalcuHist(void* pArgs)
+{
+    ArgsWdrStat* a = (ArgsWdrStat*)pArgs;
+    CalcuHist(a->pFilter, a->pCount, a->pWeight, NUM_LINE_DDR2DSP_THUMB+2, a->nWid, a->nStatWid, 0);
+    g_BenchSink += a->pCount[0];
+}
+
+static void CallCalcuHist_Vec(void* pArgs)
+{
+    ArgsWdrStat* a = (ArgsWdrStat*)pArgs;
+    CalcuHist_Vec(a->pFilter, a->pChunk, a->pCount, a->pWeight, NUM_LINE_DDR2DSP_THUMB, a->nWid - 2, a->nWid, a->nStatWid, 0);
+    g_BenchSink += a->pCount[0];
+}
+
+static void CallHistFilter(void* pArgs)
+{
+    ArgsWdrStat* a = (ArgsWdrStat*)pArgs;
+    HistFilter(a->pCount, a->pWeight, a->nStatHgt, a->nStatWid);
+    g_BenchSink += a->pCount[0];
+}
+
+////---- wdr_process_block: 34x66 WdrBuf -> 32x64
+typedef struct tag_ArgsWdrBlock
+{
+    RK_U16*         pBuf;
+    RK_U16*         pWeight;
+    RK_U16*         pScale;
+    RK_U16*         pGain;
+    RK_U16*         pOut;
+    RK_U16*         pLeftRight;
+    int             nStatWid;
+}ArgsWdrBlock;
+
+static void CallWdr_process_block(void* pArgs)
+{
+    ArgsWdrBlock* a = (ArgsWdrBlock*)pArgs;
+    wdr_process_block(RAW_BLK_SIZE*RAW_WIN_NUM, RAW_BLK_SIZE, RAW_BLK_SIZE*RAW_WIN_NUM, RAW_BLK_SIZE,
+        a->nStatWid, RAW_BLK_SIZE*RAW_WIN_NUM+2, RAW_BLK_SIZE*RAW_WIN_NUM,
+        a->pBuf, a->pWeight, a->pScale, a->pGain, a->pOut, a->pLeftRight);
+    g_BenchSink += a->pOut[0];
+}
+
+
+/************************************************************************/
+// Func: BenchMatch()
+// Desc: kernel filter of -k
+/*************************************************************************/
+static int BenchMatch(const char* kernel, const char* filter)
+{
+    return filter == NULL || strncmp(kernel, filter, strlen(filter)) == 0;
+} // BenchMatch()
+
+
+/************************************************************************/
+// Func: BenchRegister()
+// Desc: FeatureDetect ... ComputeHomographyError of one geometry,
+//       per-call cost is timed once and reported for every frame count
+/*************************************************************************/
+static void BenchRegister(const BenchGeometry* geo, BenchContext* ctx, int nFrameMin, int nFrameMax, const char* filter)
+{
+    double  ns;
+    double  nsFast;     // Feature*MatchingFast, timed with the exhaustive kernel
+    double  bytes;
+    int     nRefs;
+
+    //// FeatureDetect
+    if (BenchMatch("FeatureDetect", filter))
+    {
+        ArgsFeatureDetect a;
+        a.nWid           = ctx->nThumbWid + 2;
+        a.nStride        = ctx->nThumbStride + 4;
+        a.numFeature     = ctx->nSegCol;
+        a.pChunk         = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.nWid * (NUM_LINE_DDR2DSP_THUMB+2));
+        a.pFeatPoints[0] = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.numFeature);
+        a.pFeatPoints[1] = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.numFeature);
+        a.pFeatValues    = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.numFeature);
+        BenchFillImage(a.pChunk, a.nWid, NUM_LINE_DDR2DSP_THUMB+2, a.nWid, 0xFFFF, 0);
+        ns    = BenchTime(CallFeatureDetect, &a, ctx->nTimeMs);
+        bytes = sizeof(RK_U16) * (a.nWid * (NUM_LINE_DDR2DSP_THUMB+2) + 3 * a.numFeature);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            BenchReport("FeatureDetect", VARIANT_REGISTER, geo, ctx, ctx->nSegRow, ns, bytes, 0);
+        }
+        free(a.pChunk); free(a.pFeatPoints[0]); free(a.pFeatPoints[1]); free(a.pFeatValues);
+    }
+
+    //// FeatureCoarseMatching
+    if (BenchMatch("FeatureCoarseMatching", filter))
+    {
+        ArgsCoarse  a;
+        a.nRefSize = COARSE_MATCH_WIN_SIZE + 2 * COARSE_MATCH_RADIUS;
+        a.pBase    = (RK_U16*)BenchAlloc(sizeof(RK_U16) * COARSE_MATCH_WIN_SIZE * COARSE_MATCH_WIN_SIZE);
+        a.pRef     = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.nRefSize * a.nRefSize);
+        BenchFillImage(a.pRef, a.nRefSize, a.nRefSize, a.nRefSize, 0xFFFF, 0);
+        CopyBlockData(a.pRef + 5 * a.nRefSize + 3, a.pBase, COARSE_MATCH_WIN_SIZE, COARSE_MATCH_WIN_SIZE,
+            a.nRefSize * 2, COARSE_MATCH_WIN_SIZE * 2);
+        ns    = BenchTime(CallFeatureCoarseMatching, &a, ctx->nTimeMs);
+        nsFast = BenchMatch("FeatureCoarseMatchingFast", filter) ? BenchTime(CallFeatureCoarseMatchingFast, &a, ctx->nTimeMs) : 0;
+        bytes = sizeof(RK_U16) * (COARSE_MATCH_WIN_SIZE * COARSE_MATCH_WIN_SIZE + a.nRefSize * a.nRefSize);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            nRefs = ctx->nFrames - 1;
+            BenchReport("FeatureCoarseMatching", VARIANT_REGISTER, geo, ctx, (double)ctx->nValidFeature * nRefs, ns, bytes, 0);
+            if (nsFast > 0)
+            {
+                BenchReport("FeatureCoarseMatchingFast", VARIANT_REGISTER, geo, ctx, (double)ctx->nValidFeature * nRefs, nsFast, bytes, 0);
+            }
+        }
+        free(a.pBase); free(a.pRef);
+    }
+
+    //// Scaler_Raw2Luma & FeatureFineMatching
+    int nRefRaw   = FINE_MATCH_WIN_SIZE + 2 * FINE_LUMA_RADIUS * 2;   // 64+2*radius
+    int nRefRaw4p = ALIGN_4PIXEL_WIDTH(2 + nRefRaw);                  // nStartCol=2
+    if (BenchMatch("Scaler_Raw2Luma", filter))
+    {
+        ArgsScaler  a;
+        a.nWid  = nRefRaw4p;
+        a.nHgt  = nRefRaw;
+        a.pRaw  = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.nWid * a.nHgt);
+        a.pLuma = (RK_U16*)BenchAlloc(sizeof(RK_U16) * (a.nWid/2) * (a.nHgt/2));
+        BenchFillImage(a.pRaw, a.nWid, a.nHgt, a.nWid, 0x3FF, 0);
+        ns    = BenchTime(CallScaler_Raw2Luma, &a, ctx->nTimeMs);
+        bytes = sizeof(RK_U16) * (a.nWid * a.nHgt + (a.nWid/2) * (a.nHgt/2));
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            // RawBase once + RawRef per RefFrame
+            BenchReport("Scaler_Raw2Luma", VARIANT_REGISTER, geo, ctx, (double)ctx->nValidFeature * ctx->nFrames, ns, bytes, 0);
+        }
+        free(a.pRaw); free(a.pLuma);
+    }
+    if (BenchMatch("FeatureFineMatching", filter))
+    {
+        ArgsFine    a;
+        int         nBase = FINE_MATCH_WIN_SIZE / 2;
+        a.nRefHgt   = nRefRaw / 2;
+        a.nRefWid4p = nRefRaw4p / 2;
+        a.nColSt    = 1;
+        a.nRefWid   = nRefRaw / 2;
+        a.pBase     = (RK_U16*)BenchAlloc(sizeof(RK_U16) * nBase * nBase);
+        a.pRef      = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.nRefWid4p * a.nRefHgt);
+        BenchFillImage(a.pRef, a.nRefWid4p, a.nRefHgt, a.nRefWid4p, 0x3FF * 4, 0);
+        CopyBlockData(a.pRef + 4 * a.nRefWid4p + 6, a.pBase, nBase, nBase, a.nRefWid4p * 2, nBase * 2);
+        ns    = BenchTime(CallFeatureFineMatching, &a, ctx->nTimeMs);
+        nsFast = BenchMatch("FeatureFineMatchingFast", filter) ? BenchTime(CallFeatureFineMatchingFast, &a, ctx->nTimeMs) : 0;
+        bytes = sizeof(RK_U16) * (nBase * nBase + a.nRefWid4p * a.nRefHgt);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            nRefs = ctx->nFrames - 1;
+            BenchReport("FeatureFineMatching", VARIANT_REGISTER, geo, ctx, (double)ctx->nValidFeature * nRefs, ns, bytes, 0);
+            if (nsFast > 0)
+            {
+                BenchReport("FeatureFineMatchingFast", VARIANT_REGISTER, geo, ctx, (double)ctx->nValidFeature * nRefs, nsFast, bytes, 0);
+            }
+        }
+        free(a.pBase); free(a.pRef);
+    }
+
+    //// ThumbPyramidBox: PyramidBuild, a top row per 4 Thumb rows & frame
+    if (BenchMatch("ThumbPyramidBox", filter))
+    {
+        ArgsPyramidBox a;
+        a.nStride = ctx->nThumbWid;
+        a.nPyrWid = ctx->nThumbWid / SCALER_FACTOR_T2P;
+        a.pThumb  = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.nStride * SCALER_FACTOR_T2P);
+        a.pPyr    = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.nPyrWid);
+        BenchFillImage(a.pThumb, a.nStride, SCALER_FACTOR_T2P, a.nStride, 0xFFFF, 0);
+        ns    = BenchTime(CallThumbPyramidBox, &a, ctx->nTimeMs);
+        bytes = sizeof(RK_U16) * (a.nStride * SCALER_FACTOR_T2P + a.nPyrWid);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            BenchReport("ThumbPyramidBox", VARIANT_REGISTER, geo, ctx, (double)(ctx->nThumbHgt / SCALER_FACTOR_T2P) * ctx->nFrames, ns, bytes, 0);
+        }
+        free(a.pThumb); free(a.pPyr);
+    }
+
+    //// FeaturePyramidMatching: a call matches both levels of one Feature & RefFrame
+    if (BenchMatch("FeaturePyramidMatching", filter))
+    {
+        ArgsPyramid a;
+        a.nRadius[0] = PYR_MATCH_RADIUS;
+        a.nRadius[1] = PYR_THUMB_RADIUS;
+        bytes = 0;
+        for (int l=0; l < 2; l++)
+        {
+            a.nRefSize[l] = PYR_MATCH_WIN_SIZE + 2 * a.nRadius[l];
+            a.pBase[l]    = (RK_U16*)BenchAlloc(sizeof(RK_U16) * PYR_MATCH_WIN_SIZE * PYR_MATCH_WIN_SIZE);
+            a.pRef[l]     = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.nRefSize[l] * a.nRefSize[l]);
+            BenchFillImage(a.pRef[l], a.nRefSize[l], a.nRefSize[l], a.nRefSize[l], 0xFFFF, 0);
+            CopyBlockData(a.pRef[l] + (a.nRadius[l] + 1) * a.nRefSize[l] + a.nRadius[l] + 2, a.pBase[l], PYR_MATCH_WIN_SIZE, PYR_MATCH_WIN_SIZE,
+                a.nRefSize[l] * 2, PYR_MATCH_WIN_SIZE * 2);
+            bytes += sizeof(RK_U16) * (PYR_MATCH_WIN_SIZE * PYR_MATCH_WIN_SIZE + a.nRefSize[l] * a.nRefSize[l]);
+        }
+        ns    = BenchTime(CallFeaturePyramidMatching, &a, ctx->nTimeMs);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            nRefs = ctx->nFrames - 1;
+            BenchReport("FeaturePyramidMatching", VARIANT_REGISTER, geo, ctx, (double)ctx->nValidFeature * nRefs, ns, bytes, 0);
+        }
+        for (int l=0; l < 2; l++)
+        {
+            free(a.pBase[l]); free(a.pRef[l]);
+        }
+    }
+
+    //// ComputePerspectMatrix
+    if (BenchMatch("ComputePerspectMatrix", filter))
+    {
+        ArgsPerspect a;
+        RK_U16 points4[16] = {  100,  100,  103,   98,      // Base(y,x) Ref(y,x)
+                                100,  900,  102,  899,
+                                700,  100,  704,   97,
+                                700,  900,  703,  901 };
+        CreateCoefficient(points4, a.matA, a.vecB);
+        ns    = BenchTime(CallComputePerspectMatrix, &a, ctx->nTimeMs);
+        bytes = sizeof(RK_F32) * (64 + 8 + 9);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            nRefs = ctx->nFrames - 1;
+            BenchReport("ComputePerspectMatrix", VARIANT_HOMOGRAPHY, geo, ctx, (double)NUM_HOMOGRAPHY * nRefs, ns, bytes, 0);
+        }
+    }
+
+    //// ComputeHomographyError
+    if (BenchMatch("ComputeHomographyError", filter))
+    {
+        ArgsHomoError a;
+        a.numFeature  = MAX(ctx->nValidFeature, 1);
+        a.pMarks      = (RK_U8*)BenchAlloc(a.numFeature);
+        for (int k=0; k < 2; k++)
+        {
+            a.pPointYs[k] = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.numFeature);
+            a.pPointXs[k] = (RK_U16*)BenchAlloc(sizeof(RK_U16) * a.numFeature);
+        }
+        for (int n=0; n < a.numFeature; n++)
+        {
+            a.pMarks[n]      = (RK_U8)(BenchRand() % 8 != 0);  // most features survive MvHistFilter
+            a.pPointYs[0][n] = (RK_U16)(BenchRand() % ctx->nRawHgt);
+            a.pPointXs[0][n] = (RK_U16)(BenchRand() % ctx->nRawWid);
+            a.pPointYs[1][n] = (RK_U16)(a.pPointYs[0][n] + BenchRand() % 8);
+            a.pPointXs[1][n] = (RK_U16)(a.pPointXs[0][n] + BenchRand() % 8);
+        }
+        memset(a.vecX, 0, sizeof(a.vecX));
+        a.vecX[0] = 1.001f; a.vecX[2] = 3.0f;
+        a.vecX[4] = 0.999f; a.vecX[5] = 2.0f;
+        a.vecX[8] = 1.0f;
+        ns    = BenchTime(CallComputeHomographyError, &a, ctx->nTimeMs);
+        bytes = (double)a.numFeature * (sizeof(RK_U8) + 4 * sizeof(RK_U16)) + sizeof(RK_F32) * 9;
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            nRefs = ctx->nFrames - 1;
+            BenchReport("ComputeHomographyError", VARIANT_HOMOGRAPHY, geo, ctx, (double)NUM_HOMOGRAPHY * nRefs, ns, bytes, 0);
+        }
+        free(a.pMarks);
+        for (int k=0; k < 2; k++)
+        {
+            free(a.pPointYs[k]); free(a.pPointXs[k]);
+        }
+    }
+
+} // BenchRegister()
+
+
+/************************************************************************/
+// Func: BenchDenoiser()
+// Desc: MotionDetectFilter & TemporalDenoise_Modify of one geometry.
+//       Tiles are interior 32x64 blocks with identity motion, laid out as
+//       Enhancer_Modify() does: Extend = Useful - 2 rows / 4 cols
+/*************************************************************************/
+static void BenchDenoiser(const BenchGeometry* geo, BenchContext* ctx, int nFrameMin, int nFrameMax, const char* filter)
+{
+    ArgsDenoise a;
+    double      ns;
+    double      bytes;
+    int         nRow = 2 * RAW_BLK_SIZE;            // tile (#2, #4)
+    int         nCol = 4 * RAW_BLK_SIZE;
+    int         nHgtExt = RAW_BLK_SIZE + 2 * RAW_BLK_BORDER;
+    int         nWidExt = ALIGN_4PIXEL_WIDTH(RAW_BLK_SIZE * RAW_WIN_NUM + 2 * 4);
+    int         nBlkSize = nHgtExt * nWidExt;
+
+    memset(&a, 0, sizeof(a));
+    for (int k=0; k < RK_MAX_FILE_NUM; k++)
+    {
+        a.pBlocks[k] = (RK_U16*)BenchAlloc(sizeof(RK_U16) * nBlkSize);
+        a.pPoints[k] = (RK_F32*)BenchAlloc(sizeof(RK_F32) * 2 * RAW_WIN_NUM);
+        BenchFillImage(a.pBlocks[k], nWidExt, nHgtExt, nWidExt, 0x3FF, k);
+        for (int n=0; n < RAW_WIN_NUM; n++)
+        {
+            a.pPoints[k][n*2+0] = (RK_F32)nRow;
+            a.pPoints[k][n*2+1] = (RK_F32)(nCol + n * RAW_BLK_SIZE);
+        }
+        a.rects[k].rowExtend    = nRow - RAW_BLK_BORDER;
+        a.rects[k].colExtend    = ALIGN_4PIXEL_START(nCol - RAW_BLK_BORDER);
+        a.rects[k].hgtExtend    = nHgtExt;
+        a.rects[k].widExtend    = nWidExt;
+        a.rects[k].strideExtend = nWidExt * sizeof(RK_U16);
+        a.rects[k].rowValid     = a.rects[k].rowExtend;
+        a.rects[k].colValid     = a.rects[k].colExtend;
+        a.rects[k].hgtValid     = nHgtExt;
+        a.rects[k].widValid     = nWidExt;
+        a.rects[k].rowUseful    = nRow;
+        a.rects[k].colUseful    = nCol;
+        a.rects[k].hgtUseful    = RAW_BLK_SIZE;
+        a.rects[k].widUseful    = RAW_BLK_SIZE * RAW_WIN_NUM;
+    }
+    a.pTable = (RK_U16*)BenchAlloc(sizeof(RK_U16) * MOTION_DETECT_TALBE_LEN);
+    for (int i=0; i < MOTION_DETECT_TALBE_LEN; i++)
+    {
+        a.pTable[i] = (RK_U16)(64 + i / 4);     // monotonic like MotionDetectTable
+    }
+    a.pDst = (RK_U16*)BenchAlloc(sizeof(RK_U16) * nBlkSize);
+
+#ifndef CEVA_CHIP_CODE_DENOISER
+    //// MotionDetectFilter
+    if (BenchMatch("MotionDetectFilter", filter))
+    {
+        ns    = BenchTime(CallMotionDetectFilter, &a, ctx->nTimeMs);
+        bytes = sizeof(RK_U16) * (nBlkSize + RAW_BLK_SIZE * RAW_BLK_SIZE * RAW_WIN_NUM);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            // RawBase once + RawRef per RefFrame, per tile
+            BenchReport("MotionDetectFilter", "c", geo, ctx, (double)ctx->nTiles * ctx->nFrames, ns, bytes, 0);
+        }
+    }
+#endif
+
+    //// TemporalDenoise_Modify: cost grows with the frame count
+    if (BenchMatch("TemporalDenoise_Modify", filter))
+    {
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            a.nFrames = ctx->nFrames;
+            ns    = BenchTime(CallTemporalDenoise_Modify, &a, ctx->nTimeMs);
+            bytes = sizeof(RK_U16) * ((double)nBlkSize * ctx->nFrames + RAW_BLK_SIZE * RAW_BLK_SIZE * RAW_WIN_NUM);
+            BenchReport("TemporalDenoise_Modify", VARIANT_DENOISER, geo, ctx, ctx->nTiles, ns, bytes, 0);
+        }
+    }
+
+    for (int k=0; k < RK_MAX_FILE_NUM; k++)
+    {
+        free(a.pBlocks[k]); free(a.pPoints[k]);
+    }
+    free(a.pTable); free(a.pDst);
+
+} // BenchDenoiser()
+
+
+/************************************************************************/
+// Func: BenchBayerWdr()
+// Desc: wdrPreFilterBlock, CalcuHist, HistFilter & wdr_process_block of
+//       one geometry. Statistic tables are allocated for the whole grid, so
+//       geometries beyond 256 cells run memory-safe with stat_overflow=1
+/*************************************************************************/
+static void BenchBayerWdr(const BenchGeometry* geo, BenchContext* ctx, int nFrameMin, int nFrameMax, const char* filter)
+{
+    ArgsWdrStat s;
+    double      ns;
+    double      bytes;
+    int         nCells   = ctx->nStatWid * ctx->nStatHgt;
+    int         overflow = nCells > WDR_STAT_CELLS;
+    int         nTabLen  = (WDR_STAT_BINS - 1) * WDR_STAT_CELLS + MAX(nCells, WDR_STAT_CELLS);
+    int         nChunk   = (ctx->nThumbWid + 2) * (NUM_LINE_DDR2DSP_THUMB + 2);
+
+    s.nWid     = ctx->nThumbWid + 2;
+    s.nStatWid = ctx->nStatWid;
+    s.nStatHgt = ctx->nStatHgt;
+    s.pChunk   = (RK_U16*)BenchAlloc(sizeof(RK_U16) * nChunk);
+    s.pFilter  = (RK_U16*)BenchAlloc(sizeof(RK_U16) * nChunk);
+    s.pCount   = (RK_U16*)BenchAlloc(sizeof(RK_U16) * nTabLen);
+    s.pWeight  = (RK_U32*)BenchAlloc(sizeof(RK_U32) * nTabLen);
+    BenchFillImage(s.pChunk, s.nWid, NUM_LINE_DDR2DSP_THUMB+2, s.nWid, 0xFFFF, 0);
+    wdrPreFilterBlock(s.pChunk, s.pFilter, NUM_LINE_DDR2DSP_THUMB+2, s.nWid);
+
+    //// wdrPreFilterBlock
+    bytes = sizeof(RK_U16) * 2.0 * nChunk;
+    if (BenchMatch("wdrPreFilterBlock", filter))
+    {
+        ns = BenchTime(CallWdrPreFilterBlock, &s, ctx->nTimeMs);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            BenchReport("wdrPreFilterBlock", "c", geo, ctx, ctx->nSegRow, ns, bytes, 0);
+        }
+        ns = BenchTime(CallWdrPreFilterBlock_Vec, &s, ctx->nTimeMs);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            BenchReport("wdrPreFilterBlock", "vec", geo, ctx, ctx->nSegRow, ns, bytes, 0);
+        }
+    }
+
+    //// CalcuHist: every pixel updates one count & one weight bin
+    bytes = sizeof(RK_U16) * (double)nChunk + (sizeof(RK_U16) + sizeof(RK_U32)) * 2.0 * s.nWid * NUM_LINE_DDR2DSP_THUMB;
+    if (BenchMatch("CalcuHist", filter))
+    {
+        ns = BenchTime(CallCalcuHist, &s, ctx->nTimeMs);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            BenchReport("CalcuHist", "c", geo, ctx, ctx->nSegRow, ns, bytes, overflow);
+        }
+        if (ctx->nThumbWid <= CALCUHIST_VEC_MAX_WID)
+        {
+            ns = BenchTime(CallCalcuHist_Vec, &s, ctx->nTimeMs);
+            for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+            {
+                BenchReport("CalcuHist", "vec", geo, ctx, ctx->nSegRow, ns, bytes, overflow);
+            }
+        }
+        else
+        {
+            fprintf(stderr, "rk_kernel_bench: CalcuHist_Vec skipped at %dMP, ThumbWid %d > %d\n",
+                geo->nMegaPixel, ctx->nThumbWid, CALCUHIST_VEC_MAX_WID);
+        }
+    }
+
+    //// HistFilter: 9 planes, 3 passes
+    bytes = sizeof(RK_U16) * 2.0 * 3 * 9 * nCells;
+    if (BenchMatch("HistFilter", filter))
+    {
+        ns = BenchTime(CallHistFilter, &s, ctx->nTimeMs);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            BenchReport("HistFilter", "c", geo, ctx, 1, ns, bytes, overflow);
+        }
+    }
+    free(s.pChunk); free(s.pFilter); free(s.pCount); free(s.pWeight);
+
+    //// wdr_process_block
+    if (BenchMatch("wdr_process_block", filter))
+    {
+        ArgsWdrBlock b;
+        int nBufLen = (RAW_BLK_SIZE + 2) * (RAW_BLK_SIZE * RAW_WIN_NUM + 2);
+        int nOutLen = RAW_BLK_SIZE * RAW_BLK_SIZE * RAW_WIN_NUM;
+        b.nStatWid   = ctx->nStatWid;
+        b.pBuf       = (RK_U16*)BenchAlloc(sizeof(RK_U16) * nBufLen);
+        b.pWeight    = (RK_U16*)BenchAlloc(sizeof(RK_U16) * WDR_STAT_BINS * MAX(nCells, WDR_STAT_CELLS));
+        b.pScale     = (RK_U16*)BenchAlloc(sizeof(RK_U16) * 961);
+        b.pGain      = (RK_U16*)BenchAlloc(sizeof(RK_U16) * nOutLen);
+        b.pOut       = (RK_U16*)BenchAlloc(sizeof(RK_U16) * nOutLen);
+        b.pLeftRight = (RK_U16*)BenchAlloc(sizeof(RK_U16) * 32 * 16 * 2);
+        BenchFillImage(b.pBuf, RAW_BLK_SIZE * RAW_WIN_NUM + 2, RAW_BLK_SIZE + 2, RAW_BLK_SIZE * RAW_WIN_NUM + 2,
+            0x1FFF, 0); // TemporalDenoise output is WDR_GAIN x Raw
+        for (int i=0; i < WDR_STAT_BINS * MAX(nCells, WDR_STAT_CELLS); i++)
+        {
+            b.pWeight[i] = (RK_U16)(BenchRand() % 0x1000);
+        }
+        memcpy(b.pScale, cure_table[0], sizeof(RK_U16) * 961); // lutWdrTable(IspGain=1)
+        ns    = BenchTime(CallWdr_process_block, &b, ctx->nTimeMs);
+        bytes = sizeof(RK_U16) * ((double)nBufLen + 2 * nOutLen + 4 * 9);
+        for (ctx->nFrames = nFrameMin; ctx->nFrames <= nFrameMax; ctx->nFrames++)
+        {
+            BenchReport("wdr_process_block", VARIANT_WDR, geo, ctx, ctx->nTiles, ns, bytes, overflow);
+        }
+        free(b.pBuf); free(b.pWeight); free(b.pScale); free(b.pGain); free(b.pOut); free(b.pLeftRight);
+    }
+
+} // BenchBayerWdr()
+
+
+/************************************************************************/
+// Func: main()
+// Desc: rk_kernel_bench [-g 12|48|108] [-n frames] [-k kernel] [-t ms]
+/*************************************************************************/
+int main(int argc, char* argv[])
+{
+    int         nGeometry = 0;                  // 0-all
+    int         nFrameMin = 2;
+    int         nFrameMax = RK_MAX_FILE_NUM;
+    int         nTimeMs   = BENCH_TIME_MS;
+    const char* filter    = NULL;
+
+    for (int i=1; i < argc; i++)
+    {
+        if (i + 1 < argc && strcmp(argv[i], "-g") == 0)
+        {
+            nGeometry = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-n") == 0)
+        {
+            nFrameMin = nFrameMax = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-k") == 0)
+        {
+            filter = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-t") == 0)
+        {
+            nTimeMs = atoi(argv[++i]);
+            nTimeMs = MAX(nTimeMs, 1);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-g 12|48|108] [-n frames] [-k kernel] [-t ms]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (nFrameMin < 2 || nFrameMax > RK_MAX_FILE_NUM)
+    {
+        fprintf(stderr, "rk_kernel_bench: frames must be 2..%d\n", RK_MAX_FILE_NUM);
+        return 1;
+    }
+
+    for (int g=0; g < BENCH_NUM_GEOMETRY; g++)
+    {
+        const BenchGeometry* geo = &g_BenchGeometry[g];
+        BenchContext         ctx;
+        if (nGeometry != 0 && nGeometry != geo->nMegaPixel)
+        {
+            continue;
+        }
+
+        // same derivation as MFNR_Init() & Register()
+        ctx.nRawWid       = geo->nRawWid;
+        ctx.nRawHgt       = geo->nRawHgt;
+        ctx.nThumbWid     = geo->nRawWid / SCALER_FACTOR_R2T;
+        ctx.nThumbHgt     = geo->nRawHgt / SCALER_FACTOR_R2T;
+        ctx.nThumbStride  = ALIGN_4BYTE_WIDTH(ctx.nThumbWid, THUMB_BIT_COUNT);
+        ctx.nSegCol       = ctx.nThumbWid / DIV_FIXED_WIN_SIZE;
+        ctx.nSegRow       = ctx.nThumbHgt / DIV_FIXED_WIN_SIZE;
+        ctx.nValidFeature = MIN(ctx.nSegCol * ctx.nSegRow / 2, MAX_NUM_MATCH_FEATURE);
+        ctx.nTiles        = ((ctx.nRawHgt + RAW_BLK_SIZE - 1) / RAW_BLK_SIZE)
+                          * ((ctx.nRawWid + RAW_BLK_SIZE * RAW_WIN_NUM - 1) / (RAW_BLK_SIZE * RAW_WIN_NUM));
+        ctx.nStatWid      = ((ctx.nRawWid + 128) >> 8) + 1;
+        ctx.nStatHgt      = ((ctx.nRawHgt + 128) >> 8) + 1;
+        ctx.nTimeMs       = nTimeMs;
+
+        BenchRegister(geo, &ctx, nFrameMin, nFrameMax, filter);
+        BenchDenoiser(geo, &ctx, nFrameMin, nFrameMax, filter);
+        BenchBayerWdr(geo, &ctx, nFrameMin, nFrameMax, filter);
+    }
+
+    return 0;
+
+} // main()
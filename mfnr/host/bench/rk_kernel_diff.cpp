@@ -0,0 +1,1457 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: rk_kernel_diff.cpp
+// Desc: Differential bit-exactness check of the kernel implementations
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// Each kernel has up to three host implementations:
+//   c      the #ifndef CEVA_CHIP_CODE_* C model      (-DMFNR_C_MODEL=1)
+//   vec    the vector path on the scalar vec-c layer (no -mavx2)
+//   avx2   the vector path on the AVX2 vec-c layer   (-mavx2)
+// Only one of them is compiled into a binary, so the check runs in two
+// steps: every build dumps the outputs of the same seeded cases, then any
+// two dumps are compared. A dump of an older commit compares the same way,
+// which is how an optimization is checked against the tree it started from.
+// wdrPreFilterBlock/_Vec and CalcuHist/_Vec are both in every binary and
+// are compared on the spot as well, and so is ThumbStripScan against the
+// FeatureDetect & GetWdrWeightTable pair it fuses, every
+// FeatureCoarse/FineMatching case against Feature*MatchingFast, and every
+// FeaturePyramidMatching case against an exhaustive raster-order search.
+//
+// Cases are randomized tiles on the buffer shapes MFNR_Process hands each
+// kernel (smooth, uniform noise, flat with spikes, saturated edges), plus
+// whole synthetic bursts through RK_MFNR_Processor. A case depends only on
+// -seed, the kernel and the case number, so -k and -n select a subset of
+// the same cases in every build.
+//
+// Build (vector, add -DMFNR_C_MODEL=1 for the C models, drop -mavx2 for
+// the scalar vec-c layer; 6-frame bursts need more than the default 128KB
+// of g_DspBuf, as in rk_burst_synth):
+//   g++ -O2 -mavx2 -DDSP_MEM_SIZE=262144 -Imfnr/host -Imfnr mfnr/host/bench/rk_kernel_diff.cpp
+//       mfnr/rk_mfnr.cpp mfnr/rk_register.cpp mfnr/rk_denoiser.cpp
+//       mfnr/rk_bayerwdr.cpp mfnr/host/dma/dma.cpp -lpthread
+//
+// Usage: rk_kernel_diff -dump file [-seed n] [-n cases] [-b bursts] [-k kernel]
+//        rk_kernel_diff -cmp file_a file_b [-k kernel]
+//   -dump  run the cases and write every output to file
+//   -seed  case seed (default 1)
+//   -n     cases per kernel (default 64)
+//   -b     synthetic 6-frame bursts through RK_MFNR_Processor (default 2)
+//   -k     kernels whose name starts with this string
+//   -cmp   compare two dumps of the same -seed/-n/-b
+//
+// Output: one JSON object per line and kernel
+//   kernel, a, b        kernel name, variant of each side
+//   cases, mismatch     compared cases, cases with any differing element
+//   elems, diff_elems   compared elements, differing elements
+//   max_abs             largest |a - b|
+//   first               first differing element: case, x, y (element in
+//                       the output row), a & b values
+// Exit code: 0 bit-exact, 1 mismatch, 2 usage or file error.
+//
+// The vector FeatureDetect and TemporalDenoise_Modify are not bit-exact
+// ports of their C models (TemporalDenoise_Modify divides by a reciprocal
+// table and compares with <=), so c/vec mismatches there, and in the burst
+// output, are expected; the report shows how far apart they are. vec vs
+// avx2, and old vs new commit of one variant, must be bit-exact.
+//
+#include <math.h>
+
+#include "rk_mfnr.h"                    // MFNR
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Macro Definition
+//
+#ifdef CEVA_CHIP_CODE_REGISTER
+#define     VARIANT_REGISTER        DIFF_VARIANT_VEC    // FeatureDetect, Coarse/FineMatching, Scaler
+#else
+#define     VARIANT_REGISTER        "c"
+#endif
+#if !defined(CEVA_CHIP_CODE_REGISTER) || defined(VEC_C_HOST)
+#define     VARIANT_HOMOGRAPHY      "c"                 // ComputePerspectMatrix, ComputeHomographyError
+#else
+#define     VARIANT_HOMOGRAPHY      DIFF_VARIANT_VEC
+#endif
+#ifdef CEVA_CHIP_CODE_DENOISER
+#define     VARIANT_DENOISER        DIFF_VARIANT_VEC    // TemporalDenoise_Modify
+#else
+#define     VARIANT_DENOISER        "c"
+#endif
+#if WDR_VECC
+#define     VARIANT_WDR             DIFF_VARIANT_VEC    // wdr_process_block
+#else
+#define     VARIANT_WDR             "c"
+#endif
+#if VEC_C_HOST_AVX2
+#define     DIFF_VARIANT_VEC        "avx2"
+#else
+#define     DIFF_VARIANT_VEC        "vec"
+#endif
+#if defined(CEVA_CHIP_CODE_REGISTER) || defined(CEVA_CHIP_CODE_DENOISER)
+#define     VARIANT_PROCESS         DIFF_VARIANT_VEC    // MFNR_Process
+#else
+#define     VARIANT_PROCESS         "c"
+#endif
+
+#define     DIFF_MAGIC              "RKKDIFF1"      // dump file tag
+#define     DIFF_NAME_LEN           32              // kernel name in a record
+#define     DIFF_VARIANT_LEN        8               // variant name in a record
+#define     DIFF_MAX_KERNELS        32              // record names of one dump
+#define     DIFF_CASES              64              // default cases per kernel
+#define     DIFF_BURSTS             2               // default bursts
+#define     DIFF_BUF_TAIL           16384           // vector kernels load past the chunk end, as in g_DspBuf
+#define     DIFF_FILL_MODES         4               // smooth, noise, spikes, saturated
+#define     DIFF_BURST_WID          1600            // synthetic burst size
+#define     DIFF_BURST_HGT          1200
+#define     DIFF_BURST_FRAMES       6               // vector TemporalDenoise_Modify: 6 frames only
+#define     DIFF_BURST_SHIFT        12              // max translation per frame (Raw, even)
+#define     DIFF_BLACK_LEVEL        64              // nBlackLevel of every channel
+#define     DIFF_TILE_SHIFT         6               // max Luma motion of a TemporalDenoise_Modify tile
+#define     DIFF_THUMB_MAX          (64 * 1023)     // thumb = sum of an 8x8 raw block
+#define     DIFF_LUMA_MAX           (4 * 1023)      // luma  = sum of a 2x2 raw block
+#define     DIFF_FILTER_MAX         0x3FFF          // wdrPreFilterBlock output: 16*DIFF_THUMB_MAX >> 6
+#define     WDR_STAT_CELLS          256             // cells of one bin plane in the WDR statistic tables
+#define     WDR_STAT_BINS           16              // bin planes allocated (9 used)
+#define     WDR_STAT_USED           9               // bin planes used
+#define     CALCUHIST_VEC_MAX_WID   527             // idx_pre[17] of CalcuHist_Vec
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Type Defines
+//
+////---- enum DiffType: element type of a record
+enum DiffType
+{
+    DIFF_TYPE_U8 = 0,
+    DIFF_TYPE_U16,
+    DIFF_TYPE_U32,
+    DIFF_TYPE_F32,
+
+    DIFF_TYPE_NUM
+};
+
+////---- struct DiffRecord: one output of one case, nWid*nHgt elements follow
+typedef struct tag_DiffRecord
+{
+    char            sKernel[DIFF_NAME_LEN];     // kernel name (+ "." output name)
+    char            sVariant[DIFF_VARIANT_LEN]; // "c", "vec", "avx2"
+    RK_S32          nCase;                      // case number
+    RK_S32          nType;                      // DiffType
+    RK_S32          nWid;                       // elements per row
+    RK_S32          nHgt;                       // rows
+}DiffRecord;
+
+////---- struct DiffFileHeader
+typedef struct tag_DiffFileHeader
+{
+    char            sMagic[8];                  // DIFF_MAGIC
+    RK_U32          nSeed;                      // -seed
+    RK_S32          nCases;                     // -n
+    RK_S32          nBursts;                    // -b
+}DiffFileHeader;
+
+////---- struct DiffStats: comparison of one kernel
+typedef struct tag_DiffStats
+{
+    char            sKernel[DIFF_NAME_LEN];
+    char            sVariantA[DIFF_VARIANT_LEN];
+    char            sVariantB[DIFF_VARIANT_LEN];
+    int             nCases;
+    int             nMismatch;
+    double          nElems;
+    double          nDiffElems;
+    double          fMaxAbs;
+    int             nFirstCase;                 // -1: bit-exact
+    int             nFirstX;
+    int             nFirstY;
+    double          fFirstA;
+    double          fFirstB;
+    int             nType;
+}DiffStats;
+
+////---- struct DiffContext
+typedef struct tag_DiffContext
+{
+    FILE*           fp;                         // dump file
+    RK_U32          nSeed;
+    int             nCases;
+    int             nBursts;
+    const char*     filter;                     // -k
+    int             nRecords;                   // written records
+    int             nPairFail;                  // in-binary pairs with a mismatch
+    DiffStats*      pMatchFast;                 // Feature*MatchingFast vs the exhaustive search, NULL-not run
+}DiffContext;
+
+////---- kernel case
+typedef void (*DiffFunc)(DiffContext* ctx, int nCase);
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Global Variables
+//
+static RK_U32 g_DiffSeed = 1;                   // LCG state of the current case
+
+extern unsigned short cure_table[24][961];      // rk_bayerwdr.cpp: WDR scale tables
+extern RK_U16 MotionDetectTable[MOTION_DETECT_TALBE_LEN]; // rk_mfnr.cpp
+
+static const int g_DiffTypeSize[DIFF_TYPE_NUM] = { 1, 2, 4, 4 };
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Functions Definition
+//
+/************************************************************************/
+// Func: DiffRand()
+// Desc: LCG of the current case
+/*************************************************************************/
+static RK_U32 DiffRand(void)
+{
+    g_DiffSeed = g_DiffSeed * 1664525 + 1013904223;
+    return g_DiffSeed >> 8;
+} // DiffRand()
+
+
+/************************************************************************/
+// Func: DiffHash()
+// Desc: integer hash, pixel noise that does not depend on the fill order
+/*************************************************************************/
+static RK_U32 DiffHash(RK_U32 a, RK_U32 b, RK_U32 c)
+{
+    RK_U32 h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u) * 0x85EBCA77u ^ (c + 0x165667B1u) * 0xC2B2AE3Du;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return h;
+} // DiffHash()
+
+
+/************************************************************************/
+// Func: DiffSeedCase()
+// Desc: seed of (kernel, case): -k and -n do not shift the other cases
+/*************************************************************************/
+static void DiffSeedCase(const DiffContext* ctx, const char* kernel, int nCase)
+{
+    RK_U32 h = ctx->nSeed;
+    for (const char* p = kernel; *p; p++)
+    {
+        h = h * 31 + (RK_U8)*p;
+    }
+    g_DiffSeed = DiffHash(h, (RK_U32)nCase, 0x5EED);
+} // DiffSeedCase()
+
+
+/************************************************************************/
+// Func: DiffAlloc()
+// Desc: zeroed buffer with DIFF_BUF_TAIL slack, exits on failure
+/*************************************************************************/
+static void* DiffAlloc(size_t nSize)
+{
+    void* p = calloc(1, nSize + DIFF_BUF_TAIL);
+    if (p == NULL)
+    {
+        fprintf(stderr, "rk_kernel_diff: out of memory (%lu Byte)\n", (unsigned long)nSize);
+        exit(2);
+    }
+    return p;
+} // DiffAlloc()
+
+
+/************************************************************************/
+// Func: DiffSample()
+// Desc: pixel (r,c) of frame k in fill mode nMode, 0..nMax
+//       0 - smooth gradient + small noise
+//       1 - uniform noise over the full range
+//       2 - flat with sparse 0 / nMax spikes
+//       3 - bands saturated at 0 and nMax with steep edges
+/*************************************************************************/
+static int DiffSample(int nMode, RK_U32 nSalt, int r, int c, int k, int nMax)
+{
+    RK_U32  h = DiffHash(nSalt + (RK_U32)k, (RK_U32)r, (RK_U32)c);
+    int     v;
+    switch (nMode)
+    {
+    case 0:
+        v = (int)(((RK_U32)(r * 7 + c * 5) + nSalt) % (RK_U32)(nMax / 2)) + (int)(h % 32);
+        break;
+    case 1:
+        v = (int)(h % (RK_U32)(nMax + 1));
+        break;
+    case 2:
+        v = (h % 61 == 0) ? nMax : (h % 67 == 0) ? 0 : nMax / 3 + (int)(h % 8);
+        break;
+    default:
+        v = ((((RK_U32)(r + c / 3) + nSalt) / 5) % 3 == 0) ? nMax : ((((RK_U32)(r / 2 + c) + nSalt) / 7) % 2) ? 0 : (int)(h % (RK_U32)(nMax + 1));
+        break;
+    }
+    return MIN(v, nMax);
+} // DiffSample()
+
+
+/************************************************************************/
+// Func: DiffFillImage()
+// Desc: nWid x nHgt of frame k at (nRow, nCol), stride in pixels
+/*************************************************************************/
+static void DiffFillImage(RK_U16* pDst, int nWid, int nHgt, int nStride, int nRow, int nCol,
+    int nMode, RK_U32 nSalt, int k, int nMax)
+{
+    for (int r=0; r < nHgt; r++)
+    {
+        for (int c=0; c < nWid; c++)
+        {
+            pDst[r * nStride + c] = (RK_U16)DiffSample(nMode, nSalt, nRow + r, nCol + c, k, nMax);
+        }
+    }
+} // DiffFillImage()
+
+
+/************************************************************************/
+// Func: DiffMatch()
+// Desc: kernel filter of -k
+/*************************************************************************/
+static int DiffMatch(const char* kernel, const char* filter)
+{
+    return filter == NULL || strncmp(kernel, filter, strlen(filter)) == 0;
+} // DiffMatch()
+
+
+/************************************************************************/
+// Func: DiffEmit()
+// Desc: one record: nWid x nHgt elements of pData, rows nStride elements
+//       apart
+/*************************************************************************/
+static void DiffEmit(DiffContext* ctx, const char* kernel, const char* variant, int nCase,
+    int nType, const void* pData, int nWid, int nHgt, int nStride)
+{
+    DiffRecord  rec;
+    int         nSize = g_DiffTypeSize[nType];
+
+    memset(&rec, 0, sizeof(rec));
+    strncpy(rec.sKernel, kernel, DIFF_NAME_LEN - 1);
+    strncpy(rec.sVariant, variant, DIFF_VARIANT_LEN - 1);
+    rec.nCase = nCase;
+    rec.nType = nType;
+    rec.nWid  = nWid;
+    rec.nHgt  = nHgt;
+    fwrite(&rec, sizeof(rec), 1, ctx->fp);
+    for (int r=0; r < nHgt; r++)
+    {
+        fwrite((const RK_U8*)pData + (size_t)r * nStride * nSize, nSize, nWid, ctx->fp);
+    }
+    ctx->nRecords++;
+} // DiffEmit()
+
+
+/************************************************************************/
+// Func: DiffValue()
+// Desc: element i of a record as double
+/*************************************************************************/
+static double DiffValue(const void* pData, int nType, int i)
+{
+    switch (nType)
+    {
+    case DIFF_TYPE_U8:  return ((const RK_U8*)pData)[i];
+    case DIFF_TYPE_U16: return ((const RK_U16*)pData)[i];
+    case DIFF_TYPE_U32: return ((const RK_U32*)pData)[i];
+    default:            return ((const RK_F32*)pData)[i];
+    }
+} // DiffValue()
+
+
+/************************************************************************/
+// Func: DiffStatsInit() / DiffStatsAdd() / DiffStatsReport()
+// Desc: per-kernel comparison: bit equality per element, first mismatch
+//       in case order, one JSON line
+/*************************************************************************/
+static void DiffStatsInit(DiffStats* pStats, const char* kernel, const char* variantA, const char* variantB)
+{
+    memset(pStats, 0, sizeof(DiffStats));
+    strncpy(pStats->sKernel, kernel, DIFF_NAME_LEN - 1);
+    strncpy(pStats->sVariantA, variantA, DIFF_VARIANT_LEN - 1);
+    strncpy(pStats->sVariantB, variantB, DIFF_VARIANT_LEN - 1);
+    pStats->nFirstCase = -1;
+} // DiffStatsInit()
+
+static void DiffStatsAdd(DiffStats* pStats, int nCase, int nType, const void* pA, const void* pB,
+    int nWid, int nHgt, int nStride)
+{
+    int nSize     = g_DiffTypeSize[nType];
+    int nDiffCase = 0;
+
+    pStats->nCases++;
+    pStats->nElems += (double)nWid * nHgt;
+    pStats->nType   = nType;
+    for (int i=0; i < nWid * nHgt; i++)
+    {
+        int e = (i / nWid) * nStride + i % nWid;
+        if (memcmp((const RK_U8*)pA + (size_t)e * nSize, (const RK_U8*)pB + (size_t)e * nSize, nSize) == 0)
+        {
+            continue;
+        }
+        double a = DiffValue(pA, nType, e);
+        double b = DiffValue(pB, nType, e);
+        nDiffCase = 1;
+        pStats->nDiffElems++;
+        pStats->fMaxAbs = MAX(pStats->fMaxAbs, FABS(a - b));
+        if (pStats->nFirstCase < 0)
+        {
+            pStats->nFirstCase = nCase;
+            pStats->nFirstX    = i % nWid;
+            pStats->nFirstY    = i / nWid;
+            pStats->fFirstA    = a;
+            pStats->fFirstB    = b;
+        }
+    }
+    pStats->nMismatch += nDiffCase;
+} // DiffStatsAdd()
+
+static void DiffStatsReport(const DiffStats* pStats)
+{
+    const char* fmt = (pStats->nType == DIFF_TYPE_F32) ? "%.9g" : "%.0f";
+    printf("{\"kernel\":\"%s\",\"a\":\"%s\",\"b\":\"%s\",\"cases\":%d,\"mismatch\":%d,"
+        "\"elems\":%.0f,\"diff_elems\":%.0f,\"max_abs\":",
+        pStats->sKernel, pStats->sVariantA, pStats->sVariantB, pStats->nCases, pStats->nMismatch,
+        pStats->nElems, pStats->nDiffElems);
+    printf(fmt, pStats->fMaxAbs);
+    if (pStats->nFirstCase >= 0)
+    {
+        printf(",\"first\":{\"case\":%d,\"x\":%d,\"y\":%d,\"a\":", pStats->nFirstCase, pStats->nFirstX, pStats->nFirstY);
+        printf(fmt, pStats->fFirstA);
+        printf(",\"b\":");
+        printf(fmt, pStats->fFirstB);
+        printf("}");
+    }
+    printf("}\n");
+    fflush(stdout);
+} // DiffStatsReport()
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Kernel Cases
+//
+/************************************************************************/
+// Func: CaseFeatureDetect()
+// Desc: ThumbChunk (ThumbWid+2)x(32+2) as Register(): even ThumbWid
+//       64..526, rowSeg 0..7. Out: points & values of the segment row
+/*************************************************************************/
+static void CaseFeatureDetect(DiffContext* ctx, int nCase)
+{
+    int     nThumbWid  = 64 + 2 * (int)(DiffRand() % 232);
+    int     nWid       = nThumbWid + 2;
+    int     nHgt       = NUM_LINE_DDR2DSP_THUMB + 2;
+    int     rowSeg     = (int)(DiffRand() % 8);
+    int     numFeature = nThumbWid / DIV_FIXED_WIN_SIZE;
+    int     nLen       = (rowSeg + 1) * numFeature;
+    RK_U16* pChunk     = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nWid * nHgt);
+    RK_U16* pOut       = (RK_U16*)DiffAlloc(sizeof(RK_U16) * 3 * nLen);
+    RK_U16* pFeatPoints[2] = { pOut, pOut + nLen };
+
+    DiffFillImage(pChunk, nWid, nHgt, nWid, rowSeg * NUM_LINE_DDR2DSP_THUMB, 0,
+        nCase % DIFF_FILL_MODES, DiffRand(), 0, DIFF_THUMB_MAX);
+    FeatureDetect(pChunk, nWid, nHgt, ALIGN_4BYTE_WIDTH(nThumbWid, THUMB_BIT_COUNT) + 4, rowSeg, numFeature,
+        pFeatPoints, pOut + 2 * nLen);
+    // rows: Y, X, value of the segments of rowSeg
+    DiffEmit(ctx, "FeatureDetect", VARIANT_REGISTER, nCase, DIFF_TYPE_U16,
+        pOut + rowSeg * numFeature, numFeature, 3, nLen);
+    free(pChunk); free(pOut);
+} // CaseFeatureDetect()
+
+
+/************************************************************************/
+// Func: CaseThumbRaw10Box()
+// Desc: 8 packed RAW10 rows of ThumbWid 1..THUMB_BUILD_COLS Thumb cols at
+//       a chunk stride, as ThumbBuild(). Out: Thumb row
+/*************************************************************************/
+static void CaseThumbRaw10Box(DiffContext* ctx, int nCase)
+{
+    int     nThumbWid = 1 + (int)(DiffRand() % THUMB_BUILD_COLS);
+    int     nWid      = nThumbWid * SCALER_FACTOR_R2T;
+    int     nStride   = THUMB_BUILD_COLS * SCALER_FACTOR_R2T * 5/4;
+    RK_U16* pRaw      = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nWid * SCALER_FACTOR_R2T);
+    RK_U8*  pPacked   = (RK_U8*)DiffAlloc(nStride * SCALER_FACTOR_R2T);
+    RK_U16* pThumb    = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nThumbWid);
+
+    DiffFillImage(pRaw, nWid, SCALER_FACTOR_R2T, nWid, 0, 0, nCase % DIFF_FILL_MODES, DiffRand(), 0, 0x3FF);
+    for (int r=0; r < SCALER_FACTOR_R2T; r++)
+    {
+        rdma_pack_raw10(pRaw + r * nWid, pPacked + r * nStride, 0, nWid, 0);
+    }
+    ThumbRaw10Box(pPacked, nStride, nThumbWid, pThumb);
+    DiffEmit(ctx, "ThumbRaw10Box", VARIANT_REGISTER, nCase, DIFF_TYPE_U16, pThumb, nThumbWid, 1, nThumbWid);
+    free(pRaw); free(pPacked); free(pThumb);
+} // CaseThumbRaw10Box()
+
+
+/************************************************************************/
+// Func: CaseFeatureCoarseMatching()
+// Desc: 16x16 ThumbBase in the (16+2r)x(16+2r) ThumbRef, cut at a random
+//       offset, odd modes add noise. Out: row, col, cost
+/*************************************************************************/
+static void CaseFeatureCoarseMatching(DiffContext* ctx, int nCase)
+{
+    int     nRefSize = COARSE_MATCH_WIN_SIZE + 2 * COARSE_MATCH_RADIUS;
+    int     nOffY    = (int)(DiffRand() % (2 * COARSE_MATCH_RADIUS + 1));
+    int     nOffX    = (int)(DiffRand() % (2 * COARSE_MATCH_RADIUS + 1));
+    int     nNoise   = (nCase & 1) ? (int)(DiffRand() % 4096) : 0;
+    RK_U16* pBase    = (RK_U16*)DiffAlloc(sizeof(RK_U16) * COARSE_MATCH_WIN_SIZE * COARSE_MATCH_WIN_SIZE);
+    RK_U16* pRef     = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nRefSize * nRefSize);
+    RK_U16  out[3];
+
+    DiffFillImage(pRef, nRefSize, nRefSize, nRefSize, 0, 0, (nCase / 2) % DIFF_FILL_MODES, DiffRand(), 0, DIFF_THUMB_MAX);
+    for (int r=0; r < COARSE_MATCH_WIN_SIZE; r++)
+    {
+        for (int c=0; c < COARSE_MATCH_WIN_SIZE; c++)
+        {
+            int v = pRef[(r + nOffY) * nRefSize + c + nOffX] + (nNoise ? (int)(DiffRand() % nNoise) - nNoise / 2 : 0);
+            pBase[r * COARSE_MATCH_WIN_SIZE + c] = (RK_U16)MIN(MAX(v, 0), DIFF_THUMB_MAX);
+        }
+    }
+    FeatureCoarseMatching(pBase, COARSE_MATCH_WIN_SIZE, COARSE_MATCH_WIN_SIZE,
+        pRef, nRefSize, nRefSize, nRefSize, out[0], out[1], out[2]);
+    DiffEmit(ctx, "FeatureCoarseMatching", VARIANT_REGISTER, nCase, DIFF_TYPE_U16, out, 3, 1, 3);
+    if (ctx->pMatchFast != NULL)
+    {
+        RK_U16 fast[3];
+        FeatureCoarseMatchingFast(pBase, COARSE_MATCH_WIN_SIZE, COARSE_MATCH_WIN_SIZE,
+            pRef, nRefSize, nRefSize, nRefSize, fast[0], fast[1], fast[2]);
+        DiffStatsAdd(ctx->pMatchFast, nCase, DIFF_TYPE_U16, out, fast, 3, 1, 3);
+    }
+    free(pBase); free(pRef);
+} // CaseFeatureCoarseMatching()
+
+
+/************************************************************************/
+// Func: CaseScaler_Raw2Luma()
+// Desc: RawBase 64x64 or RawRef (64+2r) block with 4-pixel aligned width,
+//       as Register(). Out: Luma
+/*************************************************************************/
+static void CaseScaler_Raw2Luma(DiffContext* ctx, int nCase)
+{
+    int     nRefRaw = FINE_MATCH_WIN_SIZE + 2 * FINE_LUMA_RADIUS * 2;
+    int     isRef   = (int)(DiffRand() & 1);
+    int     nWid    = isRef ? ALIGN_4PIXEL_WIDTH(2 * (int)(DiffRand() & 1) + nRefRaw) : FINE_MATCH_WIN_SIZE;
+    int     nHgt    = isRef ? nRefRaw : FINE_MATCH_WIN_SIZE;
+    RK_U16* pRaw    = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nWid * nHgt);
+    RK_U16* pLuma   = (RK_U16*)DiffAlloc(sizeof(RK_U16) * (nWid/2) * (nHgt/2));
+
+    DiffFillImage(pRaw, nWid, nHgt, nWid, 0, 0, nCase % DIFF_FILL_MODES, DiffRand(), 0, 0x3FF);
+    Scaler_Raw2Luma(pRaw, nWid, nHgt, nWid/2, nHgt/2, pLuma);
+    DiffEmit(ctx, "Scaler_Raw2Luma", VARIANT_REGISTER, nCase, DIFF_TYPE_U16, pLuma, nWid/2, nHgt/2, nWid/2);
+    free(pRaw); free(pLuma);
+} // CaseScaler_Raw2Luma()
+
+
+/************************************************************************/
+// Func: CaseFeatureFineMatching()
+// Desc: 32x32 LumaBase in the LumaRef of a (64+2r) RawRef block, nStartCol
+//       0 or 2 Raw as Register(), odd modes add noise. Out: row, col, cost
+/*************************************************************************/
+static void CaseFeatureFineMatching(DiffContext* ctx, int nCase)
+{
+    int     nBase     = FINE_MATCH_WIN_SIZE / 2;
+    int     nRefRaw   = FINE_MATCH_WIN_SIZE + 2 * FINE_LUMA_RADIUS * 2;
+    int     nStartCol = 2 * (int)(DiffRand() & 1);
+    int     nRefHgt   = nRefRaw / 2;
+    int     nRefWid   = nRefRaw / 2;
+    int     nRefWid4p = ALIGN_4PIXEL_WIDTH(nStartCol + nRefRaw) / 2;
+    int     nColSt    = nStartCol / 2;
+    int     nOffY     = (int)(DiffRand() % (nRefHgt - nBase + 1));
+    int     nOffX     = nColSt + (int)(DiffRand() % (nRefWid - nBase + 1));
+    int     nNoise    = (nCase & 1) ? (int)(DiffRand() % 256) : 0;
+    RK_U16* pBase     = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nBase * nBase);
+    RK_U16* pRef      = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nRefWid4p * nRefHgt);
+    RK_U16  out[3];
+
+    DiffFillImage(pRef, nRefWid4p, nRefHgt, nRefWid4p, 0, 0, (nCase / 2) % DIFF_FILL_MODES, DiffRand(), 0, DIFF_LUMA_MAX);
+    for (int r=0; r < nBase; r++)
+    {
+        for (int c=0; c < nBase; c++)
+        {
+            int v = pRef[(r + nOffY) * nRefWid4p + c + nOffX] + (nNoise ? (int)(DiffRand() % nNoise) - nNoise / 2 : 0);
+            pBase[r * nBase + c] = (RK_U16)MIN(MAX(v, 0), DIFF_LUMA_MAX);
+        }
+    }
+    FeatureFineMatching(pBase, nBase, nBase, pRef, nRefHgt, nRefWid4p, nColSt, nRefWid, out[0], out[1], out[2]);
+    DiffEmit(ctx, "FeatureFineMatching", VARIANT_REGISTER, nCase, DIFF_TYPE_U16, out, 3, 1, 3);
+    if (ctx->pMatchFast != NULL)
+    {
+        RK_U16 fast[3];
+        FeatureFineMatchingFast(pBase, nBase, nBase, pRef, nRefHgt, nRefWid4p, nColSt, nRefWid, fast[0], fast[1], fast[2]);
+        DiffStatsAdd(ctx->pMatchFast, nCase, DIFF_TYPE_U16, out, fast, 3, 1, 3);
+    }
+    free(pBase); free(pRef);
+} // CaseFeatureFineMatching()
+
+
+/************************************************************************/
+// Func: CaseThumbPyramidBox()
+// Desc: 4 Thumb rows of PyrWid 1..128 top cols at a wider Thumb stride,
+//       as PyramidBuild(). Out: top row
+/*************************************************************************/
+static void CaseThumbPyramidBox(DiffContext* ctx, int nCase)
+{
+    int     nPyrWid = 1 + (int)(DiffRand() % 128);
+    int     nStride = nPyrWid * SCALER_FACTOR_T2P + (int)(DiffRand() % SCALER_FACTOR_T2P);
+    RK_U16* pThumb  = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nStride * SCALER_FACTOR_T2P);
+    RK_U16* pPyr    = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nPyrWid);
+
+    DiffFillImage(pThumb, nStride, SCALER_FACTOR_T2P, nStride, 0, 0, nCase % DIFF_FILL_MODES, DiffRand(), 0, DIFF_THUMB_MAX);
+    ThumbPyramidBox(pThumb, nStride, nPyrWid, pPyr);
+    DiffEmit(ctx, "ThumbPyramidBox", VARIANT_REGISTER, nCase, DIFF_TYPE_U16, pPyr, nPyrWid, 1, nPyrWid);
+    free(pThumb); free(pPyr);
+} // CaseThumbPyramidBox()
+
+
+/************************************************************************/
+// Func: CaseFeaturePyramidMatching()
+// Desc: 16x16 Base in a Ref window of 16..16+2*PYR_MATCH_RADIUS rows &
+//       cols, cut at the frame edge as CoarsePyramid(), random predicted
+//       position, odd modes add noise. Out: row, col, cost; the
+//       exhaustive raster-order search is the in-binary reference
+/*************************************************************************/
+static void CaseFeaturePyramidMatching(DiffContext* ctx, int nCase)
+{
+    int     nWin     = PYR_MATCH_WIN_SIZE;
+    int     nRefHgt  = nWin + (int)(DiffRand() % (2 * PYR_MATCH_RADIUS + 1));
+    int     nRefWid  = nWin + (int)(DiffRand() % (2 * PYR_MATCH_RADIUS + 1));
+    int     nOffY    = (int)(DiffRand() % (nRefHgt - nWin + 1));
+    int     nOffX    = (int)(DiffRand() % (nRefWid - nWin + 1));
+    int     nRow0    = (int)(DiffRand() % (nRefHgt - nWin + 1));
+    int     nCol0    = (int)(DiffRand() % (nRefWid - nWin + 1));
+    int     nNoise   = (nCase & 1) ? (int)(DiffRand() % 4096) : 0;
+    RK_U16* pBase    = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nWin * nWin);
+    RK_U16* pRef     = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nRefHgt * nRefWid);
+    RK_U16  out[3];
+
+    DiffFillImage(pRef, nRefWid, nRefHgt, nRefWid, 0, 0, (nCase / 2) % DIFF_FILL_MODES, DiffRand(), 0, DIFF_THUMB_MAX);
+    for (int r=0; r < nWin; r++)
+    {
+        for (int c=0; c < nWin; c++)
+        {
+            int v = pRef[(r + nOffY) * nRefWid + c + nOffX] + (nNoise ? (int)(DiffRand() % nNoise) - nNoise / 2 : 0);
+            pBase[r * nWin + c] = (RK_U16)MIN(MAX(v, 0), DIFF_THUMB_MAX);
+        }
+    }
+    FeaturePyramidMatching(pBase, nWin, nWin, pRef, nRefHgt, nRefWid, nRefWid, nRow0, nCol0, out[0], out[1], out[2]);
+    DiffEmit(ctx, "FeaturePyramidMatching", VARIANT_REGISTER, nCase, DIFF_TYPE_U16, out, 3, 1, 3);
+    if (ctx->pMatchFast != NULL)
+    {
+        RK_U16  full[3];
+        RK_U32  minSAD = 0xFFFFFFFF;
+        RK_U32  sad;
+        for (int i=0; i <= nRefHgt - nWin; i++)
+        {
+            for (int j=0; j <= nRefWid - nWin; j++)
+            {
+                sad = 0;
+                for (int r=0; r < nWin; r++)
+                {
+                    for (int c=0; c < nWin; c++)
+                    {
+                        sad += ABS_U16(pBase[r * nWin + c] - pRef[(i + r) * nRefWid + j + c]);
+                    }
+                }
+                if (sad < minSAD)
+                {
+                    minSAD  = sad;
+                    full[0] = (RK_U16)i;
+                    full[1] = (RK_U16)j;
+                    full[2] = (RK_U16)(sad & 0xFFFF);
+                }
+            }
+        }
+        DiffStatsAdd(ctx->pMatchFast, nCase, DIFF_TYPE_U16, full, out, 3, 1, 3);
+    }
+    free(pBase); free(pRef);
+} // CaseFeaturePyramidMatching()
+
+
+/************************************************************************/
+// Func: CaseHomography()
+// Desc: ComputePerspectMatrix on 4 random point pairs, then
+//       ComputeHomographyError (type 0 & 1) of random features under it.
+//       Out: the 9 floats of H, correct count & error sum
+/*************************************************************************/
+static void CaseHomography(DiffContext* ctx, int nCase)
+{
+    RK_U16  points4[16];
+    RK_F32  matA[64], vecB[8], vecX[9];
+    RK_F32  basePoint[3], projPoint[3], refPoint[3];
+    RK_U32  errors[2];
+    int     numFeature = 16 + (int)(DiffRand() % 200);
+    RK_U8*  pMarks     = (RK_U8*)DiffAlloc(numFeature);
+    RK_U16* pPointYs[2];
+    RK_U16* pPointXs[2];
+
+    for (int q=0; q < 4; q++)
+    {
+        // one corner per quadrant of a 4000x3000 frame, small motion
+        points4[q*4+0] = (RK_U16)(100 + (q / 2) * 1400 + DiffRand() % 1200);
+        points4[q*4+1] = (RK_U16)(100 + (q % 2) * 1900 + DiffRand() % 1700);
+        points4[q*4+2] = (RK_U16)(points4[q*4+0] + DiffRand() % 17);
+        points4[q*4+3] = (RK_U16)(points4[q*4+1] + DiffRand() % 17);
+    }
+    CreateCoefficient(points4, matA, vecB);
+    vecX[8] = 1;
+    ComputePerspectMatrix(matA, vecB, vecX);
+    DiffEmit(ctx, "ComputePerspectMatrix", VARIANT_HOMOGRAPHY, nCase, DIFF_TYPE_F32, vecX, 9, 1, 9);
+
+    for (int k=0; k < 2; k++)
+    {
+        pPointYs[k] = (RK_U16*)DiffAlloc(sizeof(RK_U16) * numFeature);
+        pPointXs[k] = (RK_U16*)DiffAlloc(sizeof(RK_U16) * numFeature);
+    }
+    for (int n=0; n < numFeature; n++)
+    {
+        pMarks[n]      = (RK_U8)(DiffRand() % 8 != 0);
+        pPointYs[0][n] = (RK_U16)(DiffRand() % 3000);
+        pPointXs[0][n] = (RK_U16)(DiffRand() % 4000);
+        pPointYs[1][n] = (RK_U16)(pPointYs[0][n] + DiffRand() % 20);
+        pPointXs[1][n] = (RK_U16)(pPointXs[0][n] + DiffRand() % 20);
+    }
+    for (int type=0; type < 2; type++)
+    {
+        errors[type] = 0;
+        ComputeHomographyError(type, pMarks, numFeature, pPointYs, pPointXs, 0, 1,
+            vecX, basePoint, projPoint, refPoint, errors[type]);
+    }
+    DiffEmit(ctx, "ComputeHomographyError", VARIANT_HOMOGRAPHY, nCase, DIFF_TYPE_U32, errors, 2, 1, 2);
+    free(pMarks);
+    for (int k=0; k < 2; k++)
+    {
+        free(pPointYs[k]); free(pPointXs[k]);
+    }
+} // CaseHomography()
+
+
+/************************************************************************/
+// Func: CaseTemporalDenoise_Modify()
+// Desc: one interior 32x64 tile of a 6-frame burst, rects & points built
+//       the way Enhancer_Modify() builds them from a per-frame Luma shift
+//       (+-1 between the two blocks). Odd modes move a patch in the
+//       RefFrames (motion detect path). Out: 32x64 RawDst
+/*************************************************************************/
+static void CaseTemporalDenoise_Modify(DiffContext* ctx, int nCase)
+{
+    RK_U16*     pBlocks[RK_MAX_FILE_NUM];
+    RK_F32*     pPoints[RK_MAX_FILE_NUM];
+    RK_RectExt  rects[RK_MAX_FILE_NUM];
+    RK_S16      nBlackLevel[4] = { DIFF_BLACK_LEVEL, DIFF_BLACK_LEVEL, DIFF_BLACK_LEVEL, DIFF_BLACK_LEVEL };
+    int         nFrames  = DIFF_BURST_FRAMES;
+    int         nRow     = RAW_BLK_SIZE * (2 + (int)(DiffRand() % 60));
+    int         nCol     = RAW_BLK_SIZE * RAW_WIN_NUM * (2 + (int)(DiffRand() % 40));
+    int         nMode    = (nCase / 2) % DIFF_FILL_MODES;
+    RK_U32      nSalt    = DiffRand();
+    int         nMoving  = nCase & 1;
+    int         nHalf    = RAW_BLK_SIZE / 2;
+    int         shiftY[RK_MAX_FILE_NUM], shiftX[RK_MAX_FILE_NUM];
+    RK_U16*     pDst     = (RK_U16*)DiffAlloc(sizeof(RK_U16) * RAW_BLK_SIZE * RAW_BLK_SIZE * RAW_WIN_NUM);
+
+    for (int k=0; k < nFrames; k++)
+    {
+        shiftY[k] = (k == BASE_PIC_NUM) ? 0 : (int)(DiffRand() % (2 * DIFF_TILE_SHIFT + 1)) - DIFF_TILE_SHIFT;
+        shiftX[k] = (k == BASE_PIC_NUM) ? 0 : (int)(DiffRand() % (2 * DIFF_TILE_SHIFT + 1)) - DIFF_TILE_SHIFT;
+        pPoints[k] = (RK_F32*)DiffAlloc(sizeof(RK_F32) * 2 * RAW_WIN_NUM);
+        for (int n=0; n < RAW_WIN_NUM; n++)
+        {
+            int jitter = (k != BASE_PIC_NUM && n > 0) ? (int)(DiffRand() % 3) - 1 : 0;
+            pPoints[k][n*2+0] = (RK_F32)(((nRow + nHalf) / 2 + shiftY[k]) * 2 - nHalf);
+            pPoints[k][n*2+1] = (RK_F32)(((nCol + nHalf + n * RAW_BLK_SIZE) / 2 + shiftX[k] + jitter) * 2 - nHalf);
+        }
+    }
+
+    //// rects: Enhancer_Modify(), frames far from the image border
+    for (int k=0; k < nFrames; k++)
+    {
+        RK_RectExt* pRect = &rects[k];
+        if (k == BASE_PIC_NUM)
+        {
+            pRect->rowUseful    = nRow;
+            pRect->colUseful    = nCol;
+            pRect->hgtUseful    = RAW_BLK_SIZE;
+            pRect->widUseful    = RAW_BLK_SIZE * RAW_WIN_NUM;
+            pRect->rowExtend    = nRow - RAW_BLK_BORDER;
+            pRect->colExtend    = ALIGN_4PIXEL_START(nCol - RAW_BLK_BORDER);
+            pRect->hgtExtend    = RAW_BLK_SIZE + 2 * RAW_BLK_EXTEND_ROW;
+            pRect->widExtend    = ALIGN_4PIXEL_WIDTH(RAW_BLK_SIZE * RAW_WIN_NUM + 2 * RAW_BLK_EXTEND_COL);
+            pRect->strideExtend = (RAW_BLK_SIZE * RAW_WIN_NUM + 2 * RAW_BLK_EXTEND_COL) * sizeof(RK_U16);
+        }
+        else
+        {
+            int minRow = (int)MIN(pPoints[k][0], pPoints[k][2]);
+            int maxRow = (int)MAX(pPoints[k][0], pPoints[k][2]);
+            int minCol = (int)MIN(pPoints[k][1], pPoints[k][3]);
+            int maxCol = (int)MAX(pPoints[k][1], pPoints[k][3]);
+            pRect->rowUseful    = minRow;
+            pRect->colUseful    = minCol;
+            pRect->hgtUseful    = maxRow - minRow + RAW_BLK_SIZE;
+            pRect->widUseful    = maxCol - minCol + RAW_BLK_SIZE;
+            pRect->rowExtend    = minRow - RAW_BLK_BORDER;
+            pRect->colExtend    = ALIGN_4PIXEL_START(minCol - RAW_BLK_BORDER);
+            pRect->hgtExtend    = maxRow - minRow + RAW_BLK_SIZE + 2 * RAW_BLK_BORDER;
+            pRect->widExtend    = ALIGN_4PIXEL_WIDTH(maxCol - minCol + RAW_BLK_SIZE + 2 * (minCol - pRect->colExtend));
+            pRect->strideExtend = pRect->widExtend * sizeof(RK_U16);
+        }
+        pRect->rowValid = pRect->rowExtend;
+        pRect->colValid = pRect->colExtend;
+        pRect->hgtValid = pRect->hgtExtend;
+        pRect->widValid = pRect->widExtend;
+
+        // Frame#k = scene moved by its shift (+ a patch moving on its own)
+        pBlocks[k] = (RK_U16*)DiffAlloc(sizeof(RK_U16) * pRect->hgtExtend * pRect->widExtend);
+        for (int r=0; r < pRect->hgtExtend; r++)
+        {
+            for (int c=0; c < pRect->widExtend; c++)
+            {
+                int sr = pRect->rowExtend + r - 2 * shiftY[k];
+                int sc = pRect->colExtend + c - 2 * shiftX[k];
+                int v  = DiffSample(nMode, nSalt, sr, sc, 0, 0x3FF);
+                if (nMoving && k != BASE_PIC_NUM && ((sr - nRow - 4 * k) & 31) < 10 && ((sc - nCol) & 63) < 24)
+                {
+                    v = 0x3FF - v;
+                }
+                v += (int)(DiffHash(nSalt, (RK_U32)(r * 4096 + c), (RK_U32)k) % 9) - 4;  // read noise
+                pBlocks[k][r * pRect->widExtend + c] = (RK_U16)MIN(MAX(v, 0), 0x3FF);
+            }
+        }
+    }
+
+    TemporalDenoise_Modify(pBlocks, RAW_WIN_NUM, rects, nFrames, BASE_PIC_NUM, pPoints,
+        MotionDetectTable, 1.0f, nBlackLevel, pDst, RAW_BLK_SIZE * RAW_WIN_NUM);
+    DiffEmit(ctx, "TemporalDenoise_Modify", VARIANT_DENOISER, nCase, DIFF_TYPE_U16,
+        pDst, RAW_BLK_SIZE * RAW_WIN_NUM, RAW_BLK_SIZE, RAW_BLK_SIZE * RAW_WIN_NUM);
+    for (int k=0; k < nFrames; k++)
+    {
+        free(pBlocks[k]); free(pPoints[k]);
+    }
+    free(pDst);
+} // CaseTemporalDenoise_Modify()
+
+
+/************************************************************************/
+// Func: CaseWdrStat()
+// Desc: ThumbChunk (ThumbWid+2)x(32+2) through wdrPreFilterBlock and
+//       CalcuHist, C & vector side by side (both are in every binary):
+//       pairs are compared here, the C outputs are dumped.
+//       Out: filtered chunk, 9 count & weight planes
+/*************************************************************************/
+static void CaseWdrStat(DiffContext* ctx, int nCase, DiffStats* pPre, DiffStats* pHist)
+{
+    int     nThumbWid = 64 + (int)(DiffRand() % (CALCUHIST_VEC_MAX_WID - 63));
+    int     nWid      = nThumbWid + 2;
+    int     nHgt      = NUM_LINE_DDR2DSP_THUMB + 2;
+    int     nStatWid  = ((nThumbWid * SCALER_FACTOR_R2T + 128) >> 8) + 1;
+    int     rowSeg    = (int)(DiffRand() % (WDR_STAT_CELLS / nStatWid - 1));
+    int     nTabLen   = WDR_STAT_BINS * WDR_STAT_CELLS;
+    RK_U16* pChunk    = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nWid * nHgt);
+    RK_U16* pTmp      = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nWid * nHgt);
+    RK_U16* pFilter[2];
+    RK_U16* pCount[2];
+    RK_U32* pWeight[2];
+
+    DiffFillImage(pChunk, nWid, nHgt, nWid, rowSeg * NUM_LINE_DDR2DSP_THUMB, 0,
+        nCase % DIFF_FILL_MODES, DiffRand(), 0, DIFF_THUMB_MAX);
+    // ring = strip edges: the vector filter reads it, the C filter clamps
+    for (int r=1; r < nHgt - 1; r++)
+    {
+        pChunk[r * nWid]            = pChunk[r * nWid + 1];
+        pChunk[r * nWid + nWid - 1] = pChunk[r * nWid + nWid - 2];
+    }
+    memcpy(pChunk, pChunk + nWid, sizeof(RK_U16) * nWid);
+    memcpy(pChunk + (nHgt - 1) * nWid, pChunk + (nHgt - 2) * nWid, sizeof(RK_U16) * nWid);
+    for (int v=0; v < 2; v++)
+    {
+        pFilter[v] = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nWid * nHgt);
+        pCount[v]  = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nTabLen);
+        pWeight[v] = (RK_U32*)DiffAlloc(sizeof(RK_U32) * nTabLen);
+    }
+    memcpy(pTmp, pChunk, sizeof(RK_U16) * nWid * nHgt);
+
+    wdrPreFilterBlock(pChunk, pFilter[0], nHgt, nWid);
+    wdrPreFilterBlock_Vec(pChunk, pFilter[1], nHgt - 2, nWid - 2, nWid);
+    DiffStatsAdd(pPre, nCase, DIFF_TYPE_U16, pFilter[0], pFilter[1], nWid - 2, nHgt - 2, nWid);
+    DiffEmit(ctx, "wdrPreFilterBlock", "c", nCase, DIFF_TYPE_U16, pFilter[0], nWid - 2, nHgt - 2, nWid);
+
+    // both histograms from the C filter output
+    memcpy(pFilter[1], pFilter[0], sizeof(RK_U16) * nWid * nHgt);
+    CalcuHist(pFilter[0], pCount[0], pWeight[0], nHgt, nWid, nStatWid, rowSeg);
+    CalcuHist_Vec(pFilter[1], pTmp, pCount[1], pWeight[1], nHgt - 2, nWid - 2, nWid, nStatWid, rowSeg);
+    DiffStatsAdd(pHist, nCase, DIFF_TYPE_U16, pCount[0], pCount[1], WDR_STAT_CELLS, WDR_STAT_USED, WDR_STAT_CELLS);
+    DiffStatsAdd(pHist, nCase, DIFF_TYPE_U32, pWeight[0], pWeight[1], WDR_STAT_CELLS, WDR_STAT_USED, WDR_STAT_CELLS);
+    pHist->nCases--; // two tables, one case
+    DiffEmit(ctx, "CalcuHist.count", "c", nCase, DIFF_TYPE_U16, pCount[0], WDR_STAT_CELLS, WDR_STAT_USED, WDR_STAT_CELLS);
+    DiffEmit(ctx, "CalcuHist.weight", "c", nCase, DIFF_TYPE_U32, pWeight[0], WDR_STAT_CELLS, WDR_STAT_USED, WDR_STAT_CELLS);
+
+    free(pChunk); free(pTmp);
+    for (int v=0; v < 2; v++)
+    {
+        free(pFilter[v]); free(pCount[v]); free(pWeight[v]);
+    }
+} // CaseWdrStat()
+
+
+/************************************************************************/
+// Func: CaseThumbStripScan()
+// Desc: ThumbChunk (ThumbWid+2)x(32+2) through ThumbStripScan and through
+//       FeatureDetect & GetWdrWeightTable (both in every binary): pairs are
+//       compared here, the fused outputs are dumped.
+//       Out: points & values of the segment row, the WDR table in the
+//            layout WDR_WEIGHT_TRANSPOSE selects (GetWdrWeightTable fills both)
+/*************************************************************************/
+static void CaseThumbStripScan(DiffContext* ctx, int nCase, DiffStats* pScan)
+{
+    int     nThumbWid  = 64 + 2 * (int)(DiffRand() % 232);
+    int     nWid       = nThumbWid + 2;
+    int     nHgt       = NUM_LINE_DDR2DSP_THUMB + 2;
+    int     numFeature = nThumbWid / DIV_FIXED_WIN_SIZE;
+    int     nStatWid   = ((nThumbWid * SCALER_FACTOR_R2T + 128) >> 8) + 1;
+    int     rowSeg     = (int)(DiffRand() % (WDR_STAT_CELLS / nStatWid - 1));
+    int     nLen       = (rowSeg + 1) * numFeature;
+    int     nTabLen    = WDR_STAT_BINS * WDR_STAT_CELLS;
+    int     nLayout    = WDR_WEIGHT_TRANSPOSE ? 1 : 0; // split table the fused one is compared with
+    int     nMismatch  = pScan->nMismatch;
+    RK_U16* pChunk     = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nWid * nHgt);
+    RK_U16* pFilter    = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nWid * nHgt);
+    RK_U16* pOut[2];
+    RK_U16* pCount[2][2];
+    RK_U32* pWeight[2][2];
+
+    DiffFillImage(pChunk, nWid, nHgt, nWid, rowSeg * NUM_LINE_DDR2DSP_THUMB, 0,
+        nCase % DIFF_FILL_MODES, DiffRand(), 0, DIFF_THUMB_MAX);
+    for (int v=0; v < 2; v++)
+    {
+        pOut[v] = (RK_U16*)DiffAlloc(sizeof(RK_U16) * 3 * nLen);
+        for (int t=0; t < 2; t++)
+        {
+            pCount[v][t]  = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nTabLen);
+            pWeight[v][t] = (RK_U32*)DiffAlloc(sizeof(RK_U32) * nTabLen);
+        }
+    }
+    RK_U16* pFusedCount  = pCount[1][nLayout];
+    RK_U32* pFusedWeight = pWeight[1][nLayout];
+
+    // 0: split kernels, 1: fused
+    RK_U16* pSplitPoints[2] = { pOut[0], pOut[0] + nLen };
+    RK_U16* pFusedPoints[2] = { pOut[1], pOut[1] + nLen };
+    FeatureDetect(pChunk, nWid, nHgt, ALIGN_4BYTE_WIDTH(nThumbWid, THUMB_BIT_COUNT) + 4, rowSeg, numFeature,
+        pSplitPoints, pOut[0] + 2 * nLen);
+    GetWdrWeightTable(pChunk, nWid, nHgt, nWid, rowSeg, pFilter, pWeight[0][0], pCount[0][0],
+        pWeight[0][1], pCount[0][1], nStatWid, 0);
+    ThumbStripScan(pChunk, nWid, nHgt, rowSeg, numFeature, pFusedPoints, pOut[1] + 2 * nLen,
+        pFusedWeight, pFusedCount, nStatWid);
+
+    DiffStatsAdd(pScan, nCase, DIFF_TYPE_U16, pOut[0] + rowSeg * numFeature, pOut[1] + rowSeg * numFeature,
+        numFeature, 3, nLen);
+    DiffStatsAdd(pScan, nCase, DIFF_TYPE_U16, pCount[0][nLayout], pFusedCount, nTabLen, 1, nTabLen);
+    DiffStatsAdd(pScan, nCase, DIFF_TYPE_U32, pWeight[0][nLayout], pFusedWeight, nTabLen, 1, nTabLen);
+    pScan->nCases   -= 2; // three outputs, one case
+    pScan->nMismatch = nMismatch + (pScan->nMismatch > nMismatch);
+    DiffEmit(ctx, "ThumbStripScan.feature", VARIANT_REGISTER, nCase, DIFF_TYPE_U16,
+        pOut[1] + rowSeg * numFeature, numFeature, 3, nLen);
+    DiffEmit(ctx, "ThumbStripScan.count", "c", nCase, DIFF_TYPE_U16, pFusedCount, nTabLen, 1, nTabLen);
+    DiffEmit(ctx, "ThumbStripScan.weight", "c", nCase, DIFF_TYPE_U32, pFusedWeight, nTabLen, 1, nTabLen);
+
+    free(pChunk); free(pFilter);
+    for (int v=0; v < 2; v++)
+    {
+        free(pOut[v]);
+        for (int t=0; t < 2; t++)
+        {
+            free(pCount[v][t]); free(pWeight[v][t]);
+        }
+    }
+} // CaseThumbStripScan()
+
+
+/************************************************************************/
+// Func: CaseHistFilter()
+// Desc: random count & weight planes of a statistic grid of <= 256 cells.
+//       Out: filtered count & weight planes
+/*************************************************************************/
+static void CaseHistFilter(DiffContext* ctx, int nCase)
+{
+    int     nStatWid = 3 + (int)(DiffRand() % 14);
+    int     nStatHgt = 3 + (int)(DiffRand() % (WDR_STAT_CELLS / nStatWid - 2));
+    int     nTabLen  = WDR_STAT_BINS * WDR_STAT_CELLS;
+    RK_U16* pCount   = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nTabLen);
+    RK_U32* pWeight  = (RK_U32*)DiffAlloc(sizeof(RK_U32) * nTabLen);
+
+    for (int b=0; b < WDR_STAT_USED; b++)
+    {
+        for (int i=0; i < nStatWid * nStatHgt; i++)
+        {
+            // a 32x32 thumb cell holds <= 1024 pixels of <= DIFF_FILTER_MAX
+            RK_U16 count = (RK_U16)((nCase & 1) ? DiffRand() % 1025 : (DiffRand() % 4 ? 0 : DiffRand() % 1025));
+            pCount[b * WDR_STAT_CELLS + i]  = count;
+            pWeight[b * WDR_STAT_CELLS + i] = count * (RK_U32)(b * 2048 + DiffRand() % 2048);
+        }
+    }
+    HistFilter(pCount, pWeight, nStatHgt, nStatWid);
+    DiffEmit(ctx, "HistFilter.count", "c", nCase, DIFF_TYPE_U16, pCount, WDR_STAT_CELLS, WDR_STAT_USED, WDR_STAT_CELLS);
+    DiffEmit(ctx, "HistFilter.weight", "c", nCase, DIFF_TYPE_U32, pWeight, WDR_STAT_CELLS, WDR_STAT_USED, WDR_STAT_CELLS);
+    free(pCount); free(pWeight);
+} // CaseHistFilter()
+
+
+/************************************************************************/
+// Func: CaseWdr_process_block()
+// Desc: 34x66 WdrBuf of TemporalDenoise output range at a random tile of
+//       a <= 256 cell grid, random weight table & WDR curve.
+//       Out: 32x64 result & gain
+/*************************************************************************/
+static void CaseWdr_process_block(DiffContext* ctx, int nCase)
+{
+    int     nBufWid  = RAW_BLK_SIZE * RAW_WIN_NUM + 2;
+    int     nBufLen  = (RAW_BLK_SIZE + 2) * nBufWid;
+    int     nOutLen  = RAW_BLK_SIZE * RAW_BLK_SIZE * RAW_WIN_NUM;
+    int     nStatWid = 4 + (int)(DiffRand() % 13);
+    int     nStatHgt = MIN(WDR_STAT_CELLS / nStatWid, 13);
+    int     nX       = RAW_BLK_SIZE * RAW_WIN_NUM * (int)(DiffRand() % ((nStatWid - 2) * 256 / (RAW_BLK_SIZE * RAW_WIN_NUM)));
+    int     nY       = RAW_BLK_SIZE * (int)(DiffRand() % ((nStatHgt - 2) * 256 / RAW_BLK_SIZE));
+    RK_U16* pBuf     = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nBufLen);
+    RK_U16* pWeight  = (RK_U16*)DiffAlloc(sizeof(RK_U16) * WDR_STAT_BINS * WDR_STAT_CELLS);
+    RK_U16* pScale   = (RK_U16*)DiffAlloc(sizeof(RK_U16) * 961);
+    RK_U16* pOut     = (RK_U16*)DiffAlloc(sizeof(RK_U16) * 2 * nOutLen);
+    RK_U16* pLeftRight = (RK_U16*)DiffAlloc(sizeof(RK_U16) * 32 * 16 * 2);
+
+    // TemporalDenoise output is WDR_GAIN x Raw
+    DiffFillImage(pBuf, nBufWid, RAW_BLK_SIZE + 2, nBufWid, nY, nX, nCase % DIFF_FILL_MODES, DiffRand(), 0, 0x1FFF);
+    for (int i=0; i < WDR_STAT_BINS * WDR_STAT_CELLS; i++)
+    {
+        pWeight[i] = (RK_U16)(DiffRand() % 0x1000);
+    }
+    memcpy(pScale, cure_table[DiffRand() % 24], sizeof(RK_U16) * 961);
+    wdr_process_block(nX, nY, RAW_BLK_SIZE * RAW_WIN_NUM, RAW_BLK_SIZE, nStatWid, nBufWid, RAW_BLK_SIZE * RAW_WIN_NUM,
+        pBuf, pWeight, pScale, pOut + nOutLen, pOut, pLeftRight);
+    // rows 0..31 result, 32..63 gain
+    DiffEmit(ctx, "wdr_process_block", VARIANT_WDR, nCase, DIFF_TYPE_U16,
+        pOut, RAW_BLK_SIZE * RAW_WIN_NUM, 2 * RAW_BLK_SIZE, RAW_BLK_SIZE * RAW_WIN_NUM);
+    free(pBuf); free(pWeight); free(pScale); free(pOut); free(pLeftRight);
+} // CaseWdr_process_block()
+
+
+/************************************************************************/
+// Func: CaseMFNR_Process()
+// Desc: 6-frame DIFF_BURST_WID x DIFF_BURST_HGT burst: one scene, an even
+//       Raw translation per frame, read noise; 1/8 thumbs as rk_burst_synth.
+//       Out: homographies (9 floats per RefFrame) & unpacked output
+/*************************************************************************/
+static void CaseMFNR_Process(DiffContext* ctx, int nCase)
+{
+    RK_RawInfo          rawInfo;
+    RK_InputParams      inParams;
+    RK_ControlParams    ctrlParams;
+    int         nWid        = DIFF_BURST_WID;
+    int         nHgt        = DIFF_BURST_HGT;
+    int         nFrames     = DIFF_BURST_FRAMES;
+    int         nRawStride  = ALIGN_4PIXEL_WIDTH(nWid) * 5 / 4;
+    int         nThumbWid   = nWid / SCALER_FACTOR_R2T;
+    int         nThumbHgt   = nHgt / SCALER_FACTOR_R2T;
+    int         nThumbStride = ALIGN_4BYTE_WIDTH(nThumbWid, THUMB_BIT_COUNT);
+    int         nMode       = nCase % 2 ? 3 : 0;
+    RK_U32      nSalt       = DiffRand();
+    RK_U16*     pFrame      = (RK_U16*)DiffAlloc(sizeof(RK_U16) * nWid * nHgt);
+    RK_U8*      pRaws[RK_MAX_FILE_NUM];
+    RK_U16*     pThumbs[RK_MAX_FILE_NUM];
+    RK_U8*      pRawDst     = (RK_U8*)DiffAlloc(nHgt * nRawStride);
+    RK_F32      homography[RK_MAX_FILE_NUM][9];
+
+    for (int k=0; k < nFrames; k++)
+    {
+        int dy = (k == BASE_PIC_NUM) ? 0 : 2 * ((int)(DiffRand() % (DIFF_BURST_SHIFT + 1)) - DIFF_BURST_SHIFT / 2);
+        int dx = (k == BASE_PIC_NUM) ? 0 : 2 * ((int)(DiffRand() % (DIFF_BURST_SHIFT + 1)) - DIFF_BURST_SHIFT / 2);
+        for (int r=0; r < nHgt; r++)
+        {
+            for (int c=0; c < nWid; c++)
+            {
+                // scene in 4x4 cells so thumbs keep texture, + read noise
+                int v = DiffSample(nMode, nSalt, (r - dy) >> 2, (c - dx) >> 2, 0, 0x3FF - 2 * DIFF_BLACK_LEVEL)
+                      + DIFF_BLACK_LEVEL + (int)(DiffHash(nSalt, (RK_U32)(r * 8192 + c), (RK_U32)k) % 9) - 4;
+                pFrame[r * nWid + c] = (RK_U16)MIN(MAX(v, 0), 0x3FF);
+            }
+        }
+        pRaws[k]   = (RK_U8*)DiffAlloc(nHgt * nRawStride);
+        pThumbs[k] = (RK_U16*)DiffAlloc(nThumbHgt * nThumbStride);
+        for (int r=0; r < nHgt; r++)
+        {
+            rdma_pack_raw10(pFrame + r * nWid, pRaws[k] + r * nRawStride, 0, nWid, 0);
+        }
+        for (int i=0; i < nThumbHgt; i++)
+        {
+            for (int j=0; j < nThumbWid; j++)
+            {
+                RK_U32 sum = 0;
+                for (int y=0; y < SCALER_FACTOR_R2T; y++)
+                {
+                    for (int x=0; x < SCALER_FACTOR_R2T; x++)
+                    {
+                        sum += pFrame[(i * SCALER_FACTOR_R2T + y) * nWid + j * SCALER_FACTOR_R2T + x];
+                    }
+                }
+                pThumbs[k][i * (nThumbStride / sizeof(RK_U16)) + j] = (RK_U16)sum;
+            }
+        }
+    }
+
+    memset(&rawInfo, 0, sizeof(rawInfo));
+    memset(&inParams, 0, sizeof(inParams));
+    memset(&ctrlParams, 0, sizeof(ctrlParams));
+    strcpy(rawInfo.sBayerType, "RGGB");
+    rawInfo.fRedGain    = 1.0f / 0.55f;
+    rawInfo.fBlueGain   = 1.0f / 0.65f;
+    rawInfo.fSensorGain = 1.0f;
+    rawInfo.fIspGain    = 1.0f + (RK_F32)(DiffRand() % 8);
+    for (int i=0; i < 4; i++)
+    {
+        rawInfo.nBlackLevel[i] = DIFF_BLACK_LEVEL;
+    }
+    inParams.nRawWid     = (RK_U16)nWid;
+    inParams.nRawHgt     = (RK_U16)nHgt;
+    inParams.nRawStride  = nRawStride;
+    inParams.nRawSize    = nHgt * nRawStride;
+    inParams.nRawFileNum = (RK_U16)nFrames;
+    inParams.pRawInfo    = &rawInfo;
+    for (int k=0; k < nFrames; k++)
+    {
+        inParams.pRawSrcs[k]   = pRaws[k];
+        inParams.pThumbSrcs[k] = pThumbs[k];
+    }
+    ctrlParams.setNumFrameCompose = (RK_F32)nFrames;
+    ctrlParams.useRegister        = 1;
+
+    int ret = RK_MFNR_Processor(&inParams, &ctrlParams, pRawDst);
+    if (ret == MFNR_ERR_DSP_MEM_OVERFLOW)
+    {
+        RK_DspMemStats dspMem;
+        RK_MFNR_GetDspMemStats(&dspMem);
+        if (dspMem.nOverrunBlock >= 0)
+        {
+            fprintf(stderr, "rk_kernel_diff: a Tile window overran its DSP chunk on burst %d\n", nCase);
+            exit(2);
+        }
+        fprintf(stderr, "rk_kernel_diff: DSP_MEM_SIZE %d too small, rebuild with -DDSP_MEM_SIZE=...\n", DSP_MEM_SIZE);
+        exit(2);
+    }
+    if (ret)
+    {
+        fprintf(stderr, "rk_kernel_diff: RK_MFNR_Processor failed (%d) on burst %d\n", ret, nCase);
+        exit(2);
+    }
+    for (int k=0; k < nFrames; k++)
+    {
+        memcpy(homography[k], g_mfnrProcessor.pHomographyMatrix[k], sizeof(homography[k]));
+    }
+    for (int r=0; r < nHgt; r++)
+    {
+        rdma_unpack_raw10(pRawDst + r * nRawStride, 0, pFrame + r * nWid, nWid, 0);
+    }
+    DiffEmit(ctx, "MFNR_Process.homography", VARIANT_PROCESS, nCase, DIFF_TYPE_F32, homography[1], 9, nFrames - 1, 9);
+    DiffEmit(ctx, "MFNR_Process.output", VARIANT_PROCESS, nCase, DIFF_TYPE_U16, pFrame, nWid, nHgt, nWid);
+
+    for (int k=0; k < nFrames; k++)
+    {
+        free(pRaws[k]); free(pThumbs[k]);
+    }
+    free(pFrame); free(pRawDst);
+} // CaseMFNR_Process()
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Drivers
+//
+/************************************************************************/
+// Func: DiffRunCases()
+// Desc: nCases cases of one kernel
+/*************************************************************************/
+static void DiffRunCases(DiffContext* ctx, const char* kernel, DiffFunc func, int nCases)
+{
+    if (!DiffMatch(kernel, ctx->filter))
+    {
+        return;
+    }
+    for (int n=0; n < nCases; n++)
+    {
+        DiffSeedCase(ctx, kernel, n);
+        func(ctx, n);
+    }
+} // DiffRunCases()
+
+
+/************************************************************************/
+// Func: DiffDump()
+// Desc: every kernel case into ctx->fp, in-binary pairs to stdout
+/*************************************************************************/
+static int DiffDump(DiffContext* ctx)
+{
+    DiffFileHeader  header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.sMagic, DIFF_MAGIC, sizeof(header.sMagic));
+    header.nSeed   = ctx->nSeed;
+    header.nCases  = ctx->nCases;
+    header.nBursts = ctx->nBursts;
+    fwrite(&header, sizeof(header), 1, ctx->fp);
+
+    DiffRunCases(ctx, "FeatureDetect",          CaseFeatureDetect,          ctx->nCases);
+    //// Feature*MatchingFast: early-terminating vs exhaustive search in this binary, on the same cases
+    DiffStats fast;
+    DiffStatsInit(&fast, "FeatureMatchingFast", "full", "fast");
+    ctx->pMatchFast = &fast;
+
+    DiffRunCases(ctx, "ThumbRaw10Box",          CaseThumbRaw10Box,          ctx->nCases);
+    DiffRunCases(ctx, "FeatureCoarseMatching",  CaseFeatureCoarseMatching,  ctx->nCases);
+    DiffRunCases(ctx, "Scaler_Raw2Luma",        CaseScaler_Raw2Luma,        ctx->nCases);
+    DiffRunCases(ctx, "FeatureFineMatching",    CaseFeatureFineMatching,    ctx->nCases);
+    DiffRunCases(ctx, "ThumbPyramidBox",        CaseThumbPyramidBox,        ctx->nCases);
+    DiffRunCases(ctx, "FeaturePyramidMatching", CaseFeaturePyramidMatching, ctx->nCases);
+
+    ctx->pMatchFast = NULL;
+    if (fast.nCases > 0)
+    {
+        DiffStatsReport(&fast);
+        ctx->nPairFail += (fast.nMismatch > 0);
+    }
+    DiffRunCases(ctx, "ComputePerspectMatrix",  CaseHomography,             ctx->nCases);
+    DiffRunCases(ctx, "TemporalDenoise_Modify", CaseTemporalDenoise_Modify, ctx->nCases);
+    DiffRunCases(ctx, "HistFilter",             CaseHistFilter,             ctx->nCases);
+    DiffRunCases(ctx, "wdr_process_block",      CaseWdr_process_block,      ctx->nCases);
+
+    //// wdrPreFilterBlock & CalcuHist: C vs vector in this binary
+    if (DiffMatch("wdrPreFilterBlock", ctx->filter) || DiffMatch("CalcuHist", ctx->filter))
+    {
+        DiffStats pre, hist;
+        DiffStatsInit(&pre,  "wdrPreFilterBlock", "c", DIFF_VARIANT_VEC);
+        DiffStatsInit(&hist, "CalcuHist",         "c", DIFF_VARIANT_VEC);
+        for (int n=0; n < ctx->nCases; n++)
+        {
+            DiffSeedCase(ctx, "wdrStat", n);
+            CaseWdrStat(ctx, n, &pre, &hist);
+        }
+        DiffStatsReport(&pre);
+        DiffStatsReport(&hist);
+        ctx->nPairFail += (pre.nMismatch > 0) + (hist.nMismatch > 0);
+    }
+
+    //// ThumbStripScan: fused vs FeatureDetect & GetWdrWeightTable in this binary
+    if (DiffMatch("ThumbStripScan", ctx->filter))
+    {
+        DiffStats scan;
+        DiffStatsInit(&scan, "ThumbStripScan", "split", "fused");
+        for (int n=0; n < ctx->nCases; n++)
+        {
+            DiffSeedCase(ctx, "ThumbStripScan", n);
+            CaseThumbStripScan(ctx, n, &scan);
+        }
+        DiffStatsReport(&scan);
+        ctx->nPairFail += (scan.nMismatch > 0);
+    }
+
+    DiffRunCases(ctx, "MFNR_Process", CaseMFNR_Process, ctx->nBursts);
+
+    printf("{\"register\":\"%s\",\"denoiser\":\"%s\",\"wdr\":\"%s\",\"records\":%d,\"pair_mismatch\":%d}\n",
+        VARIANT_REGISTER, VARIANT_DENOISER, VARIANT_WDR, ctx->nRecords, ctx->nPairFail);
+    return ctx->nPairFail ? 1 : 0;
+} // DiffDump()
+
+
+/************************************************************************/
+// Func: DiffReadFile()
+// Desc: whole dump into memory, checks the header. NULL on failure
+/*************************************************************************/
+static RK_U8* DiffReadFile(const char* pFileName, long* pSize)
+{
+    FILE*   fp = fopen(pFileName, "rb");
+    RK_U8*  pData;
+    long    nSize;
+
+    if (fp == NULL)
+    {
+        fprintf(stderr, "rk_kernel_diff: can not open %s\n", pFileName);
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    nSize = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    pData = (RK_U8*)malloc(MAX(nSize, 1));
+    if (pData == NULL || fread(pData, 1, nSize, fp) != (size_t)nSize
+        || nSize < (long)sizeof(DiffFileHeader) || memcmp(pData, DIFF_MAGIC, 8) != 0)
+    {
+        fprintf(stderr, "rk_kernel_diff: %s is not a dump\n", pFileName);
+        fclose(fp);
+        free(pData);
+        return NULL;
+    }
+    fclose(fp);
+    *pSize = nSize;
+    return pData;
+} // DiffReadFile()
+
+
+/************************************************************************/
+// Func: DiffCompare()
+// Desc: records of two dumps in file order, one DiffStats per record name
+//       reported in order of appearance
+/*************************************************************************/
+static int DiffCompare(const char* pFileA, const char* pFileB, const char* filter)
+{
+    long        nSizeA, nSizeB;
+    RK_U8*      pA = DiffReadFile(pFileA, &nSizeA);
+    RK_U8*      pB = DiffReadFile(pFileB, &nSizeB);
+    long        posA = sizeof(DiffFileHeader);
+    long        posB = sizeof(DiffFileHeader);
+    DiffStats*  stats = (DiffStats*)DiffAlloc(sizeof(DiffStats) * DIFF_MAX_KERNELS);
+    DiffStats*  pStats;
+    int         nKernels = 0;
+    int         nFail = 0;
+
+    if (pA == NULL || pB == NULL)
+    {
+        free(pA); free(pB); free(stats);
+        return 2;
+    }
+    if (memcmp(pA, pB, sizeof(DiffFileHeader)) != 0)
+    {
+        fprintf(stderr, "rk_kernel_diff: dumps of different -seed/-n/-b\n");
+        free(pA); free(pB); free(stats);
+        return 2;
+    }
+
+    while (posA < nSizeA && posB < nSizeB)
+    {
+        DiffRecord* recA = (DiffRecord*)(pA + posA);
+        DiffRecord* recB = (DiffRecord*)(pB + posB);
+        long        nLenA = (long)recA->nWid * recA->nHgt * g_DiffTypeSize[recA->nType];
+        long        nLenB = (long)recB->nWid * recB->nHgt * g_DiffTypeSize[recB->nType];
+        if (strcmp(recA->sKernel, recB->sKernel) != 0 || recA->nCase != recB->nCase)
+        {
+            fprintf(stderr, "rk_kernel_diff: %s#%d vs %s#%d, dumps of different -k\n",
+                recA->sKernel, recA->nCase, recB->sKernel, recB->nCase);
+            nFail = 2;
+            break;
+        }
+        posA += sizeof(DiffRecord) + nLenA;
+        posB += sizeof(DiffRecord) + nLenB;
+        if (!DiffMatch(recA->sKernel, filter))
+        {
+            continue;
+        }
+        pStats = NULL;
+        for (int i=0; i < nKernels; i++)
+        {
+            if (strcmp(stats[i].sKernel, recA->sKernel) == 0)
+            {
+                pStats = &stats[i];
+                break;
+            }
+        }
+        if (pStats == NULL)
+        {
+            if (nKernels == DIFF_MAX_KERNELS)
+            {
+                continue;
+            }
+            pStats = &stats[nKernels++];
+            DiffStatsInit(pStats, recA->sKernel, recA->sVariant, recB->sVariant);
+        }
+        if (recA->nType != recB->nType || recA->nWid != recB->nWid || recA->nHgt != recB->nHgt)
+        {
+            // shape change: the whole case differs
+            pStats->nCases++;
+            pStats->nMismatch++;
+            if (pStats->nFirstCase < 0)
+            {
+                pStats->nFirstCase = recA->nCase;
+            }
+            continue;
+        }
+        DiffStatsAdd(pStats, recA->nCase, recA->nType, recA + 1, recB + 1, recA->nWid, recA->nHgt, recA->nWid);
+    }
+    for (int i=0; i < nKernels; i++)
+    {
+        DiffStatsReport(&stats[i]);
+        nFail |= stats[i].nMismatch > 0;
+    }
+
+    free(pA); free(pB); free(stats);
+    return nFail;
+} // DiffCompare()
+
+
+/************************************************************************/
+// Func: main()
+// Desc: rk_kernel_diff -dump file [-seed n] [-n cases] [-b bursts] [-k kernel]
+//       rk_kernel_diff -cmp file_a file_b [-k kernel]
+/*************************************************************************/
+int main(int argc, char* argv[])
+{
+    DiffContext ctx;
+    const char* pDumpFile = NULL;
+    const char* pCmpFile[2] = { NULL, NULL };
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.nSeed   = 1;
+    ctx.nCases  = DIFF_CASES;
+    ctx.nBursts = DIFF_BURSTS;
+
+    for (int i=1; i < argc; i++)
+    {
+        if (i + 1 < argc && strcmp(argv[i], "-dump") == 0)
+        {
+            pDumpFile = argv[++i];
+        }
+        else if (i + 2 < argc && strcmp(argv[i], "-cmp") == 0)
+        {
+            pCmpFile[0] = argv[++i];
+            pCmpFile[1] = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-seed") == 0)
+        {
+            ctx.nSeed = (RK_U32)atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-n") == 0)
+        {
+            ctx.nCases = atoi(argv[++i]);
+            ctx.nCases = MAX(ctx.nCases, 1);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-b") == 0)
+        {
+            ctx.nBursts = atoi(argv[++i]);
+            ctx.nBursts = MAX(ctx.nBursts, 0);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-k") == 0)
+        {
+            ctx.filter = argv[++i];
+        }
+        else
+        {
+            pDumpFile = pCmpFile[0] = NULL;
+            break;
+        }
+    }
+    if ((pDumpFile == NULL) == (pCmpFile[0] == NULL))
+    {
+        fprintf(stderr, "usage: %s -dump file [-seed n] [-n cases] [-b bursts] [-k kernel]\n"
+                        "       %s -cmp file_a file_b [-k kernel]\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    if (pCmpFile[0] != NULL)
+    {
+        return DiffCompare(pCmpFile[0], pCmpFile[1], ctx.filter);
+    }
+
+    ctx.fp = fopen(pDumpFile, "wb");
+    if (ctx.fp == NULL)
+    {
+        fprintf(stderr, "rk_kernel_diff: can not write %s\n", pDumpFile);
+        return 2;
+    }
+    int ret = DiffDump(&ctx);
+    fclose(ctx.fp);
+
+    return ret;
+
+} // main()
@@ -0,0 +1,106 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: cpu.cpp
+// Desc: Host CPU level & runtime dispatch of the hot kernels
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+////-------- Header files
+//
+#include "cpu.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Macro Definition
+//
+#define     RK_CPU_ENV                  "MFNR_CPU"      // level override for testing
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Global Variables
+//
+static const char* const g_CpuLevelNames[RK_CPU_LEVEL_NUM] = { "base", "avx2" };
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Functions Definition
+//
+/************************************************************************/
+// Func: RK_CpuDetect()
+// Desc: Highest level the CPU & OS support, lowered by $MFNR_CPU
+//   In:
+//  Out: RK_CpuLevel
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+static int RK_CpuDetect(void)
+{
+    int             nLevel = RK_CPU_BASE;
+    const char*     pEnv;
+
+#if defined(__x86_64__) || defined(__i386__)
+    // __builtin_cpu_supports() also checks that the OS saves the YMM state
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        nLevel = RK_CPU_AVX2;
+    }
+#endif
+
+    pEnv = getenv(RK_CPU_ENV);
+    if (pEnv != NULL && pEnv[0] != '\0')
+    {
+        int     nForce = -1;
+        for (int i=0; i < RK_CPU_LEVEL_NUM; i++)
+        {
+            if (strcmp(pEnv, g_CpuLevelNames[i]) == 0)
+            {
+                nForce = i;
+            }
+        }
+        if (nForce < 0)
+        {
+            fprintf(stderr, "%s=%s: unknown level (base, avx2), using %s\n",
+                RK_CPU_ENV, pEnv, g_CpuLevelNames[nLevel]);
+        }
+        else if (nForce > nLevel)
+        {
+            fprintf(stderr, "%s=%s: not supported by this CPU, using %s\n",
+                RK_CPU_ENV, pEnv, g_CpuLevelNames[nLevel]);
+        }
+        else
+        {
+            nLevel = nForce;
+        }
+    }
+
+    return nLevel;
+
+} // RK_CpuDetect()
+
+
+/************************************************************************/
+// Func: RK_CpuGetLevel()
+// Desc: CPU level of this process, detected on the first call
+//   In:
+//  Out: RK_CpuLevel
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+int RK_CpuGetLevel(void)
+{
+    static const int    s_nLevel = RK_CpuDetect();
+
+    return s_nLevel;
+
+} // RK_CpuGetLevel()
+
+
+//////////////////////////////////////////////////////////////////////////
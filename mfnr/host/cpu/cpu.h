@@ -0,0 +1,124 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: cpu.h
+// Desc: Host CPU level & runtime dispatch of the hot kernels
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// Switch: MFNR_CPU_DISPATCH (rk_global.h, or -DMFNR_CPU_DISPATCH=1)
+//
+// The Register, Denoiser & BayerWDR sources are compiled once more per
+// level by mfnr/host/cpu/isa_<level>.cpp, under #pragma GCC target and
+// inside namespace mfnr_<level>; vec-c.h then maps to AVX2 there. The
+// baseline build (no -m flags) keeps the plain x86-64 copy and
+// RK_CPU_DISPATCH() at the top of a hot kernel forwards each call to the
+// clone of the level picked at startup:
+//
+//   level         cpuid                 clone
+//   base          -                     (the baseline build itself)
+//   avx2          AVX2                  mfnr_avx2::
+//
+// The level is the highest one the CPU (and OS) supports. The environment
+// variable MFNR_CPU=base|avx2 lowers it for testing; a level the CPU does
+// not support is refused with a warning. AVX2 is the top level: vec-c.h
+// has no wider mapping, an AVX-512 clone would only be the AVX2 one
+// compiled again.
+//
+// Build (one binary for every host):
+//   g++ -O2 -DMFNR_CPU_DISPATCH=1 -Imfnr/host -Imfnr <tool>.cpp
+//       mfnr/rk_mfnr.cpp mfnr/rk_register.cpp mfnr/rk_denoiser.cpp
+//       mfnr/rk_bayerwdr.cpp mfnr/host/dma/dma.cpp mfnr/host/cpu/cpu.cpp
+//       mfnr/host/cpu/isa_avx2.cpp -lpthread
+//
+// RK_CpuGetL2Size() sizes the Enhancer tile (classMFNR::TilePick) from
+// the L2 of the core, as reported by the C library.
+//
+#pragma once
+#ifndef _RK_HOST_CPU_H
+#define _RK_HOST_CPU_H
+
+#include <unistd.h>
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Macro Switch Setting
+//
+#ifndef MFNR_CPU_DISPATCH
+#define     MFNR_CPU_DISPATCH           0               // same default as rk_global.h
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Type Defines
+//
+// CPU level, ordered: every level includes the ones before it
+enum RK_CpuLevel
+{
+    RK_CPU_BASE         = 0,    // x86-64 baseline
+    RK_CPU_AVX2         = 1,    // AVX2
+
+    RK_CPU_LEVEL_NUM
+};
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Macro Definition
+//
+// MFNR_ISA is defined (to avx2) only by the clone TUs
+#define     RK_CPU_NS(isa)              RK_CPU_NS_(isa)
+#define     RK_CPU_NS_(isa)             mfnr_##isa
+
+#if MFNR_CPU_DISPATCH == 1 && defined(MFNR_ISA)
+
+// clone TU: wrap definitions & prototypes, no further dispatch
+#define     MFNR_ISA_BEGIN              namespace RK_CPU_NS(MFNR_ISA) {
+#define     MFNR_ISA_END                }
+#define     RK_CPU_CLONES(func)
+#define     RK_CPU_DISPATCH(func, args)
+
+#elif MFNR_CPU_DISPATCH == 1
+
+// baseline TU: declare the clones of func, forward to one of them
+#define     MFNR_ISA_BEGIN
+#define     MFNR_ISA_END
+#define     RK_CPU_CLONES(func)                                         \
+    namespace mfnr_avx2     { decltype(::func) func; }
+#define     RK_CPU_DISPATCH(func, args)                                 \
+    switch (RK_CpuGetLevel())                                           \
+    {                                                                   \
+    case RK_CPU_AVX2:       return mfnr_avx2::func args;                \
+    default:                break;                                      \
+    }
+
+#else
+
+#define     MFNR_ISA_BEGIN
+#define     MFNR_ISA_END
+#define     RK_CPU_CLONES(func)
+#define     RK_CPU_DISPATCH(func, args)
+
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Function Declaration
+//
+// CPU level of this process: cpuid, lowered by MFNR_CPU (read once)
+int RK_CpuGetLevel(void);
+
+// L2 size of one core (Bytes), 0 if unknown
+static inline int RK_CpuGetL2Size(void)
+{
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    long    nSize = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    return nSize > 0 ? (int)nSize : 0;
+#else
+    return 0;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+#endif // _RK_HOST_CPU_H
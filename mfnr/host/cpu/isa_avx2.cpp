@@ -0,0 +1,36 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: isa_avx2.cpp
+// Desc: AVX2 clone of the Register, Denoiser & BayerWDR kernels
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// Compiles the three kernel sources again for AVX2 hosts, inside namespace
+// mfnr_avx2 (see cpu.h). Empty unless MFNR_CPU_DISPATCH == 1.
+//
+#define     MFNR_ISA                    avx2            // namespace & vec-c mapping of this clone
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Header files
+//
+#include "rk_global.h"                  // MFNR_CPU_DISPATCH
+
+#if MFNR_CPU_DISPATCH == 1
+
+// library headers before the pragma: their inline code keeps the baseline target
+#include <assert.h>
+#include <immintrin.h>
+
+#pragma GCC target("avx2")
+
+#include "rk_register.cpp"
+#include "rk_denoiser.cpp"
+#include "rk_bayerwdr.cpp"
+
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,374 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: dma.cpp
+// Desc: Host software backend of the XM4 rdma transfer API
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+////-------- Header files
+//
+#include "dma.h"
+#include "cpu/cpu.h"
+
+#include <string.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define     RDMA_SIMD                   1               // SSSE3 row converters, always
+#define     RDMA_SIMD_TARGET
+#elif MFNR_CPU_DISPATCH == 1 && (defined(__x86_64__) || defined(__i386__))
+#include <tmmintrin.h>
+#define     RDMA_SIMD                   2               // SSSE3 row converters from RK_CPU_AVX2 up (cpu/cpu.h)
+#define     RDMA_SIMD_TARGET            __attribute__((target("avx2")))
+#else
+#define     RDMA_SIMD                   0               // scalar row converters
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Copy Worker
+//
+// One thread drains the descriptor queue in issue order. Tickets are the
+// 1-based issue index, so "done >= pos" means transfer #pos has landed.
+// Every calling thread gets its own worker (its own DMA channel), so
+// engines running on different threads never wait for each other.
+class classRdmaWorker
+{
+public:
+    classRdmaWorker() : mIssued(0), mDone(0), mQuit(false) {}
+    ~classRdmaWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQuit = true;
+        }
+        mCondWork.notify_all();
+        if (mThread.joinable())
+        {
+            mThread.join();
+        }
+    }
+
+    int  Issue(const rdma_info_t& info);
+    void Sync(int pos);
+
+private:
+    void Run();
+
+    std::mutex                  mMutex;
+    std::condition_variable     mCondWork;          // queue not empty / quit
+    std::condition_variable     mCondDone;          // mDone advanced
+    std::deque<rdma_info_t>     mQueue;             // pending descriptors
+    std::thread                 mThread;
+    int                         mIssued;            // tickets handed out
+    int                         mDone;              // tickets completed
+    bool                        mQuit;
+};
+
+static thread_local classRdmaWorker    g_rdmaWorker;
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Functions Definition
+//
+#if RDMA_SIMD != 0
+/************************************************************************/
+// Func: rdma_unpack_raw10_simd()
+// Desc: RAW10 line -> 16bit line, 8 pixels per step
+//   In: pBase          - [in] 4-pixel group holding the first pixel
+//       phase          - [in] first pixel in that group (0..3)
+//       num            - [in] pixel num
+//       shift          - [in] left shift applied to every pixel
+//  Out: pDst           - [out] 16bit pixels
+//       return         - pixels converted, the tail is left to the caller
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+static RDMA_SIMD_TARGET U32 rdma_unpack_raw10_simd(const U8* pBase, U32 phase, U16* pDst, U32 num, U32 shift)
+{
+    // 8 pixels = 10 bytes per step, read as one 16-byte load
+    U32         nBytes = (10 * (phase + num) + 7) >> 3;   // bytes covered by the line
+    U8          shuf[16];
+    U16         mult[8];
+    U32         i = 0;
+    for (int k=0; k < 8; k++)
+    {
+        U32 bit = 10 * (phase + k);
+        shuf[2*k+0] = (U8)(bit >> 3);
+        shuf[2*k+1] = (U8)((bit >> 3) + 1);
+        mult[k]     = (U16)(1 << (6 - (bit & 7)));          // (x << (6-s)) >> 6 == bits [s, s+10)
+    }
+    __m128i vShuf = _mm_loadu_si128((const __m128i*)shuf);
+    __m128i vMult = _mm_loadu_si128((const __m128i*)mult);
+    __m128i vShl  = _mm_cvtsi32_si128((int)shift);
+
+    for (; i + 8 <= num && (i >> 3) * 10 + 16 <= nBytes; i += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(pBase + (i >> 3) * 10));
+        v = _mm_shuffle_epi8(v, vShuf);
+        v = _mm_srli_epi16(_mm_mullo_epi16(v, vMult), 6);
+        v = _mm_sll_epi16(v, vShl);
+        _mm_storeu_si128((__m128i*)(pDst + i), v);
+    }
+    return i;
+
+} // rdma_unpack_raw10_simd()
+
+
+/************************************************************************/
+// Func: rdma_pack_raw10_simd()
+// Desc: 16bit line -> RAW10 line, whole 4-pixel groups, 8 pixels per step
+//   In: pSrc           - [in] 16bit pixels
+//       phase          - [in] group phase of pixel 0 (0..3)
+//       i              - [in] first pixel, (phase + i) is a group start
+//       num            - [in] pixel num
+//       shift          - [in] right shift applied to every pixel
+//  Out: pBase          - [out] 4-pixel group holding pixel 0
+//       return         - next pixel, the tail is left to the caller
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+static RDMA_SIMD_TARGET U32 rdma_pack_raw10_simd(const U16* pSrc, U8* pBase, U32 phase, U32 i, U32 num, U32 shift)
+{
+    // whole groups: 8 pixels -> 10 bytes, no neighbouring bits involved
+    __m128i vMask = _mm_set1_epi16(0x3FF);
+    __m128i vShr  = _mm_cvtsi32_si128((int)shift);
+    __m128i vMadd = _mm_set1_epi32(0x04000001);                     // p0 + p1*1024
+    __m128i vLo20 = _mm_set1_epi64x(0x00000000000FFFFFLL);
+    __m128i vHi20 = _mm_set1_epi64x(0x000000FFFFF00000LL);
+    __m128i vShuf = _mm_setr_epi8(0, 1, 2, 3, 4, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1);
+    for (; i + 8 <= num; i += 8)
+    {
+        U8      tmp[16];
+        __m128i v = _mm_loadu_si128((const __m128i*)(pSrc + i));
+        v = _mm_and_si128(_mm_srl_epi16(v, vShr), vMask);
+        v = _mm_madd_epi16(v, vMadd);                               // 4x 20bit pairs
+        v = _mm_or_si128(_mm_and_si128(v, vLo20),
+                         _mm_and_si128(_mm_srli_epi64(v, 12), vHi20)); // 2x 40bit groups
+        _mm_storeu_si128((__m128i*)tmp, _mm_shuffle_epi8(v, vShuf));
+        memcpy(pBase + ((10 * (phase + i)) >> 3), tmp, 10);
+    }
+    return i;
+
+} // rdma_pack_raw10_simd()
+#endif
+
+
+/************************************************************************/
+// Func: rdma_unpack_raw10()
+// Desc: RAW10 line -> 16bit line
+//   In: pSrc           - [in] byte holding the first pixel
+//       bitOffset      - [in] bit of the first pixel in *pSrc (0,2,4,6)
+//       num            - [in] pixel num
+//       shift          - [in] left shift applied to every pixel
+//  Out: pDst           - [out] 16bit pixels
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+void rdma_unpack_raw10(const U8* pSrc, U32 bitOffset, U16* pDst, U32 num, U32 shift)
+{
+    // 4-pixel group base: pixel k of the line sits at bit 10*(phase+k)
+    U32         phase = bitOffset >> 1;
+    const U8*   pBase = pSrc - phase;
+    U32         i = 0;
+
+#if RDMA_SIMD == 1
+    i = rdma_unpack_raw10_simd(pBase, phase, pDst, num, shift);
+#elif RDMA_SIMD == 2
+    if (RK_CpuGetLevel() >= RK_CPU_AVX2)
+    {
+        i = rdma_unpack_raw10_simd(pBase, phase, pDst, num, shift);
+    }
+#endif
+
+    for (; i < num; i++)
+    {
+        U32 bit = 10 * (phase + i);
+        U32 w   = pBase[bit >> 3] | (pBase[(bit >> 3) + 1] << 8);
+        pDst[i] = (U16)(((w >> (bit & 7)) & 0x3FF) << shift);
+    }
+
+} // rdma_unpack_raw10()
+
+
+/************************************************************************/
+// Func: rdma_pack_raw10()
+// Desc: 16bit line -> RAW10 line, bits outside the line are preserved
+//   In: pSrc           - [in] 16bit pixels
+//       bitOffset      - [in] bit of the first pixel in *pDst (0,2,4,6)
+//       num            - [in] pixel num
+//       shift          - [in] right shift applied to every pixel
+//  Out: pDst           - [out] byte holding the first pixel
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+void rdma_pack_raw10(const U16* pSrc, U8* pDst, U32 bitOffset, U32 num, U32 shift)
+{
+    U32         phase = bitOffset >> 1;
+    U8*         pBase = pDst - phase;
+    U32         i = 0;
+
+    // partial group at the head: read-modify-write
+    for (; i < num && ((phase + i) & 3); i++)
+    {
+        U32 bit  = 10 * (phase + i);
+        U32 s    = bit & 7;
+        U32 w    = pBase[bit >> 3] | (pBase[(bit >> 3) + 1] << 8);
+        w        = (w & ~(0x3FF << s)) | (((pSrc[i] >> shift) & 0x3FF) << s);
+        pBase[(bit >> 3) + 0] = (U8)w;
+        pBase[(bit >> 3) + 1] = (U8)(w >> 8);
+    }
+
+#if RDMA_SIMD == 1
+    i = rdma_pack_raw10_simd(pSrc, pBase, phase, i, num, shift);
+#elif RDMA_SIMD == 2
+    if (RK_CpuGetLevel() >= RK_CPU_AVX2)
+    {
+        i = rdma_pack_raw10_simd(pSrc, pBase, phase, i, num, shift);
+    }
+#endif
+
+    for (; i < num; i++)
+    {
+        U32 bit  = 10 * (phase + i);
+        U32 s    = bit & 7;
+        U32 w    = pBase[bit >> 3] | (pBase[(bit >> 3) + 1] << 8);
+        w        = (w & ~(0x3FF << s)) | (((pSrc[i] >> shift) & 0x3FF) << s);
+        pBase[(bit >> 3) + 0] = (U8)w;
+        pBase[(bit >> 3) + 1] = (U8)(w >> 8);
+    }
+
+} // rdma_pack_raw10()
+
+
+/************************************************************************/
+// Func: RdmaExecute()
+// Desc: Execute one descriptor
+//   In: info           - [in] transfer descriptor
+//  Out:
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+static void RdmaExecute(const rdma_info_t& info)
+{
+    const U8*   p_src = (const U8*)info.src_addr;
+    U8*         p_dst = (U8*)info.dst_addr;
+
+    for (U32 r=0; r < info.height; r++)
+    {
+        switch (info.transfer_mode)
+        {
+        case RDMA_10BIT_2_16BIT:
+            rdma_unpack_raw10(p_src, info.bit_offset, (U16*)p_dst, info.width, info.shift_num);
+            break;
+        case RDMA_16BIT_2_10BIT:
+            rdma_pack_raw10((const U16*)p_src, p_dst, info.bit_offset, info.width, info.shift_num);
+            break;
+        default: // RDMA_DIRECTION
+            memcpy(p_dst, p_src, info.width);
+            break;
+        }
+        p_src += info.src_stride;
+        p_dst += info.dst_stride;
+    }
+
+} // RdmaExecute()
+
+
+int classRdmaWorker::Issue(const rdma_info_t& info)
+{
+    int pos;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mThread.joinable())
+        {
+            mThread = std::thread(&classRdmaWorker::Run, this);
+        }
+        mQueue.push_back(info);
+        pos = ++mIssued;
+    }
+    mCondWork.notify_one();
+
+    return pos;
+}
+
+
+void classRdmaWorker::Sync(int pos)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (mDone < pos)
+    {
+        mCondDone.wait(lock);
+    }
+}
+
+
+void classRdmaWorker::Run()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    for (;;)
+    {
+        while (mQueue.empty() && !mQuit)
+        {
+            mCondWork.wait(lock);
+        }
+        if (mQueue.empty())
+        {
+            break; // quit
+        }
+        rdma_info_t info = mQueue.front();
+        lock.unlock();
+
+        RdmaExecute(info);
+
+        lock.lock();
+        mQueue.pop_front();
+        mDone++;
+        mCondDone.notify_all();
+    }
+}
+
+
+/************************************************************************/
+// Func: rdma_transf()
+// Desc: Queue a transfer on the copy worker
+//   In: pInfo          - [in] transfer descriptor (copied)
+//       useHwDMA       - [in] ignored, the host has no DMA engine
+//  Out: ticket for rdma_sync() on the same thread
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+int rdma_transf(rdma_info_t* pInfo, int useHwDMA)
+{
+    (void)useHwDMA;
+    return g_rdmaWorker.Issue(*pInfo);
+
+} // rdma_transf()
+
+
+/************************************************************************/
+// Func: rdma_sync()
+// Desc: Wait for a queued transfer
+//   In: pos            - [in] ticket returned by rdma_transf()
+//  Out:
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+void rdma_sync(int pos)
+{
+    g_rdmaWorker.Sync(pos);
+
+} // rdma_sync()
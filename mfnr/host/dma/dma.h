@@ -0,0 +1,96 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: dma.h
+// Desc: Host software backend of the XM4 rdma transfer API
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// Same descriptor and entry points as the XM4 SDK dma/dma.h, executed on a
+// copy worker thread. rdma_transf() queues a descriptor and returns its
+// ticket; rdma_sync() blocks until that ticket (and every earlier one) has
+// completed. Transfers are executed in issue order. Each calling thread
+// has its own worker and ticket sequence; a ticket is only valid for
+// rdma_sync() on the thread that issued it.
+//
+// Addresses are pointer-width (size_t), so 64-bit hosts can pass DDR and
+// DSP buffers directly.
+//
+// RAW10 layout in DDR: each row is a little-endian bit stream, pixel k of
+// a row occupies bits [10k, 10k+10). A row starting at pixel col therefore
+// starts at byte col*5/4, bit (col%4)*2 == bit_offset.
+//
+#pragma once
+#ifndef _RK_HOST_DMA_H
+#define _RK_HOST_DMA_H
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Header files
+//
+#include <stddef.h>
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Macro Switch Setting
+//
+#define     RDMA_HOST_BACKEND           1               // transfers complete asynchronously, rdma_sync() is required
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Type Defines
+//
+typedef     unsigned char           U8;             // u8bit
+typedef     unsigned short          U16;            // u16bit
+typedef     unsigned int            U32;            // u32bit
+
+// transfer mode
+enum rdma_transfer_mode
+{
+    RDMA_DIRECTION      = 0,    // byte copy, width in bytes
+    RDMA_10BIT_2_16BIT  = 1,    // RAW10 -> 16bit, width in pixels
+    RDMA_16BIT_2_10BIT  = 2     // 16bit -> RAW10, width in pixels
+};
+
+// transfer direction
+enum rdma_direction
+{
+    DIR_EXT_INT         = 0,    // DDR -> DSP
+    DIR_INT_EXT         = 1     // DSP -> DDR
+};
+
+// transfer descriptor
+typedef struct rdma_info
+{
+    size_t  src_addr;           // source pic addr
+    size_t  dst_addr;           // destin pic addr
+    U32     width;              // pixel num (bytes for RDMA_DIRECTION)
+    U32     height;             // row num
+    U32     src_stride;         // unit is byte
+    U32     dst_stride;         // unit is byte
+    U32     transfer_mode;      // enum rdma_transfer_mode
+    U32     shift_num;          // 10bit -> 16bit left shift / 16bit -> 10bit right shift
+    U32     bit_offset;         // first pixel bit offset of the 10bit line
+    U32     dsp_sel;            // unused on host
+    U32     dir;                // enum rdma_direction
+    U32     res[3];             // reserved
+} rdma_info_t;
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Function Declaration
+//
+// Queue a transfer, return its ticket
+int  rdma_transf(rdma_info_t* pInfo, int useHwDMA = 1);
+
+// Wait until transfer #pos has completed
+void rdma_sync(int pos);
+
+// Row converters used by the worker (also usable synchronously)
+void rdma_unpack_raw10(const U8* pSrc, U32 bitOffset, U16* pDst, U32 num, U32 shift);
+void rdma_pack_raw10(const U16* pSrc, U8* pDst, U32 bitOffset, U32 num, U32 shift);
+
+//////////////////////////////////////////////////////////////////////////
+
+#endif // _RK_HOST_DMA_H
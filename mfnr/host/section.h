@@ -0,0 +1,44 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: section.h
+// Desc: Host build of the XM4 memory section macros
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// On the XM4 these macros place code and data into the CODE/DATA sections
+// of proj/Debug/system.lsf. A host build (-Imfnr/host) has one flat address
+// space, so every section collapses to the default one.
+//
+#pragma once
+#ifndef _RK_HOST_SECTION_H
+#define _RK_HOST_SECTION_H
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Platform Switch
+//
+#define     RK_HOST_PLATFORM            1               // built against mfnr/host instead of the XM4 SDK
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Code Sections
+//
+#define     CODE_MFNR_EX                                // external code
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Data Sections
+//
+#define     DATA_MFNR_EX                                // external DDR data
+#define     DATA_MFNR_INT_DSP                           // internal DSP memory
+#define     DATA_WDR_INT_B0                             // internal DSP memory, block 0
+#define     DATA_WDR_INT_B1                             // internal DSP memory, block 1
+#define     DATA_WDR_INT_B2                             // internal DSP memory, block 2
+#define     DATA_WDR_INT_B3                             // internal DSP memory, block 3
+
+
+//////////////////////////////////////////////////////////////////////////
+
+#endif // _RK_HOST_SECTION_H
@@ -0,0 +1,611 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: vec-c.h
+// Desc: Host implementation of the XM4 vec-c intrinsics used by the
+//       register, denoiser and WDR-statistics kernels
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// Covers exactly what these kernels (and their helpers) need:
+//   FeatureDetect_Vec, FeatureCoarseMatching_Vec_vswsad,
+//   FeatureFineMatching_Vec_vswsad, MatchRowsSad, Scaler_Raw2Luma_Vec,
+//   wdrPreFilterBlock_Vec, CalcuHist_Vec, countFilter_Vec and the
+//   CEVA_CHIP_CODE_DENOISER branch of TemporalDenoise_Modify.
+// Vector code outside this set (wdr_process_block, weightFilter_Vec,
+// normalizeWeight_Vec, the homography kernels) is compiled out when
+// VEC_C_HOST is defined and the C models run instead.
+//
+// Vector registers are plain element arrays, so "*(ushort16*)p" is an
+// unaligned load exactly as on the XM4. Arithmetic is mapped to AVX2 when
+// the compiler targets it (-mavx2) or in a CPU clone TU (MFNR_ISA, see
+// cpu/cpu.h), otherwise to scalar loops. Each build of this header lives in
+// its own inline namespace, so the baseline copy and the clones of these
+// inline functions are never merged by the linker.
+//
+// Semantics follow the kernels' C models:
+//   vswsad            2 taps per call:  acc[i] += sum_t |s[i+so+t] - c[co+t]|
+//   vswmpy5/vswmac5   4 taps per call:  acc[i] += sum_t  s[i+so+t] * c[co+t]
+//                     (s = concat(src0, src1), so/co from SW_CONFIG,
+//                      psl returns (acc >> init_psh) truncated to 16bit)
+//   vldchk            even elements -> first, odd elements -> second
+//   vldov             four loads at p, p+1, p+2, p+3
+//   vhist/vpld(rel)   per-lane banks: bin b of lane i lives at [b*16 + i]
+//   predicates        bit i selects element i
+//
+#pragma once
+#ifndef _RK_HOST_VEC_C_H
+#define _RK_HOST_VEC_C_H
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Header files
+//
+#include <string.h>
+
+#if defined(__AVX2__) || defined(MFNR_ISA)        // #pragma GCC target does not define __AVX2__ in C++
+#include <immintrin.h>
+#define     VEC_C_HOST_AVX2             1               // AVX2 mapping
+#else
+#define     VEC_C_HOST_AVX2             0               // scalar mapping
+#endif
+
+#define     VEC_C_HOST                  1               // host vec-c layer in use
+
+#define     VEC_C_NS(isa)               VEC_C_NS_(isa)
+#define     VEC_C_NS_(isa)              vec_c_##isa
+#if defined(MFNR_ISA)
+inline namespace VEC_C_NS(MFNR_ISA) {                   // vec_c_avx2
+#else
+inline namespace vec_c_host {
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Instruction Modifiers
+//
+enum vec_c_accumulate_t { accumulate };
+enum vec_c_psl_t        { psl };
+enum vec_c_le_t         { le };
+enum vec_c_satu_t       { satu };
+enum vec_c_rnd_t        { rnd };
+enum vec_c_rel_t        { rel };
+enum vec_c_set_t        { set };
+enum vec_c_lsb_t        { lsb };
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Vector Types
+//
+template <typename T, int N>
+struct vec_c
+{
+    T   e[N];
+
+    enum { num_of_elements = N };
+
+    vec_c() {}
+    vec_c(T s)                                          // broadcast
+    {
+        for (int i=0; i < N; i++) e[i] = s;
+    }
+    template <typename U>
+    explicit vec_c(const vec_c<U, N>& v)                // per-element convert
+    {
+        for (int i=0; i < N; i++) e[i] = (T)v.e[i];
+    }
+
+    T&       operator[](int i)       { return e[i]; }
+    const T& operator[](int i) const { return e[i]; }
+
+    friend vec_c operator+(const vec_c& a, const vec_c& b)
+    {
+        vec_c r;
+        for (int i=0; i < N; i++) r.e[i] = (T)(a.e[i] + b.e[i]);
+        return r;
+    }
+    friend vec_c operator-(const vec_c& a, const vec_c& b)
+    {
+        vec_c r;
+        for (int i=0; i < N; i++) r.e[i] = (T)(a.e[i] - b.e[i]);
+        return r;
+    }
+    friend vec_c operator*(const vec_c& a, const vec_c& b)
+    {
+        vec_c r;
+        for (int i=0; i < N; i++) r.e[i] = (T)(a.e[i] * b.e[i]);
+        return r;
+    }
+    friend vec_c operator<<(const vec_c& a, int n)
+    {
+        vec_c r;
+        for (int i=0; i < N; i++) r.e[i] = (T)(a.e[i] << n);
+        return r;
+    }
+    friend vec_c operator>>(const vec_c& a, int n)
+    {
+        vec_c r;
+        for (int i=0; i < N; i++) r.e[i] = (T)(a.e[i] >> n);
+        return r;
+    }
+
+    friend vec_c vadd(const vec_c& a, const vec_c& b)   { return a + b; }
+
+    // element i = bit i of pr ? a : b
+    friend vec_c vselect(const vec_c& a, const vec_c& b, unsigned int pr)
+    {
+        vec_c r;
+        for (int i=0; i < N; i++) r.e[i] = ((pr >> i) & 1) ? a.e[i] : b.e[i];
+        return r;
+    }
+
+    // store elements whose mask bit is set
+    friend void vst(const vec_c& v, void* p, unsigned int mask)
+    {
+        const unsigned int full = (N >= 32) ? 0xFFFFFFFFu : ((1u << N) - 1);
+        if ((mask & full) == full)
+        {
+            memcpy(p, v.e, sizeof(v.e));
+            return;
+        }
+        for (int i=0; i < N; i++)
+        {
+            if ((mask >> i) & 1) ((T*)p)[i] = v.e[i];
+        }
+    }
+};
+
+typedef     vec_c<unsigned char,  32>   uchar32;
+typedef     vec_c<signed char,    32>   char32;
+typedef     vec_c<unsigned char,  16>   uchar16;
+typedef     vec_c<unsigned short, 16>   ushort16;
+typedef     vec_c<short,          16>   short16;
+typedef     vec_c<unsigned int,   16>   uint16;
+typedef     vec_c<int,            16>   int16;
+typedef     vec_c<unsigned int,    8>   uint8;
+typedef     vec_c<int,             8>   int8;
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- AVX2 helpers
+//
+#if VEC_C_HOST_AVX2
+static inline __m256i vec_c_ld(const void* p)       { return _mm256_loadu_si256((const __m256i*)p); }
+static inline void    vec_c_st(void* p, __m256i v)  { _mm256_storeu_si256((__m256i*)p, v); }
+
+// |a - b| of 16 x u16
+static inline __m256i vec_c_absdiff_u16(__m256i a, __m256i b)
+{
+    return _mm256_or_si256(_mm256_subs_epu16(a, b), _mm256_subs_epu16(b, a));
+}
+
+// acc(16 x u32) += zero-extended v(16 x u16)
+static inline void vec_c_acc_u16(unsigned int* acc, __m256i v)
+{
+    __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v));
+    __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1));
+    vec_c_st(acc + 0, _mm256_add_epi32(vec_c_ld(acc + 0), lo));
+    vec_c_st(acc + 8, _mm256_add_epi32(vec_c_ld(acc + 8), hi));
+}
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Load / Store
+//
+// a = p[0..15], b = p[1..16], c = p[2..17], d = p[3..18]
+static inline void vldov(const unsigned short* p, ushort16& a, ushort16& b, ushort16& c, ushort16& d)
+{
+    memcpy(a.e, p + 0, sizeof(a.e));
+    memcpy(b.e, p + 1, sizeof(b.e));
+    memcpy(c.e, p + 2, sizeof(c.e));
+    memcpy(d.e, p + 3, sizeof(d.e));
+}
+
+// even = p[0,2,..,30], odd = p[1,3,..,31]
+static inline void vldchk(const unsigned short* p, ushort16& even, ushort16& odd)
+{
+#if VEC_C_HOST_AVX2
+    const __m256i mask = _mm256_set1_epi32(0xFFFF);
+    __m256i v0 = vec_c_ld(p);
+    __m256i v1 = vec_c_ld(p + 16);
+    __m256i ev = _mm256_packus_epi32(_mm256_and_si256(v0, mask), _mm256_and_si256(v1, mask));
+    __m256i od = _mm256_packus_epi32(_mm256_srli_epi32(v0, 16), _mm256_srli_epi32(v1, 16));
+    vec_c_st(even.e, _mm256_permute4x64_epi64(ev, 0xD8));
+    vec_c_st(odd.e,  _mm256_permute4x64_epi64(od, 0xD8));
+#else
+    for (int i=0; i < 16; i++)
+    {
+        even.e[i] = p[2*i + 0];
+        odd.e[i]  = p[2*i + 1];
+    }
+#endif
+}
+
+static inline void vldchk(const int* p, int8& even, int8& odd)
+{
+    for (int i=0; i < 8; i++)
+    {
+        even.e[i] = p[2*i + 0];
+        odd.e[i]  = p[2*i + 1];
+    }
+}
+
+// table lookup: element i = pTable[idx[i]]
+static inline ushort16 vpld(const unsigned short* pTable, const short16& idx)
+{
+    ushort16 r;
+    for (int i=0; i < 16; i++) r.e[i] = pTable[(unsigned short)idx.e[i]];
+    return r;
+}
+
+// per-lane bank load: element i = p[idx[i]*16 + i]
+static inline short16 vpld(vec_c_rel_t, const short* p, const short16& idx)
+{
+    short16 r;
+    for (int i=0; i < 16; i++) r.e[i] = p[idx.e[i] * 16 + i];
+    return r;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Arithmetic
+//
+static inline ushort16 vabssub(const ushort16& a, const ushort16& b)
+{
+    ushort16 r;
+#if VEC_C_HOST_AVX2
+    vec_c_st(r.e, vec_c_absdiff_u16(vec_c_ld(a.e), vec_c_ld(b.e)));
+#else
+    for (int i=0; i < 16; i++) r.e[i] = (unsigned short)(a.e[i] > b.e[i] ? a.e[i] - b.e[i] : b.e[i] - a.e[i]);
+#endif
+    return r;
+}
+
+static inline ushort16 vabssub(const short16& a, const short16& b)
+{
+    ushort16 r;
+#if VEC_C_HOST_AVX2
+    __m256i va = vec_c_ld(a.e), vb = vec_c_ld(b.e);
+    vec_c_st(r.e, _mm256_sub_epi16(_mm256_max_epi16(va, vb), _mm256_min_epi16(va, vb)));
+#else
+    for (int i=0; i < 16; i++) r.e[i] = (unsigned short)(a.e[i] > b.e[i] ? a.e[i] - b.e[i] : b.e[i] - a.e[i]);
+#endif
+    return r;
+}
+
+// acc + |a - b|
+static inline uint16 vabssubacc(const ushort16& a, const ushort16& b, const uint16& acc)
+{
+    uint16 r = acc;
+#if VEC_C_HOST_AVX2
+    vec_c_acc_u16(r.e, vec_c_absdiff_u16(vec_c_ld(a.e), vec_c_ld(b.e)));
+#else
+    for (int i=0; i < 16; i++) r.e[i] += (a.e[i] > b.e[i] ? a.e[i] - b.e[i] : b.e[i] - a.e[i]);
+#endif
+    return r;
+}
+
+// acc + a * b
+static inline uint16 vmac(const ushort16& a, const ushort16& b, const uint16& acc)
+{
+    uint16 r;
+#if VEC_C_HOST_AVX2
+    __m256i va = vec_c_ld(a.e), vb = vec_c_ld(b.e);
+    __m256i lo = _mm256_mullo_epi16(va, vb);
+    __m256i hi = _mm256_mulhi_epu16(va, vb);
+    __m256i p0 = _mm256_unpacklo_epi16(lo, hi);         // elements 0-3, 8-11
+    __m256i p1 = _mm256_unpackhi_epi16(lo, hi);         // elements 4-7, 12-15
+    vec_c_st(r.e + 0, _mm256_add_epi32(vec_c_ld(acc.e + 0), _mm256_permute2x128_si256(p0, p1, 0x20)));
+    vec_c_st(r.e + 8, _mm256_add_epi32(vec_c_ld(acc.e + 8), _mm256_permute2x128_si256(p0, p1, 0x31)));
+#else
+    for (int i=0; i < 16; i++) r.e[i] = acc.e[i] + (unsigned int)a.e[i] * b.e[i];
+#endif
+    return r;
+}
+
+// (a * b + round) >> sh, saturated to s16
+static inline short16 vmpynorm(vec_c_rnd_t, const ushort16& a, const ushort16& b, const ushort16& sh)
+{
+    short16 r;
+    for (int i=0; i < 16; i++)
+    {
+        unsigned int s = sh.e[i] & 31;
+        unsigned long long v = (unsigned long long)a.e[i] * b.e[i];
+        if (s) v = (v + (1ULL << (s - 1))) >> s;
+        r.e[i] = (short)(v > 32767 ? 32767 : v);
+    }
+    return r;
+}
+
+// 16 x u32 -> 16 x u16, unsigned saturation
+static inline ushort16 vacccast(vec_c_satu_t, const uint16& v)
+{
+    ushort16 r;
+#if VEC_C_HOST_AVX2
+    __m256i p = _mm256_packus_epi32(_mm256_min_epu32(vec_c_ld(v.e + 0), _mm256_set1_epi32(0xFFFF)),
+                                    _mm256_min_epu32(vec_c_ld(v.e + 8), _mm256_set1_epi32(0xFFFF)));
+    vec_c_st(r.e, _mm256_permute4x64_epi64(p, 0xD8));
+#else
+    for (int i=0; i < 16; i++) r.e[i] = (unsigned short)(v.e[i] > 0xFFFF ? 0xFFFF : v.e[i]);
+#endif
+    return r;
+}
+
+static inline short16 vshiftr(const short16& v, unsigned char n)
+{
+    short16 r;
+    for (int i=0; i < 16; i++) r.e[i] = (short)(v.e[i] >> n);
+    return r;
+}
+
+static inline short16 vmin(const short16& a, const short16& b)
+{
+    short16 r;
+    for (int i=0; i < 16; i++) r.e[i] = a.e[i] < b.e[i] ? a.e[i] : b.e[i];
+    return r;
+}
+
+static inline uint8 vmin(const uint8& a, const uint8& b)
+{
+    uint8 r;
+#if VEC_C_HOST_AVX2
+    vec_c_st(r.e, _mm256_min_epu32(vec_c_ld(a.e), vec_c_ld(b.e)));
+#else
+    for (int i=0; i < 8; i++) r.e[i] = a.e[i] < b.e[i] ? a.e[i] : b.e[i];
+#endif
+    return r;
+}
+
+static inline uint8 vmin(const uint8& a, const uint8& b, const uint8& c)
+{
+    return vmin(vmin(a, b), c);
+}
+
+static inline uint8 vmax(const uint8& a, const uint8& b)
+{
+    uint8 r;
+#if VEC_C_HOST_AVX2
+    vec_c_st(r.e, _mm256_max_epu32(vec_c_ld(a.e), vec_c_ld(b.e)));
+#else
+    for (int i=0; i < 8; i++) r.e[i] = a.e[i] > b.e[i] ? a.e[i] : b.e[i];
+#endif
+    return r;
+}
+
+static inline uint8 vmax(const uint8& a, const uint8& b, const uint8& c)
+{
+    return vmax(vmax(a, b), c);
+}
+
+// bit i = a[i] <= b[i]
+static inline unsigned int vcmp(vec_c_le_t, const ushort16& a, const ushort16& b)
+{
+    unsigned int pr = 0;
+    for (int i=0; i < 16; i++) pr |= (unsigned int)(a.e[i] <= b.e[i]) << i;
+    return pr;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Sliding Window
+//
+#define     VEC_C_SW_SRC_OFFSET(cfg)        (((cfg) >>  8) & 0x3f)
+#define     VEC_C_SW_COEFF_OFFSET(cfg)      (((cfg) >> 16) & 0x1f)
+#define     VEC_C_SW_INIT_PSH(cfg)          (((cfg) >>  0) & 0x3f)
+
+// s = concat(a, b), zero padded so every window stays in bounds
+struct vec_c_window
+{
+    unsigned short s[80];
+    vec_c_window(const ushort16& a, const ushort16& b)
+    {
+        memcpy(s +  0, a.e, sizeof(a.e));
+        memcpy(s + 16, b.e, sizeof(b.e));
+        memset(s + 32, 0, sizeof(s) - 32 * sizeof(s[0]));
+    }
+};
+
+// acc[i] += |s[i+so] - c[co]| + |s[i+so+1] - c[co+1]|
+static inline uint16 vswsad(vec_c_accumulate_t, const ushort16& a, const ushort16& b, const ushort16& c,
+                            unsigned int cfg, const uint16& acc)
+{
+    vec_c_window w(a, b);
+    unsigned int so = VEC_C_SW_SRC_OFFSET(cfg);
+    unsigned int co = VEC_C_SW_COEFF_OFFSET(cfg) & 15;
+    unsigned short c0 = c.e[co], c1 = c.e[(co + 1) & 15];
+    uint16 r = acc;
+#if VEC_C_HOST_AVX2
+    // each tap widened on its own: two 16bit differences can carry past 0xFFFF
+    vec_c_acc_u16(r.e, vec_c_absdiff_u16(vec_c_ld(w.s + so + 0), _mm256_set1_epi16((short)c0)));
+    vec_c_acc_u16(r.e, vec_c_absdiff_u16(vec_c_ld(w.s + so + 1), _mm256_set1_epi16((short)c1)));
+#else
+    for (int i=0; i < 16; i++)
+    {
+        unsigned int s0 = w.s[i + so], s1 = w.s[i + so + 1];
+        r.e[i] += (s0 > c0 ? s0 - c0 : c0 - s0) + (s1 > c1 ? s1 - c1 : c1 - s1);
+    }
+#endif
+    return r;
+}
+
+// r[i] = sum_t s[i+so+t] * c[co+t], t = 0..3
+static inline void vec_c_swmpy(const ushort16& a, const ushort16& b, const uchar32& c, unsigned int cfg, unsigned int* r)
+{
+    vec_c_window w(a, b);
+    unsigned int so = VEC_C_SW_SRC_OFFSET(cfg);
+    unsigned int co = VEC_C_SW_COEFF_OFFSET(cfg);
+#if VEC_C_HOST_AVX2
+    __m256i lo = _mm256_setzero_si256();
+    __m256i hi = _mm256_setzero_si256();
+    for (unsigned int t=0; t < 4; t++)
+    {
+        unsigned int k = co + t;
+        if (k >= 32 || c.e[k] == 0) continue;
+        __m256i vc = _mm256_set1_epi32(c.e[k]);
+        lo = _mm256_add_epi32(lo, _mm256_mullo_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(w.s + so + t + 0))), vc));
+        hi = _mm256_add_epi32(hi, _mm256_mullo_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(w.s + so + t + 8))), vc));
+    }
+    vec_c_st(r + 0, lo);
+    vec_c_st(r + 8, hi);
+#else
+    for (int i=0; i < 16; i++)
+    {
+        unsigned int sum = 0;
+        for (unsigned int t=0; t < 4; t++)
+        {
+            unsigned int k = co + t;
+            if (k < 32) sum += (unsigned int)w.s[i + so + t] * c.e[k];
+        }
+        r[i] = sum;
+    }
+#endif
+}
+
+static inline int16 vswmpy5(const ushort16& a, const ushort16& b, const uchar32& c, unsigned int cfg)
+{
+    unsigned int s[16];
+    int16 r;
+    vec_c_swmpy(a, b, c, cfg, s);
+    for (int i=0; i < 16; i++) r.e[i] = (int)s[i];
+    return r;
+}
+
+static inline uint16 vswmac5(vec_c_accumulate_t, const ushort16& a, const ushort16& b, const uchar32& c,
+                             unsigned int cfg, const uint16& acc)
+{
+    uint16 r;
+    vec_c_swmpy(a, b, c, cfg, r.e);
+    return r + acc;
+}
+
+static inline int16 vswmac5(vec_c_accumulate_t, const ushort16& a, const ushort16& b, const uchar32& c,
+                            unsigned int cfg, const int16& acc)
+{
+    return int16(vswmac5(accumulate, a, b, c, cfg, uint16(acc)));
+}
+
+static inline ushort16 vswmac5(vec_c_psl_t, const ushort16& a, const ushort16& b, const uchar32& c,
+                               unsigned int cfg, const uint16& acc)
+{
+    uint16 v = vswmac5(accumulate, a, b, c, cfg, acc) >> (int)VEC_C_SW_INIT_PSH(cfg);
+    return ushort16(v);
+}
+
+static inline short16 vswmac5(vec_c_psl_t, const ushort16& a, const ushort16& b, const uchar32& c,
+                              unsigned int cfg, const int16& acc)
+{
+    return short16(vswmac5(psl, a, b, c, cfg, uint16(acc)));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Permute / Pack
+//
+static inline uint8 vunpack_lo(const uint16& v) { uint8 r; memcpy(r.e, v.e + 0, sizeof(r.e)); return r; }
+static inline uint8 vunpack_hi(const uint16& v) { uint8 r; memcpy(r.e, v.e + 8, sizeof(r.e)); return r; }
+static inline int8  vunpack_lo(const int16& v)  { int8 r;  memcpy(r.e, v.e + 0, sizeof(r.e)); return r; }
+static inline int8  vunpack_hi(const int16& v)  { int8 r;  memcpy(r.e, v.e + 8, sizeof(r.e)); return r; }
+
+static inline uint16 vpack(const uint8& lo, const uint8& hi)
+{
+    uint16 r;
+    memcpy(r.e + 0, lo.e, sizeof(lo.e));
+    memcpy(r.e + 8, hi.e, sizeof(hi.e));
+    return r;
+}
+
+// element i = concat(a, b)[perm[i]]
+static inline short16 vperm(const short16& a, const short16& b, const uchar32& perm)
+{
+    short16 r;
+    for (int i=0; i < 16; i++)
+    {
+        unsigned int k = perm.e[i] & 31;
+        r.e[i] = k < 16 ? a.e[k] : b.e[k - 16];
+    }
+    return r;
+}
+
+// element i = concat(lo, hi)[idx[i] + off[i]]
+static inline ushort16 vlut(const ushort16& lo, const ushort16& hi, const char32& idx, const short16& off)
+{
+    ushort16 r;
+    for (int i=0; i < 16; i++)
+    {
+        unsigned int k = (unsigned int)(idx.e[i] + off.e[i]) & 31;
+        r.e[i] = k < 16 ? lo.e[k] : hi.e[k - 16];
+    }
+    return r;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Reductions
+//
+static inline void vintramax(const uint8& v, unsigned char mask, unsigned int& val, unsigned char& pr)
+{
+    val = 0; pr = 0;
+    for (int i=0; i < 8; i++) if (((mask >> i) & 1) && v.e[i] > val) val = v.e[i];
+    for (int i=0; i < 8; i++) if (((mask >> i) & 1) && v.e[i] == val) pr |= (unsigned char)(1 << i);
+}
+
+static inline void vintramin(const uint8& v, unsigned char mask, unsigned int& val, unsigned char& pr)
+{
+    val = 0xFFFFFFFF; pr = 0;
+    for (int i=0; i < 8; i++) if (((mask >> i) & 1) && v.e[i] < val) val = v.e[i];
+    for (int i=0; i < 8; i++) if (((mask >> i) & 1) && v.e[i] == val) pr |= (unsigned char)(1 << i);
+}
+
+static inline int vintrasum(const int8& v)
+{
+    int sum = 0;
+    for (int i=0; i < 8; i++) sum += v.e[i];
+    return sum;
+}
+
+static inline unsigned int vintrasum(const uint8& v)
+{
+    unsigned int sum = 0;
+    for (int i=0; i < 8; i++) sum += v.e[i];
+    return sum;
+}
+
+// element k = a[2k] + a[2k+1] + b[2k] + b[2k+1]
+static inline int8 vintrasum(const short16& a, const short16& b)
+{
+    int8 r;
+    for (int k=0; k < 8; k++) r.e[k] = a.e[2*k] + a.e[2*k + 1] + b.e[2*k] + b.e[2*k + 1];
+    return r;
+}
+
+// index of the first set bit from the lsb, 32 if none
+static inline int ffb(vec_c_set_t, vec_c_lsb_t, unsigned int x)
+{
+    for (int i=0; i < 32; i++) if ((x >> i) & 1) return i;
+    return 32;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Histogram
+//
+// count: p[idx[i]*16 + i] += 1
+static inline void vhist(short* p, const short16& idx, unsigned short mask)
+{
+    for (int i=0; i < 16; i++) if ((mask >> i) & 1) p[idx.e[i] * 16 + i] += 1;
+}
+
+// weight: p[idx[i]*16 + i] += v[i]
+static inline void vhist(const short16& v, int* p, const short16& idx, unsigned short mask)
+{
+    for (int i=0; i < 16; i++) if ((mask >> i) & 1) p[idx.e[i] * 16 + i] += v.e[i];
+}
+
+
+} // inline namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+#endif // _RK_HOST_VEC_C_H
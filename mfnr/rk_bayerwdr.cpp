@@ -33,6 +33,7 @@
 #include "rk_bayerwdr.h"     // BayerWDR
 #define 	COL_4		1
 
+MFNR_ISA_BEGIN
 
 DATA_MFNR_EX unsigned short cure_table[24][961] =
 {
@@ -124,15 +125,16 @@ int CopyBlockData(RK_U16* pSrc, RK_U16* pDst, int nWid, int nHgt, int nSrcStride
 // Date: Revised by yousf 20160824
 // 
 /*************************************************************************/
+RK_CPU_CLONES(wdr_process_block)
 CODE_MFNR_EX
 void wdr_process_block(
     int     x_base,         // [in] x of block in Raw
     int     y_base,         // [in] y of block in Raw
-    int     cols,           // [in] min(64, valid)
-    int     rows,           // [in] min(32, valid)
+    int     cols,           // [in] min(TileWid, valid) <= WDR_MAX_COLS
+    int     rows,           // [in] min(TileHgt, valid) <= WDR_MAX_ROWS
     int     statisticWidth,	// [in] (raw_width+128)/256+1 ceil((4164+128)/256)
-    int     stride,	        // [in] buffer stride         66
-    int     blockWidth,		// [in] picture stride        64
+    int     stride,	        // [in] buffer stride         TileWid+2: 66
+    int     blockWidth,		// [in] picture stride        TileWid:   64
     RK_U16* pPixel_padding, // [in] input buf             34x66*2B
     RK_U16* weightdata,	    // [in] thumb weight table,   9x256*2B
     RK_U16* scale_table,    // [in] tabale[expouse_times] 961*2B
@@ -141,6 +143,10 @@ void wdr_process_block(
     RK_U16* pLeftRight      // [in] 2 * 32x16*2B byte space   2K store 32 line left and right, align 16, actually 9 valid..
 						)         
 {
+    // host: AVX2 clone picked at startup (cpu/cpu.h)
+    RK_CPU_DISPATCH(wdr_process_block, (x_base, y_base, cols, rows, statisticWidth, stride, blockWidth,
+        pPixel_padding, weightdata, scale_table, pGainMat, pPixel_out, pLeftRight));
+
 	#ifdef __XM4__
 		PROFILER_START(rows, cols);
 	#endif	
@@ -170,17 +176,17 @@ void wdr_process_block(
 	#endif
 
 	#if WDR_C_MODEL
-		RK_U16 		left[32*16],right[32*16];
-		RK_U16 		light16[64];
-		RK_U16 		lindex16[64],lindex2_16[64];
-		RK_U16 		weight1[64];
-		RK_U16 		weight2[64];
-		RK_U16 		weight_phase0[64],weight[64];
-		RK_U16 		light16_bak[64];
-		RK_U16 		lindex16_bak[64],lindex2_16_bak[64];
-		RK_U16 		weight1_bak[64];
-		RK_U16 		weight2_bak[64];
-		RK_U16 		weight_phase0_bak[64],weight_bak[64];
+		RK_U16 		left[WDR_MAX_ROWS*16],right[WDR_MAX_ROWS*16];
+		RK_U16 		light16[WDR_MAX_COLS];
+		RK_U16 		lindex16[WDR_MAX_COLS],lindex2_16[WDR_MAX_COLS];
+		RK_U16 		weight1[WDR_MAX_COLS];
+		RK_U16 		weight2[WDR_MAX_COLS];
+		RK_U16 		weight_phase0[WDR_MAX_COLS],weight[WDR_MAX_COLS];
+		RK_U16 		light16_bak[WDR_MAX_COLS];
+		RK_U16 		lindex16_bak[WDR_MAX_COLS],lindex2_16_bak[WDR_MAX_COLS];
+		RK_U16 		weight1_bak[WDR_MAX_COLS];
+		RK_U16 		weight2_bak[WDR_MAX_COLS];
+		RK_U16 		weight_phase0_bak[WDR_MAX_COLS],weight_bak[WDR_MAX_COLS];
 		RK_U16 		*pLine1 = pPixel_padding + 1;                      
 		RK_U16 		*pLine2 = pPixel_padding + 1 + stride;             
 		RK_U16 		*pLine3 = pPixel_padding + 1 + 2*stride;           
@@ -620,6 +626,7 @@ void wdr_process_block(
 		#endif
 
 
+		#if WDR_VECC
 		// calcu the uBiYx
 		uBiY1[0] 		= (y_base+row) & 255;
 		uBiY1[1] 		= (y_base+row+1) & 255;
@@ -631,6 +638,8 @@ void wdr_process_block(
 		v1 = vmac3(psl, vFir1, uBiY0[0], vSnd1, uBiY1[0], (uint16) 0, (unsigned char)8);
 		v2 = vmac3(psl, vFir,  uBiY0[1], vSnd,  uBiY1[1], (uint16) 0, (unsigned char)8); 
 		v3 = vmac3(psl, vFir1, uBiY0[1], vSnd1, uBiY1[1], (uint16) 0, (unsigned char)8);
+		#endif
+
 	
 
 		#if WDR_VECC	
@@ -1434,20 +1443,41 @@ void set_char32(uchar32 &data, int offset)
 	data = *(uchar32*)chargroup;
 }
 
+/************************************************************************/
+// Func: wdrPreFilterBlock()
+// Desc: 3x3 light filter of a Thumb strip. The 1-pixel ring of the chunk
+//       (row 0 & BlockHeight-1, col 0 & BlockWidth-1) is never read: the
+//       edge rows are clamped and the edge cols run their own variant, the
+//       same result as replicating the strip edges into the ring
+//   In: pBaseRawData       - [in] Thumb chunk, strip at (1,1), stride BlockWidth
+//       BlockHeight        - [in] strip Hgt + 2
+//       BlockWidth         - [in] strip Wid + 2
+//  Out: p_dst              - [out] filtered strip, stride BlockWidth
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
 CODE_MFNR_EX
 void wdrPreFilterBlock( ushort *pBaseRawData, ushort *p_dst, int BlockHeight, int BlockWidth )
 {
 	RK_U16		*p1, *p2, *p3;
 	int			x,y;  
 	int 		ScaleDownlight = 0;
-
-	p1 = pBaseRawData;
-	p2 = pBaseRawData + BlockWidth;
-	p3 = pBaseRawData + 2 * BlockWidth;
+	int 		xLast = BlockWidth - 2;		// last col of the strip
 
 	for (y = 1; y < BlockHeight - 1 ; y++)
 	{
-		for (x = 1; x < BlockWidth - 1; x++)
+		// rows above & below, clamped to the strip
+		p2 = pBaseRawData + y * BlockWidth;
+		p1 = (y == 1)               ? p2 : p2 - BlockWidth;
+		p3 = (y == BlockHeight - 2) ? p2 : p2 + BlockWidth;
+
+		// left col: col 0 = col 1
+		x = 1;
+		ScaleDownlight	= 3 * p1[x] + p1[x + 1] + 6 * p2[x] + 2 * p2[x + 1] + 3 * p3[x] + p3[x + 1];
+		p_dst[ ( y - 1 ) * BlockWidth + x - 1 ] = ScaleDownlight >> 6;
+
+		for (x = 2; x < xLast; x++)
 		{
 
 			ScaleDownlight	= p1[x - 1] + 2 * p1[x] + p1[x + 1] + 2 * p2[x - 1] + 4 * p2[x] + 2 * p2[x + 1] + p3[x - 1] + 2 * p3[x] + p3[x + 1];
@@ -1456,11 +1486,13 @@ void wdrPreFilterBlock( ushort *pBaseRawData, ushort *p_dst, int BlockHeight, in
 
 			p_dst[ ( y - 1 ) * BlockWidth + x - 1 ] = ScaleDownlight;
 		}
-		p1 += BlockWidth;
-		p2 += BlockWidth;
-		p3 += BlockWidth;
+
+		// right col: col xLast+1 = col xLast
+		x = xLast;
+		ScaleDownlight	= p1[x - 1] + 3 * p1[x] + 2 * p2[x - 1] + 6 * p2[x] + p3[x - 1] + 3 * p3[x];
+		p_dst[ ( y - 1 ) * BlockWidth + x - 1 ] = ScaleDownlight >> 6;
 	}
-}
+} // wdrPreFilterBlock()
 
 CODE_MFNR_EX
 void CalcuHist( ushort *p_src, ushort *pcount_mat, uint *pweight_mat, int BlockHeight, int BlockWidth, int statisticWidth, int row )
@@ -1663,7 +1695,7 @@ void CalcuHistTranspose( ushort *p_src, ushort *pcount_mat, uint *pweight_mat, i
 			lindex = (ScaleDownlight + 1024) >> 11;
 			assert(lindex < 9);
 			idx = (x  - 1 + 16) >> 5;
-			idy = row * 32 + ((y - 1 + 16) >> 5);
+			idy = (row * 32 + y - 1 + 16) >> 5;
 
 			pcount_mat [(idy*statisticWidth + idx)*16 + lindex] = pcount_mat [(idy*statisticWidth + idx)*16 + lindex] + 1;
 
@@ -2244,12 +2276,12 @@ void CalcuHist_Vec( RK_U16 *p_src,       // <<![ in ]: data used to calculate hi
 #else
 
 	//Block0, aligned to 32 byte address
-	RK_U32 a = ( RK_U32 )( u16dstB0 );
+	RK_U32 a = ( RK_U32 )( RK_Addr )( u16dstB0 );
 	a = ( ( ( a + 31 ) >> 5 ) << 5 ) - a;
 	RK_S16 *p_u16dstB0 MEM_BLOCK(0) = u16dstB0 + ( a >> 1 );
 
 	//Block2
-	RK_U32 b = ( RK_U32 )( u16dstB1 );
+	RK_U32 b = ( RK_U32 )( RK_Addr )( u16dstB1 );
 	b = ( ( ( b + 31 ) >> 5 ) << 5 ) - b;
 	RK_S32	*p_u16dstB1 MEM_BLOCK(1) = u16dstB1 + ( b >> 2 );
 
@@ -2607,6 +2639,7 @@ void countFilter_Vec( RK_U16 *p_src,     // <<! [ in/out ]: pcount need to filte
 
 }
 
+#ifndef VEC_C_HOST // host builds keep the C weight filter and normalization
 CODE_MFNR_EX
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 // add by shm @2016.08.31
@@ -2997,3 +3030,7 @@ void normalizeWeight_Vec( RK_U16 *pcount,     // <<! [ in/out ]: pcount
 	}	
 
 }
+
+#endif // VEC_C_HOST
+
+MFNR_ISA_END
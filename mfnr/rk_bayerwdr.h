@@ -54,22 +54,37 @@
 
 #define     WDR_SIMU_DEBUG                      0 // debug the wdr only.
 #define     WDR_WEIGHT_TRANSPOSE                1 // SET wdr from thumb be 256lines x 16 ( 9 valid data).
+#if WDR_WEIGHT_TRANSPOSE
+#define     WDR_THUMB_TABLE_SIZE                (16 * 256) // Thumb Weight Table & Weight Mat: cell*16+bin
+#else
+#define     WDR_THUMB_TABLE_SIZE                (9 * 256)  // Thumb Weight Table & Weight Mat: bin*256+cell
+#endif
 
 #define     WDR_THUMB_TABLE_TR                  0
 
 
 
-#if 1
+#if !defined(VEC_C_HOST) // the host vec-c layer does not cover wdr_process_block
 	#define     WDR_VECC                           1
 #else
 	#define     WDR_VECC                           0
 #endif
-#ifdef  WIN32
+#if defined(WIN32) || defined(VEC_C_HOST)
 #define WDR_C_MODEL		    1
 #else
 #define WDR_C_MODEL		    0
 #endif
 
+// wdr_process_block() block bound: the vector code is written for 32x64,
+// the C model takes any Enhancer_Modify tile
+#if WDR_VECC
+#define WDR_MAX_ROWS        32
+#define WDR_MAX_COLS        64
+#else
+#define WDR_MAX_ROWS        256     // RAW_TILE_MAX_SIZE
+#define WDR_MAX_COLS        256     // RAW_TILE_MAX_SIZE
+#endif
+
 
 
 #define max_(a,b) ((a) > (b) ? (a) : (b))
@@ -120,8 +135,8 @@
 
 #endif
 
-extern RK_U16      g_BaseThumbBuf[409600];                         // Thumb data pointers
 
+MFNR_ISA_BEGIN
 void writeFile(RK_U16 *data, int Num, char* FileName);
 
 
@@ -204,11 +219,11 @@ int CopyBlockData(RK_U16* pSrc, RK_U16* pDst, int nWid, int nHgt, int nSrcStride
 void wdr_process_block(
     int     x_base,         // [in] x of block in Raw
     int     y_base,         // [in] y of block in Raw
-    int     cols,           // [in] min(64, valid)
-    int     rows,           // [in] min(32, valid)
+    int     cols,           // [in] min(TileWid, valid) <= WDR_MAX_COLS
+    int     rows,           // [in] min(TileHgt, valid) <= WDR_MAX_ROWS
     int     statisticWidth,	// [in] (raw_width+128)/256+1 ceil((4164+128)/256)
-    int     stride,	        // [in] buffer stride         66
-    int     blockWidth,		// [in] picture stride        64
+    int     stride,	        // [in] buffer stride         TileWid+2: 66
+    int     blockWidth,		// [in] picture stride        TileWid:   64
     RK_U16* pPixel_padding, // [in] input buf             34x66*2B
     RK_U16* weightdata,	    // [in] thumb weight table,   256*16*2B = 8K,  
     RK_U16* scale_table,    // [in] tabale[expouse_times] 961*2B
@@ -216,6 +231,8 @@ void wdr_process_block(
     RK_U16* pPixel_out,     // [out] WDR result           32x64*2B
     RK_U16* pLeftRight      // [in] 2 * 32x16*2B byte space   2K store 32 line left and right, align 16, actually 9 valid..
 						) ;
+
+MFNR_ISA_END
 //////////////////////////////////////////////////////////////////////////
 
 #endif // _RK_BAYER_WDR_H
@@ -18,6 +18,8 @@
 #define PATTERN_OFFSET	24
 #define SW_CONFIG(init_psh,num_filter,src_offset,coeff_offset,step,pattern)		(((init_psh) & 0x3f) << INIT_PSH_VAL | ((num_filter) & 0x7) << NUM_FILTER     | ((src_offset) & 0x3f) << SRC_OFFSET | ((coeff_offset) & 0x1f) << COEFF_OFFSET | ((step) & 0x7) << STEP | ((pattern) & 0xff) << PATTERN_OFFSET )				
 
+MFNR_ISA_BEGIN
+
 //////////////////////////////////////////////////////////////////////////
 ////-------- Functions Definition
 //
@@ -297,17 +299,23 @@ int TemporalDenoise(RK_U16* pRawBaseFilter, RK_RectExt rectBase, RK_F32* pBaseBl
 //       MotionDetectTable  - [in] Motion Detect Table
 //       fIspGain           - [in] ISP Gain
 //       nBlackLevel        - [in] Black Level
+//       nDstStride         - [in] RawDst stride (pixels), the Tile Wid
 //  Out: pRawDst            - [out] RawDst data pointer
 // 
 // Date: Revised by yousf 20160822
 // 
 /*************************************************************************/
+RK_CPU_CLONES(TemporalDenoise_Modify)
 CODE_MFNR_EX
 int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt rects[], 
     int nRawFileNum, int nBasePicNum, RK_F32* pRawBlkPoints[], 
     RK_U16 MotionDetectTable[], RK_F32 fIspGain, RK_S16 nBlackLevel[],
-    RK_U16* pRawDst)
+    RK_U16* pRawDst, int nDstStride)
 {
+    // host: AVX2 clone picked at startup (cpu/cpu.h)
+    RK_CPU_DISPATCH(TemporalDenoise_Modify, (pRawBlocksData, numBlocks, rects, nRawFileNum, nBasePicNum,
+        pRawBlkPoints, MotionDetectTable, fIspGain, nBlackLevel, pRawDst, nDstStride));
+
 #ifndef CEVA_CHIP_CODE_DENOISER
     //
     int     ret = 0; // return value
@@ -315,6 +323,7 @@ int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt r
     //
     RK_U16*     pTmpSrc = NULL;
     RK_U16*     pTmpDst = NULL;
+    RK_U16*     pBlkDst = NULL;     // Block#n in RawDst
     int         cntPixel;
 
     // Motion Detect Result
@@ -325,7 +334,7 @@ int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt r
     RK_U16      MD_Th;			    // Motion Detect Threshold
     RK_F32      dstValue;           // 
 
-    // Block Chunk Hgt
+    // Block Chunk Hgt: all Block rows of the Tile
     RK_U16      nBlkHgt;            
 
     // SubBlock Size of Chunk
@@ -341,7 +350,7 @@ int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt r
 
 
     //// RawDst Init <- RawBase
-    nBlkHgt = (RK_U16)MIN(RAW_BLK_SIZE, rects[nBasePicNum].rowUseful + rects[nBasePicNum].hgtUseful - pRawBlkPoints[nBasePicNum][0]);// Sub Block Hgt
+    nBlkHgt = (RK_U16)(rects[nBasePicNum].rowUseful + rects[nBasePicNum].hgtUseful - pRawBlkPoints[nBasePicNum][0]);// Chunk Hgt
     offsetBaseY = (RK_U16)(pRawBlkPoints[nBasePicNum][0] - rects[nBasePicNum].rowExtend); 
     offsetBaseX = (RK_U16)(pRawBlkPoints[nBasePicNum][1] - rects[nBasePicNum].colExtend); 
     pTmpSrc = pRawBlocksData[nBasePicNum] + offsetBaseY * rects[nBasePicNum].widExtend + offsetBaseX;
@@ -350,7 +359,7 @@ int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt r
     {
         memcpy(pTmpDst, pTmpSrc, sizeof(RK_U16) * rects[nBasePicNum].widUseful);
         pTmpSrc += rects[nBasePicNum].widExtend;
-        pTmpDst += RAW_BLK_SIZE * RAW_WIN_NUM;
+        pTmpDst += nDstStride;
     }
 
     for (int n=0; n < numBlocks; n++) // Block#n in Chunk
@@ -359,6 +368,8 @@ int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt r
         subBlkWid   = (RK_U16)MIN(RAW_BLK_SIZE, rects[nBasePicNum].colUseful + rects[nBasePicNum].widUseful - pRawBlkPoints[nBasePicNum][n*2+1]);// Sub Block Wid
         offsetBaseY = (RK_U16)(pRawBlkPoints[nBasePicNum][n*2+0] - rects[nBasePicNum].rowExtend); 
         offsetBaseX = (RK_U16)(pRawBlkPoints[nBasePicNum][n*2+1] - rects[nBasePicNum].colExtend); 
+        pBlkDst     = pRawDst + (RK_S32)(pRawBlkPoints[nBasePicNum][n*2+0] - rects[nBasePicNum].rowUseful) * nDstStride
+                    + (RK_S32)(pRawBlkPoints[nBasePicNum][n*2+1] - rects[nBasePicNum].colUseful);
         for (int r=0; r < subBlkHgt; r++)
         {
             for (int c=0; c < subBlkWid; c++)
@@ -403,7 +414,7 @@ int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt r
 
                         if (ABS_U16(baseFilterValue - refFilterValue) < MD_Th)
                         {
-                            *(pRawDst + r * RAW_BLK_SIZE * RAW_WIN_NUM + c + n*RAW_BLK_SIZE) += refValue;
+                            *(pBlkDst + r * nDstStride + c) += refValue;
                             cntPixel++;
                         }
 
@@ -411,17 +422,17 @@ int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt r
                 } // for k
                 
                 // IspGain 
-//                 dstValue  = *(pRawDst + r * RAW_BLK_SIZE * RAW_WIN_NUM + c + n*RAW_BLK_SIZE) * fIspGain;
+//                 dstValue  = *(pBlkDst + r * nDstStride + c) * fIspGain;
 //                 dstValue /= cntPixel;
 //                 dstValue  = dstValue - (fIspGain - 1) * nBlackLevel[r%2 * 2 + c%2] / 4;
-//                 *(pRawDst + r * RAW_BLK_SIZE * RAW_WIN_NUM + c + n*RAW_BLK_SIZE) = ROUND_U16(MIN(dstValue, 0x3FF)); // 2^10-1=0x3FF, 2^10*8-1=0x1FFF
+//                 *(pBlkDst + r * nDstStride + c) = ROUND_U16(MIN(dstValue, 0x3FF)); // 2^10-1=0x3FF, 2^10*8-1=0x1FFF
 
                 // Gain x8 for WDR-Input 
-                dstValue  = *(pRawDst + r * RAW_BLK_SIZE * RAW_WIN_NUM + c + n*RAW_BLK_SIZE) * WDR_GAIN;
+                dstValue  = *(pBlkDst + r * nDstStride + c) * WDR_GAIN;
                 dstValue /= cntPixel;
                 //dstValue  = dstValue - (WDR_GAIN - 1) * nBlackLevel[r%2 * 2 + c%2] / 4.0;
                 //dstValue  = MAX(dstValue, 0);
-                *(pRawDst + r * RAW_BLK_SIZE * RAW_WIN_NUM + c + n*RAW_BLK_SIZE) = ROUND_U16(MIN(dstValue, 0x1FFF));
+                *(pBlkDst + r * nDstStride + c) = ROUND_U16(MIN(dstValue, 0x1FFF));
 
             } // for c
         } // for r
@@ -449,9 +460,13 @@ int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt r
 
 	RK_U16* pAdjBase = NULL;
 	RK_U16* pAdjRef = NULL;
+	RK_U16* pBlkDst = NULL;         // Block#n in RawDst
 
+	RK_U16      offsetBaseY;        // offset
+	RK_U16      offsetBaseX;        // offset
 	RK_U16      offsetRefY;         // offset
 	RK_U16      offsetRefX;         // offset
+	int         nBaseStride = rects[0].widExtend;
 
 	ushort16 v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11;
 	ushort16 v12, v13, v14, v15, v16, v17, v18, v19, v20, v21, v22, v23;
@@ -474,14 +489,19 @@ int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt r
 
 	for (int n = 0; n < numBlocks; n++) // Block#n in Chunk
 	{
+		offsetBaseY = (RK_U16)(pRawBlkPoints[0][n * 2 + 0] - rects[0].rowExtend);
+		offsetBaseX = (RK_U16)(pRawBlkPoints[0][n * 2 + 1] - rects[0].colExtend);
+		pBlkDst = pRawDst + (RK_S32)(pRawBlkPoints[0][n * 2 + 0] - rects[0].rowUseful) * nDstStride
+			+ (RK_S32)(pRawBlkPoints[0][n * 2 + 1] - rects[0].colUseful);
+
 		//base frame 3 rows
-		pAdjBase = pRawBlocksData[0] + n * 32 + 2;
+		pAdjBase = pRawBlocksData[0] + (offsetBaseY - 2) * nBaseStride + (offsetBaseX - 2);
 		p0 = pAdjBase;
-		pAdjBase += 2 * 72;
+		pAdjBase += 2 * nBaseStride;
 		p1 = pAdjBase;
-		pAdjBase += 2 * 72;
+		pAdjBase += 2 * nBaseStride;
 		p2 = pAdjBase;
-		pAdjBase += 2 * 72;
+		pAdjBase += 2 * nBaseStride;
 		vldchk(p0, v0, v1);
 		vldchk(p1, v2, v3);
 		vldchk(p2, v4, v5);
@@ -780,18 +800,18 @@ int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt r
 			results1 = vperm(vout1, vout2, perm1);
 			results2 = vperm(vout1, vout2, perm2);
 
-			vst(results1, (short16*)(pRawDst + row * 64 + n * 32), 0xFFFF);
-			vst(results2, (short16*)(pRawDst + row * 64 + n * 32 + 16), 0xFFFF);
+			vst(results1, (short16*)(pBlkDst + row * nDstStride), 0xFFFF);
+			vst(results2, (short16*)(pBlkDst + row * nDstStride + 16), 0xFFFF);
 
 			++row;
 			//base frame 3 rows
-			pAdjBase = pRawBlocksData[0] + row * 72 + n * 32 + 2;
+			pAdjBase = pRawBlocksData[0] + (offsetBaseY - 2 + row) * nBaseStride + (offsetBaseX - 2);
 			p0 = pAdjBase;
-			pAdjBase += 2 * 72;
+			pAdjBase += 2 * nBaseStride;
 			p1 = pAdjBase;
-			pAdjBase += 2 * 72;
+			pAdjBase += 2 * nBaseStride;
 			p2 = pAdjBase;
-			pAdjBase += 2 * 72;
+			pAdjBase += 2 * nBaseStride;
 			vldchk(p0, v0, v1);
 			vldchk(p1, v2, v3);
 			vldchk(p2, v4, v5);
@@ -911,5 +931,4 @@ int RawDstNormalize(RK_RectExt rectBase, RK_F32 ispGain, RK_U16* pRawDstSum, RK_
 }
 //////////////////////////////////////////////////////////////////////////
 
-
-
+MFNR_ISA_END
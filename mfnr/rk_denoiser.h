@@ -38,6 +38,13 @@
 #define     RAW_BLK_EXTEND_COL      4               // Raw Block Extend Col of Block for DSPMalloc 4-PixelAlign
 #define     RAW_REF_EXTEND_ROW      9               // RawRef Hgt Win Border of Block for DSPMalloc
 #define     RAW_REF_EXTEND_COL      12              // RawRef Wid Win Border of Block for DSPMalloc 4-PixelAlign
+#define     RAW_TILE_MAX_SIZE       256             // Max Tile Hgt/Wid of Enhancer_Modify (classMFNR::TilePick)
+// pRawBlkChunks of a Tile: 32x64 -> (32+2*4)x(64+2*8); the RawRef Blocks of a bigger Tile spread 1/8 further (rotation, zoom)
+#define     RAW_TILE_CHUNK_HGT(h)   ((h) + 2*4 + ((h) - RAW_BLK_SIZE) / 8)
+#define     RAW_TILE_CHUNK_WID(w)   ((w) + 2*8 + MAX((w) - RAW_BLK_SIZE*RAW_WIN_NUM, 0) / 8)
+// Row-band rings of Enhancer_Modify (ControlParams useRowBand): full-width rows of every frame, each unpacked once
+#define     RAW_BAND_PAD_COL        32              // cols of 64 left & right of the Raw in a ring row (+TileWid right), 4-PixelAlign
+#define     RAW_BAND_SPREAD_ROWS    64              // ring rows beyond a Tile window: RawRef rows spread along a band (rotation)
 
 
 //#define     USE_MOTION_DETECT       1               // Motion Detect: 1-use Motion Detect, 0-not use
@@ -87,6 +94,7 @@ typedef struct tag_RK_NRMemory
 
 //////////////////////////////////////////////////////////////////////////
 ////-------- Function Declaration
+MFNR_ISA_BEGIN
 
 // Motion Detect Filter
 int MotionDetectFilter(RK_U16* pSrc, RK_RectExt rect, RK_U16* pDst);
@@ -107,11 +115,13 @@ int TemporalDenoise(RK_U16* pRawBaseFilter, RK_RectExt rectBase, RK_F32* pBaseBl
 int TemporalDenoise_Modify(RK_U16* pRawBlocksData[], int numBlocks, RK_RectExt rects[], 
     int nRawFileNum, int nBasePicNum, RK_F32* pRawBlkPoints[], 
     RK_U16 MotionDetectTable[], RK_F32 fIspGain, RK_S16 nBlackLevel[],
-    RK_U16* pRawDst);
+    RK_U16* pRawDst, int nDstStride);
 
 // Normalization
 int RawDstNormalize(RK_RectExt rectBase, RK_F32 ispGain, RK_U16* pRawDstSum, RK_U8* pRawDstWgt);
 
+MFNR_ISA_END
+
 //////////////////////////////////////////////////////////////////////////
 
 #endif // _RK_DENOISER_H
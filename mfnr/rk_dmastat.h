@@ -0,0 +1,90 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: rk_dmastat.h
+// Desc: DDR traffic & read amplification of the RKDMA_* calls
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// Switch: MFNR_DMA_STATS (rk_global.h, or -DMFNR_DMA_STATS=1)
+//   0 - RKDMA_* calls are not counted, no state is kept
+//   1 - every RKDMA_* call adds its DDR bytes, one descriptor and its rows
+//       to [site][role]; reads are also added to the frame they hit
+//
+// site = RK_DspMemStage of the call (rk_dspmem.h), role = which frame the
+// DDR address belongs to: BaseFrame, a RefFrame, or RawDst for writes.
+// DDR bytes of a RAW10 row are the bytes its bit stream spans.
+//
+// Host builds also keep a fetch counter per DDR byte of every raw & thumb
+// frame. nRawTouched/nThumbTouched are then the bytes fetched at least
+// once, and nRawFetchHist/nThumbFetchHist[n] the bytes fetched n times
+// (last bin: n or more). XM4 builds leave them 0.
+//
+// Amplification = fetched / frame size: how many times the burst reads
+// each DDR byte of its inputs on average.
+//
+#pragma once
+#ifndef _RK_DMASTAT_H
+#define _RK_DMASTAT_H
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Header files
+//
+#include "rk_typedef.h"                 // Type definition
+#include "rk_global.h"                  // Global definition
+#include "rk_dspmem.h"                  // DSP Memory stages
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Macro Definition
+//
+#define     DMA_FETCH_HIST_NUM      8               // fetch count bins: 0,1,...,6,>=7
+#if MFNR_DMA_STATS == 1 && defined(RK_HOST_PLATFORM)
+#define     DMA_FETCH_MAP           1               // per-byte fetch counters (host only)
+#else
+#define     DMA_FETCH_MAP           0
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Type Defines
+//
+////---- enum DmaRole
+enum RK_DmaRole
+{
+    DMA_ROLE_BASE = 0,                  // read of the BaseFrame (raw or thumb)
+    DMA_ROLE_REF,                       // read of a RefFrame (raw or thumb)
+    DMA_ROLE_DST,                       // write of RawDst
+
+    DMA_ROLE_NUM
+};
+
+////---- struct DmaCounter
+typedef struct tag_RK_DmaCounter
+{
+    RK_U64          nBytes;             // DDR bytes
+    RK_U32          nDescs;             // rdma descriptors
+    RK_U32          nRows;              // rows
+}RK_DmaCounter;
+
+////---- struct DmaStats
+typedef struct tag_RK_DmaStats
+{
+    RK_DmaCounter   site[DSPMEM_STAGE_NUM][DMA_ROLE_NUM];   // per call site & role
+    int             nFrames;                                // raw & thumb frames of the burst
+    RK_U32          nRawFrameSize;                          // DDR bytes of one raw frame
+    RK_U32          nThumbFrameSize;                        // DDR bytes of one thumb frame
+    RK_U64          nRawFetched[RK_MAX_FILE_NUM];           // DDR bytes read per raw frame
+    RK_U64          nThumbFetched[RK_MAX_FILE_NUM];         // DDR bytes read per thumb frame
+    RK_U64          nRawTouched[RK_MAX_FILE_NUM];           // distinct DDR bytes read (host)
+    RK_U64          nThumbTouched[RK_MAX_FILE_NUM];         // distinct DDR bytes read (host)
+    RK_U64          nRawFetchHist[DMA_FETCH_HIST_NUM];      // raw bytes by fetch count (host)
+    RK_U64          nThumbFetchHist[DMA_FETCH_HIST_NUM];    // thumb bytes by fetch count (host)
+}RK_DmaStats;
+
+
+//////////////////////////////////////////////////////////////////////////
+
+#endif // _RK_DMASTAT_H
@@ -0,0 +1,349 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: rk_dspmem.h
+// Desc: DSP Memory Array usage: per-stage peaks & labeled memory map
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// dspMemoryArray is a stack arena (RK_DspArena). Every chunk is carved out by
+// RK_DspArenaAlloc() / classMFNR::DspAlloc<T>() on a DSPMEM_ALIGN boundary,
+// which records [offset, size, stage, label] and the high-water mark per
+// stage. On overflow the call returns NULL, the first failing request is
+// kept, later requests fail too, and the caller returns
+// MFNR_ERR_DSP_MEM_OVERFLOW after the allocation group:
+//
+//     pA = DspAlloc<RK_U16>(nNum, "pA");
+//     pB = DspAlloc<RK_U32>(nNum, "pB");
+//     if (RK_DspArenaFailed(&mDspArena)) { ... }
+//
+// Lifetimes are stack scopes: classDspMemScope rewinds the arena (and its
+// stage) to where it was created when it goes out of scope; Mark() keeps
+// what is allocated so far and Rewind() drops what came after, e.g. the
+// scratch of one Register step before the next one starts.
+//
+// The whole layout is built once by classMFNR::DspMemPlan() in MFNR_Init:
+// chunk sizes only depend on mRawWid/mRawHgt/mRawFileNum and the tile
+// constants, so a configuration that does not fit is rejected there, before
+// any DMA, and MFNR_Process only uses the precomputed pointers.
+//
+// The one data-dependent size is the Ref window of an Enhancer Tile: its
+// spread follows the Homography. It is checked against its pRawBlkChunks
+// chunk per Tile, before the DMA; one that does not fit is recorded by
+// RK_DspArenaOverrun() and MFNR_Process returns MFNR_ERR_DSP_MEM_OVERFLOW.
+// The chunk is named by the map index RK_DspArenaLastBlock() gave right
+// after its allocation: scopes rewind, so an offset is no unique name.
+// With MFNR_DSPMEM_GUARD (host default) each of these chunks is followed
+// by DSPMEM_GUARD_SIZE guard bytes, set by RK_DspGuardSet() and checked by
+// RK_DspGuardCheck() once the DMA of the Tile is done: a write past the
+// chunk that slipped through is an overrun with nOverrunGuard set.
+//
+// Offsets are relative to dspMemoryArray. Scopes rewind, so blocks of
+// different stages overlap in the map.
+//
+#pragma once
+#ifndef _RK_DSPMEM_H
+#define _RK_DSPMEM_H
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Header files
+//
+#include "rk_typedef.h"                 // Type definition
+#include "rk_global.h"                  // Global definition
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Macro Definition
+//
+#define     DSPMEM_MAX_BLOCK        (64 + 16 * RK_MAX_FILE_NUM) // max recorded blocks, later blocks only count in peaks; a burst takes ~47 + 11 a frame
+#define     DSPMEM_ALIGN            64              // chunk alignment (Bytes): vector loads & DMA bursts
+#if MFNR_DSPMEM_GUARD == 1
+#define     DSPMEM_GUARD_SIZE       64              // guard Bytes after a guarded chunk
+#else
+#define     DSPMEM_GUARD_SIZE       0
+#endif
+#define     DSPMEM_GUARD_BYTE       0xA5            // guard pattern: 0xA5A5 is no 10bit pixel
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Type Defines
+//
+////---- enum DspMemStage
+enum RK_DspMemStage
+{
+    DSPMEM_PROCESS = 0,                 // MFNR_Process: pHomographyMatrix & pWdrThumbWgtTable (kept to the end)
+    DSPMEM_THUMB_BUILD,                 // ThumbBuild: ThumbSrcs from RawSrcs (pThumbSrcs[k] NULL)
+    DSPMEM_REG_FEATURE_DETECT,          // Register Step 1: Feature Detect & WDR Weight Mats
+    DSPMEM_REG_PYRAMID,                 // Register Step 3: PyramidBuild (usePyramidMatch)
+    DSPMEM_REG_COARSE_MATCH,            // Register Step 3: Thumb Coarse Matching
+    DSPMEM_REG_FINE_MATCH,              // Register Step 4: Luma Fine Matching
+    DSPMEM_REG_HOMOGRAPHY,              // Register Step 5: Compute Homography
+    DSPMEM_ENHANCER,                    // Enhancer / Enhancer_Modify
+
+    DSPMEM_STAGE_NUM
+};
+
+////---- struct DspMemBlock
+typedef struct tag_RK_DspMemBlock
+{
+    const char*     pLabel;             // member name of the chunk
+    RK_S16          nIndex[2];          // array index of the chunk, -1 if unused
+    RK_U8           nStage;             // RK_DspMemStage
+    RK_U32          nOffset;            // offset in dspMemoryArray (Bytes)
+    RK_U32          nSize;              // requested size (Bytes), without padding
+}RK_DspMemBlock;
+
+////---- struct DspMemStats
+typedef struct tag_RK_DspMemStats
+{
+    RK_U32          nCapacity;                      // DSP_MEM_SIZE
+    RK_U32          nPeak;                          // high-water mark of the whole MFNR_Process
+    RK_U32          nStagePeak[DSPMEM_STAGE_NUM];   // high-water mark per stage
+    RK_U32          nBlockNum;                      // allocations (may exceed DSPMEM_MAX_BLOCK)
+    RK_DspMemBlock  blocks[DSPMEM_MAX_BLOCK];       // memory map in allocation order
+    RK_S32          nFailBlock;                     // index of the first overflowing call, -1 if none
+    RK_DspMemBlock  failBlock;                      // the first overflowing call
+    RK_S32          nOverrunBlock;                  // index of the first chunk asked past its size by MFNR_Process, -1 if none
+    RK_U32          nOverrunSize;                   // size (Bytes) that chunk was asked to hold, or held up to its overwritten guard
+    RK_U32          nOverrunGuard;                  // guard Bytes found overwritten (RK_DspGuardCheck), 0: rejected before the DMA
+}RK_DspMemStats;
+
+////---- struct DspArena
+typedef struct tag_RK_DspArena
+{
+    RK_U8*          pBase;              // dspMemoryArray, DSPMEM_ALIGN aligned
+    RK_U32          nCapacity;          // DSP_MEM_SIZE
+    RK_U32          nUsed;              // top of the stack (Bytes)
+    RK_U8           nStage;             // RK_DspMemStage of the next allocation
+    RK_DspMemStats  stats;              // memory map & peaks since RK_DspArenaReset()
+}RK_DspArena;
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Functions Definition
+//
+/************************************************************************/
+// Func: RK_DspArenaReset()
+// Desc: Empty the arena and its stats
+//   In: pBase              - DSP Memory Array
+//       nCapacity          - size of pBase (Bytes)
+//  Out: pArena
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+static inline void RK_DspArenaReset(RK_DspArena* pArena, RK_U8* pBase, RK_U32 nCapacity)
+{
+    memset(pArena, 0, sizeof(RK_DspArena));
+    pArena->pBase            = pBase;
+    pArena->nCapacity        = nCapacity;
+    pArena->nStage           = DSPMEM_PROCESS;
+    pArena->stats.nCapacity  = nCapacity;
+    pArena->stats.nFailBlock = -1;
+    pArena->stats.nOverrunBlock = -1;
+
+} // RK_DspArenaReset()
+
+
+/************************************************************************/
+// Func: RK_DspArenaAlloc()
+// Desc: Carve a DSPMEM_ALIGN aligned chunk at the top of the arena
+//   In: nSize              - chunk size (Bytes)
+//       pLabel             - chunk name for the memory map
+//       nIndex0, nIndex1   - chunk array index, -1 if unused
+//  Out: chunk pointer, NULL on overflow or after an earlier overflow
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+static inline RK_U8* RK_DspArenaAlloc(RK_DspArena* pArena, RK_U32 nSize, const char* pLabel, int nIndex0 = -1, int nIndex1 = -1)
+{
+    RK_DspMemStats* pStats = &pArena->stats;
+    RK_DspMemBlock  block;
+    RK_U32          nEnd;
+
+    if (pStats->nFailBlock >= 0)
+    {
+        return NULL;
+    }
+
+    block.pLabel    = pLabel;
+    block.nIndex[0] = (RK_S16)nIndex0;
+    block.nIndex[1] = (RK_S16)nIndex1;
+    block.nStage    = pArena->nStage;
+    block.nOffset   = ALIGN_SET(pArena->nUsed, DSPMEM_ALIGN);
+    block.nSize     = nSize;
+    if (pStats->nBlockNum < DSPMEM_MAX_BLOCK)
+    {
+        pStats->blocks[pStats->nBlockNum] = block;
+    }
+    pStats->nBlockNum++;
+    nEnd = block.nOffset + nSize;
+
+    // Peaks
+    if (nEnd > pStats->nPeak)
+    {
+        pStats->nPeak = nEnd;
+    }
+    if (nEnd > pStats->nStagePeak[pArena->nStage])
+    {
+        pStats->nStagePeak[pArena->nStage] = nEnd;
+    }
+
+    // Overflow: keep the first one
+    if (nEnd > pArena->nCapacity)
+    {
+        pStats->nFailBlock = pStats->nBlockNum - 1;
+        pStats->failBlock  = block;
+        return NULL;
+    }
+
+    pArena->nUsed = nEnd;
+    return pArena->pBase + block.nOffset;
+
+} // RK_DspArenaAlloc()
+
+
+/************************************************************************/
+// Func: RK_DspArenaFailed()
+// Desc: An allocation overflowed since RK_DspArenaReset()
+//   In: pArena
+//  Out: 1 - overflow, 0 - ok
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+static inline int RK_DspArenaFailed(const RK_DspArena* pArena)
+{
+    return pArena->stats.nFailBlock >= 0;
+
+} // RK_DspArenaFailed()
+
+
+/************************************************************************/
+// Func: RK_DspArenaLastBlock()
+// Desc: Map index of the last RK_DspArenaAlloc()
+//   In: pArena
+//  Out: index in stats.blocks, -1 if none
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+static inline int RK_DspArenaLastBlock(const RK_DspArena* pArena)
+{
+    return (int)pArena->stats.nBlockNum - 1;
+
+} // RK_DspArenaLastBlock()
+
+
+/************************************************************************/
+// Func: RK_DspArenaOverrun()
+// Desc: Record a chunk asked at runtime to hold more than its size, e.g.
+//       a data-dependent window; the first one is kept
+//   In: nBlock             - map index of the chunk, RK_DspArenaLastBlock()
+//                            after its allocation
+//       nSize              - size asked (Bytes), or chunk & guard size
+//       nGuard             - guard Bytes found overwritten, 0 if none
+//  Out: pArena->stats.nOverrunBlock & nOverrunSize & nOverrunGuard
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+static inline void RK_DspArenaOverrun(RK_DspArena* pArena, int nBlock, RK_U32 nSize, RK_U32 nGuard = 0)
+{
+    RK_DspMemStats* pStats = &pArena->stats;
+
+    if (pStats->nOverrunBlock >= 0)
+    {
+        return;
+    }
+    pStats->nOverrunBlock = nBlock;
+    pStats->nOverrunSize  = nSize;
+    pStats->nOverrunGuard = nGuard;
+
+} // RK_DspArenaOverrun()
+
+
+/************************************************************************/
+// Func: RK_DspGuardSet()
+// Desc: Write the guard bytes after a chunk allocated with
+//       DSPMEM_GUARD_SIZE more than nSize
+//   In: nSize              - chunk size (Bytes), without the guard
+//  Out: pChunk
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+static inline void RK_DspGuardSet(void* pChunk, RK_U32 nSize)
+{
+#if MFNR_DSPMEM_GUARD == 1
+    memset((RK_U8*)pChunk + nSize, DSPMEM_GUARD_BYTE, DSPMEM_GUARD_SIZE);
+#endif
+
+} // RK_DspGuardSet()
+
+
+/************************************************************************/
+// Func: RK_DspGuardCheck()
+// Desc: The guard bytes of RK_DspGuardSet() are intact
+//   In: pChunk
+//       nSize              - chunk size (Bytes), without the guard
+//  Out: 1 - overwritten, 0 - ok
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+static inline int RK_DspGuardCheck(const void* pChunk, RK_U32 nSize)
+{
+#if MFNR_DSPMEM_GUARD == 1
+    const RK_U8*    pGuard = (const RK_U8*)pChunk + nSize;
+
+    for (int i=0; i < DSPMEM_GUARD_SIZE; i++)
+    {
+        if (pGuard[i] != DSPMEM_GUARD_BYTE)
+        {
+            return 1;
+        }
+    }
+#endif
+    return 0;
+
+} // RK_DspGuardCheck()
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Class Definition
+// class DspMemScope: stack lifetime of the chunks allocated inside a scope
+class classDspMemScope
+{
+public:
+    // remember the arena top & stage
+    classDspMemScope(RK_DspArena* pArena)
+        : mpArena(pArena), mBegin(pArena->nUsed), mMark(pArena->nUsed), mStage(pArena->nStage) {}
+
+    // free everything allocated since the scope began
+    ~classDspMemScope()
+    {
+        mpArena->nUsed  = mBegin;
+        mpArena->nStage = mStage;
+    }
+
+    // keep what is allocated so far: later Rewind() stops here
+    void Mark(void)     { mMark = mpArena->nUsed; }
+
+    // free what was allocated since the last Mark()
+    void Rewind(void)   { mpArena->nUsed = mMark; }
+
+private:
+    RK_DspArena*    mpArena;            // arena
+    RK_U32          mBegin;             // arena top at scope begin
+    RK_U32          mMark;              // Rewind() position
+    RK_U8           mStage;             // stage at scope begin
+};
+
+
+//////////////////////////////////////////////////////////////////////////
+
+#endif // _RK_DSPMEM_H
@@ -28,8 +28,14 @@
 #define 	DEBUG_DMA_SW_HW 	0 // 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
 // HW-DMA
 //#define 	CEVA_CHIP_CODE
+// C-model Switch: -DMFNR_C_MODEL=1 builds the Register & Denoiser C models
+#ifndef MFNR_C_MODEL
+#define     MFNR_C_MODEL                0   // 1/0 C-model or vector Register & Denoiser kernels
+#endif
+#if MFNR_C_MODEL == 0
 #define 	CEVA_CHIP_CODE_REGISTER
 #define 	CEVA_CHIP_CODE_DENOISER
+#endif
 #define 	CEVA_CHIP_CODE_BAYERWDR
 
 
@@ -48,6 +54,36 @@
 #define     CEVA_XM4_DEBUG              1   // 1/0 for CEVA_XM4 IDE Debug-View
 ////-------- Debug Params Setting
 #define     MY_DEBUG_PRINTF             0   // for printf()  1 or 0
+////-------- Profile Switch Setting
+#ifndef MFNR_STAGE_PROFILE
+#define     MFNR_STAGE_PROFILE          0   // 1/0 per-stage timers & counters in MFNR_Process (rk_profile.h)
+#endif
+#ifndef MFNR_TRACE
+#define     MFNR_TRACE                  0   // 1/0 trace-event spans of tiles, features, DMA & kernels (rk_trace.h)
+#endif
+#ifndef MFNR_DMA_STATS
+#define     MFNR_DMA_STATS              0   // 1/0 DDR traffic & read amplification of the RKDMA_* calls (rk_dmastat.h)
+#endif
+////-------- DSP Memory Guard Switch Setting
+#ifndef MFNR_DSPMEM_GUARD
+#ifdef RK_HOST_PLATFORM
+#define     MFNR_DSPMEM_GUARD           1   // 1/0 guard words after the Enhancer Tile chunks, checked per Tile (rk_dspmem.h)
+#else
+#define     MFNR_DSPMEM_GUARD           0   // 1/0 guard words after the Enhancer Tile chunks, checked per Tile (rk_dspmem.h)
+#endif
+#endif
+////-------- Host CPU Dispatch Switch Setting
+#ifndef MFNR_CPU_DISPATCH
+#define     MFNR_CPU_DISPATCH           0   // 1/0 host: run the AVX2 clone of the hot kernels picked from cpuid (cpu/cpu.h)
+#endif
+#ifdef RK_HOST_PLATFORM
+#include "cpu/cpu.h"                    // RK_CPU_DISPATCH(), MFNR_ISA_BEGIN/END
+#else
+#define     MFNR_ISA_BEGIN
+#define     MFNR_ISA_END
+#define     RK_CPU_CLONES(func)
+#define     RK_CPU_DISPATCH(func, args)
+#endif
 
 //////////////////////////////////////////////////////////////////////////
 ////-------- Input Params Setting
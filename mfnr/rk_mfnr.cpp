@@ -12,7 +12,7 @@
 
 
 //// DSP Memory: 128KB
-DATA_MFNR_INT_DSP  RK_U8 	g_DspBuf[DSP_MEM_SIZE];
+DATA_MFNR_INT_DSP  RK_U8 	ALIGN(g_DspBuf[DSP_MEM_SIZE], DSPMEM_ALIGN);
 
 // classMFNR
 DATA_MFNR_EX 	classMFNR	g_mfnrProcessor;
@@ -341,7 +341,7 @@ DATA_MFNR_EX RK_U16 MotionDetectTable[MOTION_DETECT_TALBE_LEN] = {
 ////-------- Functions Definition
 //
 CODE_MFNR_EX
-int CopyThumbChunkBOUDER(RK_U32 srcAddr, RK_U32 dstAddr, int nWid, int nHgt, int nSrcStride, int nDstStride)
+int CopyThumbChunkBOUDER(RK_Addr srcAddr, RK_Addr dstAddr, int nWid, int nHgt, int nSrcStride, int nDstStride)
 {
     ////
     int     ret = 0; // return value
@@ -359,6 +359,213 @@ int CopyThumbChunkBOUDER(RK_U32 srcAddr, RK_U32 dstAddr, int nWid, int nHgt, int
     return ret;
 } // CopyBlockData()
 
+
+/************************************************************************/
+// Func: ChunkEdgeFill()
+// Desc: Refill a RawBlk Chunk clipped by the Raw edge with the init value,
+//       so the Extend rows & cols outside the Raw never hold the pixels of
+//       the last Tile (and the result does not depend on the Tile size)
+//   In: nChunkSize         - [in] Chunk capacity (RK_U16)
+//       pRect              - [in] Rect of the Chunk, Extend & Valid
+//  Out: pChunk             - [out] Chunk data pointer
+//       MFNR_ERR_DSP_MEM_OVERFLOW if the Rect does not fit nChunkSize,
+//       nothing written
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+CODE_MFNR_EX
+static int ChunkEdgeFill(RK_U16* pChunk, int nChunkSize, const RK_RectExt* pRect)
+{
+    int     nSize = pRect->hgtExtend * MAX(pRect->widExtend, pRect->strideExtend / (int)sizeof(RK_U16));
+
+    if (nSize > nChunkSize)
+    {
+        return MFNR_ERR_DSP_MEM_OVERFLOW;
+    }
+    if (pRect->hgtValid < pRect->hgtExtend || pRect->widValid < pRect->widExtend)
+    {
+        for (int i=0; i < nSize; i++)
+        {
+            pChunk[i] = 64;
+        }
+    }
+
+    return 0;
+} // ChunkEdgeFill()
+
+#if MFNR_DMA_STATS == 1
+/************************************************************************/
+// Func: classMFNR::DmaStatsReset()
+// Desc: Clear the DDR traffic counters before a burst, and on host
+//       allocate one fetch counter per DDR byte of every raw & thumb frame
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+void classMFNR::DmaStatsReset(void)
+{
+    memset(&mDmaStats, 0, sizeof(RK_DmaStats));
+    mDmaStats.nFrames         = mRawFileNum;
+    mDmaStats.nRawFrameSize   = mRawDataSize;
+    mDmaStats.nThumbFrameSize = mThumbDataSize;
+
+#if DMA_FETCH_MAP == 1
+    DmaStatsFree();
+    for (int k=0; k < mRawFileNum; k++)
+    {
+        pRawFetchMap[k]   = (RK_U8*)calloc(mRawDataSize, 1);
+        pThumbFetchMap[k] = (RK_U8*)calloc(mThumbDataSize, 1);
+    }
+#endif
+
+} // classMFNR::DmaStatsReset()
+
+
+/************************************************************************/
+// Func: classMFNR::DmaAccount()
+// Desc: Add one RKDMA_* call to the DDR traffic counters
+//   In: ddrAddr            - DDR address of the first row
+//       nRowBytes          - DDR bytes of one row
+//       nRows              - row num
+//       nStride            - DDR stride (Bytes)
+//       isWrite            - 0: DDR->DSP read of a Raw/Thumb frame, 1: write of RawDst
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+void classMFNR::DmaAccount(RK_Addr ddrAddr, int nRowBytes, int nRows, int nStride, int isWrite)
+{
+    //
+    RK_U8*          pAddr  = (RK_U8*)ddrAddr;
+    RK_U64          nBytes = (RK_U64)nRowBytes * nRows;
+    RK_DmaCounter*  pCounter;
+    RK_U64*         pFetched = NULL;
+    RK_U8*          pMap     = NULL;
+    RK_U8*          pFrame   = NULL;
+    RK_U32          nFrameSize = 0;
+    int             role = DMA_ROLE_DST;
+
+    // Frame of the address
+    for (int k=0; k < mRawFileNum && !isWrite && pFrame == NULL; k++)
+    {
+        if (pAddr >= (RK_U8*)pRawSrcs[k] && pAddr < (RK_U8*)pRawSrcs[k] + mRawDataSize)
+        {
+            pFrame     = (RK_U8*)pRawSrcs[k];
+            nFrameSize = mRawDataSize;
+            pFetched   = &mDmaStats.nRawFetched[k];
+#if DMA_FETCH_MAP == 1
+            pMap       = pRawFetchMap[k];
+#endif
+        }
+        else if (pAddr >= (RK_U8*)pThumbSrcs[k] && pAddr < (RK_U8*)pThumbSrcs[k] + mThumbDataSize)
+        {
+            pFrame     = (RK_U8*)pThumbSrcs[k];
+            nFrameSize = mThumbDataSize;
+            pFetched   = &mDmaStats.nThumbFetched[k];
+#if DMA_FETCH_MAP == 1
+            pMap       = pThumbFetchMap[k];
+#endif
+        }
+        if (pFrame != NULL)
+        {
+            role = (k == mBasePicNum) ? DMA_ROLE_BASE : DMA_ROLE_REF;
+        }
+    }
+    if (!isWrite && pFrame == NULL)
+    {
+        role = DMA_ROLE_REF; // outside every frame, only counted per site
+    }
+
+    // Site & role
+    pCounter = &mDmaStats.site[mDspArena.nStage][role];
+    pCounter->nBytes += nBytes;
+    pCounter->nDescs++;
+    pCounter->nRows  += nRows;
+
+    // Frame
+    if (pFetched != NULL)
+    {
+        *pFetched += nBytes;
+    }
+    if (pMap != NULL)
+    {
+        for (int r=0; r < nRows; r++)
+        {
+            RK_U32 nStart = (RK_U32)(pAddr - pFrame) + r * nStride;
+            RK_U32 nEnd   = MIN(nStart + nRowBytes, nFrameSize);
+            for (RK_U32 b=nStart; b < nEnd; b++)
+            {
+                pMap[b] += (pMap[b] < 255);
+            }
+        }
+    }
+
+} // classMFNR::DmaAccount()
+
+
+/************************************************************************/
+// Func: classMFNR::DmaStatsFinish()
+// Desc: Fold the fetch counters into touched bytes & fetch histograms
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+void classMFNR::DmaStatsFinish(void)
+{
+#if DMA_FETCH_MAP == 1
+    for (int k=0; k < mRawFileNum; k++)
+    {
+        if (pRawFetchMap[k] == NULL || pThumbFetchMap[k] == NULL)
+        {
+            continue;
+        }
+        for (int b=0; b < mRawDataSize; b++)
+        {
+            int n = MIN((int)pRawFetchMap[k][b], DMA_FETCH_HIST_NUM - 1);
+            mDmaStats.nRawFetchHist[n]++;
+            mDmaStats.nRawTouched[k] += (n > 0);
+        }
+        for (int b=0; b < mThumbDataSize; b++)
+        {
+            int n = MIN((int)pThumbFetchMap[k][b], DMA_FETCH_HIST_NUM - 1);
+            mDmaStats.nThumbFetchHist[n]++;
+            mDmaStats.nThumbTouched[k] += (n > 0);
+        }
+    }
+    DmaStatsFree();
+#endif
+
+} // classMFNR::DmaStatsFinish()
+
+
+#if DMA_FETCH_MAP == 1
+/************************************************************************/
+// Func: classMFNR::DmaStatsFree()
+// Desc: Free the per-byte fetch counters
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+void classMFNR::DmaStatsFree(void)
+{
+    for (int k=0; k < RK_MAX_FILE_NUM; k++)
+    {
+        free(pRawFetchMap[k]);
+        free(pThumbFetchMap[k]);
+        pRawFetchMap[k]   = NULL;
+        pThumbFetchMap[k] = NULL;
+    }
+
+} // classMFNR::DmaStatsFree()
+#endif
+#endif // MFNR_DMA_STATS == 1
+
+
 /************************************************************************/
 // Func: classMFNR::RKDMA_ReadThumb16bit2DSP()
 // Desc: transfer_mode = 0 // RDMA_DIRECTION
@@ -374,12 +581,43 @@ int CopyThumbChunkBOUDER(RK_U32 srcAddr, RK_U32 dstAddr, int nWid, int nHgt, int
 // 
 /*************************************************************************/
 CODE_MFNR_EX
-int classMFNR::RKDMA_ReadThumb16bit2DSP(U32 srcAddr, U32 dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col)
+int classMFNR::RKDMA_ReadThumb16bit2DSP(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col)
 {
     //
     int     ret = 0; // return value
     int pos;
 
+    pos = RKDMA_IssueThumb16bit2DSP(srcAddr, dstAddr, wid, hgt, srcStride, dstStride, col);
+    RKDMA_Sync(pos);
+
+    //
+    return ret;
+
+} // classMFNR::RKDMA_ReadThumb16bit2DSP()
+
+
+/************************************************************************/
+// Func: classMFNR::RKDMA_IssueThumb16bit2DSP()
+// Desc: transfer_mode = 0 // RDMA_DIRECTION, queued: the data is only
+//       in dstAddr after RKDMA_Sync() of the ticket (or of a later one)
+//   In: srcAddr            - src pointer value
+//       wid                - block data width
+//       hgt                - block data height
+//       srcStride          - src data Stride
+//       dstStride          - dst data Stride
+//       col                - block data col
+//  Out: dstAddr            - dst pointer value
+//       return             - rdma ticket, 0-already complete
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::RKDMA_IssueThumb16bit2DSP(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col)
+{
+    //
+    int pos;
+
     // DMA Info Struct
     rdma_info_t     rdmaInfo;
 
@@ -399,25 +637,33 @@ int classMFNR::RKDMA_ReadThumb16bit2DSP(U32 srcAddr, U32 dstAddr, U16 wid, U16 h
 
 #if DEBUG_DMA_SW_HW == 0 // 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
 
+    TRACE_BEGIN(mTrace, evXfer, "dma_read_thumb16", TRACE_TRACK_DMA);
+    TRACE_ARG(mTrace, evXfer, "wid", wid);
+    TRACE_ARG(mTrace, evXfer, "hgt", hgt);
+    TRACE_ARG(mTrace, evXfer, "slot", mTraceSlot);
+    TRACE_BEGIN(mTrace, evIssue, "dma_issue", TRACE_TRACK_DSP);
      pos = rdma_transf(&rdmaInfo); // DMA
-#ifdef CEVA_CHIP_CODE
-	rdma_sync(pos);
+    TRACE_END(mTrace, evIssue);
+#if MFNR_TRACE == 1
+    RKDMA_TracePending(evXfer, pos); // the DMA-track span ends in RKDMA_Sync()
 #endif
 
 #else// 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
 
 	pos = rdma_transf(&rdmaInfo, mUseHwDMA); // DMA
-	if (mUseHwDMA == 1)
+	if (mUseHwDMA != 1)
 	{
-		rdma_sync(pos);
+		pos = 0; // SW copy, done
 	}//*/
 
 #endif
-
+#if MFNR_DMA_STATS == 1
+    DmaAccount(srcAddr, wid * sizeof(U16), hgt, srcStride, 0); // DDR traffic
+#endif
     //
-    return ret;
+    return pos;
 
-} // classMFNR::RKDMA_ReadThumb16bit2DSP()
+} // classMFNR::RKDMA_IssueThumb16bit2DSP()
 
 
 /************************************************************************/
@@ -435,12 +681,43 @@ int classMFNR::RKDMA_ReadThumb16bit2DSP(U32 srcAddr, U32 dstAddr, U16 wid, U16 h
 // 
 /*************************************************************************/
 CODE_MFNR_EX
-int classMFNR::RKDMA_ReadRaw10bit2DSP(U32 srcAddr, U32 dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col)
+int classMFNR::RKDMA_ReadRaw10bit2DSP(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col)
 {
     //
     int     ret = 0; // return value
     int pos;
 
+    pos = RKDMA_IssueRaw10bit2DSP(srcAddr, dstAddr, wid, hgt, srcStride, dstStride, col);
+    RKDMA_Sync(pos);
+
+    //
+    return ret;
+
+} // classMFNR::RKDMA_ReadRaw10bit2DSP()
+
+
+/************************************************************************/
+// Func: classMFNR::RKDMA_IssueRaw10bit2DSP()
+// Desc: transfer_mode = 1 // RDMA_10BIT_2_16BIT, queued: the data is only
+//       in dstAddr after RKDMA_Sync() of the ticket (or of a later one)
+//   In: srcAddr            - src pointer value
+//       wid                - block data width
+//       hgt                - block data height
+//       srcStride          - src data Stride
+//       dstStride          - dst data Stride
+//       col                - block data col
+//  Out: dstAddr            - dst pointer value
+//       return             - rdma ticket, 0-already complete
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::RKDMA_IssueRaw10bit2DSP(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col)
+{
+    //
+    int pos;
+
     //      Bytes: 8 2+6 4+4 6+2 8
     //     Pixels: 8+2 6+4 4+6 2+8
     // bit_offset: 0   2   4   6
@@ -465,29 +742,190 @@ int classMFNR::RKDMA_ReadRaw10bit2DSP(U32 srcAddr, U32 dstAddr, U16 wid, U16 hgt
 
 #if DEBUG_DMA_SW_HW == 0 // 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
 
+    TRACE_BEGIN(mTrace, evXfer, "dma_read_raw10", TRACE_TRACK_DMA);
+    TRACE_ARG(mTrace, evXfer, "wid", wid);
+    TRACE_ARG(mTrace, evXfer, "hgt", hgt);
+    TRACE_ARG(mTrace, evXfer, "slot", mTraceSlot);
+    TRACE_BEGIN(mTrace, evIssue, "dma_issue", TRACE_TRACK_DSP);
      pos = rdma_transf(&rdmaInfo); // DMA
-#ifdef CEVA_CHIP_CODE
+    TRACE_END(mTrace, evIssue);
+#if MFNR_TRACE == 1
+    RKDMA_TracePending(evXfer, pos); // the DMA-track span ends in RKDMA_Sync()
+#endif
+
+#else// 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
+
+	pos = rdma_transf(&rdmaInfo, mUseHwDMA); // DMA
+	if (mUseHwDMA != 1)
+	{
+		pos = 0; // SW copy, done
+	}//*/
+
+#endif
+#if MFNR_DMA_STATS == 1
+    DmaAccount(srcAddr, (bit_offset + wid * 10 + 7) >> 3, hgt, srcStride, 0); // DDR traffic
+#endif
+    //
+    return pos;
+
+} // classMFNR::RKDMA_IssueRaw10bit2DSP()
+
+
+/************************************************************************/
+// Func: classMFNR::RKDMA_Sync()
+// Desc: Wait for a ticket of RKDMA_IssueRaw10bit2DSP() / RKDMA_IssueThumb16bit2DSP()
+//       and every transfer issued before it
+//   In: pos                - rdma ticket, 0-none
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+void classMFNR::RKDMA_Sync(int pos)
+{
+    if (pos == 0)
+    {
+        return;
+    }
+
+#if DEBUG_DMA_SW_HW == 0 // 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
+#if defined(CEVA_CHIP_CODE) || defined(RDMA_HOST_BACKEND)
+    TRACE_BEGIN(mTrace, evWait, "dma_wait", TRACE_TRACK_DSP);
+	rdma_sync(pos);
+    TRACE_END(mTrace, evWait);
+#endif
+#if MFNR_TRACE == 1
+    // transfers complete in issue order: every open span up to pos has landed
+    int nOpen = 0;
+    for (int n=0; n < mTraceXferNum; n++)
+    {
+        if (mTraceXferPos[n] <= pos)
+        {
+            TRACE_END(mTrace, mTraceXfers[n]);
+        }
+        else
+        {
+            mTraceXfers[nOpen]   = mTraceXfers[n];
+            mTraceXferPos[nOpen] = mTraceXferPos[n];
+            nOpen++;
+        }
+    }
+    mTraceXferNum = nOpen;
+#endif
+
+#else// 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
+
 	rdma_sync(pos);
+
+#endif
+
+} // classMFNR::RKDMA_Sync()
+
+
+#if MFNR_TRACE == 1
+/************************************************************************/
+// Func: classMFNR::RKDMA_TracePending()
+// Desc: Keep the DMA-track span of an issued transfer open until
+//       RKDMA_Sync() of its ticket; ended at once when RDMA_TRACE_PENDING
+//       spans are already open
+//   In: nEvent             - span of TRACE_BEGIN(), TRACE_TRACK_DMA
+//       pos                - rdma ticket of the transfer
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+void classMFNR::RKDMA_TracePending(int nEvent, int pos)
+{
+    if (mTraceXferNum < RDMA_TRACE_PENDING)
+    {
+        mTraceXfers[mTraceXferNum]   = nEvent;
+        mTraceXferPos[mTraceXferNum] = pos;
+        mTraceXferNum++;
+    }
+    else
+    {
+        TRACE_END(mTrace, nEvent);
+    }
+
+} // classMFNR::RKDMA_TracePending()
+#endif
+
+
+/************************************************************************/
+// Func: classMFNR::RKDMA_IssueRaw10Packed2DSP()
+// Desc: transfer_mode = 0 // RDMA_DIRECTION, RAW10 rows copied still packed
+//       (unpacked by the kernel that reads them), queued: the data is only
+//       in dstAddr after RKDMA_Sync() of the ticket (or of a later one)
+//   In: srcAddr            - src pointer value, 4-pixel group of col
+//       wid                - block data width (pixels)
+//       hgt                - block data height
+//       srcStride          - src data Stride
+//       dstStride          - dst data Stride
+//       col                - block data col, 4PixelAlign
+//  Out: dstAddr            - dst pointer value
+//       return             - rdma ticket, 0-already complete
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::RKDMA_IssueRaw10Packed2DSP(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col)
+{
+    //
+    int pos;
+
+    // DMA Info Struct
+    rdma_info_t     rdmaInfo;
+
+    rdmaInfo.src_addr       = srcAddr;              /* source pic addr */
+    rdmaInfo.dst_addr       = dstAddr;              /* destin pic addr */
+    rdmaInfo.width          = (wid * 10 + 7) >> 3;  /* byte num */
+    rdmaInfo.height         = hgt;				    /* row num */
+    rdmaInfo.src_stride     = srcStride; 		    /* unit is byte */
+    rdmaInfo.dst_stride     = dstStride;			/* unit is byte */
+    rdmaInfo.transfer_mode  = RDMA_DIRECTION;       /* enum rdma_transfer_mode */
+    rdmaInfo.shift_num      = 0;			        /* 10bit -> 16bit every pixel left shift num / 16bit -> 10bit every pixel right shift num */
+    rdmaInfo.bit_offset     = 0;                    /* 10bit -> 16bit src line first pixel bits offset / 16bit -> 10bit dst line first pixel bits offset */
+//     rdmaInfo.dsp_sel        = ; 
+     rdmaInfo.dir            = DIR_EXT_INT;
+//     rdmaInfo.res[3]         = ;
+
+
+#if DEBUG_DMA_SW_HW == 0 // 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
+
+    TRACE_BEGIN(mTrace, evXfer, "dma_read_raw10_packed", TRACE_TRACK_DMA);
+    TRACE_ARG(mTrace, evXfer, "wid", wid);
+    TRACE_ARG(mTrace, evXfer, "hgt", hgt);
+    TRACE_ARG(mTrace, evXfer, "slot", mTraceSlot);
+    TRACE_BEGIN(mTrace, evIssue, "dma_issue", TRACE_TRACK_DSP);
+     pos = rdma_transf(&rdmaInfo); // DMA
+    TRACE_END(mTrace, evIssue);
+#if MFNR_TRACE == 1
+    RKDMA_TracePending(evXfer, pos); // the DMA-track span ends in RKDMA_Sync()
 #endif
 
 #else// 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
 
 	pos = rdma_transf(&rdmaInfo, mUseHwDMA); // DMA
-	if (mUseHwDMA == 1)
+	if (mUseHwDMA != 1)
 	{
-		rdma_sync(pos);
+		pos = 0; // SW copy, done
 	}//*/
 
+#endif
+#if MFNR_DMA_STATS == 1
+    DmaAccount(srcAddr, rdmaInfo.width, hgt, srcStride, 0); // DDR traffic
 #endif
     //
-    return ret;
+    return pos;
 
-} // classMFNR::RKDMA_ReadRaw10bit2DSP()
+} // classMFNR::RKDMA_IssueRaw10Packed2DSP()
 
 
 /************************************************************************/
-// Func: classMFNR::RKDMA_WriteRaw16bit2DDR()
-// Desc: transfer_mode = 2 // RDMA_16BIT_2_10BIT
+// Func: classMFNR::RKDMA_WriteThumb16bit2DDR()
+// Desc: transfer_mode = 0 // RDMA_DIRECTION, DSP -> DDR
 //   In: srcAddr            - src pointer value
 //       wid                - block data width
 //       hgt                - block data height
@@ -496,33 +934,28 @@ int classMFNR::RKDMA_ReadRaw10bit2DSP(U32 srcAddr, U32 dstAddr, U16 wid, U16 hgt
 //       col                - block data col
 //  Out: dstAddr            - dst pointer value
 // 
-// Date: Revised by yousf 20160820
+// Date: Created 20261017
 // 
 /*************************************************************************/
 CODE_MFNR_EX
-int classMFNR::RKDMA_WriteRaw16bit2DDR(U32 srcAddr, U32 dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col)
+int classMFNR::RKDMA_WriteThumb16bit2DDR(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col)
 {
     //
     int     ret = 0; // return value
     int pos;
 
-    //      Bytes: 8 2+6 4+4 6+2 8
-    //     Pixels: 8+2 6+4 4+6 2+8
-    // bit_offset: 0   2   4   6
-    int bit_offset = col % 4 * 2;
-
     // DMA Info Struct
     rdma_info_t     rdmaInfo;
 
     rdmaInfo.src_addr       = srcAddr;              /* source pic addr */
     rdmaInfo.dst_addr       = dstAddr;              /* destin pic addr */
-    rdmaInfo.width          = wid;                  /* pixel num */
+    rdmaInfo.width          = wid * sizeof(U16);    /* byte num */
     rdmaInfo.height         = hgt;				    /* row num */
     rdmaInfo.src_stride     = srcStride; 		    /* unit is byte */
     rdmaInfo.dst_stride     = dstStride;			/* unit is byte */
-    rdmaInfo.transfer_mode  = RDMA_16BIT_2_10BIT;   /* enum rdma_transfer_mode */
+    rdmaInfo.transfer_mode  = RDMA_DIRECTION;       /* enum rdma_transfer_mode */
     rdmaInfo.shift_num      = 0;			        /* 10bit -> 16bit every pixel left shift num / 16bit -> 10bit every pixel right shift num */
-    rdmaInfo.bit_offset     = bit_offset;           /* 10bit -> 16bit src line first pixel bits offset / 16bit -> 10bit dst line first pixel bits offset */
+    rdmaInfo.bit_offset     = 0;                    /* 10bit -> 16bit src line first pixel bits offset / 16bit -> 10bit dst line first pixel bits offset */
 //     rdmaInfo.dsp_sel        = ; 
      rdmaInfo.dir            = DIR_INT_EXT;
 //     rdmaInfo.res[3]         = ;
@@ -530,10 +963,19 @@ int classMFNR::RKDMA_WriteRaw16bit2DDR(U32 srcAddr, U32 dstAddr, U16 wid, U16 hg
 
 #if DEBUG_DMA_SW_HW == 0 // 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
 
+    TRACE_BEGIN(mTrace, evXfer, "dma_write_thumb16", TRACE_TRACK_DMA);
+    TRACE_ARG(mTrace, evXfer, "wid", wid);
+    TRACE_ARG(mTrace, evXfer, "hgt", hgt);
+    TRACE_ARG(mTrace, evXfer, "slot", mTraceSlot);
+    TRACE_BEGIN(mTrace, evIssue, "dma_issue", TRACE_TRACK_DSP);
      pos = rdma_transf(&rdmaInfo); // DMA
-#ifdef CEVA_CHIP_CODE
+    TRACE_END(mTrace, evIssue);
+#if defined(CEVA_CHIP_CODE) || defined(RDMA_HOST_BACKEND)
+    TRACE_BEGIN(mTrace, evWait, "dma_wait", TRACE_TRACK_DSP);
 	rdma_sync(pos);
+    TRACE_END(mTrace, evWait);
 #endif
+    TRACE_END(mTrace, evXfer);
 
 #else// 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
 
@@ -543,18 +985,175 @@ int classMFNR::RKDMA_WriteRaw16bit2DDR(U32 srcAddr, U32 dstAddr, U16 wid, U16 hg
 		rdma_sync(pos);
 	}//*/
 
+#endif
+#if MFNR_DMA_STATS == 1
+    DmaAccount(dstAddr, wid * sizeof(U16), hgt, dstStride, 1); // DDR traffic
 #endif
 
     //
     return ret;
 
-} // classMFNR::RKDMA_WriteRaw16bit2DDR()
+} // classMFNR::RKDMA_WriteThumb16bit2DDR()
 
 
 /************************************************************************/
-// Func: classMFNR::MFNR_Init()
-// Desc: MFNR Init
-//   In: pInputParams   - [in] InputParams pointer
+// Func: classMFNR::RKDMA_WriteRaw16bit2DDR()
+// Desc: transfer_mode = 2 // RDMA_16BIT_2_10BIT
+//   In: srcAddr            - src pointer value
+//       wid                - block data width
+//       hgt                - block data height
+//       srcStride          - src data Stride
+//       dstStride          - dst data Stride
+//       col                - block data col
+//  Out: dstAddr            - dst pointer value
+// 
+// Date: Revised by yousf 20160820
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::RKDMA_WriteRaw16bit2DDR(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col)
+{
+    //
+    int     ret = 0; // return value
+    int pos;
+
+    //      Bytes: 8 2+6 4+4 6+2 8
+    //     Pixels: 8+2 6+4 4+6 2+8
+    // bit_offset: 0   2   4   6
+    int bit_offset = col % 4 * 2;
+
+    // DMA Info Struct
+    rdma_info_t     rdmaInfo;
+
+    rdmaInfo.src_addr       = srcAddr;              /* source pic addr */
+    rdmaInfo.dst_addr       = dstAddr;              /* destin pic addr */
+    rdmaInfo.width          = wid;                  /* pixel num */
+    rdmaInfo.height         = hgt;				    /* row num */
+    rdmaInfo.src_stride     = srcStride; 		    /* unit is byte */
+    rdmaInfo.dst_stride     = dstStride;			/* unit is byte */
+    rdmaInfo.transfer_mode  = RDMA_16BIT_2_10BIT;   /* enum rdma_transfer_mode */
+    rdmaInfo.shift_num      = 0;			        /* 10bit -> 16bit every pixel left shift num / 16bit -> 10bit every pixel right shift num */
+    rdmaInfo.bit_offset     = bit_offset;           /* 10bit -> 16bit src line first pixel bits offset / 16bit -> 10bit dst line first pixel bits offset */
+//     rdmaInfo.dsp_sel        = ; 
+     rdmaInfo.dir            = DIR_INT_EXT;
+//     rdmaInfo.res[3]         = ;
+
+
+#if DEBUG_DMA_SW_HW == 0 // 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
+
+    TRACE_BEGIN(mTrace, evXfer, "dma_write_raw10", TRACE_TRACK_DMA);
+    TRACE_ARG(mTrace, evXfer, "wid", wid);
+    TRACE_ARG(mTrace, evXfer, "hgt", hgt);
+    TRACE_ARG(mTrace, evXfer, "slot", mTraceSlot);
+    TRACE_BEGIN(mTrace, evIssue, "dma_issue", TRACE_TRACK_DSP);
+     pos = rdma_transf(&rdmaInfo); // DMA
+    TRACE_END(mTrace, evIssue);
+#if defined(CEVA_CHIP_CODE) || defined(RDMA_HOST_BACKEND)
+    TRACE_BEGIN(mTrace, evWait, "dma_wait", TRACE_TRACK_DSP);
+	rdma_sync(pos);
+    TRACE_END(mTrace, evWait);
+#endif
+    TRACE_END(mTrace, evXfer);
+
+#else// 0-Use CEVA_CHIP_CODE   1-Use flag_UseHwDMA
+
+	pos = rdma_transf(&rdmaInfo, mUseHwDMA); // DMA
+	if (mUseHwDMA == 1)
+	{
+		rdma_sync(pos);
+	}//*/
+
+#endif
+#if MFNR_DMA_STATS == 1
+    DmaAccount(dstAddr, (bit_offset + wid * 10 + 7) >> 3, hgt, dstStride, 1); // DDR traffic
+#endif
+
+    //
+    return ret;
+
+} // classMFNR::RKDMA_WriteRaw16bit2DDR()
+
+
+/************************************************************************/
+// Func: classMFNR::classMFNR()
+// Desc: Engine without DSP Memory; RK_MFNR_EngineProcess() binds it
+//   In: 
+//  Out: 
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+classMFNR::classMFNR(void)
+{
+    dspMemoryArray = NULL;
+    mDspMemSize    = 0;
+    mWdrScaleGain  = -1;
+    mTileHgt       = RAW_BLK_SIZE;
+    mTileWid       = RAW_BLK_SIZE * RAW_WIN_NUM;
+    mTileChunkSize = 0;
+    mUseRowBand    = 0;
+    mUseThumbStrip = 0;
+    mCoarseRefPitch = 0;
+    mUseFastMatch = 0;
+    mUsePyramid   = 0;
+    mThumbBuildMask = 0;
+    for (int k=0; k < RK_MAX_FILE_NUM; k++)
+    {
+        pThumbBufs[k] = NULL;
+        pPyrBufs[k]   = NULL;
+    }
+    RK_DspArenaReset(&mDspArena, NULL, 0);
+#if MFNR_TRACE == 1
+    memset(&mTrace, 0, sizeof(mTrace));
+    mTraceSlot     = 0;
+    mTraceXferNum  = 0;
+#endif
+#if DMA_FETCH_MAP == 1
+    for (int k=0; k < RK_MAX_FILE_NUM; k++)
+    {
+        pRawFetchMap[k]   = NULL;
+        pThumbFetchMap[k] = NULL;
+    }
+#endif
+
+} // classMFNR::classMFNR()
+
+
+/************************************************************************/
+// Func: classMFNR::~classMFNR()
+// Desc: Free the host-side buffers of the engine
+//   In: 
+//  Out: 
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+classMFNR::~classMFNR(void)
+{
+    for (int k=0; k < RK_MAX_FILE_NUM; k++)
+    {
+        free(pThumbBufs[k]);
+        pThumbBufs[k] = NULL;
+        free(pPyrBufs[k]);
+        pPyrBufs[k]   = NULL;
+    }
+#if MFNR_TRACE == 1
+    free(mTrace.pEvents);
+    mTrace.pEvents = NULL;
+#endif
+#if DMA_FETCH_MAP == 1
+    DmaStatsFree();
+#endif
+
+} // classMFNR::~classMFNR()
+
+
+/************************************************************************/
+// Func: classMFNR::MFNR_Init()
+// Desc: MFNR Init: geometry, Enhancer tile, DSP Memory layout & the first burst
+//   In: pInputParams   - [in] InputParams pointer
 //       pCtrlParams    - [in] ControlParams pointer
 //  Out: 
 // 
@@ -576,10 +1175,6 @@ int classMFNR::MFNR_Init(RK_InputParams* pInParams, RK_ControlParams* pCtrlParam
     //mRawStride      = ALIGN_4BYTE_WIDTH(mRawWid, RAW_BIT_COUNT);   // Raw10bit data Stride (Bytes, 4ByteAlign) in DDR
     mRawStride      = ALIGN_4PIXEL_WIDTH(mRawWid)*5/4;      // Raw10bit data Stride (4PixelAlign) in DDR
     mRawDataSize     = mRawHgt * mRawStride;                // Raw10bit data Size (Bytes)
-    for (int k=0; k < mRawFileNum; k++)                     // Thumb Srcs data pointers
-    {
-        pRawSrcs[k]   = (RK_U16*)pInParams->pRawSrcs[k];
-    }
 
     // Scaler
     mScaleRaw2Raw   = SCALER_FACTOR_R2R;                    // scale factor for Raw to Raw (for Preview)
@@ -591,26 +1186,12 @@ int classMFNR::MFNR_Init(RK_InputParams* pInParams, RK_ControlParams* pCtrlParam
     mThumbHgt       = mRawHgt / mScaleRaw2Thumb;	        // Thumb data height (floor)
     mThumbStride    = ALIGN_4BYTE_WIDTH(mThumbWid,THUMB_BIT_COUNT);// Thumb data Stride (Bytes, 4ByteAlign)
     mThumbDataSize  = mThumbHgt * mThumbStride;             // Thumb data Size (Bytes)
-    for (int k=0; k < mRawFileNum; k++)                     // Thumb Srcs data pointers
-    {
-        pThumbSrcs[k] = (RK_U16*)pInParams->pThumbSrcs[k];
-    }
-
-
-    // ISP Gain
-    mIspGain = pInParams->pRawInfo->fIspGain;
-    mBlackLevel[0] = pInParams->pRawInfo->nBlackLevel[0];
-    mBlackLevel[1] = pInParams->pRawInfo->nBlackLevel[1];
-    mBlackLevel[2] = pInParams->pRawInfo->nBlackLevel[2];
-    mBlackLevel[3] = pInParams->pRawInfo->nBlackLevel[3];
-
-
-    mUseHwDMA = pCtrlParams->useHwDMA;
-
-    //////////////////////////////////////////////////////////////////////////
-    // DSP Memory
-    mDspMem_UsedCount = 0;  // Method-2: use MemoryArray, DSP Memory Array Used Count
 
+    // Pyramid top
+    mPyrWid         = mThumbWid / SCALER_FACTOR_T2P;        // Pyramid top width  (floor)
+    mPyrHgt         = mThumbHgt / SCALER_FACTOR_T2P;        // Pyramid top height (floor)
+    mPyrStride      = ALIGN_4BYTE_WIDTH(mPyrWid,THUMB_BIT_COUNT);// Pyramid top Stride (Bytes, 4ByteAlign)
+    mPyrDataSize    = mPyrHgt * mPyrStride;                 // Pyramid top Size (Bytes)
 
     //////////////////////////////////////////////////////////////////////////
     
@@ -620,6 +1201,28 @@ int classMFNR::MFNR_Init(RK_InputParams* pInParams, RK_ControlParams* pCtrlParam
     mThumbDivSegRow     = mThumbHgt / mThumbFeatWinSize;    // number of Seg Row
     mBasePicNum         = BASE_PIC_NUM;                     // Base Picture Num
     mMaxNumFeature      = mThumbDivSegCol * mThumbDivSegRow;// Max Num of Feature
+    mUseThumbStrip      = pCtrlParams->useThumbStrip;       // kept by the bursts of a session
+    mUseFastMatch       = pCtrlParams->useFastMatch;
+    mUsePyramid         = pCtrlParams->usePyramidMatch      // a smaller top falls back to the Thumb window
+        && mPyrWid >= PYR_MATCH_WIN_SIZE && mPyrHgt >= PYR_MATCH_WIN_SIZE;
+
+    //////////////////////////////////////////////////////////////////////////
+    // Enhancer tile & DSP Memory: lay out every stage, reject a misfit before any DMA
+#if USE_MODIFY_ENHANCER == 1
+    mUseRowBand         = pCtrlParams->useRowBand;          // kept by the bursts of a session
+#endif
+    ret = TilePick(pCtrlParams->nTileHgt, pCtrlParams->nTileWid);
+    if (ret)
+    {
+#if MY_DEBUG_PRINTF == 1
+        printf("Failed to TilePick %dx%d !\n", pCtrlParams->nTileHgt, pCtrlParams->nTileWid);
+#endif
+        return ret;
+    }
+    mWdrScaleGain       = -1;                               // pWdrScaleTable not built yet
+
+    // first burst
+    ret = MFNR_SetBurst(pInParams, pCtrlParams);
 
     //
     return ret;
@@ -628,498 +1231,865 @@ int classMFNR::MFNR_Init(RK_InputParams* pInParams, RK_ControlParams* pCtrlParam
 
 
 /************************************************************************/
-// Func: classMFNR::Register()
-// Desc: Process Module: Register Interface 
-//   In: 
-//  Out: 
+// Func: classMFNR::MFNR_SetBurst()
+// Desc: Per-burst inputs of a session: frame pointers, ISP Gain, Black Level
+//   In: pInputParams   - [in] InputParams pointer, same geometry as MFNR_Init
+//       pCtrlParams    - [in] ControlParams pointer
+//  Out: MFNR_ERR_SESSION if the geometry differs from MFNR_Init
 // 
-// Date: Revised by yousf 20160824
+// Date: Created 20261017
 // 
 /*************************************************************************/
 CODE_MFNR_EX
-int classMFNR::Register(void)
+int classMFNR::MFNR_SetBurst(RK_InputParams* pInParams, RK_ControlParams* pCtrlParams)
 {
     //
     int     ret = 0; // return value
 #if MY_DEBUG_PRINTF == 1
-    printf("classMFNR::Register()\n");
+    printf("classMFNR::MFNR_SetBurst()\n");
 #endif
-    //
-    RK_U16*     pTmpThumbBase = NULL;
-    RK_U16*     pTmpThumbDsp  = NULL;
-    RK_U16*     pTmpThumbRef  = NULL;
-    RK_U16*     pTmpRawBase   = NULL;
-    RK_U16*     pTmpRawRef    = NULL;
-    int         nThumbChunkStride;
-    int         radius;         // search radius
-    int         nChunkSize;     // size
-    int         chunkIdx;       // odd-even
-    int         chunkIdx_base;  // odd-even
-    int         chunkIdx_ref;   // odd-even
-    RK_U16*     pTmpDspSrc    = NULL;
-    RK_U16*     pTmpDspDst    = NULL;
-
-    //////////////////////////////////////////////////////////////////////////
-    ////-------- Step 1 Feature Detect
-    //==== DSP Malloc: pFeaturePoints & pFeatureValues addr in DSP
-    // pFeaturePoints
-    nChunkSize         = sizeof(RK_U16) * mMaxNumFeature;
-    pFeaturePoints[0]  = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    pFeaturePoints[1]  = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
+    if (pInParams->nRawWid != mRawWid || pInParams->nRawHgt != mRawHgt || pInParams->nRawFileNum != mRawFileNum)
     {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pFeaturePoints !\n");
-#endif
+        ret = MFNR_ERR_SESSION;
         return ret;
     }
-    // pFeatureValues
-    nChunkSize         = sizeof(RK_U16) * mMaxNumFeature;
-    pFeatureValues     = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
+
+    // RawSrcs & ThumbSrcs
+    mThumbBuildMask = 0;
+    for (int k=0; k < mRawFileNum; k++)                     // Raw & Thumb Srcs data pointers
     {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pFeatureValues !\n");
-#endif
-        return ret;
+        pRawSrcs[k]   = (RK_U16*)pInParams->pRawSrcs[k];
+        pThumbSrcs[k] = (RK_U16*)pInParams->pThumbSrcs[k];
+        if (pThumbSrcs[k] == NULL)
+        {
+            // built by ThumbBuild(), the DDR is kept by the bursts of a session
+            if (pThumbBufs[k] == NULL)
+            {
+                pThumbBufs[k] = (RK_U16*)malloc(mThumbDataSize);
+            }
+            if (pThumbBufs[k] == NULL)
+            {
+                ret = MFNR_ERR_THUMB_ALLOC;
+                return ret;
+            }
+            pThumbSrcs[k]    = pThumbBufs[k];
+            mThumbBuildMask |= 1 << k;
+        }
+        if (mUsePyramid)
+        {
+            // built by PyramidBuild() every burst, the DDR is kept by the bursts of a session
+            if (pPyrBufs[k] == NULL)
+            {
+                pPyrBufs[k] = (RK_U16*)malloc(mPyrDataSize);
+            }
+            if (pPyrBufs[k] == NULL)
+            {
+                ret = MFNR_ERR_PYR_ALLOC;
+                return ret;
+            }
+        }
     }
 
-    //==== DSP Memory Reuse Operation
-    mDspMem_ResetPos = mDspMem_UsedCount; // Mark Position
+    // ISP Gain
+    mIspGain = pInParams->pRawInfo->fIspGain;
+    mBlackLevel[0] = pInParams->pRawInfo->nBlackLevel[0];
+    mBlackLevel[1] = pInParams->pRawInfo->nBlackLevel[1];
+    mBlackLevel[2] = pInParams->pRawInfo->nBlackLevel[2];
+    mBlackLevel[3] = pInParams->pRawInfo->nBlackLevel[3];
 
-    //==== DSP Malloc: pThumbDspChunk addr in DSP
-    // pThumbDspChunks
-    nChunkSize         = sizeof(RK_U16) * (mThumbWid + 2) * (NUM_LINE_DDR2DSP_THUMB + 2);
-    pThumbDspChunks[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    pThumbDspChunks[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pThumbDspChunks !\n");
-#endif
-        return ret;
-    }
-    // pThumbFilterDspChunk
-    nChunkSize           = sizeof(RK_U16) * (mThumbWid + 2) * (NUM_LINE_DDR2DSP_THUMB + 2);
-    pThumbFilterDspChunk = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount    += nChunkSize; // current used count
-	memset( pThumbFilterDspChunk, 0, nChunkSize );
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pThumbFilterDspChunk !\n");
-#endif
-        return ret;
-    }
-	mDspMem_UsedCount  = ALIGN_SET(mDspMem_UsedCount, 64);
-    // pWdrWeightMat: 9x256*4B
-    nChunkSize         = sizeof(RK_U32)* 9 * 256;
-    pWdrWeightMat      = (RK_U32*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
 
-    pWdrWeightMat1    = (RK_U32*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += sizeof(RK_U32)* 16 * 256;; // current used count
+    mUseHwDMA = pCtrlParams->useHwDMA;
 
+    //
+    return ret;
 
-#if 1                                                       
-	// add by zxy for init the full size weigth and count statitics.            
-	memset( pWdrWeightMat, 0, nChunkSize );                                     
-	memset( pWdrThumbWgtTable, 0, nChunkSize>>1/*sizeof( RK_U16 ) * 9 * 256*/ );
+} // classMFNR::MFNR_SetBurst()
 
-	memset( pWdrWeightMat1, 0, nChunkSize );                                     
-	memset( pWdrThumbWgtTable1, 0, nChunkSize>>1/*sizeof( RK_U16 ) * 9 * 256*/ );
-	
-#endif                                                                       
 
-	
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
+/************************************************************************/
+// Func: classMFNR::DspMemPlan()
+// Desc: Lay out the DSP Memory Array of every stage once, from the burst
+//       size only; Register & Enhancer use the member pointers as set here.
+//       The Ref windows of a Tile follow the Homography: pRawBlkChunks holds
+//       the spread of RAW_TILE_CHUNK_HGT/WID, EnhancerFetch() checks each
+//       window against it at runtime
+//   In: 
+//  Out: MFNR_ERR_DSP_MEM_OVERFLOW if the layout does not fit mDspMemSize
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::DspMemPlan(void)
+{
+    //
+    int     ret = 0; // return value
+    int     nChunkSize;                 // Memory Size for DSP Malloc (elements)
+    int     radius;                     // search radius
+
+    RK_DspArenaReset(&mDspArena, dspMemoryArray, mDspMemSize); // Method-2: use MemoryArray
+
+    //////////////////////////////////////////////////////////////////////////
+    ////-------- MFNR_Process: pHomographyMatrix & pWdrThumbWgtTable & pWdrScaleTable (kept to the end)
+    mDspArena.nStage = DSPMEM_PROCESS; // DSP Memory Map
+    // pHomographyMatrix
+    for (int k=0; k < mRawFileNum; k++)
     {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrWeightMat !\n");
-#endif
-        return ret;
+        pHomographyMatrix[k] = DspAlloc<RK_F32>(9, "pHomographyMatrix", k);
     }
+    // pWdrThumbWgtTable // Thumb Weight Table: in the layout wdr_process_block reads, WDR_THUMB_TABLE_SIZE*2B
+    pWdrThumbWgtTable  = DspAlloc<RK_U16>(WDR_THUMB_TABLE_SIZE, "pWdrThumbWgtTable");
 
+    // pWdrScaleTable // ScaleTabale[expouse_times] 961*2B, kept across the bursts of a session
+    pWdrScaleTable      = DspAlloc<RK_U16>(961, "pWdrScaleTable");
 
+    //////////////////////////////////////////////////////////////////////////
+    ////-------- ThumbBuild: before Register, from the same base
+    {
+        classDspMemScope    dspThumb(&mDspArena);       // DSP Memory: all of ThumbBuild
+        mDspArena.nStage = DSPMEM_THUMB_BUILD; // DSP Memory Map
+        //==== DSP Malloc: pRaw10BandChunks & pThumbRowChunk addr in DSP
+        // pRaw10BandChunks: 8 Raw rows x THUMB_BUILD_COLS*8 pixels packed RAW10, odd-even, +8B for the 64bit loads of the last group
+        nChunkSize          = SCALER_FACTOR_R2T * (THUMB_BUILD_COLS * SCALER_FACTOR_R2T * RAW_BIT_COUNT / 8) + 8;
+        pRaw10BandChunks[0] = DspAlloc<RK_U8>(nChunkSize, "pRaw10BandChunks[0]");
+        pRaw10BandChunks[1] = DspAlloc<RK_U8>(nChunkSize, "pRaw10BandChunks[1]");
+        // pThumbRowChunk: ThumbWid*2B
+        pThumbRowChunk      = DspAlloc<RK_U16>(mThumbWid, "pThumbRowChunk");
+    }
 
-    //---- DMA: Thumb(DDR16bit->DSP16bit)
-    pTmpThumbBase = pThumbSrcs[mBasePicNum]; // stride = mThumbStride // addr in DDR
-    chunkIdx      = 0; // odd-even
-    pTmpThumbDsp  = pThumbDspChunks[chunkIdx] + (mThumbWid + 2) + 1;
-    //memset(pThumbDspChunks[chunkIdx], 0, 2*522*34);
-    nThumbChunkStride = sizeof(RK_U16) * (mThumbWid + 2);
-    RKDMA_ReadThumb16bit2DSP((U32)pTmpThumbBase, (U32)pTmpThumbDsp, 
-        mThumbWid, NUM_LINE_DDR2DSP_THUMB, mThumbStride, nThumbChunkStride, 0);
+    //////////////////////////////////////////////////////////////////////////
+    ////-------- Register: Step 1/3/4 results stay for the later Steps, scratch is reused
+    {
+        classDspMemScope    dspRegister(&mDspArena);    // DSP Memory: all of Register
+        classDspMemScope    dspStep(&mDspArena);        // DSP Memory: scratch of the current Step
+
+        ////-------- Register Step 1 Feature Detect
+        mDspArena.nStage = DSPMEM_REG_FEATURE_DETECT; // DSP Memory Map
+        //==== DSP Malloc: pFeaturePoints & pFeatureValues addr in DSP (kept until Step 2)
+        pFeaturePoints[0]  = DspAlloc<RK_U16>(mMaxNumFeature, "pFeaturePoints[0]");
+        pFeaturePoints[1]  = DspAlloc<RK_U16>(mMaxNumFeature, "pFeaturePoints[1]");
+        pFeatureValues     = DspAlloc<RK_U16>(mMaxNumFeature, "pFeatureValues");
+
+        //==== DSP Memory Reuse Operation
+        dspStep.Mark(); // Step 1 scratch: released by Step 3
+
+        //==== DSP Malloc: pThumbDspChunk & pWdrWeightMat addr in DSP (light filter fused into ThumbStripScan)
+        nChunkSize           = (mThumbWid + 2) * (NUM_LINE_DDR2DSP_THUMB + 2);
+        pThumbDspChunks[0]   = DspAlloc<RK_U16>(nChunkSize, "pThumbDspChunks[0]");
+        pThumbDspChunks[1]   = DspAlloc<RK_U16>(nChunkSize, "pThumbDspChunks[1]");
+        // pWdrWeightMat: WDR_THUMB_TABLE_SIZE*4B
+        pWdrWeightMat        = DspAlloc<RK_U32>(WDR_THUMB_TABLE_SIZE, "pWdrWeightMat");
+
+        ////-------- Register Step 3 Thumb Coarse Matching
+        dspStep.Rewind(); // release Step 1 scratch
+        mDspArena.nStage = DSPMEM_REG_COARSE_MATCH; // DSP Memory Map
+        radius = COARSE_MATCH_RADIUS;  // search radius
+        //==== DSP Malloc: pMatchPointYs & pMatchPointXs addr in DSP (kept until Step 5, mNumValidFeature <= mMaxNumFeature)
+        for (int k=0; k < mRawFileNum; k++)
+        {
+            pMatchPointsY[k]   = DspAlloc<RK_U16>(mMaxNumFeature, "pMatchPointsY", k);
+            pMatchPointsX[k]   = DspAlloc<RK_U16>(mMaxNumFeature, "pMatchPointsX", k);
+        }
 
-//    pTmpDspSrc = pThumbDspChunks[chunkIdx] + (mThumbWid + 2);
-//    pTmpDspDst = pThumbDspChunks[chunkIdx];
-//    CopyBlockData(pTmpDspSrc, pTmpDspDst, mThumbWid + 2, 1, nThumbChunkStride, nThumbChunkStride);
-
-/*
-    CopyThumbChunkBOUDER((U32)(pThumbDspChunks[chunkIdx] + (mThumbWid + 2)),
-            		     (U32)(pThumbDspChunks[chunkIdx]),
-					     mThumbWid + 2, 1, nThumbChunkStride, nThumbChunkStride);
-    CopyThumbChunkBOUDER((U32)(pThumbDspChunks[chunkIdx] + 1),
-    					 (U32)(pThumbDspChunks[chunkIdx]),
-						 1, NUM_LINE_DDR2DSP_THUMB+2, nThumbChunkStride, nThumbChunkStride);
-    CopyThumbChunkBOUDER((U32)(pThumbDspChunks[chunkIdx] + (NUM_LINE_DDR2DSP_THUMB+0)*(mThumbWid+2)),
-    				     (U32)(pThumbDspChunks[chunkIdx] + (NUM_LINE_DDR2DSP_THUMB+1)*(mThumbWid+2)),
-						 mThumbWid + 2, 1, nThumbChunkStride, nThumbChunkStride);
-    CopyThumbChunkBOUDER((U32)(pThumbDspChunks[chunkIdx] + mThumbWid),
-    					 (U32)(pThumbDspChunks[chunkIdx] + (mThumbWid + 1)),
-						 1, NUM_LINE_DDR2DSP_THUMB+2, nThumbChunkStride, nThumbChunkStride);
-//*/
+        //==== DSP Memory Reuse Operation
+        dspStep.Mark(); // Step 3 scratch: released by Step 4
 
-//*
-    CopyBlockData(pThumbDspChunks[chunkIdx] + (mThumbWid + 2),//(U16*)((U32)pThumbDspChunks[chunkIdx] + (mThumbWid + 2)*2),
-                  pThumbDspChunks[chunkIdx],
-                  mThumbWid + 2, 1, nThumbChunkStride, nThumbChunkStride);              // Top
-    CopyBlockData(pThumbDspChunks[chunkIdx] + 1, 
-                  pThumbDspChunks[chunkIdx],
-                  1, NUM_LINE_DDR2DSP_THUMB+2, nThumbChunkStride, nThumbChunkStride);   // Left
-    CopyBlockData(pThumbDspChunks[chunkIdx] + (NUM_LINE_DDR2DSP_THUMB+0)*(mThumbWid+2),
-                  pThumbDspChunks[chunkIdx] + (NUM_LINE_DDR2DSP_THUMB+1)*(mThumbWid+2),
-                  mThumbWid + 2, 1, nThumbChunkStride, nThumbChunkStride);              // Down
-    CopyBlockData(pThumbDspChunks[chunkIdx] + mThumbWid, 
-                  pThumbDspChunks[chunkIdx] + (mThumbWid + 1),
-                  1, NUM_LINE_DDR2DSP_THUMB+2, nThumbChunkStride, nThumbChunkStride);   // Right
-//*/
-    for (int i=0; i < mThumbDivSegRow; i++)
-    {
-        //---- ThumbChunk Feature Detect
-        FeatureDetect(pThumbDspChunks[chunkIdx], mThumbWid+2, NUM_LINE_DDR2DSP_THUMB+2, mThumbStride+4, i, mThumbDivSegCol, pFeaturePoints, pFeatureValues);
-
-		GetWdrWeightTable(	pThumbDspChunks[chunkIdx],  
-							mThumbWid+2,                          
-							NUM_LINE_DDR2DSP_THUMB+2,             
-							mThumbWid+2,                       
-							i,                                    
-							pThumbFilterDspChunk,                 
-							pWdrWeightMat,                        
-							pWdrThumbWgtTable,                    
-						#if 1//WDR_THUMB_TABLE_TR
-							pWdrWeightMat1,        // <<! [in]  
-							pWdrThumbWgtTable1,
-						#endif	
-							((mRawWid+128)>>8) + 1,					      
-    			    		((mRawHgt+128)>>8) + 1            
-							);                                    
+        //==== DSP Malloc: pThumbBaseBlkDspChunks & pThumbRefBlkDspChunks addr in DSP, odd-even batch (RK_CoarseBatch)
+        if (mUsePyramid)
+        {
+            {
+                classDspMemScope    dspPyr(&mDspArena);     // DSP Memory: PyramidBuild, done before the matching
+                mDspArena.nStage = DSPMEM_REG_PYRAMID; // DSP Memory Map
+                //==== DSP Malloc: pPyrThumbChunks & pPyrRowChunk addr in DSP
+                nChunkSize         = NUM_LINE_DDR2DSP_THUMB * mThumbWid;
+                pPyrThumbChunks[0] = DspAlloc<RK_U16>(nChunkSize, "pPyrThumbChunks[0]");
+                pPyrThumbChunks[1] = DspAlloc<RK_U16>(nChunkSize, "pPyrThumbChunks[1]");
+                pPyrRowChunk       = DspAlloc<RK_U16>(PYR_BUILD_ROWS * mPyrWid, "pPyrRowChunk");
+            }
+            // pThumbBaseBlkDspChunks: the 16x16 Base block of one Feature & level
+            nChunkSize      = PYR_MATCH_WIN_SIZE * PYR_MATCH_WIN_SIZE;
+            // pThumbRefBlkDspChunks: the Ref window of either level per Ref frame
+            mCoarseRefPitch = MAX((PYR_MATCH_WIN_SIZE + 2*PYR_MATCH_RADIUS) * (PYR_MATCH_WIN_SIZE + 2*PYR_MATCH_RADIUS),
+                (PYR_MATCH_WIN_SIZE + 2*PYR_THUMB_RADIUS) * (PYR_MATCH_WIN_SIZE + 2*PYR_THUMB_RADIUS));
+        }
+        else if (mUseThumbStrip)
+        {
+            // pThumbBaseBlkDspChunks: Base strip 32xThumbWid, then the 16x16 block in matching
+            nChunkSize      = NUM_LINE_DDR2DSP_THUMB * mThumbWid + COARSE_MATCH_WIN_SIZE * COARSE_MATCH_WIN_SIZE;
+            // pThumbRefBlkDspChunks: (32+2*radius)x(ThumbWid+2*radius) per Ref frame, windows run past the Thumb edge
+            mCoarseRefPitch = COARSE_THUMB_STRIP_HGT * (mThumbWid + 2*radius);
+        }
+        else
+        {
+            // pThumbBaseBlkDspChunks: a 16x16 Base block per Feature of the batch
+            nChunkSize      = COARSE_MATCH_WIN_SIZE * COARSE_MATCH_WIN_SIZE * COARSE_BATCH_FEATURES;
+            // pThumbRefBlkDspChunks: a Ref strip per Ref frame
+            mCoarseRefPitch = COARSE_STRIP_HGT * COARSE_STRIP_WID;
+        }
+        pThumbBaseBlkDspChunks[0] = DspAlloc<RK_U16>(nChunkSize, "pThumbBaseBlkDspChunks[0]");
+        pThumbBaseBlkDspChunks[1] = DspAlloc<RK_U16>(nChunkSize, "pThumbBaseBlkDspChunks[1]");
+        nChunkSize = mCoarseRefPitch * MAX(mRawFileNum - 1, 1);
+        pThumbRefBlkDspChunks[0] = DspAlloc<RK_U16>(nChunkSize, "pThumbRefBlkDspChunks[0]");
+        pThumbRefBlkDspChunks[1] = DspAlloc<RK_U16>(nChunkSize, "pThumbRefBlkDspChunks[1]");
+
+        ////-------- Register Step 4 Luma Fine Matching
+        dspStep.Rewind(); // release Step 3 scratch
+        mDspArena.nStage = DSPMEM_REG_FINE_MATCH; // DSP Memory Map
+        radius            = FINE_LUMA_RADIUS * 2;  // search radius
+        //==== DSP Malloc: pFeatureIdxsInAgent & pAgentPointsWeight addr in DSP (kept until Step 5)
+        pFeatureIdxsInAgent = DspAlloc<RK_U8>(mMaxNumFeature, "pFeatureIdxsInAgent");
+        for (int k=0; k < mRawFileNum; k++)
+        {
+            pAgentPointsWeight[k] = DspAlloc<RK_U16>(mMaxNumFeature, "pAgentPointsWeight", k);
+        }
 
-        // Next Chunk
-        if (i < mThumbDivSegRow - 1)
+        //==== DSP Memory Reuse Operation
+        dspStep.Mark(); // Step 4 scratch: released by Step 5
+
+        //==== DSP Malloc: pRawBaseBlkDspChunks & pLumaBaseBlkDspChunks & pRawRefBlkDspChunks & pLumaRefBlkDspChunks addr in DSP
+        // pRawBaseBlkDspChunks
+        nChunkSize = FINE_MATCH_WIN_SIZE * FINE_MATCH_WIN_SIZE;
+        pRawBaseBlkDspChunks[0] = DspAlloc<RK_U16>(nChunkSize, "pRawBaseBlkDspChunks[0]");
+        pRawBaseBlkDspChunks[1] = DspAlloc<RK_U16>(nChunkSize, "pRawBaseBlkDspChunks[1]");
+        // pLumaBaseBlkDspChunks
+        nChunkSize              /= 4;
+        pLumaBaseBlkDspChunks[0] = DspAlloc<RK_U16>(nChunkSize, "pLumaBaseBlkDspChunks[0]");
+        pLumaBaseBlkDspChunks[1] = DspAlloc<RK_U16>(nChunkSize, "pLumaBaseBlkDspChunks[1]");
+        // pRawRefBlkDspChunks
+        nChunkSize = (FINE_MATCH_WIN_SIZE + 2*radius) * (FINE_MATCH_WIN_SIZE + 2*radius + 2*4); // 4PixelAlign
+        pRawRefBlkDspChunks[0] = DspAlloc<RK_U16>(nChunkSize, "pRawRefBlkDspChunks[0]");
+        pRawRefBlkDspChunks[1] = DspAlloc<RK_U16>(nChunkSize, "pRawRefBlkDspChunks[1]");
+        // pLumaRefBlkDspChunks
+        nChunkSize             /= 4;
+        pLumaRefBlkDspChunks[0] = DspAlloc<RK_U16>(nChunkSize, "pLumaRefBlkDspChunks[0]");
+        pLumaRefBlkDspChunks[1] = DspAlloc<RK_U16>(nChunkSize, "pLumaRefBlkDspChunks[1]");
+
+        ////-------- Register Step 5 Compute Homography
+        dspStep.Rewind(); // release Step 4 scratch
+        mDspArena.nStage = DSPMEM_REG_HOMOGRAPHY; // DSP Memory Map
+        //==== DSP Malloc: pRowMvHist & pColMvHist & pMarkMatchFeature & ... addr in DSP
+        // pRowMvHist & pColMvHist
+#if USE_MV_HIST_FILTRATE == 1
+        nChunkSize         = LEN_MV_HIST;
+        pRowMvHist         = DspAlloc<RK_U8>(nChunkSize, "pRowMvHist");
+        pColMvHist         = DspAlloc<RK_U8>(nChunkSize, "pColMvHist");
+#endif
+        // pMarkMatchFeature
+        nChunkSize         = MAX_NUM_MATCH_FEATURE;
+        pMarkMatchFeature  = DspAlloc<RK_U8>(nChunkSize, "pMarkMatchFeature");
+        // pAgentsIn4x4Region_Marks // Agents in 4x4 Region [RegMark4x4] * 16
+        nChunkSize               = NUM_DIVIDE_IMAGE * NUM_DIVIDE_IMAGE;
+        pAgentsIn4x4Region_Marks = DspAlloc<RK_U8>(nChunkSize, "pAgentsIn4x4Region_Marks");
+        // pAgentsIn4x4Region_Wgts // Agents in 4x4 Region [Sharp/SAD] * 16
+        nChunkSize              = NUM_DIVIDE_IMAGE * NUM_DIVIDE_IMAGE;
+        pAgentsIn4x4Region_Wgts = DspAlloc<RK_U16>(nChunkSize, "pAgentsIn4x4Region_Wgts");
+        // pAgentsIn4x4Region_PtYs & pAgentsIn4x4Region_PtXs
+        nChunkSize = NUM_DIVIDE_IMAGE * NUM_DIVIDE_IMAGE;
+        for (int k=0; k < mRawFileNum; k++)
         {
-            //---- DMA: Thumb(DDR16bit->DSP16bit)
-            pTmpThumbBase += mThumbStride/sizeof(RK_U16)*NUM_LINE_DDR2DSP_THUMB; // addr in DDR
-            chunkIdx       = (chunkIdx + 1) & 0x1; // odd-even
-            pTmpThumbDsp   = pThumbDspChunks[chunkIdx] + (mThumbWid + 2) + 1;
-            RKDMA_ReadThumb16bit2DSP((U32)pTmpThumbBase, (U32)pTmpThumbDsp, 
-                mThumbWid, NUM_LINE_DDR2DSP_THUMB, mThumbStride, mThumbStride+4, 0);
-			CopyBlockData(pThumbDspChunks[chunkIdx] + (mThumbWid + 2), 
-				pThumbDspChunks[chunkIdx],
-				mThumbWid + 2, 1, nThumbChunkStride, nThumbChunkStride);              // Top
-			CopyBlockData(pThumbDspChunks[chunkIdx] + 1, 
-				pThumbDspChunks[chunkIdx],
-				1, NUM_LINE_DDR2DSP_THUMB+2, nThumbChunkStride, nThumbChunkStride);   // Left
-			CopyBlockData(pThumbDspChunks[chunkIdx] + (NUM_LINE_DDR2DSP_THUMB+0)*(mThumbWid+2), 
-				pThumbDspChunks[chunkIdx] + (NUM_LINE_DDR2DSP_THUMB+1)*(mThumbWid+2),
-				mThumbWid + 2, 1, nThumbChunkStride, nThumbChunkStride);              // Down
-			CopyBlockData(pThumbDspChunks[chunkIdx] + mThumbWid, 
-				pThumbDspChunks[chunkIdx] + (mThumbWid + 1),
-				1, NUM_LINE_DDR2DSP_THUMB+2, nThumbChunkStride, nThumbChunkStride);   // Right
+            // Agents in 4x4 Region [Y] * RawFileNum * 16
+            pAgentsIn4x4Region_PtYs[k] = DspAlloc<RK_U16>(nChunkSize, "pAgentsIn4x4Region_PtYs", k);
+            // Agents in 4x4 Region [X] * RawFileNum * 16
+            pAgentsIn4x4Region_PtXs[k] = DspAlloc<RK_U16>(nChunkSize, "pAgentsIn4x4Region_PtXs", k);
         }
+        // pRegion4Points // 4 points in 4 Regions: [x0,y0,x1,y1] * 4Points * 2Byte
+        nChunkSize     = 4 * 4;
+        pRegion4Points = DspAlloc<RK_U16>(nChunkSize, "pRegion4Points");
+        // pMatrixA // Coefficient Matrix A for A*X = B: 8*8*4Byte
+        nChunkSize = 8 * 8;
+        pMatrixA   = DspAlloc<RK_F32>(nChunkSize, "pMatrixA");
+        // pVectorB // Coefficient Vector B for A*X = B: 8*1*4Byte
+        nChunkSize = 8 * 1;
+        pVectorB   = DspAlloc<RK_F32>(nChunkSize, "pVectorB");
+        // pVectorX // Coefficient Vector X for A*X = B: 3*3*4Byte
+        nChunkSize = 3 * 3;
+        pVectorX   = DspAlloc<RK_F32>(nChunkSize, "pVectorX");
+        // pBasePoint & pRefPoint & pProjPoint
+        nChunkSize = 2;
+        pBasePoint = DspAlloc<RK_F32>(nChunkSize, "pBasePoint");
+        pRefPoint  = DspAlloc<RK_F32>(nChunkSize, "pRefPoint");
+        pProjPoint = DspAlloc<RK_F32>(nChunkSize, "pProjPoint");
     }
 
-  
-#if 1//ndef CEVA_CHIP_CODE_BAYERWDR
-
-	HistFilter( pWdrThumbWgtTable, pWdrWeightMat, ((mRawHgt+128)>>8) + 1, ((mRawWid+128)>>8) + 1  );     
-	//normalize                                                                                          
-	normalizeWeight( pWdrThumbWgtTable, pWdrWeightMat, ((mRawHgt+128)>>8) + 1, ((mRawWid+128)>>8) + 1 ); 
-	//writeFile(pWdrThumbWgtTable, 9*256, "weightData_block.dat");
-
+    //////////////////////////////////////////////////////////////////////////
+    ////-------- Enhancer: after Register, from the same base
+    {
+        classDspMemScope    dspEnhancer(&mDspArena);    // DSP Memory: all of Enhancer
+        mDspArena.nStage = DSPMEM_ENHANCER; // DSP Memory Map
+#if USE_MODIFY_ENHANCER == 0
+        int     blkHgt  = RAW_BLK_SIZE;                 // Block Height in Raw Allowed to Read
+        int     blkWid  = RAW_BLK_SIZE * RAW_WIN_NUM;   // Block Width  in Raw Allowed to Read
 
-	HistFilterTranspose( pWdrThumbWgtTable1, pWdrWeightMat1, ((mRawHgt+128)>>8) + 1, ((mRawWid+128)>>8) + 1  );     
-	//normalize                                                                                          
-	normalizeWeightTranspose( pWdrThumbWgtTable1, pWdrWeightMat1, ((mRawHgt+128)>>8) + 1, ((mRawWid+128)>>8) + 1 );
+        //==== pBaseBlocksPoint & pProjBlocksPoint & ... addr in DSP
+        // pBaseBlocksPoint & pProjBlocksPoint
+        nChunkSize = 2;
+        for (int i=0; i < RAW_WIN_NUM; i++)
+        {
+            // pBaseBlocksPoint // BaseBlocks Center Pointer: 4 Points for n-block(32x32)
+            pBaseBlocksPoint[i] = DspAlloc<RK_F32>(nChunkSize, "pBaseBlocksPoint", i);
+        }
+        for (int i=0; i < RAW_WIN_NUM; i++)
+        {
+            // pProjBlocksPoint // ProjBlocks Center Pointer: 4 Points for n-block(32x32)
+            pProjBlocksPoint[i] = DspAlloc<RK_F32>(nChunkSize, "pProjBlocksPoint", i);
+        }
 
+        // pRawBaseBlocksDspChunks // RawBaseBlocks DSP Chunks: (32+2*2)x(32n+2*4) * 2B * 2  ExpandedBoundary=(2,2)
+        nChunkSize                 = (blkHgt+2*RAW_BLK_EXTEND_ROW) * (blkWid+2*RAW_BLK_EXTEND_COL);
+        pRawBaseBlocksDspChunks[0] = DspAlloc<RK_U16>(nChunkSize, "pRawBaseBlocksDspChunks[0]");
+        pRawBaseBlocksDspChunks[1] = DspAlloc<RK_U16>(nChunkSize, "pRawBaseBlocksDspChunks[1]");
+        // pRawBaseFilterDspChunk // RawBaseFilter DSP Chunk: (32+2*2)x(32n+2*4) * 2B * 2  ExpandedBoundary=(2,2)
+        nChunkSize             = (blkHgt+2*RAW_BLK_EXTEND_ROW) * (blkWid+2*RAW_BLK_EXTEND_COL);
+        pRawBaseFilterDspChunk = DspAlloc<RK_U16>(nChunkSize, "pRawBaseFilterDspChunk");
+        //pRawBaseThreshDspChunk // RawBaseThresh DSP Chunk: 32x32n * 1B
+        nChunkSize             = blkHgt * blkWid;
+        pRawBaseThreshDspChunk = DspAlloc<RK_U16>(nChunkSize, "pRawBaseThreshDspChunk");
+
+        // pRawRefBlocksDspChunks // RawRefBlocks DSP Chunks: (32+2*9)x(32n+2*12) * 2B * 2  ExpandedBoundary=(9,12)
+        nChunkSize                = (blkHgt+2*RAW_REF_EXTEND_ROW) * (blkWid+2*RAW_REF_EXTEND_COL);
+        pRawRefBlocksDspChunks[0] = DspAlloc<RK_U16>(nChunkSize, "pRawRefBlocksDspChunks[0]");
+        pRawRefBlocksDspChunks[1] = DspAlloc<RK_U16>(nChunkSize, "pRawRefBlocksDspChunks[1]");
+        // pRawRefFilterDspChunk // RawRefFilter DSP Chunk:  (32+2*9)x(32n+2*11) * 2B ExpandedBoundary=(9,11)
+        nChunkSize            = (blkHgt+2*RAW_REF_EXTEND_ROW) * (blkWid+2*RAW_REF_EXTEND_COL);
+        pRawRefFilterDspChunk = DspAlloc<RK_U16>(nChunkSize, "pRawRefFilterDspChunk");
+
+        // pRawDstSumDspChunk // RawDstSum DSP Chunk: 32x32n * 2B
+        nChunkSize         = blkHgt * blkWid;
+        pRawDstSumDspChunk = DspAlloc<RK_U16>(nChunkSize, "pRawDstSumDspChunk");
+        // pRawDstWgtDspChunk // RawDstWgt DSP Chunk: 32x32n * 1B
+        nChunkSize         = blkHgt * blkWid;
+        pRawDstWgtDspChunk = DspAlloc<RK_U8>(nChunkSize, "pRawDstWgtDspChunk");
+
+        // pWdrRawBlockBuf // BlkBuf: (2+32)x(1+32n+1)*2B, n=2 -> 32*n=64
+        mWdrBufWid         = RAW_BLK_SIZE * RAW_WIN_NUM + 2; // 1+32*2+1
+        nChunkSize         = (RAW_BLK_SIZE+2) * mWdrBufWid;//
+        pWdrRawBlockBuf[0] = DspAlloc<RK_U16>(nChunkSize, "pWdrRawBlockBuf[0]");
+        pWdrRawBlockBuf[1] = DspAlloc<RK_U16>(nChunkSize, "pWdrRawBlockBuf[1]");
+        // pWdrRawRowBuf // RowBuf: 2xRawWid*2B
+        mWdrRowsBufWid     = CEIL(mRawWid*1.0/(RAW_BLK_SIZE*RAW_WIN_NUM))*RAW_BLK_SIZE*RAW_WIN_NUM + 2; // 64-Align
+        nChunkSize         = 2 * mWdrRowsBufWid;
+        pWdrRawRowBuf      = DspAlloc<RK_U16>(nChunkSize, "pWdrRawRowBuf");
+        // pWdrRawColBuf // ColBuf: 32x1*2B
+        nChunkSize         = RAW_BLK_SIZE;
+        pWdrRawColBuf      = DspAlloc<RK_U16>(nChunkSize, "pWdrRawColBuf");
+        // pWdrRawBlockRect // Rects: 1x4*2B
+        nChunkSize          = 4;//
+        pWdrRawBlockRect[0] = DspAlloc<RK_U16>(nChunkSize, "pWdrRawBlockRect[0]");
+        pWdrRawBlockRect[1] = DspAlloc<RK_U16>(nChunkSize, "pWdrRawBlockRect[1]");
+
+        // pWdrLeft & pWdrRight // 32x16*2B byte space   2K store 32 line left and right, align 16, actually 9 valid..
+        nChunkSize         = 32 * 16 * 2;
+        pWdrLeftRight      = DspAlloc<RK_U16>(nChunkSize, "pWdrLeftRight");
+
+        // pWdrGainMat // Result: 32x32n*2B
+        nChunkSize         = RAW_BLK_SIZE * RAW_BLK_SIZE*RAW_WIN_NUM;
+        pWdrGainMat        = DspAlloc<RK_U16>(nChunkSize, "pWdrGainMat");
+        // pWdrRawResult // Result: 32x32n*2B
+        nChunkSize         = RAW_BLK_SIZE * RAW_BLK_SIZE*RAW_WIN_NUM;
+        pWdrRawResult      = DspAlloc<RK_U16>(nChunkSize, "pWdrRawResult");
 #else
+        //==== DSP Malloc: pRawBlkPoints & pRawBlkChunks & pWdr* addr in DSP, sized by the Tile of TilePick()
+        // pRawBlkPoints[2][RK_MAX_FILE_NUM]
+        nChunkSize = 2 * (mTileHgt / RAW_BLK_SIZE) * (mTileWid / RAW_BLK_SIZE);
+        for (int n=0; n < 2; n++)
+        {
+            for (int k=0; k < mRawFileNum; k++)
+            {
+                // pRawBlkPoints[n][k][i]: [Y,X]
+                pRawBlkPoints[n][k] = DspAlloc<RK_F32>(nChunkSize, "pRawBlkPoints", n, k);
+            }
+        }
+        // pRawBlkChunks[2][RK_MAX_FILE_NUM]
+        mTileChunkSize = RAW_TILE_CHUNK_HGT(mTileHgt) * RAW_TILE_CHUNK_WID(mTileWid);
+        for (int n=0; n < 2; n++)
+        {
+            for (int k=0; k < mRawFileNum; k++)
+            {
+                pRawBlkChunks[n][k]   = DspAlloc<RK_U16>(mTileChunkSize + DSPMEM_GUARD_SIZE / sizeof(RK_U16), "pRawBlkChunks", n, k);
+                mTileChunkBlock[n][k] = RK_DspArenaLastBlock(&mDspArena);
+            }
+        }
+        // pRawBandRings[RK_MAX_FILE_NUM] // Row-band rings: (RingRows+WinRows+1) x (32+RawWid+32+TileWid)*2B, 1 row of slack
+        if (mUseRowBand)
+        {
+            mBandWinRows  = RAW_TILE_CHUNK_HGT(mTileHgt);               // a Tile window, as in pRawBlkChunks
+            mBandRingRows = mBandWinRows + RAW_BAND_SPREAD_ROWS + mTileHgt;   // + the Tile row fed ahead (prefetch)
+            mBandRingWid  = RAW_BAND_PAD_COL + ALIGN_4PIXEL_WIDTH(mRawWid) + RAW_BAND_PAD_COL + mTileWid; // + the last Tile past the Raw
+            nChunkSize    = (mBandRingRows + mBandWinRows + 1) * mBandRingWid;
+            for (int k=0; k < mRawFileNum; k++)
+            {
+                pRawBandRings[k] = DspAlloc<RK_U16>(nChunkSize, "pRawBandRings", k);
+            }
+        }
+        // pWdrRawBlockBuf // BlkBuf: (2+TileHgt)x(1+TileWid+1)*2B, 32x64 -> 34x66, RawDst of TemporalDenoise at (2,1)
+        mWdrBufWid         = mTileWid + 2; // 1+TileWid+1
+        nChunkSize         = (mTileHgt+2) * mWdrBufWid;//
+        pWdrRawBlockBuf[0] = DspAlloc<RK_U16>(nChunkSize, "pWdrRawBlockBuf[0]");
+        pWdrRawBlockBuf[1] = DspAlloc<RK_U16>(nChunkSize, "pWdrRawBlockBuf[1]");
+        // pWdrRawRowBuf // RowBuf: 2xRawWid*2B
+        mWdrRowsBufWid     = (mRawWid + mTileWid - 1) / mTileWid * mTileWid + 2; // TileWid-Align
+        nChunkSize         = 2 * mWdrRowsBufWid;
+        pWdrRawRowBuf      = DspAlloc<RK_U16>(nChunkSize, "pWdrRawRowBuf");
+        // pWdrRawBlockRect // Rects: 1x4*2B
+        nChunkSize          = 4;//
+        pWdrRawBlockRect[0] = DspAlloc<RK_U16>(nChunkSize, "pWdrRawBlockRect[0]");
+        pWdrRawBlockRect[1] = DspAlloc<RK_U16>(nChunkSize, "pWdrRawBlockRect[1]");
+
+        // pWdrLeft & pWdrRight // 32x16*2B byte space   2K store 32 line left and right, align 16, actually 9 valid..
+        nChunkSize         = 32 * 16 * 2;
+        pWdrLeftRight      = DspAlloc<RK_U16>(nChunkSize, "pWdrLeftRight");
+
+        // pWdrGainMat // Result: TileHgtxTileWid*2B
+        nChunkSize         = mTileHgt * mTileWid;
+        pWdrGainMat        = DspAlloc<RK_U16>(nChunkSize, "pWdrGainMat");
+
+        // pWdrRawResult // Result: TileHgtxTileWid*2B
+        nChunkSize         = mTileHgt * mTileWid;
+        pWdrRawResult      = DspAlloc<RK_U16>(nChunkSize, "pWdrRawResult");
+#endif
+    }
 
-	//hist filter
-	countFilter_Vec( pWdrThumbWgtTable, ( mRawHgt + 128 ) / 256 + 1, ( mRawWid + 128 ) / 256 + 1, 256 );
-	weightFilter_Vec( pWdrWeightMat, ( mRawHgt + 128 ) / 256 + 1, ( mRawWid + 128 ) / 256 + 1, 256 );
-	normalizeWeight_Vec( pWdrThumbWgtTable, pWdrWeightMat, ( mRawHgt + 128 ) / 256 + 1, ( mRawWid + 128 ) / 256 + 1, 256 );
-	//writeFile(pWdrThumbWgtTable, 9*256, "weightData_block.dat");
-
+    // one check for the whole layout: the first overflowing chunk is in mDspArena.stats
+    if (RK_DspArenaFailed(&mDspArena))
+    {
+#if MY_DEBUG_PRINTF == 1
+        printf("Failed to Allocate %s !\n", mDspArena.stats.failBlock.pLabel);
 #endif
+        ret = MFNR_ERR_DSP_MEM_OVERFLOW;
+        return ret;
+    }
 
-#if WDR_WEIGHT_TRANSPOSE// set weight output is 256x16(9 valid) matrix.
-	ushort16 v0;
-    RK_U16 vReg[16] = {0};
-	RK_U16 *pWeightTran = pWdrThumbWgtTable + 9*256;
-	RK_U16 *pData 		= pWdrThumbWgtTable1;
-	for ( int l = 0 ; l < 256 ; l++ )
-	{
+    //
+    return ret;
+
+} // classMFNR::DspMemPlan()
 
-		vReg[0] = *(pWdrThumbWgtTable + 0*256 + l); 
-		vReg[1] = *(pWdrThumbWgtTable + 1*256 + l);
-		vReg[2] = *(pWdrThumbWgtTable + 2*256 + l);
-		vReg[3] = *(pWdrThumbWgtTable + 3*256 + l);
-		vReg[4] = *(pWdrThumbWgtTable + 4*256 + l);
-		vReg[5] = *(pWdrThumbWgtTable + 5*256 + l);
-		vReg[6] = *(pWdrThumbWgtTable + 6*256 + l);
-		vReg[7] = *(pWdrThumbWgtTable + 7*256 + l);
-		vReg[8] = *(pWdrThumbWgtTable + 8*256 + l);		
-		v0 = *(ushort16*)vReg;
-		
-      	vst(v0,	(ushort16*)(pWeightTran+l*16), 0xffff);
-		// compare the result
-		for ( int rIdx = 0 ; rIdx < 9 ; rIdx++ )
-		{
-		    ;//assert(vReg[rIdx] == *(pData+rIdx));
-		}
-		pData += 256;
-	}
-	
-	
 
+/************************************************************************/
+// Func: classMFNR::TilePick()
+// Desc: Tile of Enhancer_Modify & the DSP Memory layout for it. A zero Hgt
+//       or Wid is picked: the biggest tile whose working set (DSP chunks of
+//       all frames & WDR buffers) fits half the L2 of the core and
+//       whose layout fits mDspMemSize; the wider one of two equal areas
+//   In: nTileHgt       - [in] Tile Hgt: 0-pick, 32/64/128/256
+//       nTileWid       - [in] Tile Wid: 0-pick, 32/64/128/256
+//  Out: MFNR_ERR_TILE if this build does not run the Tile,
+//       MFNR_ERR_DSP_MEM_OVERFLOW if no Tile fits mDspMemSize
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::TilePick(int nTileHgt, int nTileWid)
+{
+    //
+    int     ret = 0; // return value
+    int     nL2Size;                    // L2 of one core (Bytes), 0-unknown
+    int     nBestHgt = 0;               // best Tile that fits
+    int     nBestWid = 0;
+    int     nFirstHgt = 0;              // first Tile this build runs
+    int     nFirstWid = 0;
+    int     nBytes;                     // working set of a Tile (Bytes)
+
+#ifdef RK_HOST_PLATFORM
+    nL2Size = RK_CpuGetL2Size();
+#else
+    nL2Size = 0; // XM4: the DSP Memory is the working set, keep 32x64
 #endif
-                                                                                            
-    //////////////////////////////////////////////////////////////////////////
-    ////-------- Step 2 Feature Filter
-    FeatureFilter(pFeaturePoints, pFeatureValues, mMaxNumFeature, mThumbWid, mThumbHgt, mNumValidFeature);
-    
 
-    //////////////////////////////////////////////////////////////////////////
-    ////-------- Step 3 Thumb Coarse Matching
-    mDspMem_UsedCount = mDspMem_ResetPos; // Mark Position
-    radius = COARSE_MATCH_RADIUS;  // ceil(MAX_OFFSET * 1.0 / SCALER_FACTOR_R2T);     // search radius
-    //==== DSP Malloc: pMatchPointYs & pMatchPointXs addr in DSP
-    nChunkSize = sizeof(RK_U16) * mNumValidFeature;
-    for (int k=0; k < mRawFileNum; k++)
+    // Tile Hgt & Wid: powers of 2, so a 32x32 Block never straddles a 256x256 WDR weight cell
+    for (int h = RAW_BLK_SIZE; h <= RAW_TILE_MAX_SIZE; h *= 2)
     {
-        // pMatchPointsY
-        pMatchPointsY[k]   = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-        mDspMem_UsedCount += nChunkSize; // current used count
-        if (mDspMem_UsedCount > DSP_MEM_SIZE)
+        for (int w = RAW_BLK_SIZE; w <= RAW_TILE_MAX_SIZE; w *= 2)
         {
-#if MY_DEBUG_PRINTF == 1
-            printf("Failed to Allocate pMatchPointsY !\n");
-#endif
-            return ret;
-        }
-        // pMatchPointsX
-        pMatchPointsX[k]   = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-        mDspMem_UsedCount += nChunkSize; // current used count
-        if (mDspMem_UsedCount > DSP_MEM_SIZE)
-        {
-#if MY_DEBUG_PRINTF == 1
-            printf("Failed to Allocate pMatchPointsX !\n");
+            if ((nTileHgt != 0 && h != nTileHgt) || (nTileWid != 0 && w != nTileWid))
+            {
+                continue;
+            }
+#if WDR_VECC || USE_MODIFY_ENHANCER == 0
+            // vector wdr_process_block & Enhancer: 32x64 only
+            if (h != RAW_BLK_SIZE || w != RAW_BLK_SIZE * RAW_WIN_NUM)
+            {
+                continue;
+            }
 #endif
-            return ret;
+            if (nFirstHgt == 0)
+            {
+                nFirstHgt = h;
+                nFirstWid = w;
+            }
+
+            // picked: the working set of a Tile in half the L2 (32x64 always qualifies)
+            nBytes = sizeof(RK_U16) * (2 * mRawFileNum * RAW_TILE_CHUNK_HGT(h) * RAW_TILE_CHUNK_WID(w)
+                   + 2 * h * w + 2 * (h + 2) * (w + 2));
+            if ((nTileHgt == 0 || nTileWid == 0) && nBytes > nL2Size / 2
+                && (h != RAW_BLK_SIZE || w != RAW_BLK_SIZE * RAW_WIN_NUM))
+            {
+                continue;
+            }
+            if (h * w < nBestHgt * nBestWid || (h * w == nBestHgt * nBestWid && w < nBestWid))
+            {
+                continue;
+            }
+
+            // DSP Memory
+            mTileHgt = h;
+            mTileWid = w;
+            if (DspMemPlan() == 0)
+            {
+                nBestHgt = h;
+                nBestWid = w;
+            }
         }
     }
 
-    //==== DSP Memory Reuse Operation
-    mDspMem_ResetPos = mDspMem_UsedCount; // Mark Position
-
-    //==== DSP Malloc: pThumbBaseBlkDspChunks & pThumbRefBlkDspChunks addr in DSP
-    // pThumbBaseBlkDspChunks
-    nChunkSize = sizeof(RK_U16) * COARSE_MATCH_WIN_SIZE * COARSE_MATCH_WIN_SIZE;
-    pThumbBaseBlkDspChunks[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount        += nChunkSize; // current used count
-    pThumbBaseBlkDspChunks[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount        += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
+    if (nFirstHgt == 0)
     {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pThumbBaseBlkDspChunks !\n");
-#endif
+        ret = MFNR_ERR_TILE;
         return ret;
     }
-    // pThumbRefBlkDspChunks
-    nChunkSize = sizeof(RK_U16) * (COARSE_MATCH_WIN_SIZE + 2*radius) * (COARSE_MATCH_WIN_SIZE + 2*radius);
-    pThumbRefBlkDspChunks[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount       += nChunkSize; // current used count
-    pThumbRefBlkDspChunks[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount       += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
+
+    // layout of the best Tile; none fits: the first one, for RK_MFNR_GetDspMemStats()
+    mTileHgt = nBestHgt ? nBestHgt : nFirstHgt;
+    mTileWid = nBestWid ? nBestWid : nFirstWid;
+    ret      = DspMemPlan();
+
+    //
+    return ret;
+
+} // classMFNR::TilePick()
+
+
+/************************************************************************/
+// Func: classMFNR::ThumbChunkIssue()
+// Desc: Issue the DMA of ThumbBuild chunk n of frame k: the 8 Raw rows of
+//       Thumb row n / nChunks, Thumb cols THUMB_BUILD_COLS * (n % nChunks)
+//       on, still packed as RAW10
+//   In: k                  - [in] frame
+//       n                  - [in] chunk of the frame
+//       nChunkIdx          - [in] odd-even chunk slot
+//  Out: pRaw10BandChunks[nChunkIdx]
+//       return             - rdma ticket
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::ThumbChunkIssue(int k, int n, int nChunkIdx)
+{
+    int     nChunks = (mThumbWid + THUMB_BUILD_COLS - 1) / THUMB_BUILD_COLS; // chunks of a Thumb row
+    int     nRow    = n / nChunks * SCALER_FACTOR_R2T;                      // Raw Top-Left
+    int     nCol    = n % nChunks * THUMB_BUILD_COLS * SCALER_FACTOR_R2T;
+    int     nWid    = MIN(THUMB_BUILD_COLS * SCALER_FACTOR_R2T, mThumbWid * SCALER_FACTOR_R2T - nCol);
+    RK_U8*  pDdrRaw = (RK_U8*)pRawSrcs[k] + nRow * mRawStride + nCol * 5/4;
+
+    return RKDMA_IssueRaw10Packed2DSP((RK_Addr)pDdrRaw, (RK_Addr)pRaw10BandChunks[nChunkIdx],
+        nWid, SCALER_FACTOR_R2T, mRawStride, THUMB_BUILD_COLS * SCALER_FACTOR_R2T * 5/4, nCol);
+
+} // classMFNR::ThumbChunkIssue()
+
+
+/************************************************************************/
+// Func: classMFNR::ThumbBuild()
+// Desc: Process Module: ThumbSrcs of the frames in mThumbBuildMask, made
+//       from their RawSrcs. Every Raw byte below Thumb row mThumbHgt is
+//       read once, packed, the next chunk in flight while ThumbRaw10Box()
+//       sums this one; only the Thumb rows are written back to DDR
+//   In: 
+//  Out: pThumbSrcs[k]      - [out] Thumb of frame k, mThumbStride
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::ThumbBuild(void)
+{
+    //
+    int     ret = 0; // return value
 #if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pThumbRefBlkDspChunks !\n");
+    printf("classMFNR::ThumbBuild()\n");
 #endif
+    int     nChunks   = (mThumbWid + THUMB_BUILD_COLS - 1) / THUMB_BUILD_COLS; // chunks of a Thumb row
+    int     nNum      = mThumbHgt * nChunks;                                // chunks of a frame
+    int     nStride   = THUMB_BUILD_COLS * SCALER_FACTOR_R2T * 5/4;         // pRaw10BandChunks row (Bytes)
+    int     chunkIdx  = 0;  // odd-even
+    int     pos[2]    = { 0, 0 };
+    int     nextK, nCol;
+
+    mDspArena.nStage = DSPMEM_THUMB_BUILD; // DMA Traffic site
+    //==== DSP Memory: pRaw10BandChunks & pThumbRowChunk laid out by DspMemPlan()
+
+    // first chunk of the first frame
+    for (nextK=0; nextK < mRawFileNum && !(mThumbBuildMask & (1 << nextK)); nextK++);
+    if (nextK == mRawFileNum || nNum == 0)
+    {
         return ret;
     }
+    pos[chunkIdx] = ThumbChunkIssue(nextK, 0, chunkIdx);
 
-    //---- Features Coarse Matching
-    RK_U16      blkRow_div16, blkCol_div16;
-    RK_U16      nBaseBlkRow, nBaseBlkCol, nBaseBlkHgt, nBaseBlkWid, nBaseBlkStride;
-    RK_U16      nRefBlkRow,  nRefBlkCol,  nRefBlkHgt,  nRefBlkWid,  nRefBlkStride;
-    RK_U16      nMatchRow, nMatchCol, nMatchCost;
-    //---- DMA: ThumbBase(DDR16bit->DSP16bit)
-    blkRow_div16   = pFeaturePoints[0][0] / COARSE_MATCH_WIN_SIZE; // select 16x16Block in 32x32Block in BaseThumb
-    blkCol_div16   = pFeaturePoints[1][0] / COARSE_MATCH_WIN_SIZE; 
-    nBaseBlkRow    = COARSE_MATCH_WIN_SIZE * blkRow_div16;// block(row, col) 16x16
-    nBaseBlkCol    = COARSE_MATCH_WIN_SIZE * blkCol_div16;
-    nBaseBlkHgt    = COARSE_MATCH_WIN_SIZE;
-    nBaseBlkWid    = COARSE_MATCH_WIN_SIZE;
-    nBaseBlkStride = nBaseBlkWid * sizeof(RK_U16);
-    pTmpThumbBase  = pThumbSrcs[mBasePicNum] + nBaseBlkRow * mThumbStride/2 + nBaseBlkCol; // stride = mThumbStride
-    chunkIdx_base  = 0; // odd-even
-    RKDMA_ReadThumb16bit2DSP((U32)pTmpThumbBase, (U32)pThumbBaseBlkDspChunks[chunkIdx_base], 
-        nBaseBlkWid, nBaseBlkHgt, mThumbStride, nBaseBlkStride, nBaseBlkCol);
-    for (int n=0; n < mNumValidFeature; n++)
+    for (int k=nextK; k < mRawFileNum; k=nextK)
     {
-        // MatchPoints[Base#0][Feature#0]
-        pMatchPointsY[mBasePicNum][n] = nBaseBlkRow;
-        pMatchPointsX[mBasePicNum][n] = nBaseBlkCol;
+        // frame after k, its first chunk follows the last chunk of k
+        for (nextK=k + 1; nextK < mRawFileNum && !(mThumbBuildMask & (1 << nextK)); nextK++);
 
-        //---- DMA: ThumbRef(DDR16bit->DSP16bit)
-        nRefBlkRow    = MAX(nBaseBlkRow - radius, 0);// block(row, col) (16+2*radius)x(16+2*radius)
-        nRefBlkCol    = MAX(nBaseBlkCol - radius, 0);
-        nRefBlkHgt    = MIN(nBaseBlkHgt + 2*radius, mThumbHgt - 1);
-        nRefBlkWid    = MIN(nBaseBlkWid + 2*radius, mThumbWid - 1);
-        nRefBlkStride = nRefBlkWid * sizeof(RK_U16);
-        pTmpThumbRef  = pThumbSrcs[1] + nRefBlkRow * mThumbWid + nRefBlkCol; // stride = mThumbStride
-        chunkIdx_ref  = 0; // odd-even
-        RKDMA_ReadThumb16bit2DSP((U32)pTmpThumbRef, (U32)pThumbRefBlkDspChunks[chunkIdx_ref], 
-            nRefBlkWid, nRefBlkHgt, mThumbStride, nRefBlkStride, nRefBlkCol);
-
-        // Matching Ref#k
-        for (int k=0; k < mRawFileNum; k++) // Ref#1-#5
+        for (int n=0; n < nNum; n++)
         {
-            if (k != mBasePicNum)
+            //---- DMA: next chunk (RAW10 packed, DDR->DSP) while this one is summed
+            if (n + 1 < nNum)
+            {
+                pos[chunkIdx ^ 1] = ThumbChunkIssue(k, n + 1, chunkIdx ^ 1);
+            }
+            else if (nextK < mRawFileNum)
             {
-                //---- Feature Coarse Matching
-                FeatureCoarseMatching(pThumbBaseBlkDspChunks[chunkIdx_base], nBaseBlkHgt, nBaseBlkWid, 
-                    pThumbRefBlkDspChunks[chunkIdx_ref], nRefBlkHgt, nRefBlkWid, nMatchRow, nMatchCol, nMatchCost);
+                pos[chunkIdx ^ 1] = ThumbChunkIssue(nextK, 0, chunkIdx ^ 1);
+            }
+            RKDMA_Sync(pos[chunkIdx]);
 
-                // MatchPoints[Base#0][Feature#k]
-                pMatchPointsY[k][n] = nRefBlkRow + nMatchRow;
-                pMatchPointsX[k][n] = nRefBlkCol + nMatchCol;
+            //---- Thumb cols of the chunk
+            PROFILE_BEGIN(mProfile, PROF_THUMB_BUILD);
+            nCol = n % nChunks * THUMB_BUILD_COLS;
+            ThumbRaw10Box(pRaw10BandChunks[chunkIdx], nStride, MIN(THUMB_BUILD_COLS, mThumbWid - nCol), pThumbRowChunk + nCol);
+            PROFILE_END(mProfile, PROF_THUMB_BUILD);
 
-                // Next RefChunk
-                if (k < mRawFileNum - 1)
-                {
-                    //---- DMA: ThumbRef(DDR16bit->DSP16bit)
-                    pTmpThumbRef  = pThumbSrcs[k+1] + nRefBlkRow * mThumbStride/2 + nRefBlkCol; // stride = mThumbStride
-                    chunkIdx_ref  = (chunkIdx_ref + 1) & 0x1; // odd-even
-                    RKDMA_ReadThumb16bit2DSP((U32)pTmpThumbRef, (U32)pThumbRefBlkDspChunks[chunkIdx_ref], 
-                        nRefBlkWid, nRefBlkHgt, mThumbStride, nRefBlkStride, nRefBlkCol);
-                }
+            //---- DMA: Thumb row (DSP16bit->DDR16bit)
+            if (n % nChunks == nChunks - 1)
+            {
+                RKDMA_WriteThumb16bit2DDR((RK_Addr)pThumbRowChunk, (RK_Addr)((RK_U8*)pThumbSrcs[k] + n / nChunks * mThumbStride),
+                    mThumbWid, 1, mThumbWid * sizeof(RK_U16), mThumbStride, 0);
             }
+            chunkIdx ^= 1;
         }
-        
-        // Next BaseChunk
-        if (n < mNumValidFeature - 1)
-        {
-            //---- DMA: ThumbBase(DDR16bit->DSP16bit)
-            blkRow_div16   = pFeaturePoints[0][n+1] / COARSE_MATCH_WIN_SIZE; // select 16x16Block in 32x32Block in BaseThumb
-            blkCol_div16   = pFeaturePoints[1][n+1] / COARSE_MATCH_WIN_SIZE; 
-            nBaseBlkRow    = COARSE_MATCH_WIN_SIZE * blkRow_div16;// block(row, col) 16x16
-            nBaseBlkCol    = COARSE_MATCH_WIN_SIZE * blkCol_div16;
-            nBaseBlkHgt    = COARSE_MATCH_WIN_SIZE;
-            nBaseBlkWid    = COARSE_MATCH_WIN_SIZE;
-            nBaseBlkStride = nBaseBlkWid * sizeof(RK_U16);
-            pTmpThumbBase  = pThumbSrcs[mBasePicNum] + nBaseBlkRow * mThumbStride/2 + nBaseBlkCol; // stride = mThumbStride
-            chunkIdx_base  = (chunkIdx_base + 1) & 0x1; // odd-even
-            RKDMA_ReadThumb16bit2DSP((U32)pTmpThumbBase, (U32)pThumbBaseBlkDspChunks[chunkIdx_base], 
-                nBaseBlkWid, nBaseBlkHgt, mThumbStride, nBaseBlkStride, nBaseBlkCol);
-        }
-    } // for n
+    }
 
+    //
+    return ret;
 
-    //////////////////////////////////////////////////////////////////////////
-    ////-------- Step 4 Luma Fine Matching
-    mDspMem_UsedCount = mDspMem_ResetPos; // Mark Position
-    radius            = FINE_LUMA_RADIUS * 2;  // ceil(MAX_OFFSET * 1.0 / SCALER_FACTOR_R2T); // search radius
-    //==== DSP Malloc: pFeatureIdxsInAgent & pAgentPointsWeight addr in DSP
-    // pFeatureIdxsInAgent
-    nChunkSize          = sizeof(RK_U8) * mNumValidFeature;
-    pFeatureIdxsInAgent = (RK_U8*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount  += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
+} // classMFNR::ThumbBuild()
+
+
+/************************************************************************/
+// Func: classMFNR::Register()
+// Desc: Process Module: Register Interface 
+//   In: 
+//  Out: 
+// 
+// Date: Revised by yousf 20160824
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::Register(void)
+{
+    //
+    int     ret = 0; // return value
 #if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pFeatureIdxsInAgent !\n");
+    printf("classMFNR::Register()\n");
 #endif
-        return ret;
-    }
-    // pAgentPointsWeight
-    nChunkSize = sizeof(RK_U16) * mNumValidFeature;
-    for (int k=0; k < mRawFileNum; k++)
+    //
+    RK_U16*     pTmpThumbBase = NULL;
+    RK_U16*     pTmpThumbDsp  = NULL;
+    RK_U16*     pTmpThumbRef  = NULL;
+    RK_U16*     pTmpRawBase   = NULL;
+    RK_U16*     pTmpRawRef    = NULL;
+    int         nThumbChunkStride;
+    int         radius;         // search radius
+    int         chunkIdx;       // odd-even
+    int         chunkIdx_base;  // odd-even
+    int         chunkIdx_ref;   // odd-even
+
+    //////////////////////////////////////////////////////////////////////////
+    ////-------- Step 1 Feature Detect
+    mDspArena.nStage = DSPMEM_REG_FEATURE_DETECT; // DMA Traffic site
+    //==== DSP Memory: pFeaturePoints & pThumbDspChunks & ... laid out by DspMemPlan()
+#if 1                                                       
+	// add by zxy for init the full size weigth and count statitics.            
+	// only the layout wdr_process_block reads (WDR_WEIGHT_TRANSPOSE: cell*16+bin)
+	memset( pWdrWeightMat, 0, sizeof(RK_U32) * WDR_THUMB_TABLE_SIZE );
+	memset( pWdrThumbWgtTable, 0, sizeof(RK_U16) * WDR_THUMB_TABLE_SIZE );
+	
+#endif                                                                       
+
+
+
+    //---- DMA: Thumb(DDR16bit->DSP16bit)
+    pTmpThumbBase = pThumbSrcs[mBasePicNum]; // stride = mThumbStride // addr in DDR
+    chunkIdx      = 0; // odd-even
+    pTmpThumbDsp  = pThumbDspChunks[chunkIdx] + (mThumbWid + 2) + 1;
+    //memset(pThumbDspChunks[chunkIdx], 0, 2*522*34);
+    nThumbChunkStride = sizeof(RK_U16) * (mThumbWid + 2);
+    RKDMA_ReadThumb16bit2DSP((RK_Addr)pTmpThumbBase, (RK_Addr)pTmpThumbDsp, 
+        mThumbWid, NUM_LINE_DDR2DSP_THUMB, mThumbStride, nThumbChunkStride, 0);
+
+    // The 1-pixel ring of the ThumbChunk is not filled: ThumbStripScan never
+    // reads it, its light filter clamps at the strip edges.
+    for (int i=0; i < mThumbDivSegRow; i++)
     {
-        pAgentPointsWeight[k] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-        mDspMem_UsedCount    += nChunkSize; // current used count
-        if (mDspMem_UsedCount > DSP_MEM_SIZE)
+        //---- ThumbChunk Feature Detect
+        PROFILE_BEGIN(mProfile, PROF_REG_FEATURE_DETECT);
+        ThumbStripScan(pThumbDspChunks[chunkIdx], mThumbWid+2, NUM_LINE_DDR2DSP_THUMB+2, i, mThumbDivSegCol, pFeaturePoints, pFeatureValues,
+            pWdrWeightMat, pWdrThumbWgtTable, ((mRawWid+128)>>8) + 1);
+        PROFILE_END(mProfile, PROF_REG_FEATURE_DETECT);
+
+        // Next Chunk
+        if (i < mThumbDivSegRow - 1)
         {
-#if MY_DEBUG_PRINTF == 1
-            printf("Failed to Allocate pAgentPointsWeight[%d] !\n", k);
-#endif
-            return ret;
+            //---- DMA: Thumb(DDR16bit->DSP16bit)
+            pTmpThumbBase += mThumbStride/sizeof(RK_U16)*NUM_LINE_DDR2DSP_THUMB; // addr in DDR
+            chunkIdx       = (chunkIdx + 1) & 0x1; // odd-even
+            pTmpThumbDsp   = pThumbDspChunks[chunkIdx] + (mThumbWid + 2) + 1;
+            RKDMA_ReadThumb16bit2DSP((RK_Addr)pTmpThumbBase, (RK_Addr)pTmpThumbDsp, 
+                mThumbWid, NUM_LINE_DDR2DSP_THUMB, mThumbStride, mThumbStride+4, 0);
         }
     }
 
-    //==== DSP Memory Reuse Operation
-    mDspMem_ResetPos = mDspMem_UsedCount; // Mark Position
+  
+#if 1//ndef CEVA_CHIP_CODE_BAYERWDR
 
-    //==== DSP Malloc: pRawBaseBlkDspChunks & pLumaBaseBlkDspChunks & pRawRefBlkDspChunks & pLumaRefBlkDspChunks addr in DSP
-    // pRawBaseBlkDspChunks
-    nChunkSize = sizeof(RK_U16) * FINE_MATCH_WIN_SIZE * FINE_MATCH_WIN_SIZE;
-    pRawBaseBlkDspChunks[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount      += nChunkSize; // current used count
-    pRawBaseBlkDspChunks[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount      += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRawBaseBlkDspChunks !\n");
+#if WDR_WEIGHT_TRANSPOSE// weight output is 256x16(9 valid) matrix, read as is by wdr_process_block.
+	HistFilterTranspose( pWdrThumbWgtTable, pWdrWeightMat, ((mRawHgt+128)>>8) + 1, ((mRawWid+128)>>8) + 1  );     
+	//normalize                                                                                          
+	normalizeWeightTranspose( pWdrThumbWgtTable, pWdrWeightMat, ((mRawHgt+128)>>8) + 1, ((mRawWid+128)>>8) + 1 );
+#else
+	HistFilter( pWdrThumbWgtTable, pWdrWeightMat, ((mRawHgt+128)>>8) + 1, ((mRawWid+128)>>8) + 1  );     
+	//normalize                                                                                          
+	normalizeWeight( pWdrThumbWgtTable, pWdrWeightMat, ((mRawHgt+128)>>8) + 1, ((mRawWid+128)>>8) + 1 ); 
+	//writeFile(pWdrThumbWgtTable, 9*256, "weightData_block.dat");
 #endif
-        return ret;
-    }
-    // pLumaBaseBlkDspChunks
-    nChunkSize              /= 4;
-    pLumaBaseBlkDspChunks[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount       += nChunkSize; // current used count
-    pLumaBaseBlkDspChunks[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount       += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pLumaBaseBlkDspChunks !\n");
+
+#else
+
+	//hist filter
+	countFilter_Vec( pWdrThumbWgtTable, ( mRawHgt + 128 ) / 256 + 1, ( mRawWid + 128 ) / 256 + 1, 256 );
+	weightFilter_Vec( pWdrWeightMat, ( mRawHgt + 128 ) / 256 + 1, ( mRawWid + 128 ) / 256 + 1, 256 );
+	normalizeWeight_Vec( pWdrThumbWgtTable, pWdrWeightMat, ( mRawHgt + 128 ) / 256 + 1, ( mRawWid + 128 ) / 256 + 1, 256 );
+	//writeFile(pWdrThumbWgtTable, 9*256, "weightData_block.dat");
+
 #endif
-        return ret;
+                                                                                            
+    //////////////////////////////////////////////////////////////////////////
+    ////-------- Step 2 Feature Filter
+    PROFILE_BEGIN(mProfile, PROF_REG_FEATURE_FILTER);
+    FeatureFilter(pFeaturePoints, pFeatureValues, mMaxNumFeature, mThumbWid, mThumbHgt, mNumValidFeature);
+    PROFILE_END(mProfile, PROF_REG_FEATURE_FILTER);
+    
+
+    //////////////////////////////////////////////////////////////////////////
+    ////-------- Step 3 Thumb Coarse Matching
+    mDspArena.nStage = DSPMEM_REG_COARSE_MATCH; // DMA Traffic site
+    radius = COARSE_MATCH_RADIUS;  // ceil(MAX_OFFSET * 1.0 / SCALER_FACTOR_R2T);     // search radius
+    //==== DSP Memory: pMatchPointsY/X & pThumbBaseBlkDspChunks & pThumbRefBlkDspChunks laid out by DspMemPlan()
+
+    //---- Features Coarse Matching: batches of neighbouring Features (useThumbStrip: of a FeatureDetect strip), the next batch is fetched while this one is matched
+    RK_U16      nBaseBlkRow, nBaseBlkCol, nBaseBlkHgt, nBaseBlkWid, nBaseBlkStride;
+    RK_U16      nRefBlkRow,  nRefBlkCol,  nRefBlkHgt,  nRefBlkWid;
+    RK_U16      nMatchRow, nMatchCol, nMatchCost;
+    RK_CoarseBatch  coarseBatches[2];   // odd-even
+    RK_CoarseBatch* pBatch;
+    int         nBaseRow, nBaseCol, nRefRow, nRefCol;
+    nBaseBlkHgt    = COARSE_MATCH_WIN_SIZE;
+    nBaseBlkWid    = COARSE_MATCH_WIN_SIZE;
+    chunkIdx_base  = 0; // odd-even
+    coarseBatches[chunkIdx_base].nNum = 0;
+    if (mUsePyramid)
+    {
+        // usePyramidMatch: 1/32 top, then Thumb around its Match; no batches
+        PyramidBuild();
+        mDspArena.nStage = DSPMEM_REG_COARSE_MATCH; // DMA Traffic site
+        CoarsePyramid();
     }
-    // pRawRefBlkDspChunks
-    nChunkSize = sizeof(RK_U16) * (FINE_MATCH_WIN_SIZE + 2*radius) * (FINE_MATCH_WIN_SIZE + 2*radius + 2*4); // 4PixelAlign
-    pRawRefBlkDspChunks[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount     += nChunkSize; // current used count
-    pRawRefBlkDspChunks[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount     += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
+    else
     {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRawRefBlkDspChunks !\n");
-#endif
-        return ret;
+        CoarseBatchIssue(0, chunkIdx_base, &coarseBatches[chunkIdx_base]);
     }
-    // pLumaRefBlkDspChunks
-    nChunkSize             /= 4;
-    pLumaRefBlkDspChunks[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount      += nChunkSize; // current used count
-    pLumaRefBlkDspChunks[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount      += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
+    while (coarseBatches[chunkIdx_base].nNum > 0)
     {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pLumaRefBlkDspChunks !\n");
+        pBatch = &coarseBatches[chunkIdx_base];
+        RKDMA_Sync(pBatch->nDmaPos);
+
+        // Next batch: DMA runs under the SADs of this one
+        CoarseBatchIssue(pBatch->nFirst + pBatch->nNum, (chunkIdx_base + 1) & 0x1, &coarseBatches[(chunkIdx_base + 1) & 0x1]);
+
+        for (int i=0; i < pBatch->nNum; i++)
+        {
+            int n = pBatch->nFirst + i;
+            TRACE_BEGIN(mTrace, evFeature, "coarse_feature", TRACE_TRACK_DSP);
+            TRACE_ARG(mTrace, evFeature, "n", n);
+            TRACE_ARG(mTrace, evFeature, "chunkIdx_base", chunkIdx_base);
+            // MatchPoints[Base#0][Feature#0]
+            CoarseWindow(n, nBaseRow, nBaseCol, nRefRow, nRefCol);
+            nBaseBlkRow = nBaseRow;
+            nBaseBlkCol = nBaseCol;
+            pMatchPointsY[mBasePicNum][n] = nBaseBlkRow;
+            pMatchPointsX[mBasePicNum][n] = nBaseBlkCol;
+
+            // Ref window: in the Ref strip of each frame, stride = nStripWid
+            nRefBlkRow = nRefRow;
+            nRefBlkCol = nRefCol;
+            nRefBlkHgt = pBatch->nRefHgt;
+            nRefBlkWid = pBatch->nRefWid;
+            chunkIdx_ref = 0; // Ref strip of frame k
+            if (pBatch->pBaseStrip != NULL)
+            {
+                // Base block out of the Base strip: the SAD kernels read it packed 16x16
+                pTmpThumbBase = pBatch->pBaseStrip + (nBaseBlkRow - pBatch->nBaseStripRow) * pBatch->nBaseStripWid 
+                    + (nBaseBlkCol - pBatch->nBaseStripCol);
+                for (int m=0; m < nBaseBlkHgt; m++)
+                {
+                    memcpy(pBatch->pBaseBlks + m * nBaseBlkWid, pTmpThumbBase + m * pBatch->nBaseStripWid, nBaseBlkWid * sizeof(RK_U16));
+                }
+                pTmpThumbBase = pBatch->pBaseBlks;
+            }
+            else
+            {
+                pTmpThumbBase = pBatch->pBaseBlks + i * nBaseBlkHgt * nBaseBlkWid;
+            }
+
+            // Matching Ref#k
+            for (int k=0; k < mRawFileNum; k++) // Ref#1-#5
+            {
+                if (k != mBasePicNum)
+                {
+                    pTmpThumbRef = pBatch->pRefStrips + chunkIdx_ref * mCoarseRefPitch
+                        + (nRefBlkRow - pBatch->nStripRow) * pBatch->nStripWid + (nRefBlkCol - pBatch->nStripCol);
+
+                    //---- Feature Coarse Matching
+                    PROFILE_BEGIN(mProfile, PROF_REG_COARSE_MATCH);
+                    TRACE_BEGIN(mTrace, evMatch, "FeatureCoarseMatching", TRACE_TRACK_DSP);
+                    TRACE_ARG(mTrace, evMatch, "k", k);
+                    TRACE_ARG(mTrace, evMatch, "chunkIdx_ref", chunkIdx_ref);
+                    if (mUseFastMatch)
+                    {
+                        FeatureCoarseMatchingFast(pTmpThumbBase, nBaseBlkHgt, nBaseBlkWid, 
+                            pTmpThumbRef, nRefBlkHgt, nRefBlkWid, pBatch->nStripWid, nMatchRow, nMatchCol, nMatchCost);
+                    }
+                    else
+                    {
+                        FeatureCoarseMatching(pTmpThumbBase, nBaseBlkHgt, nBaseBlkWid, 
+                            pTmpThumbRef, nRefBlkHgt, nRefBlkWid, pBatch->nStripWid, nMatchRow, nMatchCol, nMatchCost);
+                    }
+                    TRACE_END(mTrace, evMatch);
+                    PROFILE_END(mProfile, PROF_REG_COARSE_MATCH);
+
+                    // MatchPoints[Base#0][Feature#k]
+                    pMatchPointsY[k][n] = nRefBlkRow + nMatchRow;
+                    pMatchPointsX[k][n] = nRefBlkCol + nMatchCol;
+                    chunkIdx_ref++;
+                }
+            }
+            TRACE_END(mTrace, evFeature);
+        } // for i
+
+        chunkIdx_base = (chunkIdx_base + 1) & 0x1; // odd-even
+    } // while batch
+#if MFNR_TRACE == 1
+    mTraceSlot = 0;
 #endif
-        return ret;
-    }
+
+
+    //////////////////////////////////////////////////////////////////////////
+    ////-------- Step 4 Luma Fine Matching
+    mDspArena.nStage = DSPMEM_REG_FINE_MATCH; // DMA Traffic site
+    radius            = FINE_LUMA_RADIUS * 2;  // ceil(MAX_OFFSET * 1.0 / SCALER_FACTOR_R2T); // search radius
+    //==== DSP Memory: pFeatureIdxsInAgent & pAgentPointsWeight & pRaw/LumaBlkDspChunks laid out by DspMemPlan()
 
     
     //---- Features Fine Matching
@@ -1139,7 +2109,7 @@ int classMFNR::Register(void)
     nBaseBlkStride = nBaseBlkWid * sizeof(RK_U16); // stride in DSP
     pTmpRawBase    = (RK_U16*)((RK_U8*)pRawSrcs[mBasePicNum] + nBaseBlkRow * mRawStride + nBaseBlkCol*5/4); // stride = mRawStride
     chunkIdx_base  = 0; // odd-even
-    RKDMA_ReadRaw10bit2DSP((U32)pTmpRawBase, (U32)pRawBaseBlkDspChunks[chunkIdx_base], 
+    RKDMA_ReadRaw10bit2DSP((RK_Addr)pTmpRawBase, (RK_Addr)pRawBaseBlkDspChunks[chunkIdx_base], 
         nBaseBlkWid, nBaseBlkHgt, mRawStride, nBaseBlkStride, nBaseBlkCol);
     Scaler_Raw2Luma(pRawBaseBlkDspChunks[chunkIdx_base], nBaseBlkWid, nBaseBlkHgt, nBaseBlkWid/2, nBaseBlkHgt/2, 
         pLumaBaseBlkDspChunks[chunkIdx_base]);
@@ -1147,6 +2117,9 @@ int classMFNR::Register(void)
     //pAgentPointsWeight = pFeatureValues;
     for (int n=0; n < mNumValidFeature; n++)
     {
+        TRACE_BEGIN(mTrace, evFeature, "fine_feature", TRACE_TRACK_DSP);
+        TRACE_ARG(mTrace, evFeature, "n", n);
+        TRACE_ARG(mTrace, evFeature, "chunkIdx_base", chunkIdx_base);
         
         // which 64x64 in 256x256
         flagRow = 1;
@@ -1183,14 +2156,13 @@ int classMFNR::Register(void)
         nRefBlkCol       = MAX(pMatchPointsX[1][n]*scaleUpFactor + flagCol*FINE_MATCH_WIN_SIZE - radius, 0);
         nRefBlkHgt       = MIN(nBaseBlkHgt + 2*radius, mRawHgt - 1);
         nRefBlkWid       = MIN(nBaseBlkWid + 2*radius, mRawWid - 1);
-        nRefBlkStride    = nRefBlkWid * sizeof(RK_U16); // stride in DSP
         nRefBlkCol_4p    = ALIGN_4PIXEL_START(nRefBlkCol);
         nStartCol        = nRefBlkCol - nRefBlkCol_4p;
         nRefBlkWid_4p    = ALIGN_4PIXEL_WIDTH(nStartCol + nRefBlkWid);
         nRefBlkStride_4p = nRefBlkWid_4p * sizeof(RK_U16); // stride in DSP
         pTmpRawRef       = (RK_U16*)((RK_U8*)pRawSrcs[1] + nRefBlkRow * mRawStride + nRefBlkCol_4p*5/4); // stride = mThumbStride
         chunkIdx_ref     = 0; // odd-even
-        RKDMA_ReadRaw10bit2DSP((U32)pTmpRawRef, (U32)pRawRefBlkDspChunks[chunkIdx_ref], 
+        RKDMA_ReadRaw10bit2DSP((RK_Addr)pTmpRawRef, (RK_Addr)pRawRefBlkDspChunks[chunkIdx_ref], 
             nRefBlkWid_4p, nRefBlkHgt, mRawStride, nRefBlkStride_4p, nRefBlkCol_4p);
         Scaler_Raw2Luma(pRawRefBlkDspChunks[chunkIdx_ref], nRefBlkWid_4p, nRefBlkHgt, nRefBlkWid_4p/2, nRefBlkHgt/2, 
             pLumaRefBlkDspChunks[chunkIdx_ref]);
@@ -1199,10 +2171,26 @@ int classMFNR::Register(void)
         for (int k=1; k < mRawFileNum; k++) // Base#0 Ref#1-#5
         {
             //---- Feature Fine Matching
-            FeatureFineMatching(pLumaBaseBlkDspChunks[chunkIdx_base], nBaseBlkHgt/2, nBaseBlkWid/2, 
-                pLumaRefBlkDspChunks[chunkIdx_ref], nRefBlkHgt/2, nRefBlkWid_4p/2, 
-                nStartCol/2, nRefBlkWid/2, 
-                nMatchRow, nMatchCol, nMatchCost);
+            PROFILE_BEGIN(mProfile, PROF_REG_FINE_MATCH);
+            TRACE_BEGIN(mTrace, evMatch, "FeatureFineMatching", TRACE_TRACK_DSP);
+            TRACE_ARG(mTrace, evMatch, "k", k);
+            TRACE_ARG(mTrace, evMatch, "chunkIdx_ref", chunkIdx_ref);
+            if (mUseFastMatch)
+            {
+                FeatureFineMatchingFast(pLumaBaseBlkDspChunks[chunkIdx_base], nBaseBlkHgt/2, nBaseBlkWid/2, 
+                    pLumaRefBlkDspChunks[chunkIdx_ref], nRefBlkHgt/2, nRefBlkWid_4p/2, 
+                    nStartCol/2, nRefBlkWid/2, 
+                    nMatchRow, nMatchCol, nMatchCost);
+            }
+            else
+            {
+                FeatureFineMatching(pLumaBaseBlkDspChunks[chunkIdx_base], nBaseBlkHgt/2, nBaseBlkWid/2, 
+                    pLumaRefBlkDspChunks[chunkIdx_ref], nRefBlkHgt/2, nRefBlkWid_4p/2, 
+                    nStartCol/2, nRefBlkWid/2, 
+                    nMatchRow, nMatchCol, nMatchCost);
+            }
+            TRACE_END(mTrace, evMatch);
+            PROFILE_END(mProfile, PROF_REG_FINE_MATCH);
 
             // MatchPoints[Base#0][Feature#k]
             pMatchPointsY[k][n] = nRefBlkRow    + nMatchRow * 2;
@@ -1210,7 +2198,7 @@ int classMFNR::Register(void)
 
             // pAgentPointsWeight
 //            pAgentPointsWeight[k][n] = ROUND_U16( (nFeatureValue << 16) * 1.0 / nMatchCost );
-            pAgentPointsWeight[k][n] = ROUND_U16( (nFeatureValue << 16) / nMatchCost );
+            pAgentPointsWeight[k][n] = ROUND_U16( (nFeatureValue << 16) / MAX(nMatchCost, 1) ); // cost 0: identical frames
 //			pAgentPointsWeight[k][n] = ( (nFeatureValue << 16) / nMatchCost ) & 0xFFFF;
 
             // Next RefChunk
@@ -1221,14 +2209,13 @@ int classMFNR::Register(void)
                 nRefBlkCol       = MAX(pMatchPointsX[k+1][n]*scaleUpFactor + flagCol*FINE_MATCH_WIN_SIZE - radius, 0);
                 nRefBlkHgt       = MIN(nBaseBlkHgt + 2*radius, mRawHgt - 1);
                 nRefBlkWid       = MIN(nBaseBlkWid + 2*radius, mRawWid - 1);
-                nRefBlkStride    = nRefBlkHgt * sizeof(RK_U16); // stride in DSP
                 nRefBlkCol_4p    = ALIGN_4PIXEL_START(nRefBlkCol);
                 nStartCol        = nRefBlkCol - nRefBlkCol_4p;
                 nRefBlkWid_4p    = ALIGN_4PIXEL_WIDTH(nStartCol + nRefBlkWid);
                 nRefBlkStride_4p = nRefBlkWid_4p * sizeof(RK_U16); // stride in DSP
                 pTmpRawRef       = (RK_U16*)((RK_U8*)pRawSrcs[k+1] + nRefBlkRow * mRawStride + nRefBlkCol_4p*5/4); // stride = mThumbStride
                 chunkIdx_ref     = (chunkIdx_ref + 1) & 0x1; // odd-even
-                RKDMA_ReadRaw10bit2DSP((U32)pTmpRawRef, (U32)pRawRefBlkDspChunks[chunkIdx_ref], 
+                RKDMA_ReadRaw10bit2DSP((RK_Addr)pTmpRawRef, (RK_Addr)pRawRefBlkDspChunks[chunkIdx_ref], 
                     nRefBlkWid_4p, nRefBlkHgt, mRawStride, nRefBlkStride_4p, nRefBlkCol_4p);
                 Scaler_Raw2Luma(pRawRefBlkDspChunks[chunkIdx_ref], nRefBlkWid_4p, nRefBlkHgt, nRefBlkWid_4p/2, nRefBlkHgt/2, 
                     pLumaRefBlkDspChunks[chunkIdx_ref]);
@@ -1248,160 +2235,25 @@ int classMFNR::Register(void)
             nBaseBlkStride = nBaseBlkWid * sizeof(RK_U16);
             pTmpRawBase    = (RK_U16*)((RK_U8*)pRawSrcs[mBasePicNum] + nBaseBlkRow * mRawStride + nBaseBlkCol*5/4); // stride = mRawStride
             chunkIdx_base  = (chunkIdx_base + 1) & 0x1; // odd-even
-            RKDMA_ReadRaw10bit2DSP((U32)pTmpRawBase, (U32)pRawBaseBlkDspChunks[chunkIdx_base], 
-                nBaseBlkWid, nBaseBlkHgt, mRawStride, nBaseBlkStride, nBaseBlkCol);
-            Scaler_Raw2Luma(pRawBaseBlkDspChunks[chunkIdx_base], nBaseBlkWid, nBaseBlkHgt, nBaseBlkWid/2, nBaseBlkHgt/2, 
-                pLumaBaseBlkDspChunks[chunkIdx_base]);
-        }
-    } // for n
-
-   
-
-    //////////////////////////////////////////////////////////////////////////
-    ////-------- Step 5 Compute Homography
-    mDspMem_UsedCount = mDspMem_ResetPos; // Mark Position
-    //==== DSP Malloc: pHomographyMatrix addr in DSP
-    // pHomographyMatrix move to the DSP Memory addr#0
-
-    //==== DSP Memory Reuse Operation
-    mDspMem_ResetPos = mDspMem_UsedCount; // Mark Position
-
-    //==== DSP Malloc: pRowMvHist & pColMvHist & pMarkMatchFeature & ... addr in DSP
-    // pRowMvHist & pColMvHist
-#if USE_MV_HIST_FILTRATE == 1
-    nChunkSize         = sizeof(RK_U8) * LEN_MV_HIST;
-    pRowMvHist         = (RK_U8*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    pColMvHist         = (RK_U8*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRowMvHist & pColMvHist !\n");
-#endif
-        return ret;
-    }
-#endif
-    // pMarkMatchFeature
-    nChunkSize         = sizeof(RK_U8) * MAX_NUM_MATCH_FEATURE;
-    pMarkMatchFeature  = (RK_U8*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pMarkMatchFeature !\n");
-#endif
-        return ret;
-    }
-    // pAgentsIn4x4Region_Marks // Agents in 4x4 Region [RegMark4x4] * 16
-    nChunkSize               = sizeof(RK_U8) * NUM_DIVIDE_IMAGE * NUM_DIVIDE_IMAGE;
-    pAgentsIn4x4Region_Marks = (RK_U8*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount       += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pAgentsIn4x4Region_Marks !\n");
-#endif
-        return ret;
-    }
-    // pAgentsIn4x4Region_Wgts // Agents in 4x4 Region [Sharp/SAD] * 16
-    nChunkSize              = sizeof(RK_U16) * NUM_DIVIDE_IMAGE * NUM_DIVIDE_IMAGE;
-    pAgentsIn4x4Region_Wgts = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount      += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pAgentsIn4x4Region_Wgts !\n");
-#endif
-        return ret;
-    }
-    // pAgentsIn4x4Region_PtYs & pAgentsIn4x4Region_PtXs
-    nChunkSize = sizeof(RK_U16) * NUM_DIVIDE_IMAGE * NUM_DIVIDE_IMAGE;
-    for (int k=0; k < mRawFileNum; k++)
-    {
-        // Agents in 4x4 Region [Y] * RawFileNum * 16
-        pAgentsIn4x4Region_PtYs[k] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-        mDspMem_UsedCount         += nChunkSize; // current used count
-        if (mDspMem_UsedCount > DSP_MEM_SIZE)
-        {
-#if MY_DEBUG_PRINTF == 1
-            printf("Failed to Allocate pAgentsIn4x4Region_PtYs !\n");
-#endif
-            return ret;
-        }
-        // Agents in 4x4 Region [X] * RawFileNum * 16
-        pAgentsIn4x4Region_PtXs[k] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-        mDspMem_UsedCount         += nChunkSize; // current used count
-        if (mDspMem_UsedCount > DSP_MEM_SIZE)
-        {
-#if MY_DEBUG_PRINTF == 1
-            printf("Failed to Allocate pAgentsIn4x4Region_PtXs !\n");
-#endif
-            return ret;
-        }
-    }
-    // pRegion4Points // 4 points in 4 Regions: [x0,y0,x1,y1] * 4Points * 2Byte
-    nChunkSize     = sizeof(RK_U16) * 4 * 4;
-    pRegion4Points = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRegion4Points !\n");
-#endif
-        return ret;
-    }
-    // pMatrixA // Coefficient Matrix A for A*X = B: 8*8*4Byte
-    nChunkSize = sizeof(RK_F32) * 8 * 8;
-    pMatrixA   = (RK_F32*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pMatrixA !\n");
-#endif
-        return ret;
-    }
-    // pVectorB // Coefficient Vector B for A*X = B: 8*1*4Byte
-    nChunkSize = sizeof(RK_F32) * 8 * 1;
-    pVectorB   = (RK_F32*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pVectorB !\n");
-#endif
-        return ret;
-    }
-    // pVectorX // Coefficient Vector X for A*X = B: 3*3*4Byte
-    nChunkSize = sizeof(RK_F32) * 3 * 3;
-    pVectorX   = (RK_F32*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pVectorX !\n");
-#endif
-        return ret;
-    }
-    // pBasePoint & pRefPoint & pProjPoint
-    nChunkSize = sizeof(RK_F32) * 2;
-    pBasePoint = (RK_F32*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    pRefPoint  = (RK_F32*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    pProjPoint = (RK_F32*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pBasePoint & pRefPoint & pProjPoint !\n");
-#endif
-        return ret;
-    }
+            RKDMA_ReadRaw10bit2DSP((RK_Addr)pTmpRawBase, (RK_Addr)pRawBaseBlkDspChunks[chunkIdx_base], 
+                nBaseBlkWid, nBaseBlkHgt, mRawStride, nBaseBlkStride, nBaseBlkCol);
+            Scaler_Raw2Luma(pRawBaseBlkDspChunks[chunkIdx_base], nBaseBlkWid, nBaseBlkHgt, nBaseBlkWid/2, nBaseBlkHgt/2, 
+                pLumaBaseBlkDspChunks[chunkIdx_base]);
+        }
+        TRACE_END(mTrace, evFeature);
+    } // for n
+
+   
+
+    //////////////////////////////////////////////////////////////////////////
+    ////-------- Step 5 Compute Homography
+    mDspArena.nStage = DSPMEM_REG_HOMOGRAPHY; // DMA Traffic site
+    //==== DSP Memory: pMarkMatchFeature & pAgentsIn4x4Region_* & pMatrixA & ... laid out by DspMemPlan()
 
 
 
+    PROFILE_BEGIN(mProfile, PROF_REG_HOMOGRAPHY);
+
     // init vars
     int         Index4x4;       // Index:0 -- (NUM_DIVIDE_IMAGE * NUM_DIVIDE_IMAGE - 1)
     RK_U16      wgt;            // wgt = sum(Sharp/SAD)
@@ -1718,6 +2570,7 @@ int classMFNR::Register(void)
         } // if (k != mBasePicNum)
     } // for k
 
+    PROFILE_END(mProfile, PROF_REG_HOMOGRAPHY);
 
 
     //
@@ -1727,6 +2580,455 @@ int classMFNR::Register(void)
 } // classMFNR::Register()
 
 
+/************************************************************************/
+// Func: classMFNR::CoarseBatchIssue()
+// Desc: Group the Features from nFirst on into one Register Step 3 batch
+//       and issue its DMA: the Base blocks, and per Ref frame one strip
+//       covering the Ref windows of every Feature in the batch.
+//       A Feature joins while the strip fits COARSE_STRIP_HGT x COARSE_STRIP_WID
+//       and fetches no more than the separate windows would; useThumbStrip:
+//       every Feature of the FeatureDetect strip joins, and the Base blocks
+//       come as one strip too
+//   In: nFirst             - [in] first Feature of the batch
+//       nChunkIdx          - [in] odd-even batch slot
+//  Out: pBatch             - [out] batch, nNum = 0 past the last Feature;
+//                                  data valid after RKDMA_Sync(pBatch->nDmaPos)
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::CoarseBatchIssue(int nFirst, int nChunkIdx, RK_CoarseBatch* pBatch)
+{
+    //
+    int     ret = 0; // return value
+    int     radius = COARSE_MATCH_RADIUS; // search radius
+    int     nWinSize = COARSE_MATCH_WIN_SIZE;
+    int     nBaseRow, nBaseCol, nRefRow, nRefCol;
+    int     nRowBeg, nColBeg, nRowEnd, nColEnd;     // Ref strip
+    int     nBaseRowBeg, nBaseColBeg, nBaseRowEnd, nBaseColEnd; // Base strip
+    int     nUnionHgt, nUnionWid;
+    int     nArea = 0;  // area of the separate windows
+    int     nStrip = 0; // FeatureDetect strip of the batch
+    int     nRefIdx;
+    RK_U16* pTmpThumb;
+
+    pBatch->nFirst     = nFirst;
+    pBatch->nNum       = 0;
+    pBatch->nDmaPos    = 0;
+    pBatch->pBaseBlks  = pThumbBaseBlkDspChunks[nChunkIdx];
+    pBatch->pBaseStrip = NULL;
+    pBatch->pRefStrips = pThumbRefBlkDspChunks[nChunkIdx];
+    pBatch->nRefHgt    = MIN(nWinSize + 2*radius, mThumbHgt - 1);
+    pBatch->nRefWid    = MIN(nWinSize + 2*radius, mThumbWid - 1);
+    nRowBeg = nColBeg = nRowEnd = nColEnd = 0;
+    nBaseRowBeg = nBaseColBeg = nBaseRowEnd = nBaseColEnd = 0;
+    if (nFirst < mNumValidFeature)
+    {
+        nStrip = pFeaturePoints[0][nFirst] / NUM_LINE_DDR2DSP_THUMB;
+    }
+
+    //---- Features of the batch
+    for (int n=nFirst; n < mNumValidFeature; n++)
+    {
+        if (mUseThumbStrip)
+        {
+            if (pFeaturePoints[0][n] / NUM_LINE_DDR2DSP_THUMB != nStrip)
+            {
+                break;
+            }
+        }
+        else if (pBatch->nNum >= COARSE_BATCH_FEATURES)
+        {
+            break;
+        }
+        CoarseWindow(n, nBaseRow, nBaseCol, nRefRow, nRefCol);
+        if (pBatch->nNum == 0)
+        {
+            nRowBeg = nRefRow;
+            nColBeg = nRefCol;
+            nRowEnd = nRefRow + pBatch->nRefHgt;
+            nColEnd = nRefCol + pBatch->nRefWid;
+            nBaseRowBeg = nBaseRow;
+            nBaseColBeg = nBaseCol;
+            nBaseRowEnd = nBaseRow + nWinSize;
+            nBaseColEnd = nBaseCol + nWinSize;
+        }
+        else
+        {
+            nUnionHgt = MAX(nRowEnd, nRefRow + pBatch->nRefHgt) - MIN(nRowBeg, nRefRow);
+            nUnionWid = MAX(nColEnd, nRefCol + pBatch->nRefWid) - MIN(nColBeg, nRefCol);
+            if (!mUseThumbStrip 
+                && (nUnionHgt > COARSE_STRIP_HGT || nUnionWid > COARSE_STRIP_WID 
+                    || nUnionHgt * nUnionWid > nArea + pBatch->nRefHgt * pBatch->nRefWid))
+            {
+                break;
+            }
+            nRowBeg = MIN(nRowBeg, nRefRow);
+            nColBeg = MIN(nColBeg, nRefCol);
+            nRowEnd = MAX(nRowEnd, nRefRow + pBatch->nRefHgt);
+            nColEnd = MAX(nColEnd, nRefCol + pBatch->nRefWid);
+            nBaseRowBeg = MIN(nBaseRowBeg, nBaseRow);
+            nBaseColBeg = MIN(nBaseColBeg, nBaseCol);
+            nBaseRowEnd = MAX(nBaseRowEnd, nBaseRow + nWinSize);
+            nBaseColEnd = MAX(nBaseColEnd, nBaseCol + nWinSize);
+        }
+        pBatch->nNum++;
+        nArea += pBatch->nRefHgt * pBatch->nRefWid;
+    }
+    if (pBatch->nNum == 0)
+    {
+        return ret;
+    }
+    pBatch->nStripRow = nRowBeg;
+    pBatch->nStripCol = nColBeg;
+    pBatch->nStripHgt = nRowEnd - nRowBeg;
+    pBatch->nStripWid = nColEnd - nColBeg;
+
+#if MFNR_TRACE == 1
+    mTraceSlot = nChunkIdx;
+#endif
+    //---- DMA: ThumbBase(DDR16bit->DSP16bit)
+    if (mUseThumbStrip)
+    {
+        // one strip, the 16x16 block in matching after it
+        pBatch->nBaseStripRow = nBaseRowBeg;
+        pBatch->nBaseStripCol = nBaseColBeg;
+        pBatch->nBaseStripHgt = nBaseRowEnd - nBaseRowBeg;
+        pBatch->nBaseStripWid = nBaseColEnd - nBaseColBeg;
+        pBatch->pBaseStrip    = pBatch->pBaseBlks;
+        pBatch->pBaseBlks     = pBatch->pBaseStrip + NUM_LINE_DDR2DSP_THUMB * mThumbWid;
+        pTmpThumb = pThumbSrcs[mBasePicNum] + pBatch->nBaseStripRow * mThumbStride/2 + pBatch->nBaseStripCol; // stride = mThumbStride
+        pBatch->nDmaPos = RKDMA_IssueThumb16bit2DSP((RK_Addr)pTmpThumb, (RK_Addr)pBatch->pBaseStrip, 
+            pBatch->nBaseStripWid, pBatch->nBaseStripHgt, mThumbStride, pBatch->nBaseStripWid * sizeof(RK_U16), pBatch->nBaseStripCol);
+    }
+    else
+    {
+        // a block per Feature
+        for (int i=0; i < pBatch->nNum; i++)
+        {
+            CoarseWindow(nFirst + i, nBaseRow, nBaseCol, nRefRow, nRefCol);
+            pTmpThumb = pThumbSrcs[mBasePicNum] + nBaseRow * mThumbStride/2 + nBaseCol; // stride = mThumbStride
+            pBatch->nDmaPos = RKDMA_IssueThumb16bit2DSP((RK_Addr)pTmpThumb, (RK_Addr)(pBatch->pBaseBlks + i * nWinSize * nWinSize), 
+                nWinSize, nWinSize, mThumbStride, nWinSize * sizeof(RK_U16), nBaseCol);
+        }
+    }
+
+    //---- DMA: ThumbRef(DDR16bit->DSP16bit), a strip per Ref frame
+    nRefIdx = 0;
+    for (int k=0; k < mRawFileNum; k++)
+    {
+        if (k != mBasePicNum)
+        {
+            pTmpThumb = pThumbSrcs[k] + pBatch->nStripRow * mThumbStride/2 + pBatch->nStripCol; // stride = mThumbStride
+            pBatch->nDmaPos = RKDMA_IssueThumb16bit2DSP((RK_Addr)pTmpThumb, 
+                (RK_Addr)(pBatch->pRefStrips + nRefIdx * mCoarseRefPitch), 
+                pBatch->nStripWid, pBatch->nStripHgt, mThumbStride, pBatch->nStripWid * sizeof(RK_U16), pBatch->nStripCol);
+            nRefIdx++;
+        }
+    }
+
+    //
+    return ret;
+
+} // classMFNR::CoarseBatchIssue()
+
+
+/************************************************************************/
+// Func: classMFNR::CoarseWindow()
+// Desc: Base block & Ref window of Feature n in Register Step 3
+//   In: n                  - [in] Feature
+//  Out: nBaseRow, nBaseCol - [out] 16x16 Base block in 32x32 Segment, 16-aligned
+//       nRefRow, nRefCol   - [out] (16+2*radius)x(16+2*radius) Ref window
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+void classMFNR::CoarseWindow(int n, int& nBaseRow, int& nBaseCol, int& nRefRow, int& nRefCol)
+{
+    int     radius = COARSE_MATCH_RADIUS; // search radius
+
+    nBaseRow = COARSE_MATCH_WIN_SIZE * (pFeaturePoints[0][n] / COARSE_MATCH_WIN_SIZE); // select 16x16Block in 32x32Block in BaseThumb
+    nBaseCol = COARSE_MATCH_WIN_SIZE * (pFeaturePoints[1][n] / COARSE_MATCH_WIN_SIZE);
+    nRefRow  = MAX(nBaseRow - radius, 0); // block(row, col) (16+2*radius)x(16+2*radius)
+    nRefCol  = MAX(nBaseCol - radius, 0);
+
+} // classMFNR::CoarseWindow()
+
+
+/************************************************************************/
+// Func: classMFNR::PyramidBuild()
+// Desc: Process Module: Pyramid top of every frame, from its ThumbSrcs.
+//       Thumb strips of NUM_LINE_DDR2DSP_THUMB rows, the next strip in
+//       flight while ThumbPyramidBox() sums this one; PYR_BUILD_ROWS top
+//       rows are written back to DDR per strip
+//   In: 
+//  Out: pPyrBufs[k]        - [out] Pyramid top of frame k, mPyrStride
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::PyramidBuild(void)
+{
+    //
+    int     ret = 0; // return value
+#if MY_DEBUG_PRINTF == 1
+    printf("classMFNR::PyramidBuild()\n");
+#endif
+    int     nStrips  = (mPyrHgt + PYR_BUILD_ROWS - 1) / PYR_BUILD_ROWS;   // strips of a frame
+    int     nNum     = mRawFileNum * nStrips;                           // strips of the burst
+    int     chunkIdx = 0;  // odd-even
+    int     pos[2]   = { 0, 0 };
+    int     k, nRow, nRows;
+
+    mDspArena.nStage = DSPMEM_REG_PYRAMID; // DMA Traffic site
+    //==== DSP Memory: pPyrThumbChunks & pPyrRowChunk laid out by DspMemPlan()
+
+    for (int t=0; t <= nNum; t++)
+    {
+        //---- DMA: Thumb strip t (DDR16bit->DSP16bit) while strip t-1 is summed
+        if (t < nNum)
+        {
+            k     = t / nStrips;
+            nRow  = t % nStrips * PYR_BUILD_ROWS;
+            nRows = MIN(PYR_BUILD_ROWS, mPyrHgt - nRow);
+            pos[t & 0x1] = RKDMA_IssueThumb16bit2DSP((RK_Addr)((RK_U8*)pThumbSrcs[k] + nRow * SCALER_FACTOR_T2P * mThumbStride),
+                (RK_Addr)pPyrThumbChunks[t & 0x1], mThumbWid, nRows * SCALER_FACTOR_T2P, mThumbStride, mThumbWid * sizeof(RK_U16), 0);
+        }
+        if (t == 0)
+        {
+            continue;
+        }
+        chunkIdx = (t - 1) & 0x1;
+        k        = (t - 1) / nStrips;
+        nRow     = (t - 1) % nStrips * PYR_BUILD_ROWS;
+        nRows    = MIN(PYR_BUILD_ROWS, mPyrHgt - nRow);
+        RKDMA_Sync(pos[chunkIdx]);
+
+        //---- top rows of the strip
+        PROFILE_BEGIN(mProfile, PROF_REG_PYRAMID);
+        for (int i=0; i < nRows; i++)
+        {
+            ThumbPyramidBox(pPyrThumbChunks[chunkIdx] + i * SCALER_FACTOR_T2P * mThumbWid, mThumbWid, mPyrWid,
+                pPyrRowChunk + i * mPyrWid);
+        }
+        PROFILE_END(mProfile, PROF_REG_PYRAMID);
+
+        //---- DMA: top rows (DSP16bit->DDR16bit)
+        RKDMA_WriteThumb16bit2DDR((RK_Addr)pPyrRowChunk, (RK_Addr)((RK_U8*)pPyrBufs[k] + nRow * mPyrStride),
+            mPyrWid, nRows, mPyrWid * sizeof(RK_U16), mPyrStride, 0);
+    }
+
+    //
+    return ret;
+
+} // classMFNR::PyramidBuild()
+
+
+/************************************************************************/
+// Func: classMFNR::PyramidWindow()
+// Desc: Base block & Ref window of Feature n, Ref frame k, at one level of
+//       CoarsePyramid(). The window is the predicted position +-radius,
+//       cut (not shifted) at the frame edge
+//   In: nLevel             - [in] 0-Pyramid top, pyramid-centred on the Thumb Base block,
+//                                   predicted at zero motion, +-PYR_MATCH_RADIUS;
+//                                 1-Thumb, predicted by pMatchPointsY/X[k][n], +-PYR_THUMB_RADIUS
+//       n                  - [in] Feature
+//       k                  - [in] Ref frame
+//  Out: nBaseRow, nBaseCol - [out] 16x16 Base block at the level
+//       nRefRow, nRefCol   - [out] Ref window, predicted position MIN(radius, prediction) in
+//       nRefHgt, nRefWid
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+void classMFNR::PyramidWindow(int nLevel, int n, int k, int& nBaseRow, int& nBaseCol, int& nRefRow, int& nRefCol, int& nRefHgt, int& nRefWid)
+{
+    int     nWinSize = PYR_MATCH_WIN_SIZE;
+    int     radius, nHgt, nWid, nPredRow, nPredCol;
+
+    CoarseWindow(n, nBaseRow, nBaseCol, nRefRow, nRefCol);
+    if (nLevel == 0)
+    {
+        radius   = PYR_MATCH_RADIUS;
+        nHgt     = mPyrHgt;
+        nWid     = mPyrWid;
+        nBaseRow = MIN(MAX((nBaseRow + nWinSize/2) / SCALER_FACTOR_T2P - nWinSize/2, 0), mPyrHgt - nWinSize);
+        nBaseCol = MIN(MAX((nBaseCol + nWinSize/2) / SCALER_FACTOR_T2P - nWinSize/2, 0), mPyrWid - nWinSize);
+        nPredRow = nBaseRow;
+        nPredCol = nBaseCol;
+    }
+    else
+    {
+        radius   = PYR_THUMB_RADIUS;
+        nHgt     = mThumbHgt;
+        nWid     = mThumbWid;
+        nPredRow = pMatchPointsY[k][n];
+        nPredCol = pMatchPointsX[k][n];
+    }
+    nRefRow = MAX(nPredRow - radius, 0);
+    nRefCol = MAX(nPredCol - radius, 0);
+    nRefHgt = MIN(nPredRow + nWinSize + radius, nHgt) - nRefRow;
+    nRefWid = MIN(nPredCol + nWinSize + radius, nWid) - nRefCol;
+
+} // classMFNR::PyramidWindow()
+
+
+/************************************************************************/
+// Func: classMFNR::PyramidIssue()
+// Desc: Issue the DMA of Feature n at one level of CoarsePyramid(): the
+//       Base block, and the Ref window of each Ref frame, packed
+//   In: nLevel             - [in] 0-Pyramid top, 1-Thumb
+//       n                  - [in] Feature
+//       nChunkIdx          - [in] odd-even chunk slot
+//  Out: pThumbBaseBlkDspChunks[nChunkIdx], pThumbRefBlkDspChunks[nChunkIdx]
+//       return             - rdma ticket of the last transfer
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::PyramidIssue(int nLevel, int n, int nChunkIdx)
+{
+    RK_U16**    pSrcs   = nLevel == 0 ? pPyrBufs : pThumbSrcs;
+    int         nStride = nLevel == 0 ? mPyrStride : mThumbStride;
+    int         nWinSize = PYR_MATCH_WIN_SIZE;
+    int         nBaseRow, nBaseCol, nRefRow, nRefCol, nRefHgt, nRefWid;
+    int         nRefIdx = 0;
+    int         pos;
+    RK_U16*     pTmpSrc;
+
+#if MFNR_TRACE == 1
+    mTraceSlot = nChunkIdx;
+#endif
+    //---- DMA: Base block (DDR16bit->DSP16bit)
+    PyramidWindow(nLevel, n, mBasePicNum, nBaseRow, nBaseCol, nRefRow, nRefCol, nRefHgt, nRefWid);
+    pTmpSrc = (RK_U16*)((RK_U8*)pSrcs[mBasePicNum] + nBaseRow * nStride) + nBaseCol;
+    pos = RKDMA_IssueThumb16bit2DSP((RK_Addr)pTmpSrc, (RK_Addr)pThumbBaseBlkDspChunks[nChunkIdx], 
+        nWinSize, nWinSize, nStride, nWinSize * sizeof(RK_U16), nBaseCol);
+
+    //---- DMA: Ref window per Ref frame (DDR16bit->DSP16bit)
+    for (int k=0; k < mRawFileNum; k++)
+    {
+        if (k != mBasePicNum)
+        {
+            PyramidWindow(nLevel, n, k, nBaseRow, nBaseCol, nRefRow, nRefCol, nRefHgt, nRefWid);
+            pTmpSrc = (RK_U16*)((RK_U8*)pSrcs[k] + nRefRow * nStride) + nRefCol;
+            pos = RKDMA_IssueThumb16bit2DSP((RK_Addr)pTmpSrc, (RK_Addr)(pThumbRefBlkDspChunks[nChunkIdx] + nRefIdx * mCoarseRefPitch), 
+                nRefWid, nRefHgt, nStride, nRefWid * sizeof(RK_U16), nRefCol);
+            nRefIdx++;
+        }
+    }
+
+    return pos;
+
+} // classMFNR::PyramidIssue()
+
+
+/************************************************************************/
+// Func: classMFNR::CoarsePyramid()
+// Desc: Register Step 3 in place of the Thumb windows (usePyramidMatch):
+//       every Feature is matched at the 1/32 Pyramid top around zero
+//       motion (+-PYR_MATCH_RADIUS), then at the Thumb around that Match
+//       scaled up (+-PYR_THUMB_RADIUS); the next Feature is fetched while
+//       this one is matched
+//   In: 
+//  Out: pMatchPointsY/X    - [out] Thumb Base block & Match per frame, as Step 3
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::CoarsePyramid(void)
+{
+    //
+    int     ret = 0; // return value
+    int     nWinSize = PYR_MATCH_WIN_SIZE;
+    int     nBaseRow, nBaseCol, nRefRow, nRefCol, nRefHgt, nRefWid;
+    int     nThumbRow, nThumbCol, nPredRow, nPredCol;
+    int     radius;
+    int     chunkIdx;  // odd-even
+    int     pos[2] = { 0, 0 };
+    int     nRefIdx;
+    RK_U16  nMatchRow, nMatchCol, nMatchCost;
+
+    if (mNumValidFeature == 0)
+    {
+        return ret;
+    }
+
+    for (int nLevel=0; nLevel < 2; nLevel++)
+    {
+        radius   = nLevel == 0 ? PYR_MATCH_RADIUS : PYR_THUMB_RADIUS;
+        chunkIdx = 0;
+        pos[chunkIdx] = PyramidIssue(nLevel, 0, chunkIdx);
+        for (int n=0; n < mNumValidFeature; n++)
+        {
+            // Next Feature: DMA runs under the SADs of this one
+            if (n + 1 < mNumValidFeature)
+            {
+                pos[chunkIdx ^ 1] = PyramidIssue(nLevel, n + 1, chunkIdx ^ 1);
+            }
+            RKDMA_Sync(pos[chunkIdx]);
+
+            TRACE_BEGIN(mTrace, evFeature, "pyramid_feature", TRACE_TRACK_DSP);
+            TRACE_ARG(mTrace, evFeature, "n", n);
+            TRACE_ARG(mTrace, evFeature, "level", nLevel);
+            CoarseWindow(n, nThumbRow, nThumbCol, nRefRow, nRefCol);
+
+            // Matching Ref#k
+            nRefIdx = 0;
+            for (int k=0; k < mRawFileNum; k++)
+            {
+                if (k != mBasePicNum)
+                {
+                    PyramidWindow(nLevel, n, k, nBaseRow, nBaseCol, nRefRow, nRefCol, nRefHgt, nRefWid);
+                    nPredRow = nLevel == 0 ? nBaseRow : pMatchPointsY[k][n];
+                    nPredCol = nLevel == 0 ? nBaseCol : pMatchPointsX[k][n];
+
+                    //---- Feature Pyramid Matching
+                    PROFILE_BEGIN(mProfile, PROF_REG_COARSE_MATCH);
+                    TRACE_BEGIN(mTrace, evMatch, "FeaturePyramidMatching", TRACE_TRACK_DSP);
+                    TRACE_ARG(mTrace, evMatch, "k", k);
+                    FeaturePyramidMatching(pThumbBaseBlkDspChunks[chunkIdx], nWinSize, nWinSize, 
+                        pThumbRefBlkDspChunks[chunkIdx] + nRefIdx * mCoarseRefPitch, nRefHgt, nRefWid, nRefWid, 
+                        MIN(radius, nPredRow), MIN(radius, nPredCol), nMatchRow, nMatchCol, nMatchCost);
+                    TRACE_END(mTrace, evMatch);
+                    PROFILE_END(mProfile, PROF_REG_COARSE_MATCH);
+
+                    // MatchPoints[Base#0][Feature#k]: top Match -> Thumb prediction, Thumb Match
+                    if (nLevel == 0)
+                    {
+                        pMatchPointsY[k][n] = MIN(MAX(nThumbRow + (nRefRow + nMatchRow - nBaseRow) * SCALER_FACTOR_T2P, 0), mThumbHgt - nWinSize);
+                        pMatchPointsX[k][n] = MIN(MAX(nThumbCol + (nRefCol + nMatchCol - nBaseCol) * SCALER_FACTOR_T2P, 0), mThumbWid - nWinSize);
+                    }
+                    else
+                    {
+                        pMatchPointsY[k][n] = nRefRow + nMatchRow;
+                        pMatchPointsX[k][n] = nRefCol + nMatchCol;
+                    }
+                    nRefIdx++;
+                }
+            }
+
+            // MatchPoints[Base#0][Feature#0]
+            pMatchPointsY[mBasePicNum][n] = nThumbRow;
+            pMatchPointsX[mBasePicNum][n] = nThumbCol;
+            TRACE_END(mTrace, evFeature);
+
+            chunkIdx ^= 1; // odd-even
+        }
+    }
+
+    //
+    return ret;
+
+} // classMFNR::CoarsePyramid()
+
+
 /************************************************************************/
 // Func: classMFNR::Register_BypassWrite()
 // Desc: Register_BypassRead
@@ -1895,8 +3197,7 @@ int classMFNR::Enhancer(RK_RawType* pRawDst)
     printf("classMFNR::Enhancer()\n");
 #endif
     ////-------- TemporalDenoise & BayerWDR & SpatialDenoise
-    mDspMem_UsedCount = mDspMem_ResetPos; // Mark Position
-    int         nChunkSize;
+    mDspArena.nStage = DSPMEM_ENHANCER; // DMA Traffic site
     int			blkHgt  = RAW_BLK_SIZE;	                // Block Height in Raw Allowed to Read
     int			blkWid  = RAW_BLK_SIZE * RAW_WIN_NUM;	// Block Width  in Raw Allowed to Read
 
@@ -1933,259 +3234,41 @@ int classMFNR::Enhancer(RK_RawType* pRawDst)
     RK_S32      nRefBlkRow_border; // RefBlock
     RK_S32      nRefBlkCol_border;
     RK_S32      nRefBlkHgt_border;
-    RK_S32      nRefBlkWid_border;
-    RK_S32      nRefBlkStride_border;
-
-    // 4PixelAlign Rectangle for DMA
-    RK_U16      nBaseBlkRow_4p; // BaseBlock
-    RK_U16      nBaseBlkCol_4p;
-    RK_U16      nBaseBlkHgt_4p;
-    RK_U16      nBaseBlkWid_4p; 
-    RK_U16      nRefBlkRow_4p; // RefBlock
-    RK_U16      nRefBlkCol_4p;
-    RK_U16      nRefBlkHgt_4p;
-    RK_U16      nRefBlkWid_4p; 
-    RK_U16      nStartCol_4p;
-    int         nColCrop;
-
-    // Half Block Size
-    RK_U16      nHalfBlkHgt;        // Half Block Hgt
-    RK_U16      nHalfBlkWid;        // Half Block Wid
-
-    // Project Result
-    RK_S32      minRefBlocksRow;    // min Ref Row in Current Chunk
-    RK_S32      maxRefBlocksRow;    // max Ref Row in Current Chunk
-    RK_S32      minRefBlocksCol;    // min Ref Col in Current Chunk
-    RK_S32      maxRefBlocksCol;    // max Ref Col in Current Chunk
-    RK_U16      maxProjRowDist;     // max Ref ProjRowDist in Current Chunk
-    RK_U16      maxProjColDist;     // max Ref ProjColDist in Current Chunk
-
-    // Rects of Raw data
-    RK_RectExt  rectBase;           // Rect Info of RawBase Chunk
-    RK_RectExt  rectRef;            // Rect Info of RawRef Chunk
-
-
-    //==== pBaseBlocksPoint & pProjBlocksPoint & ... addr in DSP
-    // pBaseBlocksPoint & pProjBlocksPoint
-    nChunkSize = sizeof(RK_F32) * 2;
-    for (int i=0; i < RAW_WIN_NUM; i++)
-    {
-        // pBaseBlocksPoint // BaseBlocks Center Pointer: 4 Points for n-block(32x32)
-        pBaseBlocksPoint[i] = (RK_F32*)&dspMemoryArray[mDspMem_UsedCount];
-        mDspMem_UsedCount  += nChunkSize; // current used count
-        if (mDspMem_UsedCount > DSP_MEM_SIZE)
-        {
-#if MY_DEBUG_PRINTF == 1
-            printf("Failed to Allocate pBaseBlocksPoint[%d] !\n", i);
-#endif
-            return ret;
-        }
-    }
-    for (int i=0; i < RAW_WIN_NUM; i++)
-    {
-        // pProjBlocksPoint // ProjBlocks Center Pointer: 4 Points for n-block(32x32)
-        pProjBlocksPoint[i] = (RK_F32*)&dspMemoryArray[mDspMem_UsedCount];
-        mDspMem_UsedCount  += nChunkSize; // current used count
-        if (mDspMem_UsedCount > DSP_MEM_SIZE)
-        {
-#if MY_DEBUG_PRINTF == 1
-            printf("Failed to Allocate pProjBlocksPoint[%d] !\n", i);
-#endif
-            return ret;
-        }
-    }
-
-    // pRawBaseBlocksDspChunks // RawBaseBlocks DSP Chunks: (32+2*2)x(32n+2*4) * 2B * 2  ExpandedBoundary=(2,2)
-    nChunkSize                 = sizeof(RK_U16) * (blkHgt+2*RAW_BLK_EXTEND_ROW) * (blkWid+2*RAW_BLK_EXTEND_COL);
-    pRawBaseBlocksDspChunks[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount         += nChunkSize; // current used count
-    pRawBaseBlocksDspChunks[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount         += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRawBaseBlocksDspChunks !\n");
-#endif
-        return ret;
-    }
-    // pRawBaseFilterDspChunk // RawBaseFilter DSP Chunk: (32+2*2)x(32n+2*4) * 2B * 2  ExpandedBoundary=(2,2)
-    nChunkSize             = sizeof(RK_U16) * (blkHgt+2*RAW_BLK_EXTEND_ROW) * (blkWid+2*RAW_BLK_EXTEND_COL);
-    pRawBaseFilterDspChunk = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount     += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRawBaseFilterDspChunk !\n");
-#endif
-        return ret;
-    }
-    //pRawBaseThreshDspChunk // RawBaseThresh DSP Chunk: 32x32n * 1B
-    nChunkSize             = sizeof(RK_U16) * blkHgt * blkWid;
-    pRawBaseThreshDspChunk = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount     += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRawBaseThreshDspChunk !\n");
-#endif
-        return ret;
-    }
-
-    // pRawRefBlocksDspChunks // RawRefBlocks DSP Chunks: (32+2*9)x(32n+2*12) * 2B * 2  ExpandedBoundary=(9,12)
-    nChunkSize                = sizeof(RK_U16) * (blkHgt+2*RAW_REF_EXTEND_ROW) * (blkWid+2*RAW_REF_EXTEND_COL);
-    pRawRefBlocksDspChunks[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount        += nChunkSize; // current used count
-    pRawRefBlocksDspChunks[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount        += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRawRefBlocksDspChunks !\n");
-#endif
-        return ret;
-    }
-    // pRawRefFilterDspChunk // RawRefFilter DSP Chunk:  (32+2*9)x(32n+2*11) * 2B ExpandedBoundary=(9,11)
-    nChunkSize            = sizeof(RK_U16) * (blkHgt+2*RAW_REF_EXTEND_ROW) * (blkWid+2*RAW_REF_EXTEND_COL);
-    pRawRefFilterDspChunk = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount    += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRawRefFilterDspChunk !\n");
-#endif
-        return ret;
-    }
-
-    // pRawDstSumDspChunk // RawDstSum DSP Chunk: 32x32n * 2B
-    nChunkSize         = sizeof(RK_U16) * blkHgt * blkWid;
-    pRawDstSumDspChunk = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRawDstSumDspChunk !\n");
-#endif
-        return ret;
-    }
-    // pRawDstWgtDspChunk // RawDstWgt DSP Chunk: 32x32n * 1B
-    nChunkSize         = sizeof(RK_U8) * blkHgt * blkWid;
-    pRawDstWgtDspChunk = (RK_U8*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRawDstWgtDspChunk !\n");
-#endif
-        return ret;
-    }
+    RK_S32      nRefBlkWid_border;
+    RK_S32      nRefBlkStride_border;
 
+    // 4PixelAlign Rectangle for DMA
+    RK_U16      nBaseBlkRow_4p; // BaseBlock
+    RK_U16      nBaseBlkCol_4p;
+    RK_U16      nBaseBlkHgt_4p;
+    RK_U16      nBaseBlkWid_4p; 
+    RK_U16      nRefBlkRow_4p; // RefBlock
+    RK_U16      nRefBlkCol_4p;
+    RK_U16      nRefBlkHgt_4p;
+    RK_U16      nRefBlkWid_4p; 
+    RK_U16      nStartCol_4p;
+    int         nColCrop;
 
-    // pWdrRawBlockBuf // BlkBuf: (2+32)x(1+32n+1)*2B, n=2 -> 32*n=64
-    int nWdrBufWid     = RAW_BLK_SIZE * RAW_WIN_NUM + 2; // 1+32*2+1
-    nChunkSize         = sizeof(RK_U16) * (RAW_BLK_SIZE+2) * nWdrBufWid;//
-    pWdrRawBlockBuf[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    pWdrRawBlockBuf[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrRawBlockBuf !\n");
-#endif
-        return ret;
-    }
-    // pWdrRawRowBuf // RowBuf: 2xRawWid*2B
-    int nRowsBufWid    = CEIL(mRawWid*1.0/(RAW_BLK_SIZE*RAW_WIN_NUM))*RAW_BLK_SIZE*RAW_WIN_NUM + 2; // 64-Align
-    nChunkSize         = sizeof(RK_U16) * 2 * nRowsBufWid;
-    pWdrRawRowBuf      = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrRawRowBuf !\n");
-#endif
-        return ret;
-    }
-    // pWdrRawColBuf // ColBuf: 32x1*2B
-    nChunkSize         = sizeof(RK_U16) * RAW_BLK_SIZE;
-    pWdrRawColBuf      = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrRawColBuf !\n");
-#endif
-        return ret;
-    }
-    // pWdrRawBlockRect // Rects: 1x4*2B
-    nChunkSize          = sizeof(RK_U16) * 4;//
-    pWdrRawBlockRect[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount  += nChunkSize; // current used count
-    pWdrRawBlockRect[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount  += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrRawBlockRect !\n");
-#endif
-        return ret;
-    }
+    // Half Block Size
+    RK_U16      nHalfBlkHgt;        // Half Block Hgt
+    RK_U16      nHalfBlkWid;        // Half Block Wid
 
-    // pWdrThumbWgtTable // Thumb Weight Table: 9x256*2B
-//     nChunkSize         = sizeof(RK_U16) * 9 * 256;
-//     pWdrThumbWgtTable  = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-//     mDspMem_UsedCount += nChunkSize; // current used count
-//     if (mDspMem_UsedCount > DSP_MEM_SIZE)
-//     {
-//         printf("Failed to Allocate pWdrThumbWgtTable !\n");
-//         return ret;
-//     }
-    // pWdrScaleTable // ScaleTabale[expouse_times] 961*2B
-    nChunkSize         = sizeof(RK_U16) * 961;
-    pWdrScaleTable     = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrScaleTable !\n");
-#endif
-        return ret;
-    }
+    // Project Result
+    RK_S32      minRefBlocksRow;    // min Ref Row in Current Chunk
+    RK_S32      maxRefBlocksRow;    // max Ref Row in Current Chunk
+    RK_S32      minRefBlocksCol;    // min Ref Col in Current Chunk
+    RK_S32      maxRefBlocksCol;    // max Ref Col in Current Chunk
+    RK_U16      maxProjRowDist;     // max Ref ProjRowDist in Current Chunk
+    RK_U16      maxProjColDist;     // max Ref ProjColDist in Current Chunk
 
-    // pWdrLeft & pWdrRight // 32x16*2B byte space   2K store 32 line left and right, align 16, actually 9 valid..
-    nChunkSize         = sizeof(RK_U16) * 32 * 16 * 2;
-    pWdrLeftRight      = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrLeftRight !\n");
-#endif
-        return ret;
-    }
+    // Rects of Raw data
+    RK_RectExt  rectBase;           // Rect Info of RawBase Chunk
+    RK_RectExt  rectRef;            // Rect Info of RawRef Chunk
 
-    // pWdrGainMat // Result: 32x32n*2B
-    nChunkSize         = sizeof(RK_U16) * RAW_BLK_SIZE * RAW_BLK_SIZE*RAW_WIN_NUM;
-    pWdrGainMat        = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrGainMat !\n");
-#endif
-        return ret;
-    }
-    // pWdrRawResult // Result: 32x32n*2B
-    nChunkSize         = sizeof(RK_U16) * RAW_BLK_SIZE * RAW_BLK_SIZE*RAW_WIN_NUM;
-    pWdrRawResult      = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrRawResult !\n");
-#endif
-        return ret;
-    }
+
+    //==== DSP Memory: pBaseBlocksPoint & pProjBlocksPoint & ... laid out by DspMemPlan()
+    int nWdrBufWid     = mWdrBufWid;     // 1+32*2+1
+    int nRowsBufWid    = mWdrRowsBufWid; // 64-Align
 
     // init
     memset(pWdrRawBlockBuf[0], 0, sizeof(RK_U16) * (RAW_BLK_SIZE+2) * (RAW_BLK_SIZE*RAW_WIN_NUM+2));
@@ -2248,7 +3331,7 @@ int classMFNR::Enhancer(RK_RawType* pRawDst)
                           + (rectBase.colValid - rectBase.colExtend) * sizeof(RK_U16));
             memset(pRawBaseBlocksDspChunks[chunkIdx_base], 0, 
                 sizeof(RK_U16) * (blkHgt+2*RAW_BLK_EXTEND_ROW) * (blkWid+2*RAW_BLK_EXTEND_COL));
-            RKDMA_ReadRaw10bit2DSP((U32)pDdrRawBase, (U32)pDspRawBase, 
+            RKDMA_ReadRaw10bit2DSP((RK_Addr)pDdrRawBase, (RK_Addr)pDspRawBase, 
                 rectBase.widValid, rectBase.hgtValid, mRawStride, rectBase.strideExtend, rectBase.colValid);
                
 #if USE_MOTION_DETECT == 1
@@ -2345,8 +3428,8 @@ int classMFNR::Enhancer(RK_RawType* pRawDst)
                     // Valid Data Rectangle in RawRef
                     nRefBlkRow_4p    = MAX(nRefBlkRow_border, 0);// Only Include Valid Data
                     nRefBlkCol_4p    = MAX(nRefBlkCol_border, 0);
-                    nRefBlkHgt_4p    = MIN(nRefBlkHgt_border - (nRefBlkRow_4p - nRefBlkRow_border), mRawHgt - nRefBlkRow_4p);
-                    nRefBlkWid_4p    = MIN(nRefBlkWid_border - (nRefBlkCol_4p - nRefBlkCol_border), mRawWid - nRefBlkCol_4p);
+                    nRefBlkHgt_4p    = MAX(MIN(nRefBlkHgt_border - (nRefBlkRow_4p - nRefBlkRow_border), mRawHgt - nRefBlkRow_4p), 0); // none: projected past the Raw
+                    nRefBlkWid_4p    = MAX(MIN(nRefBlkWid_border - (nRefBlkCol_4p - nRefBlkCol_border), mRawWid - nRefBlkCol_4p), 0);
                     nRefBlkCol_4p    = ALIGN_4PIXEL_START(nRefBlkCol_4p);
                     nStartCol_4p     = nRefBlkCol_4p - nRefBlkCol_4p;
                     nRefBlkWid_4p    = ALIGN_4PIXEL_WIDTH(nStartCol_4p + nRefBlkWid_4p);
@@ -2358,6 +3441,12 @@ int classMFNR::Enhancer(RK_RawType* pRawDst)
                     nColCrop           = rectRef.colValid - rectRef.colUseful;
                     rectRef.colUseful += MAX(0, nColCrop);
                     rectRef.widUseful -= MAX(0, nColCrop);
+                    // a window bigger than pRawRefBlocksDspChunks (a wrong Homography): Ref skipped
+                    if (rectRef.hgtExtend * rectRef.strideExtend / (int)sizeof(RK_U16) 
+                        > (blkHgt+2*RAW_REF_EXTEND_ROW) * (blkWid+2*RAW_REF_EXTEND_COL))
+                    {
+                        continue;
+                    }
 
                     // DMA
                     pDdrRawRef   = (RK_U16*)((RK_U8*)pRawSrcs[k] + rectRef.rowValid * mRawStride + rectRef.colValid * 5/4); // stride = mThumbStride
@@ -2367,7 +3456,7 @@ int classMFNR::Enhancer(RK_RawType* pRawDst)
                                  + (rectRef.colValid - rectRef.colExtend) * sizeof(RK_U16));
                     memset(pRawRefBlocksDspChunks[chunkIdx_ref], 0, 
                         sizeof(RK_U16) * (blkHgt+2*RAW_REF_EXTEND_ROW) * (blkWid+2*RAW_REF_EXTEND_COL));
-                    RKDMA_ReadRaw10bit2DSP((U32)pDdrRawRef, (U32)pDspRawRef, 
+                    RKDMA_ReadRaw10bit2DSP((RK_Addr)pDdrRawRef, (RK_Addr)pDspRawRef, 
                         rectRef.widValid, rectRef.hgtValid, mRawStride, rectRef.strideExtend, rectRef.colValid);
 
 #if USE_MOTION_DETECT == 1
@@ -2393,7 +3482,7 @@ int classMFNR::Enhancer(RK_RawType* pRawDst)
             // TemporalDenoise Result
             /*/ DMA 
             pDdrRawDst = (RK_U16*)((RK_U8*)pRawDst + rectBase.rowUseful * mRawStride + rectBase.colUseful * 5/4); // stride = mThumbStride
-            RKDMA_WriteRaw16bit2DDR((U32)pRawDstSumDspChunk, (U32)pDdrRawDst, rectBase.widUseful, rectBase.hgtUseful, 
+            RKDMA_WriteRaw16bit2DDR((RK_Addr)pRawDstSumDspChunk, (RK_Addr)pDdrRawDst, rectBase.widUseful, rectBase.hgtUseful, 
                 rectBase.widUseful*sizeof(RK_U16), mRawStride, rectBase.colUseful);
             //*/
             
@@ -2467,7 +3556,7 @@ int classMFNR::Enhancer(RK_RawType* pRawDst)
                 pDdrRawDst = (RK_U16*)((RK_U8*)pRawDst 
                     + pWdrRawBlockRect[anotherBufIdx_wdr][0] * mRawStride 
                     + pWdrRawBlockRect[anotherBufIdx_wdr][1] * 5/4); // stride = mThumbStride
-                RKDMA_WriteRaw16bit2DDR((U32)pWdrRawResult, (U32)pDdrRawDst, 
+                RKDMA_WriteRaw16bit2DDR((RK_Addr)pWdrRawResult, (RK_Addr)pDdrRawDst, 
                     pWdrRawBlockRect[anotherBufIdx_wdr][3], pWdrRawBlockRect[anotherBufIdx_wdr][2], // w, h
                     pWdrRawBlockRect[anotherBufIdx_wdr][3]*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[anotherBufIdx_wdr][1]);
                 //*/
@@ -2499,7 +3588,7 @@ int classMFNR::Enhancer(RK_RawType* pRawDst)
     pDdrRawDst = (RK_U16*)((RK_U8*)pRawDst 
         + pWdrRawBlockRect[currentBufIdx_wdr][0] * mRawStride 
         + pWdrRawBlockRect[currentBufIdx_wdr][1] * 5/4); // stride = mThumbStride
-    RKDMA_WriteRaw16bit2DDR((U32)pWdrRawResult, (U32)pDdrRawDst, 
+    RKDMA_WriteRaw16bit2DDR((RK_Addr)pWdrRawResult, (RK_Addr)pDdrRawDst, 
         pWdrRawBlockRect[currentBufIdx_wdr][3], pWdrRawBlockRect[currentBufIdx_wdr][2], // w, h
         pWdrRawBlockRect[currentBufIdx_wdr][3]*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[currentBufIdx_wdr][1]);
     //*/
@@ -2509,7 +3598,530 @@ int classMFNR::Enhancer(RK_RawType* pRawDst)
 
     //
     return ret;
-}
+}
+
+
+/************************************************************************/
+// Func: classMFNR::BandRingFeed()
+// Desc: Feed the row-band ring of frame k up to nRowEnd: every Raw row is
+//       unpacked once into slot row%RingRows, rows outside the Raw are 64.
+//       The DMA is only issued; BandRingMirror() copies the slots below
+//       WinRows after the ring once it has landed
+//   In: k                  - [in] frame
+//       nRowEnd            - [in] Raw row after the last one needed
+//  Out: pRawBandRings[k], mBandRowEnd[k]
+//       return             - rdma ticket of the last row DMA, 0-none
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::BandRingFeed(int k, int nRowEnd)
+{
+    RK_U16*     pRing    = pRawBandRings[k];
+    int         nRingWid = mBandRingWid;
+    int         nRow     = mBandRowEnd[k];
+    int         nSlot;          // ring row of nRow
+    int         nRows;          // rows of one DMA: up to the ring end & the Raw edge
+    int         pos      = 0;   // rdma ticket
+    RK_U16*     pDst;
+
+    while (nRow < nRowEnd)
+    {
+        nSlot = (nRow % mBandRingRows + mBandRingRows) % mBandRingRows;
+        nRows = MIN(nRowEnd - nRow, mBandRingRows - nSlot);
+        pDst  = pRing + nSlot * nRingWid;
+        if (nRow < 0 || nRow >= mRawHgt)
+        {
+            // outside the Raw: the init value of the Tile chunks
+            nRows = (nRow < 0) ? MIN(nRows, -nRow) : nRows;
+            for (int i=0; i < nRows * nRingWid; i++)
+            {
+                pDst[i] = 64;
+            }
+        }
+        else
+        {
+            nRows = MIN(nRows, mRawHgt - nRow);
+            pos   = RKDMA_IssueRaw10bit2DSP((RK_Addr)((RK_U8*)pRawSrcs[k] + nRow * mRawStride),
+                (RK_Addr)(pDst + RAW_BAND_PAD_COL), 
+                ALIGN_4PIXEL_WIDTH(mRawWid), nRows, mRawStride, nRingWid * sizeof(RK_U16), 0);
+        }
+        nRow += nRows;
+    }
+    mBandRowEnd[k] = nRow;
+
+    return pos;
+
+} // classMFNR::BandRingFeed()
+
+
+/************************************************************************/
+// Func: classMFNR::BandRingMirror()
+// Desc: Mirror the rows fed to the ring of frame k since the last call:
+//       slots below WinRows are copied after the ring, so a Tile window
+//       of up to WinRows rows is contiguous wherever it starts. Called
+//       once the DMA of BandRingFeed() has landed
+//   In: k                  - [in] frame
+//  Out: pRawBandRings[k], mBandMirrorRow[k]
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+CODE_MFNR_EX
+void classMFNR::BandRingMirror(int k)
+{
+    RK_U16*     pRing    = pRawBandRings[k];
+    int         nRingWid = mBandRingWid;
+    int         nRow     = MAX(mBandMirrorRow[k], mBandRowEnd[k] - mBandRingRows); // rows still in the ring
+    int         nSlot;
+    int         nRows;
+
+    while (nRow < mBandRowEnd[k])
+    {
+        nSlot = (nRow % mBandRingRows + mBandRingRows) % mBandRingRows;
+        nRows = MIN(mBandRowEnd[k] - nRow, mBandRingRows - nSlot);
+        if (nSlot < mBandWinRows)
+        {
+            CopyBlockData(pRing + nSlot * nRingWid, pRing + (mBandRingRows + nSlot) * nRingWid, 
+                nRingWid, MIN(nRows, mBandWinRows - nSlot), nRingWid * 2, nRingWid * 2);
+        }
+        nRow += nRows;
+    }
+    mBandMirrorRow[k] = mBandRowEnd[k];
+
+} // classMFNR::BandRingMirror()
+
+
+/************************************************************************/
+// Func: classMFNR::EnhancerFetch()
+// Desc: Issue the Tile window of frame k for TemporalDenoise_Modify: from
+//       the row-band ring when it holds the window (useRowBand), else DMA
+//       into the Tile chunk. A window too tall, too far out or already
+//       dropped by the ring falls back to the chunk, the output is the
+//       same; so does one whose feed would drop rows of the Tile being
+//       computed. The data is there after EnhancerTileWait(nChunkIdx)
+//   In: k                  - [in] frame
+//       nChunkIdx          - [in] odd-even Tile chunk
+//       pRect              - [in/out] Rect of the window, Extend & Valid;
+//                            widExtend & strideExtend become the ring's
+//  Out: ppChunk            - [out] data at (rowExtend, colExtend)
+//       mTileDmaPos[nChunkIdx]
+//       MFNR_ERR_DSP_MEM_OVERFLOW if the window does not fit the chunk,
+//       nothing issued, the chunk in mDspArena.stats.nOverrunBlock
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::EnhancerFetch(int k, int nChunkIdx, RK_RectExt* pRect, RK_U16** ppChunk)
+{
+    //
+    int         ret = 0; // return value
+    RK_U16*     pDdrRaw = NULL;
+    RK_U16*     pDspRaw = NULL;
+    int         nRowEnd = pRect->rowExtend + pRect->hgtExtend;
+    int         nSlot;
+    int         nKeepRow;       // first ring row that must survive the feed
+    int         nColOver;       // pixels the DMA would read past the Raw row
+    int         pos;
+
+    PROFILE_BEGIN(mProfile, PROF_ENH_DMA_IN);
+    if (mUseRowBand)
+    {
+        // first window of the burst: the ring starts above it, for the windows
+        // further along the band that project higher (rotation)
+        if (mBandRowEnd[k] < mBandRowBeg[k])
+        {
+            mBandRowBeg[k]    = pRect->rowExtend - RAW_BAND_SPREAD_ROWS / 2;
+            mBandRowEnd[k]    = mBandRowBeg[k];
+            mBandMirrorRow[k] = mBandRowBeg[k];
+        }
+        // rows still in the ring once it is fed to nRowEnd, those of the Tile in compute too
+        nKeepRow = MIN(pRect->rowExtend, mBandKeepRow[k]);
+        if (pRect->hgtExtend <= mBandWinRows 
+            && pRect->rowExtend >= mBandRowBeg[k]
+            && nKeepRow >= MAX(mBandRowEnd[k], nRowEnd) - mBandRingRows
+            && pRect->colExtend >= -RAW_BAND_PAD_COL
+            && pRect->colExtend + pRect->widExtend <= mBandRingWid - RAW_BAND_PAD_COL)
+        {
+            pos = BandRingFeed(k, nRowEnd);
+            if (pos != 0)
+            {
+                mTileDmaPos[nChunkIdx] = pos;
+            }
+            nSlot    = (pRect->rowExtend % mBandRingRows + mBandRingRows) % mBandRingRows;
+            *ppChunk = pRawBandRings[k] + nSlot * mBandRingWid + RAW_BAND_PAD_COL + pRect->colExtend;
+            pRect->widExtend    = mBandRingWid;
+            pRect->strideExtend = mBandRingWid * sizeof(RK_U16);
+            mBandKeepRow[k]     = pRect->rowExtend;
+            PROFILE_END(mProfile, PROF_ENH_DMA_IN);
+            return ret;
+        }
+        mBandKeepRow[k] = 0x7FFFFFFF; // none: the Tile reads the chunk
+    }
+
+    // the chunk of DspMemPlan() must hold the window: checked before any write or DMA
+    ret = ChunkEdgeFill(pRawBlkChunks[nChunkIdx][k], mTileChunkSize, pRect);
+    if (ret)
+    {
+        RK_DspArenaOverrun(&mDspArena, mTileChunkBlock[nChunkIdx][k], pRect->hgtExtend * pRect->strideExtend);
+#if MY_DEBUG_PRINTF == 1
+        printf("Failed to EnhancerFetch: window %dx%d of frame %d > Tile chunk %d !\n", 
+            pRect->hgtExtend, pRect->strideExtend / (int)sizeof(RK_U16), k, mTileChunkSize);
+#endif
+        PROFILE_END(mProfile, PROF_ENH_DMA_IN);
+        return ret;
+    }
+
+    // DMA: Raw(DDR10bit->DSP16bit)
+    pDdrRaw = (RK_U16*)((RK_U8*)pRawSrcs[k] 
+            + pRect->rowValid * mRawStride 
+            + pRect->colValid * 5/4);
+    pDspRaw = (RK_U16*)((RK_U8*)pRawBlkChunks[nChunkIdx][k]
+            + (pRect->rowValid - pRect->rowExtend) * pRect->strideExtend 
+            + (pRect->colValid - pRect->colExtend) * sizeof(RK_U16));
+//    memset(pRawBlkChunks[nChunkIdx][k], 0, sizeof(RK_U16) * (blkHgt+2*4) * (blkWid+2*8));
+    // a window starting 2 pixels into a 4-pixel group would read 2 pixels of the
+    // next row at the right edge: not transferred, 64 as outside the Raw
+    nColOver = MAX(pRect->colValid + pRect->widValid - ALIGN_4PIXEL_WIDTH(mRawWid), 0);
+    if (pRect->hgtValid > 0 && pRect->widValid > nColOver) // none: projected past the Raw, all 64
+    {
+        for (int r=0; r < pRect->hgtValid && nColOver > 0; r++)
+        {
+            for (int c=pRect->widValid - nColOver; c < pRect->widValid; c++)
+            {
+                pDspRaw[r * pRect->strideExtend / sizeof(RK_U16) + c] = 64;
+            }
+        }
+        pos = RKDMA_IssueRaw10bit2DSP((RK_Addr)pDdrRaw, (RK_Addr)pDspRaw, 
+            pRect->widValid - nColOver, pRect->hgtValid, 
+            mRawStride, pRect->strideExtend, 
+            pRect->colValid);
+        if (pos != 0)
+        {
+            mTileDmaPos[nChunkIdx] = pos;
+        }
+    }
+    *ppChunk = pRawBlkChunks[nChunkIdx][k];
+    PROFILE_END(mProfile, PROF_ENH_DMA_IN);
+
+    //
+    return ret;
+
+} // classMFNR::EnhancerFetch()
+
+
+/************************************************************************/
+// Func: classMFNR::EnhancerTileIssue()
+// Desc: Set up Tile(nRow, nCol) of Enhancer_Modify in the odd-even slot
+//       nChunkIdx: Rects & Block points of every frame, and issue the DMA
+//       of its windows. Called while the other slot is computed
+//   In: nRow, nCol         - [in] Tile Top-Left in Raw
+//       nChunkIdx          - [in] odd-even Tile slot
+//  Out: rects              - [out] Rects of the windows, one per frame
+//       pTileChunks        - [out] window data, valid after EnhancerTileWait()
+//       pNumBlocks         - [out] num Block32x32 of the Tile
+//       pRawBlkPoints[nChunkIdx]
+//       MFNR_ERR_DSP_MEM_OVERFLOW of EnhancerFetch(), the DMA issued so far
+//       is left to EnhancerTileWait()
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::EnhancerTileIssue(int nRow, int nCol, int nChunkIdx, RK_RectExt* rects, RK_U16** pTileChunks, int* pNumBlocks)
+{
+    //
+    int     ret = 0; // return value
+    int			blkHgt  = mTileHgt;	                    // Block Height in Raw Allowed to Read: Tile of TilePick()
+    int			blkWid  = mTileWid;	                    // Block Width  in Raw Allowed to Read
+
+    // num Block32x32 of Current Chunk
+    int         numBlocks;      
+    int         numBlkCols;     // num Block32x32 in a row of Current Chunk
+    int         nBlkRowOffset;  // Block#n Row in Current Chunk
+    int         nBlkColOffset;  // Block#n Col in Current Chunk
+
+    // Bounding Rectangle of Raw
+    RK_U16      nBaseBlkRow;
+    RK_U16      nBaseBlkCol;
+    RK_U16      nBaseBlkHgt;
+    RK_U16      nBaseBlkWid;
+
+    // Valid Data Rectangle in Raw
+    RK_S32      nBaseBlkRow_border; // BaseBlock
+    RK_S32      nBaseBlkCol_border;
+    RK_S32      nBaseBlkHgt_border;
+    RK_S32      nBaseBlkWid_border;
+    RK_S32      nBaseBlkStride_border;
+    RK_S32      nRefBlkRow_border; // RefBlock
+    RK_S32      nRefBlkCol_border;
+    RK_S32      nRefBlkHgt_border;
+    RK_S32      nRefBlkWid_border;
+    RK_S32      nRefBlkStride_border;
+
+    // 4PixelAlign Rectangle for DMA
+    RK_U16      nBaseBlkRow_4p; // BaseBlock
+    RK_U16      nBaseBlkCol_4p;
+    RK_U16      nBaseBlkHgt_4p;
+    RK_U16      nBaseBlkWid_4p; 
+    RK_U16      nRefBlkRow_4p; // RefBlock
+    RK_U16      nRefBlkCol_4p;
+    RK_U16      nRefBlkHgt_4p;
+    RK_U16      nRefBlkWid_4p; 
+    RK_U16      nStartCol_4p;
+    int         nRowCrop;
+    int         nColCrop;
+
+    // Half Block Size
+    RK_U16      nHalfBlkHgt;        // Half Block Hgt
+    RK_U16      nHalfBlkWid;        // Half Block Wid
+
+    // Project Result
+    RK_S32      minRefBlocksRow;    // min Ref Row in Current Chunk
+    RK_S32      maxRefBlocksRow;    // max Ref Row in Current Chunk
+    RK_S32      minRefBlocksCol;    // min Ref Col in Current Chunk
+    RK_S32      maxRefBlocksCol;    // max Ref Col in Current Chunk
+    RK_U16      maxProjRowDist;     // max Ref ProjRowDist in Current Chunk
+    RK_U16      maxProjColDist;     // max Ref ProjColDist in Current Chunk
+
+    mTileDmaPos[nChunkIdx] = 0;
+
+    // num Block32x32 of Current Chunk: Block rows x Block cols
+    numBlkCols  = (MIN(blkWid, mRawWid-nCol) + RAW_BLK_SIZE - 1) / RAW_BLK_SIZE; 
+    numBlocks   = (MIN(blkHgt, mRawHgt-nRow) + RAW_BLK_SIZE - 1) / RAW_BLK_SIZE * numBlkCols;
+
+
+    // Block(#i,#j) Valid Range // block(row, col) 32x32n
+    nBaseBlkRow = nRow;
+    nBaseBlkCol = nCol;
+    nBaseBlkHgt = blkHgt;
+    nBaseBlkWid = blkWid;
+    rects[mBasePicNum].rowUseful = nBaseBlkRow;// Rect Useful
+    rects[mBasePicNum].colUseful = nBaseBlkCol;
+    rects[mBasePicNum].hgtUseful = MIN(nBaseBlkHgt, mRawHgt - nBaseBlkRow);
+    rects[mBasePicNum].widUseful = MIN(nBaseBlkWid, mRawWid - nBaseBlkCol);
+    // Bounding Rectangle of RawBase // Maybe Include Invalid Data
+    nBaseBlkRow_border    = nBaseBlkRow - RAW_BLK_BORDER;
+    nBaseBlkCol_border    = nBaseBlkCol - RAW_BLK_BORDER;
+    nBaseBlkCol_border    = ALIGN_4PIXEL_START(nBaseBlkCol_border);
+    nBaseBlkHgt_border    = nBaseBlkHgt + 2 * RAW_BLK_EXTEND_ROW;
+    nBaseBlkWid_border    = nBaseBlkWid + 2 * RAW_BLK_EXTEND_COL;
+    nBaseBlkWid_border    = ALIGN_4PIXEL_WIDTH(nBaseBlkWid_border);
+    nBaseBlkStride_border = (nBaseBlkWid + 2 * RAW_BLK_EXTEND_COL) * sizeof(RK_U16); // stride in DSP
+    rects[mBasePicNum].rowExtend    = nBaseBlkRow_border; // Rect Extend
+    rects[mBasePicNum].colExtend    = nBaseBlkCol_border;
+    rects[mBasePicNum].hgtExtend    = nBaseBlkHgt_border;
+    rects[mBasePicNum].widExtend    = nBaseBlkWid_border;
+    rects[mBasePicNum].strideExtend = nBaseBlkStride_border;
+    // Valid Data Rectangle in RawBase // Only Include Valid Data
+    nBaseBlkRow_4p    = MAX(nBaseBlkRow_border, 0);
+    nBaseBlkCol_4p    = MAX(nBaseBlkCol_border, 0);
+    nBaseBlkHgt_4p    = MIN(nBaseBlkHgt_border - (nBaseBlkRow_4p - nBaseBlkRow_border), mRawHgt - nBaseBlkRow_4p);
+    nBaseBlkWid_4p    = MIN(nBaseBlkWid_border - (nBaseBlkCol_4p - nBaseBlkCol_border), mRawWid - nBaseBlkCol_4p);
+    nBaseBlkCol_4p    = ALIGN_4PIXEL_START(nBaseBlkCol_4p); // 4PixelAlign Rectangle for DMA
+    nStartCol_4p      = nBaseBlkCol_4p - nBaseBlkCol_4p;
+    nBaseBlkWid_4p    = ALIGN_4PIXEL_WIDTH(nStartCol_4p + nBaseBlkWid_4p);
+    rects[mBasePicNum].rowValid = nBaseBlkRow_4p;// Rect Valid
+    rects[mBasePicNum].colValid = nBaseBlkCol_4p;
+    rects[mBasePicNum].hgtValid = nBaseBlkHgt_4p;
+    rects[mBasePicNum].widValid = nBaseBlkWid_4p;
+
+    // DMA
+#if MFNR_TRACE == 1
+    mTraceSlot  = nChunkIdx;
+#endif
+    ret = EnhancerFetch(mBasePicNum, nChunkIdx, &rects[mBasePicNum], &pTileChunks[mBasePicNum]);
+    if (ret)
+    {
+        return ret;
+    }
+
+    // BaseBlock
+    for (int n=0; n < numBlocks; n++)
+    {
+        // Block#n in Current Chunk, row-major
+        nBlkRowOffset = n / numBlkCols * RAW_BLK_SIZE;
+        nBlkColOffset = n % numBlkCols * RAW_BLK_SIZE;
+
+        // Half Block Size
+        nHalfBlkHgt = MIN(nBaseBlkHgt - nBlkRowOffset, RAW_BLK_SIZE) / 2;   // Half Block Hgt in Raw
+        nHalfBlkWid = MIN(nBaseBlkWid - nBlkColOffset, RAW_BLK_SIZE) / 2;   // Half Block Wid in Raw
+
+        // Block32x32 Center Row in Raw -> in Luma
+        pRawBlkPoints[nChunkIdx][mBasePicNum][n*2+0] = (RK_F32)((nBaseBlkRow + nHalfBlkHgt + nBlkRowOffset) / 2);
+        pRawBlkPoints[nChunkIdx][mBasePicNum][n*2+1] = (RK_F32)((nBaseBlkCol + nHalfBlkWid + nBlkColOffset) / 2);
+
+        // Ref
+        for (int k=0; k < mRawFileNum; k++)
+        {
+            if (k != mBasePicNum)
+            {
+                // Project in Luma
+                ret = PerspectProject(pHomographyMatrix[k], pRawBlkPoints[nChunkIdx][mBasePicNum]+2*n, pRawBlkPoints[nChunkIdx][k]+2*n);
+
+                // Center in LumaRef Block#n -> TopLeft in RawRef Block#n
+                pRawBlkPoints[nChunkIdx][k][n*2+0] = (RK_F32)(ROUND_I32(pRawBlkPoints[nChunkIdx][k][n*2+0]) * 2 - nHalfBlkHgt);
+                pRawBlkPoints[nChunkIdx][k][n*2+1] = (RK_F32)(ROUND_I32(pRawBlkPoints[nChunkIdx][k][n*2+1]) * 2 - nHalfBlkWid);
+                // Round
+//                         pRawBlkPoints[nChunkIdx][k][n*2+0] = (RK_F32)ROUND_I32(pRawBlkPoints[nChunkIdx][k][n*2+0]);
+//                         pRawBlkPoints[nChunkIdx][k][n*2+1] = (RK_F32)ROUND_I32(pRawBlkPoints[nChunkIdx][k][n*2+1]);
+            }
+        }
+
+        // Center in LumaBase Block#n -> TopLeft in RawBase Block#n
+        pRawBlkPoints[nChunkIdx][mBasePicNum][n*2+0] = pRawBlkPoints[nChunkIdx][mBasePicNum][n*2+0] * 2 - nHalfBlkHgt;
+        pRawBlkPoints[nChunkIdx][mBasePicNum][n*2+1] = pRawBlkPoints[nChunkIdx][mBasePicNum][n*2+1] * 2 - nHalfBlkWid;
+    }
+
+    for (int k=0; k < mRawFileNum; k++)
+    {
+        if (k != mBasePicNum)
+        {
+            // Find Bounding Rectangle of numBlocks-ProjPoints
+            minRefBlocksRow = +0xFFFF;  // min Ref Row in 4-ImageCornerBlocks
+            maxRefBlocksRow = -0xFFFF;  // max Ref Row in 4-ImageCornerBlocks
+            minRefBlocksCol = +0xFFFF;  // min Ref Col in 4-ImageCornerBlocks
+            maxRefBlocksCol = -0xFFFF;  // max Ref Col in 4-ImageCornerBlocks
+            for (int n=0; n < numBlocks; n++)
+            {
+                // min&max Row of numBlocks-ProjPoints
+                if (pRawBlkPoints[nChunkIdx][k][n*2+0] < minRefBlocksRow)
+                {
+                    minRefBlocksRow = (RK_S32)pRawBlkPoints[nChunkIdx][k][n*2+0];
+                }
+                if (pRawBlkPoints[nChunkIdx][k][n*2+0] > maxRefBlocksRow)
+                {
+                    maxRefBlocksRow = (RK_S32)pRawBlkPoints[nChunkIdx][k][n*2+0];
+                }
+                // min&max Col of numBlocks-ProjPoints
+                if (pRawBlkPoints[nChunkIdx][k][n*2+1] < minRefBlocksCol)
+                {
+                    minRefBlocksCol = (RK_S32)pRawBlkPoints[nChunkIdx][k][n*2+1];
+                }
+                if (pRawBlkPoints[nChunkIdx][k][n*2+1] > maxRefBlocksCol)
+                {
+                    maxRefBlocksCol = (RK_S32)pRawBlkPoints[nChunkIdx][k][n*2+1];
+                }
+            } // for n
+
+            // Compute ProjWinSize
+            maxProjRowDist = maxRefBlocksRow - minRefBlocksRow; // max Ref ProjRowDist in 4-ImageCornerBlocks
+            maxProjColDist = maxRefBlocksCol - minRefBlocksCol; // max Ref ProjColDist in 4-ImageCornerBlocks
+
+            //////////////////////////////////////////////////////////////////////////
+            //---- DMA: RawRef(DDR10bit->DSP16bit)
+            // Block(#i,#j) Valid Range
+            rects[k].rowUseful = minRefBlocksRow;// Rect Useful
+            rects[k].colUseful = minRefBlocksCol;
+            rects[k].hgtUseful = MIN(maxProjRowDist + RAW_BLK_SIZE, mRawHgt - minRefBlocksRow);
+            rects[k].widUseful = MIN(maxProjColDist + RAW_BLK_SIZE, mRawWid - minRefBlocksCol);
+            // Bounding Rectangle of RawRef
+            nRefBlkRow_border    = minRefBlocksRow - RAW_BLK_BORDER; // Maybe Include Invalid Data
+            nRefBlkCol_border    = minRefBlocksCol - RAW_BLK_BORDER;
+            nRefBlkCol_border    = ALIGN_4PIXEL_START(nRefBlkCol_border);
+            nRefBlkHgt_border    = maxProjRowDist + RAW_BLK_SIZE + 2*RAW_BLK_BORDER;//MIN(blkHgt, mRawHgt-nBaseBlkRow) + maxProjRowDist + 2*RAW_BLK_BORDER;
+            nRefBlkWid_border    = maxProjColDist + RAW_BLK_SIZE + 2*(minRefBlocksCol-nRefBlkCol_border);//MIN(blkWid, mRawWid-nBaseBlkCol) + maxProjColDist + 2*RAW_BLK_BORDER;
+            nRefBlkWid_border    = ALIGN_4PIXEL_WIDTH(nRefBlkWid_border);
+            nRefBlkStride_border = nRefBlkWid_border * sizeof(RK_U16); // stride in DSP
+            rects[k].rowExtend    = nRefBlkRow_border; // Rect Extend
+            rects[k].colExtend    = nRefBlkCol_border;
+            rects[k].hgtExtend    = nRefBlkHgt_border;
+            rects[k].widExtend    = nRefBlkWid_border;
+            rects[k].strideExtend = nRefBlkStride_border;
+            // Valid Data Rectangle in RawRef
+            nRefBlkRow_4p    = MAX(nRefBlkRow_border, 0);// Only Include Valid Data
+            nRefBlkCol_4p    = MAX(nRefBlkCol_border, 0);
+            nRefBlkHgt_4p    = MAX(MIN(nRefBlkHgt_border - (nRefBlkRow_4p - nRefBlkRow_border), mRawHgt - nRefBlkRow_4p), 0); // none: projected past the Raw
+            nRefBlkWid_4p    = MAX(MIN(nRefBlkWid_border - (nRefBlkCol_4p - nRefBlkCol_border), mRawWid - nRefBlkCol_4p), 0);
+            nRefBlkCol_4p    = ALIGN_4PIXEL_START(nRefBlkCol_4p);
+            nStartCol_4p     = nRefBlkCol_4p - nRefBlkCol_4p;
+            nRefBlkWid_4p    = ALIGN_4PIXEL_WIDTH(nStartCol_4p + nRefBlkWid_4p);
+            rects[k].rowValid = nRefBlkRow_4p;// Rect Valid
+            rects[k].colValid = nRefBlkCol_4p;
+            rects[k].hgtValid = nRefBlkHgt_4p;
+            rects[k].widValid = nRefBlkWid_4p;
+            // Rect Useful Constraint
+            nRowCrop = rects[k].rowValid - rects[k].rowUseful;
+            rects[k].rowUseful += MAX(0, nRowCrop);
+            rects[k].hgtUseful -= MAX(0, nRowCrop);
+            nColCrop = rects[k].colValid - rects[k].colUseful;
+            rects[k].colUseful += MAX(0, nColCrop);
+            rects[k].widUseful -= MAX(0, nColCrop);
+
+            // a window bigger than the chunk of DspMemPlan(): a projection spread no Tile
+            // of this size has, i.e. a wrong Homography. The Base Block stands in for the Ref
+            if (rects[k].hgtExtend * rects[k].strideExtend / (int)sizeof(RK_U16) > mTileChunkSize)
+            {
+                rects[k]       = rects[mBasePicNum];
+                pTileChunks[k] = pTileChunks[mBasePicNum];
+                for (int i=0; i < 2*numBlocks; i++)
+                {
+                    pRawBlkPoints[nChunkIdx][k][i] = pRawBlkPoints[nChunkIdx][mBasePicNum][i];
+                }
+                mBandKeepRow[k] = 0x7FFFFFFF; // none: no window of frame k in this Tile
+                continue;
+            }
+
+            // DMA or row-band ring
+            ret = EnhancerFetch(k, nChunkIdx, &rects[k], &pTileChunks[k]);
+            if (ret)
+            {
+                return ret;
+            }
+        } // if k
+    } // for k
+    *pNumBlocks = numBlocks;
+
+    //
+    return ret;
+
+} // classMFNR::EnhancerTileIssue()
+
+
+/************************************************************************/
+// Func: classMFNR::EnhancerTileWait()
+// Desc: Wait for the DMA of the Tile in slot nChunkIdx, then mirror the
+//       ring rows it fed and check the guard bytes of its chunks
+//   In: nChunkIdx          - [in] odd-even Tile slot
+//  Out: MFNR_ERR_DSP_MEM_OVERFLOW if a chunk was written past its end
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::EnhancerTileWait(int nChunkIdx)
+{
+    //
+    int     ret = 0; // return value
+
+    PROFILE_BEGIN(mProfile, PROF_ENH_DMA_IN);
+    RKDMA_Sync(mTileDmaPos[nChunkIdx]);
+    mTileDmaPos[nChunkIdx] = 0;
+    for (int k=0; k < mRawFileNum && mUseRowBand; k++)
+    {
+        BandRingMirror(k);
+    }
+    for (int k=0; k < mRawFileNum; k++)
+    {
+        if (RK_DspGuardCheck(pRawBlkChunks[nChunkIdx][k], mTileChunkSize * sizeof(RK_U16)))
+        {
+#if MY_DEBUG_PRINTF == 1
+            printf("Failed to EnhancerTileWait: pRawBlkChunks[%d][%d] guard overwritten !\n", nChunkIdx, k);
+#endif
+            RK_DspArenaOverrun(&mDspArena, mTileChunkBlock[nChunkIdx][k], 
+                mTileChunkSize * sizeof(RK_U16) + DSPMEM_GUARD_SIZE, DSPMEM_GUARD_SIZE);
+            ret = MFNR_ERR_DSP_MEM_OVERFLOW;
+            break;
+        }
+    }
+    PROFILE_END(mProfile, PROF_ENH_DMA_IN);
+
+    //
+    return ret;
+
+} // classMFNR::EnhancerTileWait()
 
 
 /************************************************************************/
@@ -2530,255 +4142,70 @@ int classMFNR::Enhancer_Modify(RK_RawType* pRawDst)
     printf("classMFNR::Enhancer_Modify()\n");
 #endif
     ////-------- TemporalDenoise & BayerWDR & SpatialDenoise
-    int         nChunkSize;
-    int			blkHgt  = RAW_BLK_SIZE;	                // Block Height in Raw Allowed to Read
-    int			blkWid  = RAW_BLK_SIZE * RAW_WIN_NUM;	// Block Width  in Raw Allowed to Read
+    int			blkHgt  = mTileHgt;	                    // Block Height in Raw Allowed to Read: Tile of TilePick()
+    int			blkWid  = mTileWid;	                    // Block Width  in Raw Allowed to Read
 
     //// Block32x32n Temp Pointers
-    RK_U16*     pDdrRawBase   = NULL;
-    RK_U16*     pDspRawBase   = NULL;
-    RK_U16*     pDdrRawRef    = NULL;
-    RK_U16*     pDspRawRef    = NULL;
+    RK_U16*     pTileChunks[2][RK_MAX_FILE_NUM];    // RawSrcs of the odd-even Tiles: pRawBlkChunks or row-band rings
     RK_U16*     pDspWdrBuf    = NULL;
     RK_U16*     pDdrRawDst    = NULL;
 
-    // num Block32x32 of Current Chunk
-    int         numBlocks;      
+    // num Block32x32 of the odd-even Tiles
+    int         numBlocks[2];
 
     // DSP Chunk Index
     int         chunkIdx_nr;    // odd-even
     int         currentBufIdx_wdr;  // odd-even
     int         anotherBufIdx_wdr;  // odd-even
 
-    // Bounding Rectangle of Raw
-    RK_U16      nBaseBlkRow;
-    RK_U16      nBaseBlkCol;
-    RK_U16      nBaseBlkHgt;
-    RK_U16      nBaseBlkWid;
-
-    // Valid Data Rectangle in Raw
-    RK_S32      nBaseBlkRow_border; // BaseBlock
-    RK_S32      nBaseBlkCol_border;
-    RK_S32      nBaseBlkHgt_border;
-    RK_S32      nBaseBlkWid_border;
-    RK_S32      nBaseBlkStride_border;
-    RK_S32      nRefBlkRow_border; // RefBlock
-    RK_S32      nRefBlkCol_border;
-    RK_S32      nRefBlkHgt_border;
-    RK_S32      nRefBlkWid_border;
-    RK_S32      nRefBlkStride_border;
-
-    // 4PixelAlign Rectangle for DMA
-    RK_U16      nBaseBlkRow_4p; // BaseBlock
-    RK_U16      nBaseBlkCol_4p;
-    RK_U16      nBaseBlkHgt_4p;
-    RK_U16      nBaseBlkWid_4p; 
-    RK_U16      nRefBlkRow_4p; // RefBlock
-    RK_U16      nRefBlkCol_4p;
-    RK_U16      nRefBlkHgt_4p;
-    RK_U16      nRefBlkWid_4p; 
-    RK_U16      nStartCol_4p;
-    int         nRowCrop;
-    int         nColCrop;
-
-    // Half Block Size
-    RK_U16      nHalfBlkHgt;        // Half Block Hgt
-    RK_U16      nHalfBlkWid;        // Half Block Wid
-
-    // Project Result
-    RK_S32      minRefBlocksRow;    // min Ref Row in Current Chunk
-    RK_S32      maxRefBlocksRow;    // max Ref Row in Current Chunk
-    RK_S32      minRefBlocksCol;    // min Ref Col in Current Chunk
-    RK_S32      maxRefBlocksCol;    // max Ref Col in Current Chunk
-    RK_U16      maxProjRowDist;     // max Ref ProjRowDist in Current Chunk
-    RK_U16      maxProjColDist;     // max Ref ProjColDist in Current Chunk
+    // Next Tile, set up & its DMA issued while the current one is computed
+    int         nNextRow;
+    int         nNextCol;
 
     // Rects of Raw data
-    RK_RectExt  rects[RK_MAX_FILE_NUM]; // Rect Info of Raw Chunk
+    RK_RectExt  rects[2][RK_MAX_FILE_NUM]; // Rect Info of Raw Chunk, odd-even Tiles
 
 
-    //==== DSP Malloc: pRawBlkPoints & pRawBlkChunks & pRawDstChunk addr in DSP
-    mDspMem_UsedCount = mDspMem_ResetPos; // Mark Position
-    // pRawBlkPoints[RK_MAX_FILE_NUM]
-    nChunkSize = sizeof(RK_F32) * 2;
-    for (int k=0; k < mRawFileNum; k++)
-    {
-        // pRawBlkPoints[k][i]: [Y,X]
-        pRawBlkPoints[k] = (RK_F32*)&dspMemoryArray[mDspMem_UsedCount];
-        mDspMem_UsedCount  += nChunkSize*RAW_WIN_NUM; // current used count
-        if (mDspMem_UsedCount > DSP_MEM_SIZE)
-        {
-#if MY_DEBUG_PRINTF == 1
-            printf("Failed to Allocate pRawBlkPoints[%d] !\n", k);
-#endif
-            return ret;
-        }
-    }
-    // pRawBlkChunks[2][RK_MAX_FILE_NUM]
-    nChunkSize = sizeof(RK_U16) * (RAW_BLK_SIZE+2*4) * (RAW_BLK_SIZE*RAW_WIN_NUM+2*8);
+    //==== DSP Memory: pRawBlkPoints & pRawBlkChunks & pWdr* laid out by DspMemPlan()
+    mDspArena.nStage = DSPMEM_ENHANCER; // DMA Traffic site
+    int nWdrBufWid     = mWdrBufWid;     // 1+TileWid+1
+    int nRowsBufWid    = mWdrRowsBufWid; // TileWid-Align
+
+    // init
     for (int n=0; n < 2; n++)
     {
         for (int k=0; k < mRawFileNum; k++)
         {
-            pRawBlkChunks[n][k] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-            mDspMem_UsedCount  += nChunkSize; // current used count
-            if (mDspMem_UsedCount > DSP_MEM_SIZE)
-            {
-#if MY_DEBUG_PRINTF == 1
-                printf("Failed to Allocate pRawBlkChunks[%d][%d] !\n", n, k);
-#endif
-                return ret;
-            }
-            // init
-            for (int i=0; i < nChunkSize/2; i++)
+            for (int i=0; i < mTileChunkSize; i++)
             {
                 pRawBlkChunks[n][k][i] = 64;
             }
+            RK_DspGuardSet(pRawBlkChunks[n][k], mTileChunkSize * sizeof(RK_U16)); // Register shares the memory
         }
     }
-    // pRawDstChunk
-    nChunkSize         = sizeof(RK_U16) * blkHgt * blkWid;
-    pRawDstChunk       = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pRawDstChunk !\n");
-#endif
-        return ret;
-    }
-
-
-    // pWdrRawBlockBuf // BlkBuf: (2+32)x(1+32n+1)*2B, n=2 -> 32*n=64
-    int nWdrBufWid     = RAW_BLK_SIZE * RAW_WIN_NUM + 2; // 1+32*2+1
-    nChunkSize         = sizeof(RK_U16) * (RAW_BLK_SIZE+2) * nWdrBufWid;//
-    pWdrRawBlockBuf[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    pWdrRawBlockBuf[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrRawBlockBuf !\n");
-#endif
-        return ret;
-    }
-    // pWdrRawRowBuf // RowBuf: 2xRawWid*2B
-    int nRowsBufWid;//    = CEIL(mRawWid*1.0/(RAW_BLK_SIZE*RAW_WIN_NUM))*RAW_BLK_SIZE*RAW_WIN_NUM + 2; // 64-Align
-    if (RAW_BLK_SIZE*RAW_WIN_NUM == 64)
-    {
-    	nRowsBufWid    = ((mRawWid >> 6) << 6) + 2;
-    }
-    else
-    {
-    	nRowsBufWid    = CEIL(mRawWid*1.0/(RAW_BLK_SIZE*RAW_WIN_NUM))*RAW_BLK_SIZE*RAW_WIN_NUM + 2; // 64-Align
-    }
-    nChunkSize         = sizeof(RK_U16) * 2 * nRowsBufWid;
-    pWdrRawRowBuf      = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrRawRowBuf !\n");
-#endif
-        return ret;
-    }
-    // pWdrRawColBuf // ColBuf: 32x1*2B
-    nChunkSize         = sizeof(RK_U16) * RAW_BLK_SIZE;
-    pWdrRawColBuf      = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrRawColBuf !\n");
-#endif
-        return ret;
-    }
-    // pWdrRawBlockRect // Rects: 1x4*2B
-    nChunkSize          = sizeof(RK_U16) * 4;//
-    pWdrRawBlockRect[0] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount  += nChunkSize; // current used count
-    pWdrRawBlockRect[1] = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount  += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrRawBlockRect !\n");
-#endif
-        return ret;
-    }
-
-    // pWdrThumbWgtTable // Thumb Weight Table: 9x256*2B
-    //     nChunkSize         = sizeof(RK_U16) * 9 * 256;
-    //     pWdrThumbWgtTable  = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    //     mDspMem_UsedCount += nChunkSize; // current used count
-    //     if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    //     {
-    //         printf("Failed to Allocate pWdrThumbWgtTable !\n");
-    //         return ret;
-    //     }
-    // pWdrScaleTable // ScaleTabale[expouse_times] 961*2B
-    nChunkSize         = sizeof(RK_U16) * 961;
-    pWdrScaleTable     = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-
-	
-	// add by zxy for LUT scale tab
-	lutWdrTable(pWdrScaleTable, mIspGain/* IspGain */); 
-
-
-	
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrScaleTable !\n");
-#endif
-        return ret;
-    }
-
-    // pWdrLeft & pWdrRight // 32x16*2B byte space   2K store 32 line left and right, align 16, actually 9 valid..
-    nChunkSize         = sizeof(RK_U16) * 32 * 16 * 2;
-    pWdrLeftRight      = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
+    // Row-band rings: 64 in the pad cols, no rows fed
+    for (int k=0; k < mRawFileNum && mUseRowBand; k++)
     {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrLeftRight !\n");
-#endif
-        return ret;
+        for (int i=0; i < (mBandRingRows + mBandWinRows + 1) * mBandRingWid; i++)
+        {
+            pRawBandRings[k][i] = 64;
+        }
+        mBandRowBeg[k]  = 0;
+        mBandRowEnd[k]  = -1;
+        mBandKeepRow[k] = 0x7FFFFFFF; // none
     }
 
-    // pWdrGainMat // Result: 32x32n*2B
-    nChunkSize         = sizeof(RK_U16) * RAW_BLK_SIZE * RAW_BLK_SIZE*RAW_WIN_NUM;
-    pWdrGainMat        = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrGainMat !\n");
-#endif
-        return ret;
-    }
+	// add by zxy for LUT scale tab, rebuilt only when the gain of the session changes
+	if (mWdrScaleGain != (unsigned short)mIspGain)
+	{
+		lutWdrTable(pWdrScaleTable, mIspGain/* IspGain */); 
+		mWdrScaleGain = (unsigned short)mIspGain;
+	}
 
 	// init                                                                                         
-	memset(pWdrRawBlockBuf[0], 0, sizeof(RK_U16) * (RAW_BLK_SIZE+2) * (RAW_BLK_SIZE*RAW_WIN_NUM+2));
-	memset(pWdrRawBlockBuf[1], 0, sizeof(RK_U16) * (RAW_BLK_SIZE+2) * (RAW_BLK_SIZE*RAW_WIN_NUM+2));
+	memset(pWdrRawBlockBuf[0], 0, sizeof(RK_U16) * (blkHgt+2) * nWdrBufWid);
+	memset(pWdrRawBlockBuf[1], 0, sizeof(RK_U16) * (blkHgt+2) * nWdrBufWid);
 	memset(pWdrRawRowBuf,      0, sizeof(RK_U16) * 2 * nRowsBufWid);                                
-	memset(pWdrRawColBuf,      0, sizeof(RK_U16) * RAW_BLK_SIZE);                                   
-
-
-	
-    // pWdrRawResult // Result: 32x32n*2B
-    nChunkSize         = sizeof(RK_U16) * RAW_BLK_SIZE * RAW_BLK_SIZE*RAW_WIN_NUM;
-    pWdrRawResult      = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
-    if (mDspMem_UsedCount > DSP_MEM_SIZE)
-    {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrRawResult !\n");
-#endif
-        return ret;
-    }
 
 
 
@@ -2786,283 +4213,190 @@ int classMFNR::Enhancer_Modify(RK_RawType* pRawDst)
     ////---- Processing Block(#i, #j)
     chunkIdx_nr       = 1; // odd-even init
     currentBufIdx_wdr = 1; // odd-even init
+    mTileDmaPos[0]    = 0;
+    mTileDmaPos[1]    = 0;
+    ret = EnhancerTileIssue(0, 0, 0, rects[0], pTileChunks[0], &numBlocks[0]); // Tile(#0,#0) in slot 0
+    if (ret)
+    {
+        EnhancerTileWait(0); // windows issued before the failing one
+        return ret;
+    }
     for (int i=0; i < mRawHgt; i += blkHgt)
     {
         for (int j=0; j < mRawWid; j += blkWid)
         {
-            // num Block32x32 of Current Chunk
-            numBlocks   = (MIN(blkWid, mRawWid-j) + RAW_BLK_SIZE - 1) / RAW_BLK_SIZE; 
-
-
-            // Block(#i,#j) Valid Range // block(row, col) 32x32n
-            nBaseBlkRow = i;
-            nBaseBlkCol = j;
-            nBaseBlkHgt = blkHgt;
-            nBaseBlkWid = blkWid;
-            rects[mBasePicNum].rowUseful = nBaseBlkRow;// Rect Useful
-            rects[mBasePicNum].colUseful = nBaseBlkCol;
-            rects[mBasePicNum].hgtUseful = MIN(nBaseBlkHgt, mRawHgt - nBaseBlkRow);
-            rects[mBasePicNum].widUseful = MIN(nBaseBlkWid, mRawWid - nBaseBlkCol);
-            // Bounding Rectangle of RawBase // Maybe Include Invalid Data
-            nBaseBlkRow_border    = nBaseBlkRow - RAW_BLK_BORDER;
-            nBaseBlkCol_border    = nBaseBlkCol - RAW_BLK_BORDER;
-            nBaseBlkCol_border    = ALIGN_4PIXEL_START(nBaseBlkCol_border);
-            nBaseBlkHgt_border    = nBaseBlkHgt + 2 * RAW_BLK_EXTEND_ROW;
-            nBaseBlkWid_border    = nBaseBlkWid + 2 * RAW_BLK_EXTEND_COL;
-            nBaseBlkWid_border    = ALIGN_4PIXEL_WIDTH(nBaseBlkWid_border);
-            nBaseBlkStride_border = (nBaseBlkWid + 2 * RAW_BLK_EXTEND_COL) * sizeof(RK_U16); // stride in DSP
-            rects[mBasePicNum].rowExtend    = nBaseBlkRow_border; // Rect Extend
-            rects[mBasePicNum].colExtend    = nBaseBlkCol_border;
-            rects[mBasePicNum].hgtExtend    = nBaseBlkHgt_border;
-            rects[mBasePicNum].widExtend    = nBaseBlkWid_border;
-            rects[mBasePicNum].strideExtend = nBaseBlkStride_border;
-            // Valid Data Rectangle in RawBase // Only Include Valid Data
-            nBaseBlkRow_4p    = MAX(nBaseBlkRow_border, 0);
-            nBaseBlkCol_4p    = MAX(nBaseBlkCol_border, 0);
-            nBaseBlkHgt_4p    = MIN(nBaseBlkHgt_border - (nBaseBlkRow_4p - nBaseBlkRow_border), mRawHgt - nBaseBlkRow_4p);
-            nBaseBlkWid_4p    = MIN(nBaseBlkWid_border - (nBaseBlkCol_4p - nBaseBlkCol_border), mRawWid - nBaseBlkCol_4p);
-            nBaseBlkCol_4p    = ALIGN_4PIXEL_START(nBaseBlkCol_4p); // 4PixelAlign Rectangle for DMA
-            nStartCol_4p      = nBaseBlkCol_4p - nBaseBlkCol_4p;
-            nBaseBlkWid_4p    = ALIGN_4PIXEL_WIDTH(nStartCol_4p + nBaseBlkWid_4p);
-            rects[mBasePicNum].rowValid = nBaseBlkRow_4p;// Rect Valid
-            rects[mBasePicNum].colValid = nBaseBlkCol_4p;
-            rects[mBasePicNum].hgtValid = nBaseBlkHgt_4p;
-            rects[mBasePicNum].widValid = nBaseBlkWid_4p;
-
-            // DMA
-            pDdrRawBase = (RK_U16*)((RK_U8*)pRawSrcs[mBasePicNum] 
-                        + rects[mBasePicNum].rowValid * mRawStride 
-                        + rects[mBasePicNum].colValid * 5/4);
+            TRACE_BEGIN(mTrace, evTile, "tile", TRACE_TRACK_DSP);
+            TRACE_ARG(mTrace, evTile, "i", i);
+            TRACE_ARG(mTrace, evTile, "j", j);
+            // Tile(#i,#j) in slot chunkIdx_nr, set up by the last step
             chunkIdx_nr = (chunkIdx_nr + 1) & 0x1; // odd-even
-            pDspRawBase = (RK_U16*)((RK_U8*)pRawBlkChunks[chunkIdx_nr][mBasePicNum] 
-                        + (rects[mBasePicNum].rowValid - rects[mBasePicNum].rowExtend) * rects[mBasePicNum].strideExtend 
-                        + (rects[mBasePicNum].colValid - rects[mBasePicNum].colExtend) * sizeof(RK_U16));
-//            memset(pRawBlkChunks[chunkIdx_nr][mBasePicNum], 0, sizeof(RK_U16) * (blkHgt+2*4) * (blkWid+2*8));
-            RKDMA_ReadRaw10bit2DSP((U32)pDdrRawBase, (U32)pDspRawBase, 
-                rects[mBasePicNum].widValid, rects[mBasePicNum].hgtValid, 
-                mRawStride, rects[mBasePicNum].strideExtend, 
-                rects[mBasePicNum].colValid);
-
-            // BaseBlock
-            for (int n=0; n < numBlocks; n++)
+            TRACE_ARG(mTrace, evTile, "chunkIdx_nr", chunkIdx_nr);
+            ret = EnhancerTileWait(chunkIdx_nr);
+            if (ret)
             {
-                // Half Block Size
-                nHalfBlkHgt = MIN(nBaseBlkHgt, RAW_BLK_SIZE) / 2;   // Half Block Hgt in Raw
-                nHalfBlkWid = MIN(nBaseBlkWid - n * RAW_BLK_SIZE, RAW_BLK_SIZE) / 2;   // Half Block Wid in Raw
-
-                // Block32x32 Center Row in Raw -> in Luma
-                pRawBlkPoints[mBasePicNum][n*2+0] = (RK_F32)((nBaseBlkRow + nHalfBlkHgt) / 2);
-                pRawBlkPoints[mBasePicNum][n*2+1] = (RK_F32)((nBaseBlkCol + nHalfBlkWid + n * RAW_BLK_SIZE) / 2);
-
-                // Ref
-                for (int k=0; k < mRawFileNum; k++)
-                {
-                    if (k != mBasePicNum)
-                    {
-                        // Project in Luma
-                        ret = PerspectProject(pHomographyMatrix[k], pRawBlkPoints[mBasePicNum]+2*n, pRawBlkPoints[k]+2*n);
-
-                        // Center in LumaRef Block#n -> TopLeft in RawRef Block#n
-                        pRawBlkPoints[k][n*2+0] = (RK_F32)(ROUND_I32(pRawBlkPoints[k][n*2+0]) * 2 - nHalfBlkHgt);
-                        pRawBlkPoints[k][n*2+1] = (RK_F32)(ROUND_I32(pRawBlkPoints[k][n*2+1]) * 2 - nHalfBlkWid);
-                        // Round
-//                         pRawBlkPoints[k][n*2+0] = (RK_F32)ROUND_I32(pRawBlkPoints[k][n*2+0]);
-//                         pRawBlkPoints[k][n*2+1] = (RK_F32)ROUND_I32(pRawBlkPoints[k][n*2+1]);
-                    }
-                }
-
-                // Center in LumaBase Block#n -> TopLeft in RawBase Block#n
-                pRawBlkPoints[mBasePicNum][n*2+0] = pRawBlkPoints[mBasePicNum][n*2+0] * 2 - nHalfBlkHgt;
-                pRawBlkPoints[mBasePicNum][n*2+1] = pRawBlkPoints[mBasePicNum][n*2+1] * 2 - nHalfBlkWid;
+                TRACE_END(mTrace, evTile);
+                return ret;
             }
 
-            for (int k=0; k < mRawFileNum; k++)
+            // DMA of the next Tile into the other slot, in flight while this one is computed
+            nNextRow = i;
+            nNextCol = j + blkWid;
+            if (nNextCol >= mRawWid)
             {
-                if (k != mBasePicNum)
+                nNextRow += blkHgt;
+                nNextCol  = 0;
+            }
+            if (nNextRow < mRawHgt)
+            {
+                ret = EnhancerTileIssue(nNextRow, nNextCol, chunkIdx_nr ^ 1, 
+                    rects[chunkIdx_nr ^ 1], pTileChunks[chunkIdx_nr ^ 1], &numBlocks[chunkIdx_nr ^ 1]);
+                if (ret)
                 {
-                    // Find Bounding Rectangle of numBlocks-ProjPoints
-                    minRefBlocksRow = +0xFFFF;  // min Ref Row in 4-ImageCornerBlocks
-                    maxRefBlocksRow = -0xFFFF;  // max Ref Row in 4-ImageCornerBlocks
-                    minRefBlocksCol = +0xFFFF;  // min Ref Col in 4-ImageCornerBlocks
-                    maxRefBlocksCol = -0xFFFF;  // max Ref Col in 4-ImageCornerBlocks
-                    for (int n=0; n < numBlocks; n++)
-                    {
-                        // min&max Row of numBlocks-ProjPoints
-                        if (pRawBlkPoints[k][n*2+0] < minRefBlocksRow)
-                        {
-                            minRefBlocksRow = (RK_S32)pRawBlkPoints[k][n*2+0];
-                        }
-                        if (pRawBlkPoints[k][n*2+0] > maxRefBlocksRow)
-                        {
-                            maxRefBlocksRow = (RK_S32)pRawBlkPoints[k][n*2+0];
-                        }
-                        // min&max Col of numBlocks-ProjPoints
-                        if (pRawBlkPoints[k][n*2+1] < minRefBlocksCol)
-                        {
-                            minRefBlocksCol = (RK_S32)pRawBlkPoints[k][n*2+1];
-                        }
-                        if (pRawBlkPoints[k][n*2+1] > maxRefBlocksCol)
-                        {
-                            maxRefBlocksCol = (RK_S32)pRawBlkPoints[k][n*2+1];
-                        }
-                    } // for n
-
-                    // Compute ProjWinSize
-                    maxProjRowDist = maxRefBlocksRow - minRefBlocksRow; // max Ref ProjRowDist in 4-ImageCornerBlocks
-                    maxProjColDist = maxRefBlocksCol - minRefBlocksCol; // max Ref ProjColDist in 4-ImageCornerBlocks
-
-                    //////////////////////////////////////////////////////////////////////////
-                    //---- DMA: RawRef(DDR10bit->DSP16bit)
-                    // Block(#i,#j) Valid Range
-                    rects[k].rowUseful = minRefBlocksRow;// Rect Useful
-                    rects[k].colUseful = minRefBlocksCol;
-                    rects[k].hgtUseful = MIN(maxProjRowDist + nBaseBlkHgt,  mRawHgt - minRefBlocksRow);
-                    rects[k].widUseful = MIN(maxProjColDist + RAW_BLK_SIZE, mRawWid - minRefBlocksCol);
-                    // Bounding Rectangle of RawRef
-                    nRefBlkRow_border    = minRefBlocksRow - RAW_BLK_BORDER; // Maybe Include Invalid Data
-                    nRefBlkCol_border    = minRefBlocksCol - RAW_BLK_BORDER;
-                    nRefBlkCol_border    = ALIGN_4PIXEL_START(nRefBlkCol_border);
-                    nRefBlkHgt_border    = maxProjRowDist + nBaseBlkHgt + 2*RAW_BLK_BORDER;//MIN(blkHgt, mRawHgt-nBaseBlkRow) + maxProjRowDist + 2*RAW_BLK_BORDER;
-                    nRefBlkWid_border    = maxProjColDist + RAW_BLK_SIZE + 2*(minRefBlocksCol-nRefBlkCol_border);//MIN(blkWid, mRawWid-nBaseBlkCol) + maxProjColDist + 2*RAW_BLK_BORDER;
-                    nRefBlkWid_border    = ALIGN_4PIXEL_WIDTH(nRefBlkWid_border);
-                    nRefBlkStride_border = nRefBlkWid_border * sizeof(RK_U16); // stride in DSP
-                    rects[k].rowExtend    = nRefBlkRow_border; // Rect Extend
-                    rects[k].colExtend    = nRefBlkCol_border;
-                    rects[k].hgtExtend    = nRefBlkHgt_border;
-                    rects[k].widExtend    = nRefBlkWid_border;
-                    rects[k].strideExtend = nRefBlkStride_border;
-                    // Valid Data Rectangle in RawRef
-                    nRefBlkRow_4p    = MAX(nRefBlkRow_border, 0);// Only Include Valid Data
-                    nRefBlkCol_4p    = MAX(nRefBlkCol_border, 0);
-                    nRefBlkHgt_4p    = MIN(nRefBlkHgt_border - (nRefBlkRow_4p - nRefBlkRow_border), mRawHgt - nRefBlkRow_4p);
-                    nRefBlkWid_4p    = MIN(nRefBlkWid_border - (nRefBlkCol_4p - nRefBlkCol_border), mRawWid - nRefBlkCol_4p);
-                    nRefBlkCol_4p    = ALIGN_4PIXEL_START(nRefBlkCol_4p);
-                    nStartCol_4p     = nRefBlkCol_4p - nRefBlkCol_4p;
-                    nRefBlkWid_4p    = ALIGN_4PIXEL_WIDTH(nStartCol_4p + nRefBlkWid_4p);
-                    rects[k].rowValid = nRefBlkRow_4p;// Rect Valid
-                    rects[k].colValid = nRefBlkCol_4p;
-                    rects[k].hgtValid = nRefBlkHgt_4p;
-                    rects[k].widValid = nRefBlkWid_4p;
-                    // Rect Useful Constraint
-                    nRowCrop = rects[k].rowValid - rects[k].rowUseful;
-                    rects[k].rowUseful += MAX(0, nRowCrop);
-                    rects[k].hgtUseful -= MAX(0, nRowCrop);
-                    nColCrop = rects[k].colValid - rects[k].colUseful;
-                    rects[k].colUseful += MAX(0, nColCrop);
-                    rects[k].widUseful -= MAX(0, nColCrop);
+                    EnhancerTileWait(chunkIdx_nr ^ 1); // windows issued before the failing one
+                    TRACE_END(mTrace, evTile);
+#if MY_DEBUG_PRINTF == 1
+                    printf("Failed to EnhancerTileIssue: Tile(%d, %d) !\n", nNextRow, nNextCol);
+#endif
+                    return ret;
+                }
+            }
 
-                    // DMA
-                    pDdrRawRef = (RK_U16*)((RK_U8*)pRawSrcs[k] 
-                               + rects[k].rowValid * mRawStride 
-                               + rects[k].colValid * 5/4); // stride = mThumbStride
-                    pDspRawRef = (RK_U16*)((RK_U8*)pRawBlkChunks[chunkIdx_nr][k]
-                               + (rects[k].rowValid - rects[k].rowExtend) * rects[k].strideExtend 
-                               + (rects[k].colValid - rects[k].colExtend) * sizeof(RK_U16));
-//                    memset(pRawBlkChunks[chunkIdx_nr][k], 0, sizeof(RK_U16) * (blkHgt+2*4) * (blkWid+2*8));
-                    RKDMA_ReadRaw10bit2DSP((U32)pDdrRawRef, (U32)pDspRawRef, 
-                        rects[k].widValid, rects[k].hgtValid, 
-                        mRawStride, rects[k].strideExtend, 
-                        rects[k].colValid);
-                } // if k
-            } // for k
 
+            // Buf Idx: TemporalDenoise writes the Tile straight into the BlkBuf
+            currentBufIdx_wdr = (currentBufIdx_wdr + 1) & 0x1; // odd-even for LoadData
+            anotherBufIdx_wdr = (currentBufIdx_wdr + 1) & 0x1; // odd-even for Process
 
             // Temporal Denoise (Modify)
-            TemporalDenoise_Modify(pRawBlkChunks[chunkIdx_nr], numBlocks, rects, 
-                mRawFileNum, mBasePicNum, pRawBlkPoints, 
+            PROFILE_BEGIN(mProfile, PROF_ENH_TEMPORAL_DENOISE);
+            TRACE_BEGIN(mTrace, evTd, "TemporalDenoise_Modify", TRACE_TRACK_DSP);
+            TRACE_ARG(mTrace, evTd, "chunkIdx_nr", chunkIdx_nr);
+            TRACE_ARG(mTrace, evTd, "numBlocks", numBlocks[chunkIdx_nr]);
+            TemporalDenoise_Modify(pTileChunks[chunkIdx_nr], numBlocks[chunkIdx_nr], rects[chunkIdx_nr], 
+                mRawFileNum, mBasePicNum, pRawBlkPoints[chunkIdx_nr], 
                 MotionDetectTable, mIspGain, mBlackLevel,
-                pRawDstChunk);
+                pWdrRawBlockBuf[currentBufIdx_wdr] + 2*nWdrBufWid + 1, nWdrBufWid);
+            TRACE_END(mTrace, evTd);
+            PROFILE_END(mProfile, PROF_ENH_TEMPORAL_DENOISE);
 
             //////////////////////////////////////////////////////////////////////////
             // TemporalDenoise Result
             /*/ DMA
-            pDdrRawDst = (RK_U16*)((RK_U8*)pRawDst + rects[mBasePicNum].rowUseful * mRawStride + rects[mBasePicNum].colUseful * 5/4); // stride = mThumbStride
-            RKDMA_WriteRaw16bit2DDR((U32)pRawDstChunk, (U32)pDdrRawDst, rects[mBasePicNum].widUseful, rects[mBasePicNum].hgtUseful, 
-                rects[mBasePicNum].widUseful*sizeof(RK_U16), mRawStride, rects[mBasePicNum].colUseful);
+            pDdrRawDst = (RK_U16*)((RK_U8*)pRawDst + rects[chunkIdx_nr][mBasePicNum].rowUseful * mRawStride + rects[chunkIdx_nr][mBasePicNum].colUseful * 5/4); // stride = mThumbStride
+            RKDMA_WriteRaw16bit2DDR((RK_Addr)(pWdrRawBlockBuf[currentBufIdx_wdr] + 2*nWdrBufWid + 1), (RK_Addr)pDdrRawDst, rects[chunkIdx_nr][mBasePicNum].widUseful, rects[chunkIdx_nr][mBasePicNum].hgtUseful, 
+                nWdrBufWid*sizeof(RK_U16), mRawStride, rects[chunkIdx_nr][mBasePicNum].colUseful);
             //*/
 
 //*
             // BayerWDR
             //////////////////////////////////////////////////////////////////////////
             //// Bayer WDR
-            // Buf Idx
-            currentBufIdx_wdr = (currentBufIdx_wdr + 1) & 0x1; // odd-even for LoadData
-            anotherBufIdx_wdr = (currentBufIdx_wdr + 1) & 0x1; // odd-even for Process
+            TRACE_ARG(mTrace, evTile, "currentBufIdx_wdr", currentBufIdx_wdr);
             // Rect Info
-            pWdrRawBlockRect[currentBufIdx_wdr][0] = rects[mBasePicNum].rowUseful; // =i;
-            pWdrRawBlockRect[currentBufIdx_wdr][1] = rects[mBasePicNum].colUseful; // =j;
-            pWdrRawBlockRect[currentBufIdx_wdr][2] = rects[mBasePicNum].hgtUseful;
-            pWdrRawBlockRect[currentBufIdx_wdr][3] = rects[mBasePicNum].widUseful;
+            pWdrRawBlockRect[currentBufIdx_wdr][0] = rects[chunkIdx_nr][mBasePicNum].rowUseful; // =i;
+            pWdrRawBlockRect[currentBufIdx_wdr][1] = rects[chunkIdx_nr][mBasePicNum].colUseful; // =j;
+            pWdrRawBlockRect[currentBufIdx_wdr][2] = rects[chunkIdx_nr][mBasePicNum].hgtUseful;
+            pWdrRawBlockRect[currentBufIdx_wdr][3] = rects[chunkIdx_nr][mBasePicNum].widUseful;
 
-            // Fill Block32x64 from TemporalDenoise
-            CopyBlockData(pRawDstChunk, pWdrRawBlockBuf[currentBufIdx_wdr] + 2 * nWdrBufWid + 1,  
-                blkWid, blkHgt, blkWid*2, nWdrBufWid*2);
+            // Block TileHgtxTileWid already in place from TemporalDenoise
+            PROFILE_BEGIN(mProfile, PROF_ENH_HALO_COPY);
+            TRACE_BEGIN(mTrace, evHalo, "halo_copy", TRACE_TRACK_DSP);
 
             // Fill 2-TopExternalRows from RowBuf
             CopyBlockData(pWdrRawRowBuf + j, pWdrRawBlockBuf[currentBufIdx_wdr], 
                 nWdrBufWid, 2, nRowsBufWid*2, nWdrBufWid*2);
 
-            // Fill 1-LeftCol from ColBuf
-            CopyBlockData(pWdrRawColBuf, pWdrRawBlockBuf[currentBufIdx_wdr]+2*nWdrBufWid, 
-                1, RAW_BLK_SIZE, 2, nWdrBufWid*2);
+            // Fill 1-LeftCol from AnotherBuf (the left Tile), 0 at the Raw left edge like the TopRows at the top edge
+            if (j == 0)
+            {
+                for (int r=0; r < blkHgt; r++)
+                {
+                    pWdrRawBlockBuf[currentBufIdx_wdr][(2+r)*nWdrBufWid] = 0;
+                }
+            }
+            else
+            {
+                CopyBlockData(pWdrRawBlockBuf[anotherBufIdx_wdr] + 2*nWdrBufWid + blkWid, 
+                              pWdrRawBlockBuf[currentBufIdx_wdr] + 2*nWdrBufWid, 
+                              1, blkHgt, nWdrBufWid*2, nWdrBufWid*2);
+            }
 
-            // Update 1-RightCol
-            CopyBlockData(pWdrRawBlockBuf[currentBufIdx_wdr]+2*nWdrBufWid+RAW_BLK_SIZE*RAW_WIN_NUM, pWdrRawColBuf, 
-                1, RAW_BLK_SIZE, nWdrBufWid*2, 2);
+            // 1-RightCol at the Raw right edge: 0, not filled from the next Tile
+            if (j + blkWid >= mRawWid)
+            {
+                for (int r=0; r < blkHgt; r++)
+                {
+                    pWdrRawBlockBuf[currentBufIdx_wdr][(2+r)*nWdrBufWid + 1 + rects[chunkIdx_nr][mBasePicNum].widUseful] = 0;
+                }
+            }
+            TRACE_END(mTrace, evHalo);
+            PROFILE_END(mProfile, PROF_ENH_HALO_COPY);
 
             // 
             if (i==0 && j==0)
             {
                 // First Block of Image
+                TRACE_END(mTrace, evTile);
                 continue;
             }
             else
             {
-                // Fill 1-RightCol from AnotherBuf
-                CopyBlockData(pWdrRawBlockBuf[currentBufIdx_wdr] + 2*nWdrBufWid + 1, 
-                              pWdrRawBlockBuf[anotherBufIdx_wdr] + 2*nWdrBufWid + RAW_BLK_SIZE*RAW_WIN_NUM+1, 
-                              1, RAW_BLK_SIZE, nWdrBufWid*2, nWdrBufWid*2);
+                // Fill 1-RightCol from AnotherBuf (in the same Tile row)
+                PROFILE_BEGIN(mProfile, PROF_ENH_HALO_COPY);
+                TRACE_BEGIN(mTrace, evHaloWdr, "halo_copy", TRACE_TRACK_DSP);
+                if (j != 0)
+                {
+                    CopyBlockData(pWdrRawBlockBuf[currentBufIdx_wdr] + 2*nWdrBufWid + 1, 
+                                  pWdrRawBlockBuf[anotherBufIdx_wdr] + 2*nWdrBufWid + blkWid+1, 
+                                  1, blkHgt, nWdrBufWid*2, nWdrBufWid*2);
+                }
 
 
                 // Update 2-TopRows to RowBuf
-                CopyBlockData(pWdrRawBlockBuf[anotherBufIdx_wdr] + RAW_BLK_SIZE*nWdrBufWid, 
+                CopyBlockData(pWdrRawBlockBuf[anotherBufIdx_wdr] + blkHgt*nWdrBufWid, 
                               pWdrRawRowBuf + pWdrRawBlockRect[anotherBufIdx_wdr][1], 
                               nWdrBufWid, 2, nWdrBufWid*2, nRowsBufWid*2);
+                TRACE_END(mTrace, evHaloWdr);
+                PROFILE_END(mProfile, PROF_ENH_HALO_COPY);
 
 
                 //////////////////////////////////////////////////////////////////////////
                 // BayerWDR
+                PROFILE_BEGIN(mProfile, PROF_ENH_BAYER_WDR);
+                TRACE_BEGIN(mTrace, evWdr, "wdr_process_block", TRACE_TRACK_DSP);
+                TRACE_ARG(mTrace, evWdr, "anotherBufIdx_wdr", anotherBufIdx_wdr);
+#if MFNR_TRACE == 1
+                mTraceSlot = anotherBufIdx_wdr;
+#endif
                 wdr_process_block(
                     pWdrRawBlockRect[anotherBufIdx_wdr][1],//rects[mBasePicNum].colUseful,       // [in] x of block in Raw 
 					pWdrRawBlockRect[anotherBufIdx_wdr][0],//rects[mBasePicNum].rowUseful,       // [in] y of block in Raw 
-					pWdrRawBlockRect[anotherBufIdx_wdr][3],//rects[mBasePicNum].widUseful,       // [in] min(64, valid)    
-					pWdrRawBlockRect[anotherBufIdx_wdr][2],//rects[mBasePicNum].hgtUseful,       // [in] min(32, valid)   
+					pWdrRawBlockRect[anotherBufIdx_wdr][3],//rects[mBasePicNum].widUseful,       // [in] min(TileWid, valid)    
+					pWdrRawBlockRect[anotherBufIdx_wdr][2],//rects[mBasePicNum].hgtUseful,       // [in] min(TileHgt, valid)   
                     ((mRawWid+128)/256+1),	            // [in] (raw_width+128)/256+1 floor((4164+128)/256)+1
-                    66,	                                // [in] buffer stride         66
-                    64,		                            // [in] picture stride        64
+                    nWdrBufWid,	                        // [in] buffer stride         TileWid+2: 66
+                    blkWid,		                        // [in] picture stride        TileWid:   64
                     pWdrRawBlockBuf[anotherBufIdx_wdr], // [in] input buf             34x66*2B
-          		#if WDR_WEIGHT_TRANSPOSE
-					pWdrThumbWgtTable1,
-					//pWdrThumbWgtTable + 9*256,
-		  		#else
-                    pWdrThumbWgtTable,	                // [in] thumb weight table,   9x256*2B
-                #endif
+                    pWdrThumbWgtTable,	                // [in] thumb weight table,   WDR_THUMB_TABLE_SIZE*2B
                     pWdrScaleTable,                     // [in] tabale[expouse_times] 961*2B
                     pWdrGainMat,                        // [out] Gain Matrix          32x64*2B
                     pWdrRawResult,                      // [out] WDR result           32x64*2B
                     pWdrLeftRight);                     // [in] 32x16*2B byte space   2K store 32 line left and right, align 16, actually 9 valid..
+                TRACE_END(mTrace, evWdr);
+                PROFILE_END(mProfile, PROF_ENH_BAYER_WDR);
 #ifdef CEVA_CHIP_CODE_BAYERWDR // #if 0-WDR Bypass, 1-WDR
 				// DMA                                                                                                                  
-				if ( (i == 0) || (i == 32 && j == 0))
+				if ( (i == 0) || (i == blkHgt && j == 0))
 				{                                                                                                                       
 				    // DspRow[1:31]->DdrRow[0:30]                                                                                       
-				    pDspWdrBuf = (RK_U16*)(pWdrRawResult + RAW_BLK_SIZE*RAW_WIN_NUM);   // DspRow[1:31]                                 
+				    pDspWdrBuf = (RK_U16*)(pWdrRawResult + blkWid);                     // DspRow[1:31]                                 
 				    pDdrRawDst = (RK_U16*)((RK_U8*)pRawDst                                                                              
 				        + pWdrRawBlockRect[anotherBufIdx_wdr][0] * mRawStride           // DdrRow[0:30]                                 
 				        + pWdrRawBlockRect[anotherBufIdx_wdr][1] * 5/4);                                                                
-				    RKDMA_WriteRaw16bit2DDR((U32)pDspWdrBuf, (U32)pDdrRawDst,                                                           
+				    PROFILE_BEGIN(mProfile, PROF_ENH_DMA_OUT);
+				    RKDMA_WriteRaw16bit2DDR((RK_Addr)pDspWdrBuf, (RK_Addr)pDdrRawDst,                                                           
 				        pWdrRawBlockRect[anotherBufIdx_wdr][3], pWdrRawBlockRect[anotherBufIdx_wdr][2] - 1, // w, h-1                   
-				        pWdrRawBlockRect[anotherBufIdx_wdr][3]*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[anotherBufIdx_wdr][1]);     
+				        blkWid*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[anotherBufIdx_wdr][1]);     
+				    PROFILE_END(mProfile, PROF_ENH_DMA_OUT);
 				}                                                                                                                       
 				else                                                                                                                    
 				{                                                                                                                       
@@ -3071,259 +4405,835 @@ int classMFNR::Enhancer_Modify(RK_RawType* pRawDst)
 				    pDdrRawDst = (RK_U16*)((RK_U8*)pRawDst                                                                              
 				        + (pWdrRawBlockRect[anotherBufIdx_wdr][0] - 1) * mRawStride     // DdrRow[32N-1:32(N+1)-2]                      
 				        + pWdrRawBlockRect[anotherBufIdx_wdr][1] * 5/4);                                                                
-				    RKDMA_WriteRaw16bit2DDR((U32)pWdrRawResult, (U32)pDdrRawDst,                                                        
+				    PROFILE_BEGIN(mProfile, PROF_ENH_DMA_OUT);
+				    RKDMA_WriteRaw16bit2DDR((RK_Addr)pWdrRawResult, (RK_Addr)pDdrRawDst,                                                        
 				        pWdrRawBlockRect[anotherBufIdx_wdr][3], pWdrRawBlockRect[anotherBufIdx_wdr][2], // w, h                         
-				        pWdrRawBlockRect[anotherBufIdx_wdr][3]*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[anotherBufIdx_wdr][1]);     
+				        blkWid*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[anotherBufIdx_wdr][1]);     
+				    PROFILE_END(mProfile, PROF_ENH_DMA_OUT);
 				}                                                                                                                       
 #else
 				// DMA
 				pDdrRawDst = (RK_U16*)((RK_U8*)pRawDst
 					+ pWdrRawBlockRect[anotherBufIdx_wdr][0] * mRawStride
 					+ pWdrRawBlockRect[anotherBufIdx_wdr][1] * 5/4); // stride = mThumbStride
-				RKDMA_WriteRaw16bit2DDR((U32)pWdrRawResult, (U32)pDdrRawDst,
+				PROFILE_BEGIN(mProfile, PROF_ENH_DMA_OUT);
+				RKDMA_WriteRaw16bit2DDR((RK_Addr)pWdrRawResult, (RK_Addr)pDdrRawDst,
 					pWdrRawBlockRect[anotherBufIdx_wdr][3], pWdrRawBlockRect[anotherBufIdx_wdr][2], // w, h
-					pWdrRawBlockRect[anotherBufIdx_wdr][3]*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[anotherBufIdx_wdr][1]);
+					blkWid*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[anotherBufIdx_wdr][1]);
+				PROFILE_END(mProfile, PROF_ENH_DMA_OUT);
 				///
 #endif
 
             } // WDR
 //*/
 
-
+            TRACE_END(mTrace, evTile);
         } // for j
     } // for i
 
 //*
     //// Processing Last Block(#end, #end)
     // BayerWDR
+    PROFILE_BEGIN(mProfile, PROF_ENH_BAYER_WDR);
+    TRACE_BEGIN(mTrace, evWdrLast, "wdr_process_block", TRACE_TRACK_DSP);
+    TRACE_ARG(mTrace, evWdrLast, "currentBufIdx_wdr", currentBufIdx_wdr);
+#if MFNR_TRACE == 1
+    mTraceSlot = currentBufIdx_wdr;
+#endif
     wdr_process_block(
-        pWdrRawBlockRect[anotherBufIdx_wdr][1],//rects[mBasePicNum].colUseful,       // [in] x of block in Raw 
-		pWdrRawBlockRect[anotherBufIdx_wdr][0],//rects[mBasePicNum].rowUseful,       // [in] y of block in Raw 
-		pWdrRawBlockRect[anotherBufIdx_wdr][3],//rects[mBasePicNum].widUseful,       // [in] min(64, valid)    
-		pWdrRawBlockRect[anotherBufIdx_wdr][2],//rects[mBasePicNum].hgtUseful,       // [in] min(32, valid)   
+        pWdrRawBlockRect[currentBufIdx_wdr][1],//rects[mBasePicNum].colUseful,       // [in] x of block in Raw 
+		pWdrRawBlockRect[currentBufIdx_wdr][0],//rects[mBasePicNum].rowUseful,       // [in] y of block in Raw 
+		pWdrRawBlockRect[currentBufIdx_wdr][3],//rects[mBasePicNum].widUseful,       // [in] min(TileWid, valid)    
+		pWdrRawBlockRect[currentBufIdx_wdr][2],//rects[mBasePicNum].hgtUseful,       // [in] min(TileHgt, valid)   
         ((mRawWid+128)/256+1),	            // [in] (raw_width+128)/256+1 floor((4164+128)/256)+1
-        66,	                                // [in] buffer stride         66
-        64,		                            // [in] picture stride        64
+        nWdrBufWid,	                        // [in] buffer stride         TileWid+2: 66
+        blkWid,		                        // [in] picture stride        TileWid:   64
         pWdrRawBlockBuf[currentBufIdx_wdr], // [in] input buf             34x66*2B
-	#if WDR_WEIGHT_TRANSPOSE
-		pWdrThumbWgtTable1,
-		//pWdrThumbWgtTable + 9*256,
-	#else
-		pWdrThumbWgtTable,	                // [in] thumb weight table,   9x256*2B
-	#endif
+        pWdrThumbWgtTable,	                // [in] thumb weight table,   WDR_THUMB_TABLE_SIZE*2B
         pWdrScaleTable,                     // [in] tabale[expouse_times] 961*2B
         pWdrGainMat,                        // [out] Gain Matrix          32x64*2B
         pWdrRawResult,                      // [out] WDR result           32x64*2B
         pWdrLeftRight);                     // [in] 32x16*2B byte space   2K store 32 line left and right, align 16, actually 9 valid..
         //pWdrRight);                         // [in] 32x16*2B byte space
+    TRACE_END(mTrace, evWdrLast);
+    PROFILE_END(mProfile, PROF_ENH_BAYER_WDR);
 #ifdef CEVA_CHIP_CODE_BAYERWDR // #if 0-WDR Bypass, 1-WDR
     // DMA
      pDdrRawDst = (RK_U16*)((RK_U8*)pRawDst
     	+ (pWdrRawBlockRect[currentBufIdx_wdr][0] - 1 )* mRawStride
 		+ pWdrRawBlockRect[currentBufIdx_wdr][1] * 5/4); // stride = mThumbStride
-     RKDMA_WriteRaw16bit2DDR((U32)pWdrRawResult, (U32)pDdrRawDst,                                                    
+     PROFILE_BEGIN(mProfile, PROF_ENH_DMA_OUT);
+     RKDMA_WriteRaw16bit2DDR((RK_Addr)pWdrRawResult, (RK_Addr)pDdrRawDst,                                                    
     	pWdrRawBlockRect[currentBufIdx_wdr][3], pWdrRawBlockRect[currentBufIdx_wdr][2], // w, h
-		pWdrRawBlockRect[currentBufIdx_wdr][3]*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[currentBufIdx_wdr][1]);
+		blkWid*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[currentBufIdx_wdr][1]);
+     PROFILE_END(mProfile, PROF_ENH_DMA_OUT);
 #else
      // DMA
 	 pDdrRawDst = (RK_U16*)((RK_U8*)pRawDst
 		+ pWdrRawBlockRect[currentBufIdx_wdr][0] * mRawStride
 		+ pWdrRawBlockRect[currentBufIdx_wdr][1] * 5/4); // stride = mThumbStride
-	 RKDMA_WriteRaw16bit2DDR((U32)pWdrRawResult, (U32)pDdrRawDst,
+	 PROFILE_BEGIN(mProfile, PROF_ENH_DMA_OUT);
+	 RKDMA_WriteRaw16bit2DDR((RK_Addr)pWdrRawResult, (RK_Addr)pDdrRawDst,
 		pWdrRawBlockRect[currentBufIdx_wdr][3], pWdrRawBlockRect[currentBufIdx_wdr][2], // w, h
-		pWdrRawBlockRect[currentBufIdx_wdr][3]*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[currentBufIdx_wdr][1]);
+		blkWid*sizeof(RK_U16), mRawStride, pWdrRawBlockRect[currentBufIdx_wdr][1]);
+	 PROFILE_END(mProfile, PROF_ENH_DMA_OUT);
 	 //
 #endif
-//*/
+//*/
+
+    //
+    return ret;
+
+} // Enhancer_Modify()
+
+
+/************************************************************************/
+// Func: classMFNR::MFNR_Process()
+// Desc: MFNR Process
+//   In: 
+//  Out: pRawDst        - [out] RawDst data pointer
+// 
+// Date: Revised by yousf 20160822
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::MFNR_Process(RK_RawType* pRawDst)
+{
+    //
+    int     ret = 0; // return value
+#if MY_DEBUG_PRINTF == 1
+    printf("classMFNR::MFNR_Process()\n");
+#endif
+    //////////////////////////////////////////////////////////////////////////
+
+    // Stage Profile
+    PROFILE_RESET(mProfile);
+
+    // DSP Memory addr#0
+    mDspArena.nStage = DSPMEM_PROCESS; // DMA Traffic site, layout by DspMemPlan() in MFNR_Init
+    mDspArena.stats.nOverrunBlock = -1; // runtime overrun of this burst only
+#if MFNR_DMA_STATS == 1
+    DmaStatsReset();
+#endif
+#if MFNR_TRACE == 1
+    if (mTrace.pEvents == NULL)
+    {
+        mTrace.pEvents = (RK_TraceEvent*)malloc(sizeof(RK_TraceEvent) * TRACE_MAX_EVENTS);
+    }
+    mTrace.nCount   = 0;
+    mTrace.nDropped = 0;
+    mTrace.nOrigin  = RK_ProfileTick();
+    mTraceSlot      = 0;
+    mTraceXferNum   = 0;
+#endif
+
+
+    //////////////////////////////////////////////////////////////////////////
+    //// Process Module-1: Register Interface 
+#if BYPASS_Register == DISABLE_BYPASS
+    // ThumbBuild: ThumbSrcs of the frames given without pThumbSrcs
+    if (mThumbBuildMask)
+    {
+        TRACE_BEGIN(mTrace, evThumbBuild, "ThumbBuild", TRACE_TRACK_DSP);
+        ret = ThumbBuild();
+        TRACE_END(mTrace, evThumbBuild);
+        if (ret)
+        {
+#if MY_DEBUG_PRINTF == 1
+            printf("Failed to ThumbBuild !\n");
+#endif
+            return ret;
+        }
+    }
+
+    // Register: FeatureDetect & FeatureFilter & CoarseMatching & FineMatching & ComputeHomography
+    TRACE_BEGIN(mTrace, evRegister, "Register", TRACE_TRACK_DSP);
+    ret = Register();
+    TRACE_END(mTrace, evRegister);
+    if (ret)
+    {
+#if MY_DEBUG_PRINTF == 1
+        printf("Failed to Register !\n");
+#endif
+        return ret;
+    }
+
+    // Write Register Result
+//     ret = Register_BypassWrite(pHomographyMatrix, mRawFileNum);
+//     if (ret)
+//     {
+// #if MY_DEBUG_PRINTF == 1
+//         printf("Failed to Register_BypassWrite !\n");
+// #endif
+//         return ret;
+//     }
+    
+#elif BYPASS_Register == ENABLE_BYPASS  // Bypass
+    // Read Register Result
+//     ret = Register_BypassRead(mRawFileNum, pHomographyMatrix);
+//     if (ret)
+//     {
+// #if MY_DEBUG_PRINTF == 1
+//         printf("Failed to Register_BypassWrite !\n");
+// #endif
+//         return ret;
+//     }
+
+#endif
+
+
+    //////////////////////////////////////////////////////////////////////////
+    //// Process Module-2: Enhancer Interface
+#if BYPASS_Enhancer == DISABLE_BYPASS
+    // Enhancer: TemporalDenoise & BayerWDR & SpatialDenoise
+#if USE_MODIFY_ENHANCER == 0
+    ret = Enhancer(pRawDst);
+#else
+    TRACE_BEGIN(mTrace, evEnhancer, "Enhancer_Modify", TRACE_TRACK_DSP);
+    ret = Enhancer_Modify(pRawDst);
+    TRACE_END(mTrace, evEnhancer);
+#endif
+    if (ret)
+    {
+#if MY_DEBUG_PRINTF == 1
+        printf("Failed to Enhancer !\n");
+#endif
+        return ret;
+    }
+
+#elif BYPASS_Register == ENABLE_BYPASS  // Bypass
+    // TODO ...
+
+#endif
+
+#if MFNR_DMA_STATS == 1
+    DmaStatsFinish();
+#endif
+
+    //
+    return ret;
+
+} // classMFNR::MFNR_Process()
+
+
+
+/************************************************************************/
+// Func: classMFNR::MFNR_UnInit()
+// Desc: MFNR UnInit
+//   In: 
+//  Out: 
+// 
+// Date: Revised by yousf 20160804
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::MFNR_UnInit(void)
+{
+    //
+    int     ret = 0; // return value
+#if MY_DEBUG_PRINTF == 1
+    printf("classMFNR::MFNR_UnInit()\n");
+#endif
+#if DMA_FETCH_MAP == 1
+    DmaStatsFree(); // left over when MFNR_Process stopped early
+#endif
+    for (int k=0; k < RK_MAX_FILE_NUM; k++)
+    {
+        free(pThumbBufs[k]);
+        pThumbBufs[k] = NULL;
+        free(pPyrBufs[k]);
+        pPyrBufs[k]   = NULL;
+    }
+    mThumbBuildMask = 0;
+
+    //
+    return ret;
+
+} // classMFNR::MFNR_UnInit()
+
+
+/************************************************************************/
+// Func: classMFNR::MFNR_GetProfile()
+// Desc: Stage timers & counters of the last MFNR_Process
+//   In: 
+//  Out: pStats         - [out] stage profile, zeroed when not compiled in
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::MFNR_GetProfile(RK_ProfileStats* pStats)
+{
+    //
+    int     ret = 0; // return value
+
+    if (pStats == NULL)
+    {
+        ret = -1;
+        return ret;
+    }
+
+#if MFNR_STAGE_PROFILE == 1
+    memcpy(pStats, &mProfile, sizeof(RK_ProfileStats));
+#else
+    memset(pStats, 0, sizeof(RK_ProfileStats));
+    ret = -1; // MFNR_STAGE_PROFILE == 0
+#endif
+
+    //
+    return ret;
+
+} // classMFNR::MFNR_GetProfile()
+
+
+/************************************************************************/
+// Func: classMFNR::MFNR_GetDspMemStats()
+// Desc: DSP Memory peaks & map of the last MFNR_Process
+//   In: 
+//  Out: pStats         - [out] DSP Memory stats
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::MFNR_GetDspMemStats(RK_DspMemStats* pStats)
+{
+    //
+    int     ret = 0; // return value
+
+    if (pStats == NULL)
+    {
+        ret = -1;
+        return ret;
+    }
+    memcpy(pStats, &mDspArena.stats, sizeof(RK_DspMemStats));
+
+    //
+    return ret;
+
+} // classMFNR::MFNR_GetDspMemStats()
+
+
+/************************************************************************/
+// Func: classMFNR::MFNR_DumpDspMem()
+// Desc: printf the DSP Memory peaks & map of the last MFNR_Process
+//   In: 
+//  Out: 
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::MFNR_DumpDspMem(void)
+{
+    //
+    int     ret = 0; // return value
+    static const char* sStageNames[DSPMEM_STAGE_NUM] =
+    {
+        "process", "thumb_build", "reg_feature_detect", "reg_pyramid", "reg_coarse_match", "reg_fine_match", "reg_homography", "enhancer"
+    };
+    RK_DspMemStats*     pStats = &mDspArena.stats;
+    RK_DspMemBlock*     pBlock;
+    int                 nBlockNum;
+
+    printf("DSP Memory: capacity %u, peak %u (%.1f%%)\n",
+        pStats->nCapacity, pStats->nPeak, pStats->nPeak * 100.0 / pStats->nCapacity);
+    for (int k=0; k < DSPMEM_STAGE_NUM; k++)
+    {
+        printf("  stage %-20s peak %7u\n", sStageNames[k], pStats->nStagePeak[k]);
+    }
+
+    nBlockNum = MIN((int)pStats->nBlockNum, DSPMEM_MAX_BLOCK);
+    printf("  %-20s %8s %8s %8s  %s\n", "stage", "offset", "size", "end", "label");
+    for (int n=0; n < nBlockNum; n++)
+    {
+        pBlock = &pStats->blocks[n];
+        printf("  %-20s %8u %8u %8u  %s", sStageNames[pBlock->nStage],
+            pBlock->nOffset, pBlock->nSize, pBlock->nOffset + pBlock->nSize, pBlock->pLabel);
+        for (int i=0; i < 2 && pBlock->nIndex[i] >= 0; i++)
+        {
+            printf("[%d]", pBlock->nIndex[i]);
+        }
+        printf("%s\n", n == pStats->nFailBlock ? "  <-- overflow" : (n == pStats->nOverrunBlock ? "  <-- overrun" : ""));
+    }
+    if (pStats->nBlockNum > DSPMEM_MAX_BLOCK)
+    {
+        printf("  ... %u more blocks not recorded\n", pStats->nBlockNum - DSPMEM_MAX_BLOCK);
+    }
+    if (pStats->nFailBlock >= 0)
+    {
+        pBlock = &pStats->failBlock;
+        printf("DSP Memory overflow at %s", pBlock->pLabel);
+        for (int i=0; i < 2 && pBlock->nIndex[i] >= 0; i++)
+        {
+            printf("[%d]", pBlock->nIndex[i]);
+        }
+        printf(": %u bytes over capacity\n", pBlock->nOffset + pBlock->nSize - pStats->nCapacity);
+    }
+    if (pStats->nOverrunBlock >= 0 && pStats->nOverrunBlock < DSPMEM_MAX_BLOCK)
+    {
+        pBlock = &pStats->blocks[pStats->nOverrunBlock];
+        printf("DSP Memory overrun of %s", pBlock->pLabel);
+        for (int i=0; i < 2 && pBlock->nIndex[i] >= 0; i++)
+        {
+            printf("[%d]", pBlock->nIndex[i]);
+        }
+        if (pStats->nOverrunGuard != 0)
+        {
+            printf(": guard of %u bytes after the %u planned overwritten\n", 
+                pStats->nOverrunGuard, pStats->nOverrunSize - pStats->nOverrunGuard);
+        }
+        else
+        {
+            printf(": %u bytes asked, %u planned (data-dependent window)\n", pStats->nOverrunSize, pBlock->nSize - DSPMEM_GUARD_SIZE);
+        }
+    }
+
+    //
+    return ret;
+
+} // classMFNR::MFNR_DumpDspMem()
+
+
+/************************************************************************/
+// Func: classMFNR::MFNR_GetDmaStats()
+// Desc: DDR traffic of the last MFNR_Process
+//   In: 
+//  Out: pStats         - [out] DMA stats, zeroed when not compiled in
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::MFNR_GetDmaStats(RK_DmaStats* pStats)
+{
+    //
+    int     ret = 0; // return value
+
+    if (pStats == NULL)
+    {
+        ret = -1;
+        return ret;
+    }
+
+#if MFNR_DMA_STATS == 1
+    memcpy(pStats, &mDmaStats, sizeof(RK_DmaStats));
+#else
+    memset(pStats, 0, sizeof(RK_DmaStats));
+    ret = -1; // MFNR_DMA_STATS == 0
+#endif
 
     //
     return ret;
 
-} // Enhancer_Modify()
+} // classMFNR::MFNR_GetDmaStats()
 
 
 /************************************************************************/
-// Func: classMFNR::MFNR_Process()
-// Desc: MFNR Process
+// Func: classMFNR::MFNR_DumpDmaStats()
+// Desc: printf the DDR traffic & read amplification of the last MFNR_Process
 //   In: 
-//  Out: pRawDst        - [out] RawDst data pointer
+//  Out: 
 // 
-// Date: Revised by yousf 20160822
+// Date: Created 20261017
 // 
 /*************************************************************************/
 CODE_MFNR_EX
-int classMFNR::MFNR_Process(RK_RawType* pRawDst)
+int classMFNR::MFNR_DumpDmaStats(void)
 {
     //
     int     ret = 0; // return value
-#if MY_DEBUG_PRINTF == 1
-    printf("classMFNR::MFNR_Process()\n");
-#endif
-    //////////////////////////////////////////////////////////////////////////
-    int     nChunkSize;                 // Memory Size for  DSP Malloc
-    int     nDspMem_NextModuleResetPos; // Next Module DSP Memory Reset Position
-
-    // DSP Memory addr#0
-    mDspMem_UsedCount = 0;  // Method-2: use MemoryArray, DSP Memory Array Used Count
-    mDspMem_ResetPos  = 0;  // Method-2: use MemoryArray, DSP Memory Reset Position
-
-    //////////////////////////////////////////////////////////////////////////
-    ////==== DSP Malloc: pHomographyMatrix & pWdrThumbWgtTable addr in DSP
-    // pHomographyMatrix
-    nChunkSize = sizeof(RK_F32) * 9;
-    for (int k=0; k < mRawFileNum; k++)
+#if MFNR_DMA_STATS == 1
+    static const char* sSiteNames[DSPMEM_STAGE_NUM] =
+    {
+        "process", "thumb_build", "reg_feature_detect", "reg_pyramid", "reg_coarse_match", "reg_fine_match", "reg_homography", "enhancer"
+    };
+    static const char* sRoleNames[DMA_ROLE_NUM] = { "base", "ref", "dst" };
+    RK_DmaStats*    pStats = &mDmaStats;
+    RK_DmaCounter*  pCounter;
+    RK_U64          nRawSum      = 0;
+    RK_U64          nThumbSum    = 0;
+    RK_U64          nRawTouch    = 0;
+    RK_U64          nThumbTouch  = 0;
+    double          nRawTotal    = (double)pStats->nRawFrameSize * pStats->nFrames;
+    double          nThumbTotal  = (double)pStats->nThumbFrameSize * pStats->nFrames;
+
+    printf("DMA traffic: %d frames, raw %u B, thumb %u B per frame\n",
+        pStats->nFrames, pStats->nRawFrameSize, pStats->nThumbFrameSize);
+    printf("  %-20s %-4s %12s %8s %8s %10s\n", "site", "role", "bytes", "descs", "rows", "B/desc");
+    for (int s=0; s < DSPMEM_STAGE_NUM; s++)
     {
-        pHomographyMatrix[k] = (RK_F32*)&dspMemoryArray[mDspMem_UsedCount];
-        mDspMem_UsedCount   += nChunkSize; // current used count
-        if (mDspMem_UsedCount > DSP_MEM_SIZE)
+        for (int r=0; r < DMA_ROLE_NUM; r++)
         {
-#if MY_DEBUG_PRINTF == 1
-            printf("Failed to Allocate pHomographyMatrix[%d] !\n", k);
-#endif
-            return ret;
+            pCounter = &pStats->site[s][r];
+            if (pCounter->nDescs == 0)
+            {
+                continue;
+            }
+            printf("  %-20s %-4s %12llu %8u %8u %10.1f\n", sSiteNames[s], sRoleNames[r],
+                (unsigned long long)pCounter->nBytes, pCounter->nDescs, pCounter->nRows,
+                (double)pCounter->nBytes / pCounter->nDescs);
         }
     }
-	mDspMem_UsedCount = ALIGN_SET(mDspMem_UsedCount, 64);
-    // pWdrThumbWgtTable // Thumb Weight Table: 9x256*2B
-    nChunkSize         = sizeof(RK_U16) * 9 * 256 * 2;// 
-    // add by zxy for store the  256x16*2B
-    nChunkSize        += sizeof(RK_U16) * 16 * 256 * 2;// 
-    pWdrThumbWgtTable  = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += nChunkSize; // current used count
 
-	// Trans
-    pWdrThumbWgtTable1  = (RK_U16*)&dspMemoryArray[mDspMem_UsedCount];
-    mDspMem_UsedCount += sizeof(RK_U16) * 16 * 256 * 2; // current used count
+    printf("  %-5s %14s %8s %14s %8s\n", "frame", "raw fetched", "amp", "thumb fetched", "amp");
+    for (int k=0; k < pStats->nFrames; k++)
+    {
+        nRawSum     += pStats->nRawFetched[k];
+        nThumbSum   += pStats->nThumbFetched[k];
+        nRawTouch   += pStats->nRawTouched[k];
+        nThumbTouch += pStats->nThumbTouched[k];
+        printf("  %-5d %14llu %8.3f %14llu %8.3f\n", k,
+            (unsigned long long)pStats->nRawFetched[k], (double)pStats->nRawFetched[k] / pStats->nRawFrameSize,
+            (unsigned long long)pStats->nThumbFetched[k], (double)pStats->nThumbFetched[k] / pStats->nThumbFrameSize);
+    }
+    printf("  burst raw amp %.3f, thumb amp %.3f, total amp %.3f\n",
+        nRawSum / nRawTotal, nThumbSum / nThumbTotal, (nRawSum + nThumbSum) / (nRawTotal + nThumbTotal));
+#if DMA_FETCH_MAP == 1
+    printf("  touched: raw %.1f%% (%.3f fetches per touched byte), thumb %.1f%% (%.3f)\n",
+        nRawTouch * 100.0 / nRawTotal, nRawTouch ? (double)nRawSum / nRawTouch : 0.0,
+        nThumbTouch * 100.0 / nThumbTotal, nThumbTouch ? (double)nThumbSum / nThumbTouch : 0.0);
+    printf("  %-7s %14s %14s\n", "fetches", "raw bytes", "thumb bytes");
+    for (int n=0; n < DMA_FETCH_HIST_NUM; n++)
+    {
+        printf("  %s%-5d %14llu %14llu\n", n == DMA_FETCH_HIST_NUM - 1 ? ">=" : "  ", n,
+            (unsigned long long)pStats->nRawFetchHist[n], (unsigned long long)pStats->nThumbFetchHist[n]);
+    }
+#endif
+#else
+    ret = -1; // MFNR_DMA_STATS == 0
+#endif
+
+    //
+    return ret;
+
+} // classMFNR::MFNR_DumpDmaStats()
+
 
+/************************************************************************/
+// Func: classMFNR::MFNR_WriteTrace()
+// Desc: Write the spans of the last MFNR_Process as trace-event JSON,
+//       loadable in chrome://tracing and ui.perfetto.dev
+//   In: pFileName      - output file
+//  Out: 
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int classMFNR::MFNR_WriteTrace(const char* pFileName)
+{
+    //
+    int     ret = 0; // return value
+#if MFNR_TRACE == 1 && defined(RK_HOST_PLATFORM)
+    FILE*           fp;
+    RK_TraceEvent*  pEvent;
+    double          fUsPerTick = 1e6 / PROFILE_TICKS_PER_SEC;
 
-	if (mDspMem_UsedCount > DSP_MEM_SIZE)
+    fp = fopen(pFileName, "w");
+    if (fp == NULL || mTrace.pEvents == NULL)
     {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Allocate pWdrThumbWgtTable !\n");
-#endif
+        if (fp != NULL)
+        {
+            fclose(fp);
+        }
+        ret = -1;
         return ret;
     }
-    // DSP Memory Reuse Operation
-    mDspMem_ResetPos           = mDspMem_UsedCount; // BaseAddress for Next Variable
-    nDspMem_NextModuleResetPos = mDspMem_ResetPos;  // BaseAddress for Process Module-2: Enhancer Interface
-
-    //////////////////////////////////////////////////////////////////////////
-    //// Process Module-1: Register Interface 
-#if BYPASS_Register == DISABLE_BYPASS
-    // Register: FeatureDetect & FeatureFilter & CoarseMatching & FineMatching & ComputeHomography
-    ret = Register();
-    if (ret)
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(fp, "{\"ph\":\"M\",\"pid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"MFNR\"}},\n");
+    fprintf(fp, "{\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"DSP\"}},\n", TRACE_TRACK_DSP);
+    fprintf(fp, "{\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"rdma\"}}", TRACE_TRACK_DMA);
+    for (RK_U32 n=0; n < mTrace.nCount; n++)
     {
-#if MY_DEBUG_PRINTF == 1
-        printf("Failed to Register !\n");
-#endif
-        return ret;
+        pEvent = &mTrace.pEvents[n];
+        if (pEvent->nEnd == 0)
+        {
+            continue; // never closed: MFNR_Process stopped early
+        }
+        fprintf(fp, ",\n{\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"name\":\"%s\",\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+            pEvent->nTrack, pEvent->pName,
+            (pEvent->nBegin - mTrace.nOrigin) * fUsPerTick, (pEvent->nEnd - pEvent->nBegin) * fUsPerTick);
+        for (int i=0; i < pEvent->nArgs; i++)
+        {
+            fprintf(fp, "%s\"%s\":%d", i ? "," : "", pEvent->pArgKeys[i], pEvent->nArgVals[i]);
+        }
+        fprintf(fp, "}}");
     }
+    fprintf(fp, "\n],\"otherData\":{\"spans\":%u,\"dropped\":%u}}\n", mTrace.nCount, mTrace.nDropped);
+    fclose(fp);
+#else
+    ret = -1; // MFNR_TRACE == 0, or no file system
+#endif
 
-    // Write Register Result
-//     ret = Register_BypassWrite(pHomographyMatrix, mRawFileNum);
-//     if (ret)
-//     {
-// #if MY_DEBUG_PRINTF == 1
-//         printf("Failed to Register_BypassWrite !\n");
-// #endif
-//         return ret;
-//     }
-    
-#elif BYPASS_Register == ENABLE_BYPASS  // Bypass
-    // Read Register Result
-//     ret = Register_BypassRead(mRawFileNum, pHomographyMatrix);
-//     if (ret)
-//     {
-// #if MY_DEBUG_PRINTF == 1
-//         printf("Failed to Register_BypassWrite !\n");
-// #endif
-//         return ret;
-//     }
+    //
+    return ret;
 
-#endif
+} // classMFNR::MFNR_WriteTrace()
 
 
-    //////////////////////////////////////////////////////////////////////////
-    //// Process Module-2: Enhancer Interface
-    // DSP Addr Reset
-    mDspMem_ResetPos = nDspMem_NextModuleResetPos;
-#if BYPASS_Enhancer == DISABLE_BYPASS
-    // Enhancer: TemporalDenoise & BayerWDR & SpatialDenoise
-#if USE_MODIFY_ENHANCER == 0
-    ret = Enhancer(pRawDst);
-#else
-    ret = Enhancer_Modify(pRawDst);
-#endif
-    if (ret)
-    {
+
+CODE_MFNR_EX
+int RK_MFNR_Processor(RK_InputParams* pInParams, RK_ControlParams* pCtrlParams, RK_RawType* pRawDst)
+{
+	//
+	int     ret = 0; // return value
 #if MY_DEBUG_PRINTF == 1
-        printf("Failed to Enhancer !\n");
+	printf("RK_MFNR_Processor()\n");
 #endif
-        return ret;
-    }
 
-#elif BYPASS_Register == ENABLE_BYPASS  // Bypass
-    // TODO ...
+	ret = RK_MFNR_EngineProcess(&g_mfnrProcessor, g_DspBuf, DSP_MEM_SIZE, pInParams, pCtrlParams, pRawDst);
 
-#endif
+	//
+	return ret;
+}
 
 
-    //
-    return ret;
+/************************************************************************/
+// Func: RK_MFNR_EngineProcess()
+// Desc: One burst on a caller-owned engine. Engines share no writable
+//       state, so each thread can run its own engine & DSP Memory
+//   In: pEngine        - [in] engine, results & stats stay readable in it
+//       pDspMem        - [in] DSP Memory Array, DSPMEM_ALIGN aligned
+//       nDspMemSize    - [in] size of pDspMem (Bytes)
+//       pInParams      - [in] InputParams pointer
+//       pCtrlParams    - [in] ControlParams pointer
+//  Out: pRawDst        - [out] result Raw
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int RK_MFNR_EngineProcess(classMFNR* pEngine, RK_U8* pDspMem, RK_U32 nDspMemSize,
+    RK_InputParams* pInParams, RK_ControlParams* pCtrlParams, RK_RawType* pRawDst)
+{
+	//
+	int     ret = 0; // return value
+#if MY_DEBUG_PRINTF == 1
+	printf("RK_MFNR_EngineProcess()\n");
+#endif
+	ret = RK_MFNR_SessionOpen(pEngine, pDspMem, nDspMemSize, pInParams, pCtrlParams);
+	if (ret == 0)
+	{
+		ret = pEngine->MFNR_Process((RK_RawType*)pRawDst);
+	}
+	RK_MFNR_SessionClose(pEngine);
 
-} // classMFNR::MFNR_Process()
+	//
+	return ret;
 
+} // RK_MFNR_EngineProcess()
 
 
 /************************************************************************/
-// Func: classMFNR::MFNR_UnInit()
-// Desc: MFNR UnInit
-//   In: 
+// Func: RK_MFNR_SessionOpen()
+// Desc: Bind the DSP Memory, run MFNR_Init & lay out every stage once;
+//       the bursts of the session only set their inputs
+//   In: pEngine        - [in] engine of the session, NULL: MFNR_ERR_SESSION
+//       pDspMem        - [in] DSP Memory Array, DSPMEM_ALIGN aligned, owned
+//                        by the session until RK_MFNR_SessionClose
+//       nDspMemSize    - [in] size of pDspMem (Bytes)
+//       pInParams      - [in] InputParams of the first burst: the geometry
+//       pCtrlParams    - [in] ControlParams pointer
 //  Out: 
 // 
-// Date: Revised by yousf 20160804
+// Date: Created 20261017
 // 
 /*************************************************************************/
 CODE_MFNR_EX
-int classMFNR::MFNR_UnInit(void)
+int RK_MFNR_SessionOpen(classMFNR* pEngine, RK_U8* pDspMem, RK_U32 nDspMemSize,
+    RK_InputParams* pInParams, RK_ControlParams* pCtrlParams)
 {
-    //
-    int     ret = 0; // return value
+	//
+	int     ret = 0; // return value
 #if MY_DEBUG_PRINTF == 1
-    printf("classMFNR::MFNR_UnInit()\n");
+	printf("RK_MFNR_SessionOpen()\n");
 #endif
+	if (pEngine == NULL)
+	{
+		ret = MFNR_ERR_SESSION;
+		return ret;
+	}
+	if (pDspMem == NULL || ((size_t)pDspMem & (DSPMEM_ALIGN - 1)) != 0)
+	{
+		ret = MFNR_ERR_DSP_MEM_ALIGN;
+		return ret;
+	}
 
+	// DSP Memory Init
+	memset(pDspMem, 0xff, nDspMemSize);
+	pEngine->dspMemoryArray = pDspMem;
+	pEngine->mDspMemSize    = nDspMemSize;
 
-    //
-    return ret;
+	ret = pEngine->MFNR_Init(pInParams, pCtrlParams);
+	if (ret)
+	{
+		pEngine->dspMemoryArray = NULL;
+	}
 
-} // classMFNR::MFNR_UnInit()
+	//
+	return ret;
 
+} // RK_MFNR_SessionOpen()
 
 
+/************************************************************************/
+// Func: RK_MFNR_SessionProcess()
+// Desc: One burst of an open session
+//   In: pEngine        - [in] engine of the session, NULL: MFNR_ERR_SESSION
+//       pInParams      - [in] InputParams, same geometry as RK_MFNR_SessionOpen
+//       pCtrlParams    - [in] ControlParams pointer
+//  Out: pRawDst        - [out] result Raw
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
 CODE_MFNR_EX
-int RK_MFNR_Processor(RK_InputParams* pInParams, RK_ControlParams* pCtrlParams, RK_RawType* pRawDst)
+int RK_MFNR_SessionProcess(classMFNR* pEngine, RK_InputParams* pInParams, RK_ControlParams* pCtrlParams, RK_RawType* pRawDst)
 {
 	//
 	int     ret = 0; // return value
 #if MY_DEBUG_PRINTF == 1
-	printf("RK_MFNR_Processor()\n");
+	printf("RK_MFNR_SessionProcess()\n");
 #endif
+	if (pEngine == NULL || pEngine->dspMemoryArray == NULL)
+	{
+		ret = MFNR_ERR_SESSION;
+		return ret;
+	}
 
-	// DSP Memory Init
-	memset(g_DspBuf, 0xff, DSP_MEM_SIZE);
-	g_mfnrProcessor.dspMemoryArray = g_DspBuf;
+	ret = pEngine->MFNR_SetBurst(pInParams, pCtrlParams);
+	if (ret == 0)
+	{
+		ret = pEngine->MFNR_Process((RK_RawType*)pRawDst);
+	}
 
-	g_mfnrProcessor.MFNR_Init(pInParams, pCtrlParams);
-	g_mfnrProcessor.MFNR_Process((RK_RawType*)pRawDst);
-	g_mfnrProcessor.MFNR_UnInit();
+	//
+	return ret;
+
+} // RK_MFNR_SessionProcess()
+
+
+/************************************************************************/
+// Func: RK_MFNR_SessionClose()
+// Desc: End the session, the DSP Memory goes back to the caller
+//   In: pEngine        - [in] engine of the session, NULL: MFNR_ERR_SESSION
+//  Out: 
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int RK_MFNR_SessionClose(classMFNR* pEngine)
+{
+	//
+	int     ret = 0; // return value
+#if MY_DEBUG_PRINTF == 1
+	printf("RK_MFNR_SessionClose()\n");
+#endif
+	if (pEngine == NULL)
+	{
+		ret = MFNR_ERR_SESSION;
+		return ret;
+	}
+	ret = pEngine->MFNR_UnInit();
+	pEngine->dspMemoryArray = NULL;
 
 	//
 	return ret;
+
+} // RK_MFNR_SessionClose()
+
+
+CODE_MFNR_EX
+int RK_MFNR_GetProfile(RK_ProfileStats* pStats)
+{
+	return RK_MFNR_EngineGetProfile(&g_mfnrProcessor, pStats);
 }
-//////////////////////////////////////////////////////////////////////////
 
 
+CODE_MFNR_EX
+int RK_MFNR_GetDspMemStats(RK_DspMemStats* pStats)
+{
+	return RK_MFNR_EngineGetDspMemStats(&g_mfnrProcessor, pStats);
+}
+
+
+CODE_MFNR_EX
+int RK_MFNR_DumpDspMem(void)
+{
+	return RK_MFNR_EngineDumpDspMem(&g_mfnrProcessor);
+}
+
+
+CODE_MFNR_EX
+int RK_MFNR_GetDmaStats(RK_DmaStats* pStats)
+{
+	return RK_MFNR_EngineGetDmaStats(&g_mfnrProcessor, pStats);
+}
+
+
+CODE_MFNR_EX
+int RK_MFNR_DumpDmaStats(void)
+{
+	return RK_MFNR_EngineDumpDmaStats(&g_mfnrProcessor);
+}
+
+
+CODE_MFNR_EX
+int RK_MFNR_WriteTrace(const char* pFileName)
+{
+	return RK_MFNR_EngineWriteTrace(&g_mfnrProcessor, pFileName);
+}
+
+
+/************************************************************************/
+// Func: RK_MFNR_Engine*()
+// Desc: Stats of the last burst on a caller-owned engine, or on the engine
+//       of a session (RK_MFNR_EngineProcess, RK_MFNR_SessionProcess)
+//   In: pEngine        - [in] engine, NULL: -1
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+int RK_MFNR_EngineGetProfile(classMFNR* pEngine, RK_ProfileStats* pStats)
+{
+	return pEngine != NULL ? pEngine->MFNR_GetProfile(pStats) : -1;
+}
+
+
+CODE_MFNR_EX
+int RK_MFNR_EngineGetDspMemStats(classMFNR* pEngine, RK_DspMemStats* pStats)
+{
+	return pEngine != NULL ? pEngine->MFNR_GetDspMemStats(pStats) : -1;
+}
+
+
+CODE_MFNR_EX
+int RK_MFNR_EngineDumpDspMem(classMFNR* pEngine)
+{
+	return pEngine != NULL ? pEngine->MFNR_DumpDspMem() : -1;
+}
+
+
+CODE_MFNR_EX
+int RK_MFNR_EngineGetDmaStats(classMFNR* pEngine, RK_DmaStats* pStats)
+{
+	return pEngine != NULL ? pEngine->MFNR_GetDmaStats(pStats) : -1;
+}
+
+
+CODE_MFNR_EX
+int RK_MFNR_EngineDumpDmaStats(classMFNR* pEngine)
+{
+	return pEngine != NULL ? pEngine->MFNR_DumpDmaStats() : -1;
+}
 
 
+CODE_MFNR_EX
+int RK_MFNR_EngineWriteTrace(classMFNR* pEngine, const char* pFileName)
+{
+	return pEngine != NULL ? pEngine->MFNR_WriteTrace(pFileName) : -1;
+}
+//////////////////////////////////////////////////////////////////////////
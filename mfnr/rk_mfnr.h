@@ -21,6 +21,10 @@
 #include "rk_register.h"                // Register
 #include "rk_denoiser.h"                // Denoiser
 #include "rk_bayerwdr.h"                // BayerWDR
+#include "rk_profile.h"                 // Stage Profile
+#include "rk_dspmem.h"                  // DSP Memory Map
+#include "rk_dmastat.h"                 // DMA Traffic
+#include "rk_trace.h"                    // Trace Spans
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -29,8 +33,17 @@
 #define     BASE_PIC_NUM            0               // BasePicNum = 0,...,5
 #define     MARK_EXIST_AGENT        1               // mark of ExistAgent in 4x4 Region
 
+#ifndef DSP_MEM_SIZE
 #define     DSP_MEM_SIZE            131072//262144          // DSP memory size: 256KB = 256*1024      =    262144 Byte
+#endif
+#define     MFNR_ERR_DSP_MEM_OVERFLOW (-2)          // MFNR_Process: DSP Memory Array too small, or a Tile window past its chunk (nOverrunBlock), see RK_MFNR_GetDspMemStats()
+#define     MFNR_ERR_DSP_MEM_ALIGN  (-3)            // RK_MFNR_EngineProcess: DSP Memory Array NULL or not DSPMEM_ALIGN aligned
+#define     MFNR_ERR_SESSION        (-4)            // RK_MFNR_Session*: pEngine NULL, session not open, or geometry differs from RK_MFNR_SessionOpen
+#define     MFNR_ERR_TILE           (-5)            // MFNR_Init: nTileHgt/nTileWid not 0/32/64/128/256, or not supported by this build
+#define     MFNR_ERR_THUMB_ALLOC    (-6)            // MFNR_SetBurst: no DDR for the ThumbSrcs built from RawSrcs
+#define     MFNR_ERR_PYR_ALLOC      (-7)            // MFNR_SetBurst: no DDR for the Pyramid tops (usePyramidMatch)
 #define     DDR_MEM_SIZE            268435456       // DDR memory size: 256MB = 256*1024*1024 = 268435456 Byte
+#define     RDMA_TRACE_PENDING      32              // DMA-track spans open at once: the transfers of a prefetched Tile
 
 #define     USE_MODIFY_ENHANCER     1               // Enhancer Select
 
@@ -65,7 +78,7 @@ typedef struct tag_RK_InputParams
     RK_U16          nRawFileNum;                // Raw file num
     RK_RawInfo*     pRawInfo;                   // Raw info struct
     RK_RawType*     pRawSrcs[RK_MAX_FILE_NUM];  // RawSrcs pointers
-    RK_ThumbType*   pThumbSrcs[RK_MAX_FILE_NUM];// ThumbSrcs pointers
+    RK_ThumbType*   pThumbSrcs[RK_MAX_FILE_NUM];// ThumbSrcs pointers, NULL: built from pRawSrcs[k] by the engine
 }RK_InputParams;
 
 
@@ -86,9 +99,39 @@ typedef struct tag_RK_ControlParams
     RK_Char     strCtrlParam[1024];     // str ControlParams
 
     RK_Char		useHwDMA;
+    RK_U16      nTileHgt;               // Enhancer tile Hgt: 0-picked from L2 & frame count, 32/64/128/256
+    RK_U16      nTileWid;               // Enhancer tile Wid: 0-picked from L2 & frame count, 32/64/128/256
+                                        //   powers of 2 only, not any multiple of 16: a tile is whole 32x32 Blocks and never
+                                        //   straddles a 256x256 WDR weight cell; vector WDR builds run 32x64 only; else MFNR_ERR_TILE
+    RK_Char     useRowBand;             // Enhancer RawSrcs: 0-DMA per tile, 1-row-band ring per frame, each row unpacked once (DSP Memory ~1.2MB a frame at 4000 wide)
+    RK_Char     useThumbStrip;          // Register Coarse Matching: 0-batches of Feature windows, 1-one strip per FeatureDetect strip & frame (DSP Memory ~100KB a frame at 4000 wide)
+    RK_Char     useFastMatch;           // Register Coarse & Fine Matching: 0-exhaustive SAD, 1-early-terminating SAD from the predicted position (same Match)
+    RK_Char     usePyramidMatch;        // Register Coarse Matching: 0-Thumb window +-8, 1-1/32 top window +-6 then Thumb +-3 (motion up to ~200 Raw, DDR 1/16 Thumb a frame)
 }RK_ControlParams;
 
 
+////---- struct CoarseBatch: neighbouring Features of Register Step 3 sharing one Ref strip per frame
+typedef struct tag_RK_CoarseBatch
+{
+    int             nFirst;                                 // first Feature of the batch
+    int             nNum;                                   // num of Features, 0-none
+    int             nDmaPos;                                // rdma ticket of the last transfer of the batch
+    RK_U16*         pBaseBlks;                              // Base blocks 16x16, one per Feature; useThumbStrip: the block of the Feature in matching
+    RK_U16*         pBaseStrip;                             // useThumbStrip: union of the Base blocks, NULL-blocks fetched one by one
+    RK_U16*         pRefStrips;                             // Ref strips, one per Ref frame, mCoarseRefPitch apart
+    RK_U16          nBaseStripRow;                          // Base strip
+    RK_U16          nBaseStripCol;
+    RK_U16          nBaseStripHgt;
+    RK_U16          nBaseStripWid;
+    RK_U16          nStripRow;                              // Ref strip: union of the Ref windows
+    RK_U16          nStripCol;
+    RK_U16          nStripHgt;
+    RK_U16          nStripWid;
+    RK_U16          nRefHgt;                                // Ref window size, the same for every Feature
+    RK_U16          nRefWid;
+}RK_CoarseBatch;
+
+
 //////////////////////////////////////////////////////////////////////////
 ////-------- Class Definition
 // class MFNR
@@ -96,8 +139,8 @@ class classMFNR
 {
 public:
     //// constructor & destructor
-    //classMFNR(void){};              // constructor
-    //~classMFNR(void){};             // destructor
+    classMFNR(void);                // constructor
+    ~classMFNR(void);               // destructor
 
 public:
     //////////////////////////////////////////////////////////////////////////
@@ -120,6 +163,19 @@ public:
     int             mThumbStride;                       // ThumbSrcs data Stride (Bytes, 16bit 4ByteAlign)
     int             mThumbDataSize;                     // ThumbSrcs data Size (Bytes, 16bit)
     RK_U16*         pThumbSrcs[RK_MAX_FILE_NUM];        // ThumbSrcs data pointers
+    RK_U16*         pThumbBufs[RK_MAX_FILE_NUM];        // ThumbSrcs built by ThumbBuild(): mThumbDataSize each, NULL-not allocated
+    RK_U32          mThumbBuildMask;                    // frames of this burst whose ThumbSrcs ThumbBuild() makes
+    RK_U8*          pRaw10BandChunks[2];                // ThumbBuild: 8 Raw rows x THUMB_BUILD_COLS*8 pixels, packed RAW10
+    RK_U16*         pThumbRowChunk;                     // ThumbBuild: one Thumb row
+
+    //// Pyramid top (usePyramidMatch): Thumb / SCALER_FACTOR_T2P
+    int             mPyrWid;                            // Pyramid top width  (floor)
+    int             mPyrHgt;                            // Pyramid top height (floor)
+    int             mPyrStride;                         // Pyramid top Stride (Bytes, 16bit 4ByteAlign)
+    int             mPyrDataSize;                       // Pyramid top Size (Bytes, 16bit)
+    RK_U16*         pPyrBufs[RK_MAX_FILE_NUM];          // Pyramid tops built by PyramidBuild(): mPyrDataSize each, NULL-not allocated
+    RK_U16*         pPyrThumbChunks[2];                 // PyramidBuild: NUM_LINE_DDR2DSP_THUMB Thumb rows
+    RK_U16*         pPyrRowChunk;                       // PyramidBuild: PYR_BUILD_ROWS top rows
 
     
     // RawInfo
@@ -136,8 +192,8 @@ public:
 
     // Method-2: use Array
     RK_U8*          dspMemoryArray;       				// Method-2: use MemoryArray
-    RK_U32          mDspMem_UsedCount;                  // DSP Memory Array Used Count
-    RK_U32          mDspMem_ResetPos;                   // DSP Memory Reset Position
+    RK_U32          mDspMemSize;                        // size of dspMemoryArray (Bytes)
+    RK_DspArena     mDspArena;                          // DSP Memory Stack & Map of the last MFNR_Process
 
     rdma_info_t     rdmaInfo;                           // DMA Info Struct
 
@@ -151,7 +207,6 @@ public:
     RK_U16*         pFeaturePoints[2];                  // Feature Points: [1xNx2] * 2Byte
     RK_U16*         pFeatureValues;                     // Feature Values: [1xN] * 2Byte
     RK_U16*         pThumbDspChunks[2];                 // Thumb DSP Chunk
-    RK_U16*         pThumbFilterDspChunk;               // Thumb Filter DSP Chunk
     int             mNumValidFeature;                   // num of Valid Feature
 
     //// Block Coarse Matching
@@ -159,6 +214,10 @@ public:
     RK_U16*         pMatchPointsX[RK_MAX_FILE_NUM];     // Matching Points X
     RK_U16*         pThumbBaseBlkDspChunks[2];          // ThumbBaseBlk DSP Chunk
     RK_U16*         pThumbRefBlkDspChunks[2];           // ThumbRefBlk DSP Chunk
+    RK_Char         mUseThumbStrip;                     // Coarse batches of a FeatureDetect strip, ControlParams useThumbStrip of MFNR_Init
+    int             mCoarseRefPitch;                    // pThumbRefBlkDspChunks: elements per Ref frame, laid out by DspMemPlan()
+    RK_Char         mUseFastMatch;                      // Feature*MatchingFast, ControlParams useFastMatch of MFNR_Init
+    RK_Char         mUsePyramid;                        // CoarsePyramid(), ControlParams usePyramidMatch of MFNR_Init & a top of 16x16 at least
 
     //// Block Fine Matching
     RK_U8*          pFeatureIdxsInAgent;                // FeatureIdxs In Agent
@@ -197,71 +256,184 @@ public:
     RK_U16*         pRawDstSumDspChunk;                 // RawDstSum DSP Chunk: 32x32n * 2B
     RK_U8*          pRawDstWgtDspChunk;                 // RawDstWgt DSP Chunk: 32x32n * 1B
 //#else
-    RK_F32*         pRawBlkPoints[RK_MAX_FILE_NUM];     // RawSrcBlocks Top-Left-Corners Pointer
+    RK_F32*         pRawBlkPoints[2][RK_MAX_FILE_NUM];  // RawSrcBlocks Top-Left-Corners Pointer, odd-even Tile as pRawBlkChunks
     RK_U16*         pRawBlkChunks[2][RK_MAX_FILE_NUM];  // RawSrcBlocks DSP Chunks
-    RK_U16*         pRawDstChunk;                       // RawDstBlocks DSP Chunk
+    int             mTileChunkBlock[2][RK_MAX_FILE_NUM];// DSP Memory map index of pRawBlkChunks[n][k], for RK_DspArenaOverrun()
+    int             mTileDmaPos[2];                     // rdma ticket of the last transfer into Tile n (chunks or rings), 0-none
+    int             mTileHgt;                           // Tile Hgt of Enhancer_Modify, picked by TilePick()
+    int             mTileWid;                           // Tile Wid of Enhancer_Modify, picked by TilePick()
+    int             mTileChunkSize;                     // pRawBlkChunks[n][k] size (elements)
+    RK_Char         mUseRowBand;                        // RawSrcs from pRawBandRings, ControlParams useRowBand of MFNR_Init
+    RK_U16*         pRawBandRings[RK_MAX_FILE_NUM];     // Row-band rings: (RingRows+WinRows+1) x RingWid * 2B, WinRows mirrored after the ring
+    int             mBandRingRows;                      // rows of a ring, laid out by DspMemPlan()
+    int             mBandWinRows;                       // max rows of a Tile window served by a ring
+    int             mBandRingWid;                       // RAW_BAND_PAD_COL + Raw 4PixelAlign + RAW_BAND_PAD_COL + TileWid
+    int             mBandRowBeg[RK_MAX_FILE_NUM];       // first Raw row fed to the ring of frame k in this burst
+    int             mBandRowEnd[RK_MAX_FILE_NUM];       // next Raw row to feed
+    int             mBandMirrorRow[RK_MAX_FILE_NUM];    // first Raw row fed & not mirrored yet: the DMA may still be running
+    int             mBandKeepRow[RK_MAX_FILE_NUM];      // first ring row read by the Tile in compute, no feed may drop it
 //#endif
 
     //// Bayer WDR
     RK_U16*         pWdrRawBlockBuf[2];                 // BlkBuf: (2+32)x(1+32n+1)*2B, n=2 -> 32*2=64
     RK_U16*         pWdrRawRowBuf;                      // RowBuf: 2xRawWid*2B
-    RK_U16*         pWdrRawColBuf;                      // ColBuf: 32x1*2B
+    RK_U16*         pWdrRawColBuf;                      // ColBuf: 32x1*2B, Enhancer() only
     RK_U16*         pWdrRawBlockRect[2];                // Rects: 1x4*2B
-    RK_U16*         pWdrThumbWgtTable;	                // Thumb Weight Table: 9x256*2B
-    RK_U32*         pWdrWeightMat;	                    // Weight Mat: 9x256*4B
-#if 1
-    RK_U16*         pWdrThumbWgtTable1;	                // Thumb Weight Table: 9x256*2B
-    RK_U32*         pWdrWeightMat1;	                    // Weight Mat: 9x256*4B
-#endif
+    RK_U16*         pWdrThumbWgtTable;	                // Thumb Weight Table: WDR_THUMB_TABLE_SIZE*2B
+    RK_U32*         pWdrWeightMat;	                    // Weight Mat: WDR_THUMB_TABLE_SIZE*4B
     RK_U16*         pWdrScaleTable;                     // ScaleTabale[expouse_times] 961*2B
+    int             mWdrScaleGain;                      // expouse_times of pWdrScaleTable, -1: not built
     RK_U16*         pWdrLeftRight;                      // 2*32x16*2B byte space, 2K store 32 line left and right, align 16, actually 9 valid..
     RK_U16*         pWdrGainMat;                        // Result: 32x32n*2B
     RK_U16*         pWdrRawResult;                      // Result: 32x32n*2B
+    int             mWdrBufWid;                         // BlkBuf width, laid out by DspMemPlan()
+    int             mWdrRowsBufWid;                     // RowBuf width, laid out by DspMemPlan()
 
     //// SpatialDenoise
 
+#if MFNR_STAGE_PROFILE == 1
+    //// Stage Profile
+    RK_ProfileStats mProfile;                           // Timers & Counters of the last MFNR_Process
+#endif
+
+#if MFNR_TRACE == 1
+    //// Trace Spans
+    RK_TraceBuf     mTrace;                             // Spans of the last MFNR_Process
+    int             mTraceSlot;                         // double-buffer slot tagged on the next DMA spans
+    int             mTraceXfers[RDMA_TRACE_PENDING];    // DMA-track spans issued & not synced yet
+    int             mTraceXferPos[RDMA_TRACE_PENDING];  // rdma ticket of each open span
+    int             mTraceXferNum;                      // open spans
+#endif
+
+#if MFNR_DMA_STATS == 1
+    //// DMA Traffic
+    RK_DmaStats     mDmaStats;                          // DDR Traffic of the last MFNR_Process
+#if DMA_FETCH_MAP == 1
+    RK_U8*          pRawFetchMap[RK_MAX_FILE_NUM];      // fetch count per DDR byte of RawSrcs[k]
+    RK_U8*          pThumbFetchMap[RK_MAX_FILE_NUM];    // fetch count per DDR byte of ThumbSrcs[k]
+#endif
+#endif
 
 
 public:
     
+    ////---- DSP Memory Array: layout of every stage, built by MFNR_Init
+    int DspMemPlan(void);
+    ////---- Enhancer tile: from ControlParams, or picked from L2 & frame count
+    int TilePick(int nTileHgt, int nTileWid);
+
+    ////---- DSP Memory Array: nNum elements of T, NULL on overflow
+    template <typename T>
+    T* DspAlloc(RK_U32 nNum, const char* pLabel, int nIndex0 = -1, int nIndex1 = -1)
+    {
+        return (T*)RK_DspArenaAlloc(&mDspArena, sizeof(T) * nNum, pLabel, nIndex0, nIndex1);
+    }
+
+#if MFNR_DMA_STATS == 1
+    ////---- DMA Traffic
+    void DmaStatsReset(void);
+    void DmaAccount(RK_Addr ddrAddr, int nRowBytes, int nRows, int nStride, int isWrite);
+    void DmaStatsFinish(void);
+#if DMA_FETCH_MAP == 1
+    void DmaStatsFree(void);
+#endif
+#endif
+
     ////---- RK DMA
     // transfer_mode = 0 // RDMA_DIRECTION
-    int RKDMA_ReadThumb16bit2DSP(U32 srcAddr, U32 dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col);
+    int RKDMA_ReadThumb16bit2DSP(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col);
+    int RKDMA_IssueThumb16bit2DSP(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col);
 
     // transfer_mode = 1 // RDMA_10BIT_2_16BIT
-    int RKDMA_ReadRaw10bit2DSP(U32 srcAddr, U32 dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col);
+    int RKDMA_ReadRaw10bit2DSP(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col);
+    int RKDMA_IssueRaw10bit2DSP(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col);
+    void RKDMA_Sync(int pos);
+#if MFNR_TRACE == 1
+private:
+    void RKDMA_TracePending(int nEvent, int pos);                               // DMA-track span open until RKDMA_Sync()
+public:
+#endif
+
+    // transfer_mode = 0 // RDMA_DIRECTION, packed RAW10 & Thumb rows
+    int RKDMA_IssueRaw10Packed2DSP(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col);
+    int RKDMA_WriteThumb16bit2DDR(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col);
 
     // transfer_mode = 2 // RDMA_16BIT_2_10BIT
-    int RKDMA_WriteRaw16bit2DDR(U32 srcAddr, U32 dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col);
+    int RKDMA_WriteRaw16bit2DDR(RK_Addr srcAddr, RK_Addr dstAddr, U16 wid, U16 hgt, U16 srcStride, U16 dstStride, U16 col);
+
+
+    ////---- Process Module-0: ThumbSrcs of the frames given without pThumbSrcs
+    int ThumbBuild(void);
+    int ThumbChunkIssue(int k, int n, int nChunkIdx);
 
 
     ////---- Process Module-1: Register Interface (FeatureDetect & FeatureFilter & CoarseMatching & FineMatching & ComputeHomography)
     int Register(void);
     int Register_BypassWrite(RK_F32* pHomoMats[], int nRawFileNum);
     int Register_BypassRead(int nRawFileNum, RK_F32* pHomoMats[]);
+    int CoarseBatchIssue(int nFirst, int nChunkIdx, RK_CoarseBatch* pBatch);
+    void CoarseWindow(int n, int& nBaseRow, int& nBaseCol, int& nRefRow, int& nRefCol);
+    int PyramidBuild(void);
+    int CoarsePyramid(void);
+    int PyramidIssue(int nLevel, int n, int nChunkIdx);
+    void PyramidWindow(int nLevel, int n, int k, int& nBaseRow, int& nBaseCol, int& nRefRow, int& nRefCol, int& nRefHgt, int& nRefWid);
 
 
     ////---- Process Module-2: Enhancer Interface (TemporalDenoise & BayerWDR & SpatialDenoise)
     int Enhancer(RK_RawType* pRawDst);
     int Enhancer_Modify(RK_RawType* pRawDst);
+    int EnhancerTileIssue(int nRow, int nCol, int nChunkIdx, RK_RectExt* rects, RK_U16** pTileChunks, int* pNumBlocks);
+    int EnhancerTileWait(int nChunkIdx);
+    int EnhancerFetch(int k, int nChunkIdx, RK_RectExt* pRect, RK_U16** ppChunk);
+    int BandRingFeed(int k, int nRowEnd);
+    void BandRingMirror(int k);
 
 
     ////---- MFNR Interface Functions
     int MFNR_Init(RK_InputParams* pInParams, RK_ControlParams* pCtrlParams);    // MFNR Init
+    int MFNR_SetBurst(RK_InputParams* pInParams, RK_ControlParams* pCtrlParams);// MFNR next Burst of the same geometry
     int MFNR_Process(RK_RawType* pRawDst);                                      // MFNR Execute
     int MFNR_UnInit();			                                                // MFNR UnInit			                                    
+    int MFNR_GetProfile(RK_ProfileStats* pStats);                               // MFNR Stage Profile
+    int MFNR_GetDspMemStats(RK_DspMemStats* pStats);                            // MFNR DSP Memory Map
+    int MFNR_DumpDspMem(void);                                                  // MFNR DSP Memory Map printf
+    int MFNR_GetDmaStats(RK_DmaStats* pStats);                                  // MFNR DMA Traffic
+    int MFNR_DumpDmaStats(void);                                                // MFNR DMA Traffic printf
+    int MFNR_WriteTrace(const char* pFileName);                                 // MFNR Trace Spans to JSON
 
 };
 
 
 //// DSP Memory: 128KB
-DATA_MFNR_INT_DSP  extern	RK_U8 g_DspBuf[DSP_MEM_SIZE];
+DATA_MFNR_INT_DSP  extern	RK_U8 ALIGN(g_DspBuf[DSP_MEM_SIZE], DSPMEM_ALIGN);
 
 // classMFNR
 DATA_MFNR_EX 	extern	classMFNR		g_mfnrProcessor;
 
-// MFNR Interface
+// MFNR Interface: g_mfnrProcessor & g_DspBuf
 int RK_MFNR_Processor(RK_InputParams* pInParams, RK_ControlParams* pCtrlParams, RK_RawType* pRawDst);
+// MFNR Engine Interface: caller-owned classMFNR & DSP Memory, engines on different threads run concurrently
+int RK_MFNR_EngineProcess(classMFNR* pEngine, RK_U8* pDspMem, RK_U32 nDspMemSize,
+    RK_InputParams* pInParams, RK_ControlParams* pCtrlParams, RK_RawType* pRawDst);
+// MFNR Session Interface: Init & DSP Memory layout once, then many bursts of the same geometry
+int RK_MFNR_SessionOpen(classMFNR* pEngine, RK_U8* pDspMem, RK_U32 nDspMemSize,
+    RK_InputParams* pInParams, RK_ControlParams* pCtrlParams);
+int RK_MFNR_SessionProcess(classMFNR* pEngine, RK_InputParams* pInParams, RK_ControlParams* pCtrlParams, RK_RawType* pRawDst);
+int RK_MFNR_SessionClose(classMFNR* pEngine);
+// MFNR Stats of the last burst on g_mfnrProcessor
+int RK_MFNR_GetProfile(RK_ProfileStats* pStats);
+int RK_MFNR_GetDspMemStats(RK_DspMemStats* pStats);
+int RK_MFNR_DumpDspMem(void);
+int RK_MFNR_GetDmaStats(RK_DmaStats* pStats);
+int RK_MFNR_DumpDmaStats(void);
+int RK_MFNR_WriteTrace(const char* pFileName);
+// MFNR Stats of the last burst on an engine or session, -1 if pEngine is NULL
+int RK_MFNR_EngineGetProfile(classMFNR* pEngine, RK_ProfileStats* pStats);
+int RK_MFNR_EngineGetDspMemStats(classMFNR* pEngine, RK_DspMemStats* pStats);
+int RK_MFNR_EngineDumpDspMem(classMFNR* pEngine);
+int RK_MFNR_EngineGetDmaStats(classMFNR* pEngine, RK_DmaStats* pStats);
+int RK_MFNR_EngineDumpDmaStats(classMFNR* pEngine);
+int RK_MFNR_EngineWriteTrace(classMFNR* pEngine, const char* pFileName);
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,121 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: rk_profile.h
+// Desc: Per-stage timers & call counters of MFNR_Process
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// Switch: MFNR_STAGE_PROFILE (rk_global.h, or -DMFNR_STAGE_PROFILE=1)
+//   0 - PROFILE_BEGIN/PROFILE_END expand to nothing, no state is kept
+//   1 - every BEGIN/END pair adds its ticks and one call to the stage
+//
+// Ticks: host builds use steady_clock nanoseconds, XM4 builds use clock().
+// nTicksPerSec converts them to seconds. RK_ProfileTick() is also the
+// clock of the trace spans (rk_trace.h, MFNR_TRACE).
+//
+#pragma once
+#ifndef _RK_PROFILE_H
+#define _RK_PROFILE_H
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Header files
+//
+#include "rk_typedef.h"                 // Type definition
+#include "rk_global.h"                  // Global definition
+
+#if MFNR_STAGE_PROFILE == 1 || MFNR_TRACE == 1
+#ifdef RK_HOST_PLATFORM
+#include <chrono>
+#else
+#include <time.h>
+#endif
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Type Defines
+//
+////---- enum ProfileStage
+enum RK_ProfileStage
+{
+    // ThumbBuild
+    PROF_THUMB_BUILD = 0,               // ThumbRaw10Box (RawSrcs -> ThumbSrcs)
+    // Register
+    PROF_REG_FEATURE_DETECT,            // ThumbStripScan (FeatureDetect & WDR statistics)
+    PROF_REG_FEATURE_FILTER,            // FeatureFilter
+    PROF_REG_PYRAMID,                   // ThumbPyramidBox (ThumbSrcs -> Pyramid tops)
+    PROF_REG_COARSE_MATCH,              // FeatureCoarseMatching (Thumb), FeaturePyramidMatching
+    PROF_REG_FINE_MATCH,                // FeatureFineMatching (Luma)
+    PROF_REG_HOMOGRAPHY,                // MvHistFilter ... ComputeHomographyError
+    // Enhancer_Modify
+    PROF_ENH_DMA_IN,                    // RawBase & RawRef DDR10bit->DSP16bit
+    PROF_ENH_TEMPORAL_DENOISE,          // TemporalDenoise_Modify
+    PROF_ENH_HALO_COPY,                 // CopyBlockData halo assembly of WDR buffers
+    PROF_ENH_BAYER_WDR,                 // wdr_process_block
+    PROF_ENH_DMA_OUT,                   // RawDst DSP16bit->DDR10bit
+
+    PROF_STAGE_NUM
+};
+
+////---- struct ProfileStats
+typedef struct tag_RK_ProfileStats
+{
+    RK_U64          nTicks[PROF_STAGE_NUM];     // accumulated ticks
+    RK_U32          nCalls[PROF_STAGE_NUM];     // BEGIN/END pairs
+    RK_U64          nTicksPerSec;               // tick rate
+    RK_U64          nStart[PROF_STAGE_NUM];     // tick of the open BEGIN (internal)
+}RK_ProfileStats;
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Functions Definition
+//
+#if MFNR_STAGE_PROFILE == 1 || MFNR_TRACE == 1
+
+#ifdef RK_HOST_PLATFORM
+#define     PROFILE_TICKS_PER_SEC           1000000000ULL
+static inline RK_U64 RK_ProfileTick(void)
+{
+    return (RK_U64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#else
+#define     PROFILE_TICKS_PER_SEC           ((RK_U64)CLOCKS_PER_SEC)
+static inline RK_U64 RK_ProfileTick(void)
+{
+    return (RK_U64)clock();
+}
+#endif
+
+#endif
+
+#if MFNR_STAGE_PROFILE == 1
+
+#define     PROFILE_RESET(stats)                                        \
+    do {                                                                \
+        memset(&(stats), 0, sizeof(stats));                             \
+        (stats).nTicksPerSec = PROFILE_TICKS_PER_SEC;                   \
+    } while (0)
+#define     PROFILE_BEGIN(stats, stage)                                 \
+    ((stats).nStart[stage] = RK_ProfileTick())
+#define     PROFILE_END(stats, stage)                                   \
+    do {                                                                \
+        (stats).nTicks[stage] += RK_ProfileTick() - (stats).nStart[stage]; \
+        (stats).nCalls[stage]++;                                        \
+    } while (0)
+
+#else
+
+#define     PROFILE_RESET(stats)
+#define     PROFILE_BEGIN(stats, stage)
+#define     PROFILE_END(stats, stage)
+
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+
+#endif // _RK_PROFILE_H
@@ -11,9 +11,77 @@
 #include "rk_register.h"     // Register
 #include "rk_bayerwdr.h"     // BayerWDR
 
+MFNR_ISA_BEGIN
+
 //////////////////////////////////////////////////////////////////////////
 ////-------- Functions Definition
 //
+/************************************************************************/
+// Func: ThumbRaw10Box()
+// Desc: One Thumb row from SCALER_FACTOR_R2T Raw rows still packed as
+//       RAW10: each Thumb pixel is the sum of its 8x8 Raw block (max
+//       64*1023 < 65536), the 10bit unpack is folded into the sum
+//   In: pRaw10             - [in] 8 Raw rows, packed RAW10, Raw col 0 at bit 0;
+//                            readable 8 Bytes past the last row
+//       nStride            - [in] Raw row stride (Bytes)
+//       nThumbWid          - [in] Thumb pixels, 8*nThumbWid Raw pixels a row
+//  Out: pThumb             - [out] Thumb pixels
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+CODE_MFNR_EX
+int ThumbRaw10Box(const RK_U8* pRaw10, int nStride, int nThumbWid, RK_U16* pThumb)
+{
+    //
+    int     ret = 0; // return value
+#ifndef CEVA_CHIP_CODE_REGISTER
+    const RK_U8*    p;
+    RK_U32          sum;
+    int             bit;
+
+    for (int j=0; j < nThumbWid; j++)
+    {
+        sum = 0;
+        for (int y=0; y < SCALER_FACTOR_R2T; y++)
+        {
+            p = pRaw10 + y * nStride;
+            for (int x=j * SCALER_FACTOR_R2T; x < (j + 1) * SCALER_FACTOR_R2T; x++)
+            {
+                bit  = x * RAW_BIT_COUNT;
+                sum += ((p[bit >> 3] | (p[(bit >> 3) + 1] << 8)) >> (bit & 7)) & 0x3FF;
+            }
+        }
+        pThumb[j] = (RK_U16)sum;
+    }
+#else
+    // 4 Raw pixels = 5 Bytes: one 64bit load, pixels 0/2 and 1/3 masked into
+    // two lanes 20 bits apart & added, 16 pairs a block (16*2046 < 2^20)
+    const RK_U64    mask = 0x3FF003FFULL;
+    const RK_U8*    p;
+    RK_U64          g0, g1, acc;
+
+    for (int j=0; j < nThumbWid; j++)
+    {
+        acc = 0;
+        p   = pRaw10 + j * SCALER_FACTOR_R2T * RAW_BIT_COUNT / 8;
+        for (int y=0; y < SCALER_FACTOR_R2T; y++)
+        {
+            memcpy(&g0, p, sizeof(g0));
+            memcpy(&g1, p + 5, sizeof(g1));
+            acc += (g0 & mask) + ((g0 >> 10) & mask) + (g1 & mask) + ((g1 >> 10) & mask);
+            p   += nStride;
+        }
+        pThumb[j] = (RK_U16)((acc & 0xFFFFF) + (acc >> 20));
+    }
+#endif
+
+    //
+    return ret;
+
+} // ThumbRaw10Box()
+
+
 /************************************************************************/
 // Func: FeatureDetect()
 // Desc: Feature Detect
@@ -166,6 +234,223 @@ void GetWdrWeightTable(RK_U16* pThumbData, // <<! [in]
 }
 
 
+/************************************************************************/
+// Func: ThumbStripScan()
+// Desc: FeatureDetect & GetWdrWeightTable of a Thumb strip in one pass.
+//       The strip is walked in THUMB_SCAN_COLS wide column chunks: each
+//       chunk row is light filtered (column sums slid along the row) into
+//       a line buffer on the stack and binned at once, and the Feature
+//       Grads of the chunk follow while it is still in cache, so no Thumb
+//       Filter chunk is written or read back. A CalcuHist cell (cols
+//       32k-16..32k+15) and the CalcuHistTranspose cell k (one col & one
+//       row on) share all but their first col: per cell the light bins of
+//       that col and of the rest are summed locally over the rows of one
+//       table row, then added to the one table layout wdr_process_block
+//       reads (WDR_WEIGHT_TRANSPOSE: CalcuHistTranspose, incl. the zero
+//       ring it reads right of & below the filtered strip; else CalcuHist).
+//       Same Features & table as the two kernels
+//   In: pThumbData             - [in] Thumb chunk, strip at (1,1), stride nWid
+//       nWid                   - [in] strip Wid + 2
+//       nHgt                   - [in] strip Hgt + 2
+//       rowSeg                 - [in] Seg(rowSeg,m)
+//       numFeature             - [in] num Feature in input Thumb data
+//       statisticWidth         - [in] WDR statistic width
+//  Out: pFeatPoints            - [out] Feature Points: [1xNx2] * 2Byte
+//       pFeatValues            - [out] Feature Values: [1xN] * 2Byte
+//       pWdrWeightMat          - [in/out] Weight Mat: WDR_THUMB_TABLE_SIZE*4B
+//       pWdrThumbWgtTable      - [in/out] Count Mat: WDR_THUMB_TABLE_SIZE*2B
+//                                (WDR_WEIGHT_TRANSPOSE: cell*16+bin, else bin*256+cell)
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+CODE_MFNR_EX
+int ThumbStripScan(RK_U16* pThumbData, int nWid, int nHgt, int rowSeg, int numFeature, 
+    RK_U16* pFeatPoints[], RK_U16* pFeatValues,
+    RK_U32* pWdrWeightMat, RK_U16* pWdrThumbWgtTable, int statisticWidth)
+{
+    //
+    int     ret = 0; // return value
+    int     wid = nWid - 2; // strip Wid
+    int     hgt = nHgt - 2; // strip Hgt
+    int     nWinSize = DIV_FIXED_WIN_SIZE;
+    RK_U16  light[THUMB_SCAN_COLS + DIV_FIXED_WIN_SIZE / 2];    // light filter of one chunk row & 16 cols to the left
+    RK_U8   lindex[THUMB_SCAN_COLS + DIV_FIXED_WIN_SIZE / 2];   // its histogram bin
+    // light bins of the cells of a chunk: first col & the rest, summed over the rows of one table row
+    RK_U32  edgeCnt[THUMB_SCAN_CELLS + 1][WDR_HIST_BINS], edgeWgt[THUMB_SCAN_CELLS + 1][WDR_HIST_BINS];
+    RK_U32  restCnt[THUMB_SCAN_CELLS][WDR_HIST_BINS], restWgt[THUMB_SCAN_CELLS][WDR_HIST_BINS];
+    RK_U16  *p1, *p2, *p3;      // rows above, at & below, clamped to the strip
+    RK_U16  *pLight;            // light of col 0
+    RK_U8   *pIndex;            // lindex of col 0
+    RK_U16* pStrip = pThumbData + nWid + 1;
+    int     x, y, x0, x1, xs, m, m0, m1, k, k1, b, c0, c1;
+    int     sumL, sumM, sumR;   // column sums left of, at & right of x
+    int     idy, idx;
+#if WDR_WEIGHT_TRANSPOSE
+    int     yStat = 1;          // CalcuHistTranspose: first strip row & col are not binned
+    int     nRowOff = 15;       // table row of strip row y: (rowSeg*32 + y + nRowOff) >> 5
+#else
+    int     yStat = 0;
+    int     nRowOff = 16;
+#endif
+#ifndef CEVA_CHIP_CODE_REGISTER
+    // FeatureDetect: first max in row order
+    int     Grdx, Grdy, Grad;
+    int     maxGrad[THUMB_SCAN_COLS / DIV_FIXED_WIN_SIZE];
+    int     maxGrdRow[THUMB_SCAN_COLS / DIV_FIXED_WIN_SIZE];
+    int     maxGrdCol[THUMB_SCAN_COLS / DIV_FIXED_WIN_SIZE];
+#else
+    // FeatureDetect: Row & Col are kept from the last Seg with a Grad
+    RK_U16  maxGrad = 0, maxGrdRow = 0, maxGrdCol = 0;
+#endif
+
+    for (x0=0; x0 < wid; x0 += THUMB_SCAN_COLS)
+    {
+        x1 = MIN(x0 + THUMB_SCAN_COLS, wid);
+        m0 = x0 / nWinSize;
+        m1 = MIN(x1 / nWinSize, numFeature);    // Segs of this chunk
+        k1 = (x1 == wid) ? ((wid + 15) >> 5) + 1 : (x1 >> 5); // CalcuHist cells m0..k1-1: cols 32k-16..32k+15
+        xs = MAX(x0 - nWinSize / 2, 0);         // light cols of this chunk: xs..x1-1
+        pLight = light + nWinSize / 2 - x0;
+        pIndex = lindex + nWinSize / 2 - x0;
+#ifndef CEVA_CHIP_CODE_REGISTER
+        for (m=m0; m < m1; m++)
+        {
+            maxGrad[m - m0]   = 0;
+            maxGrdRow[m - m0] = 0;
+            maxGrdCol[m - m0] = 0;
+        }
+#endif
+        memset(edgeCnt, 0, sizeof(edgeCnt)); memset(edgeWgt, 0, sizeof(edgeWgt));
+        memset(restCnt, 0, sizeof(restCnt)); memset(restWgt, 0, sizeof(restWgt));
+
+        for (y=0; y < hgt; y++)
+        {
+            p2   = pStrip + y * nWid;
+            p1   = (y == 0)       ? p2 : p2 - nWid;
+            p3   = (y == hgt - 1) ? p2 : p2 + nWid;
+
+            //---- WDR: light filter [1 2 1]' * [1 2 1] >> 6, edge cols replicated
+            if (y >= yStat)
+            {
+                x    = MAX(xs - 1, 0);
+                sumL = p1[x] + 2 * p2[x] + p3[x];
+                sumM = p1[xs] + 2 * p2[xs] + p3[xs];
+                for (x=xs; x < x1; x++)
+                {
+                    sumR      = (x == wid - 1) ? sumM : p1[x + 1] + 2 * p2[x + 1] + p3[x + 1];
+                    pLight[x] = (RK_U16)((sumL + 2 * sumM + sumR) >> 6);
+                    pIndex[x] = (RK_U8)((pLight[x] + 1024) >> 11);
+                    sumL      = sumM;
+                    sumM      = sumR;
+                }
+
+                //---- WDR: light bins of the cells, cell k1 only its first col (CalcuHistTranspose cell k1-1)
+                for (k=m0; k <= k1 && k * 32 - 16 < wid; k++)
+                {
+                    c0 = MAX(k * 32 - 16, 0);
+                    edgeCnt[k - m0][pIndex[c0]] += 1;
+                    edgeWgt[k - m0][pIndex[c0]] += pLight[c0];
+                    if (k == k1)
+                        break;
+                    c1 = MIN(k * 32 + 16, wid);
+                    for (x=c0 + 1; x < c1; x++)
+                    {
+                        restCnt[k - m0][pIndex[x]] += 1;
+                        restWgt[k - m0][pIndex[x]] += pLight[x];
+                    }
+                }
+
+                //---- WDR: CalcuHist / CalcuHistTranspose at the last row of a table row
+                idy = (rowSeg * 32 + y + nRowOff) >> 5;
+                if (y == hgt - 1 || ((rowSeg * 32 + y + 1 + nRowOff) >> 5) != idy)
+                {
+                    for (k=m0; k < k1; k++)
+                    {
+                        for (b=0; b < WDR_HIST_BINS; b++)
+                        {
+#if WDR_WEIGHT_TRANSPOSE
+                            // cell k: cols 32k-15..32k+16, i.e. the rest of CalcuHist cell k & the first col of k+1
+                            idx = ((idy*statisticWidth + k) << 4) + b;
+                            pWdrThumbWgtTable[idx] += restCnt[k - m0][b] + edgeCnt[k - m0 + 1][b];
+                            pWdrWeightMat[idx]     += restWgt[k - m0][b] + edgeWgt[k - m0 + 1][b];
+#else
+                            idx = b*256 + idy*statisticWidth + k;
+                            pWdrThumbWgtTable[idx] += restCnt[k - m0][b] + edgeCnt[k - m0][b];
+                            pWdrWeightMat[idx]     += restWgt[k - m0][b] + edgeWgt[k - m0][b];
+#endif
+                        }
+                    }
+                    memset(edgeCnt, 0, sizeof(edgeCnt)); memset(edgeWgt, 0, sizeof(edgeWgt));
+                    memset(restCnt, 0, sizeof(restCnt)); memset(restWgt, 0, sizeof(restWgt));
+                }
+            }
+
+#ifndef CEVA_CHIP_CODE_REGISTER
+            //---- Feature: Grad in the Seg interior
+            if (y == 0 || y >= nWinSize - 1)
+                continue;
+            for (m=m0; m < m1; m++)
+            {
+                for (int j=1; j < nWinSize - 1; j++)
+                {
+                    x    = m * nWinSize + j;
+                    Grdx = p2[x - 1] - p2[x + 1];
+                    Grdy = p1[x] - p3[x];
+                    Grdx = ABS_U16(Grdx);
+                    Grdy = ABS_U16(Grdy);
+                    Grad = ( Grdx + Grdy ) >> 1;
+#if USE_MAX_GRAD == 1
+                    Grad = MIN(Grad, MAX_GRAD);
+#endif
+                    if (Grad > maxGrad[m - m0])
+                    {
+                        maxGrad[m - m0]   = Grad;
+                        maxGrdRow[m - m0] = rowSeg * nWinSize + y;
+                        maxGrdCol[m - m0] = x;
+                    }
+                } // for j
+            } // for m
+#endif
+        } // for y
+
+        //---- Feature of each Seg
+        for (m=m0; m < m1; m++)
+        {
+#ifndef CEVA_CHIP_CODE_REGISTER
+            pFeatPoints[0][rowSeg * numFeature + m] = maxGrdRow[m - m0];
+            pFeatPoints[1][rowSeg * numFeature + m] = maxGrdCol[m - m0];
+            pFeatValues[rowSeg * numFeature + m]    = maxGrad[m - m0];
+#else
+            FeatureDetect_Vec(pThumbData, maxGrad, maxGrdRow, maxGrdCol, nWid, nWid + 1 + m * nWinSize, nWinSize, nWinSize);
+            pFeatPoints[0][rowSeg * numFeature + m] = rowSeg * nWinSize + maxGrdRow;
+            pFeatPoints[1][rowSeg * numFeature + m] = m * nWinSize + maxGrdCol;
+            pFeatValues[rowSeg * numFeature + m]    = maxGrad;
+#endif
+        } // for m
+    } // for x0
+
+#if WDR_WEIGHT_TRANSPOSE
+    //---- CalcuHistTranspose reads one zero col right of & one zero row below the filtered strip
+    idx = (wid + 15) >> 5;
+    for (y=1; y <= hgt; y++)
+    {
+        idy = (rowSeg * 32 + y + 15) >> 5;
+        pWdrThumbWgtTable[(idy*statisticWidth + idx) << 4] += 1;
+    }
+    idy = (rowSeg * 32 + hgt + 15) >> 5;
+    for (x=1; x < wid; x++)
+    {
+        pWdrThumbWgtTable[(idy*statisticWidth + ((x + 15) >> 5)) << 4] += 1;
+    }
+#endif
+
+    //
+    return ret;
+
+} // ThumbStripScan()
+
+
 /************************************************************************/
 // Func: FeatureFilter()
 // Desc: Feature Filter
@@ -364,6 +649,7 @@ int FeatureFilter(RK_U16* pFeatPoints[], RK_U16* pFeatValues, int numFeature, in
 //       pThumbRef          - [in] ThumbRef data pointer
 //       hgt1               - [in] ThumbRef data height
 //       wid1               - [in] ThumbRef data width
+//       stride1            - [in] ThumbRef data stride (pixels), >= wid1: a window in a strip
 //  Out: row                - [out] Match Result Row
 //       col                - [out] Match Result Col
 //       cost               - [out] Match Result Cost
@@ -371,12 +657,16 @@ int FeatureFilter(RK_U16* pFeatPoints[], RK_U16* pFeatValues, int numFeature, in
 // Date: Revised by yousf 20160804
 // 
 /*************************************************************************/
+RK_CPU_CLONES(FeatureCoarseMatching)
 CODE_MFNR_EX
 int FeatureCoarseMatching(
     RK_U16* pThumbBase, RK_U16 hgt0, RK_U16 wid0, 
     RK_U16* pThumbRef, RK_U16 hgt1, RK_U16 wid1, 
-    RK_U16& row, RK_U16& col, RK_U16& cost)
+    RK_U16 stride1, RK_U16& row, RK_U16& col, RK_U16& cost)
 {
+    // host: AVX2 clone picked at startup (cpu/cpu.h)
+    RK_CPU_DISPATCH(FeatureCoarseMatching, (pThumbBase, hgt0, wid0, pThumbRef, hgt1, wid1, stride1, row, col, cost));
+
 #ifndef CEVA_CHIP_CODE_REGISTER
     //
     int     ret = 0; // return value
@@ -408,7 +698,7 @@ int FeatureCoarseMatching(
         for (int j=0; j < wid1 - wid0 + 1 - 1; j++)
         {
             pTmpBase = pThumbBase;                  // Base data
-            pTmpRef  = pThumbRef + i*wid1+ j;    // Ref data
+            pTmpRef  = pThumbRef + i*stride1 + j; // Ref data
             curSAD   = 0;
             for (int m=0; m < hgt0; m++)
             {
@@ -419,7 +709,7 @@ int FeatureCoarseMatching(
                     pTmpBase++;
                     pTmpRef++;
                 }
-                pTmpRef += (wid1 - wid0);
+                pTmpRef += (stride1 - wid0);
             }
             if (curSAD < minSAD)
             {
@@ -440,7 +730,7 @@ int FeatureCoarseMatching(
 
 	int     ret = 0; // return value
 
-	 FeatureCoarseMatching_Vec_vswsad( pThumbBase, pThumbRef, wid0, wid1, hgt0, wid0, hgt1, wid1, cost, row, col );
+	 FeatureCoarseMatching_Vec_vswsad( pThumbBase, pThumbRef, wid0, stride1, hgt0, wid0, hgt1, wid1, cost, row, col );
 
 	return ret;
 #endif
@@ -539,6 +829,7 @@ int Scaler_Raw2Luma(RK_U16* pRawData, int nRawWid, int nRawHgt, int nLumaWid, in
 // Date: Revised by yousf 20160804
 // 
 /*************************************************************************/
+RK_CPU_CLONES(FeatureFineMatching)
 CODE_MFNR_EX
 int FeatureFineMatching(
     RK_U16* pLumaBase, RK_U16 hgt0, RK_U16 wid0, 
@@ -546,6 +837,9 @@ int FeatureFineMatching(
     RK_U16 col_st, RK_U16 wid_ref, 
     RK_U16& row, RK_U16& col, RK_U16& cost)
 {
+    // host: AVX2 clone picked at startup (cpu/cpu.h)
+    RK_CPU_DISPATCH(FeatureFineMatching, (pLumaBase, hgt0, wid0, pLumaRef, hgt1, wid1, col_st, wid_ref, row, col, cost));
+
 #ifndef CEVA_CHIP_CODE_REGISTER
     //
     int     ret = 0; // return value
@@ -616,6 +910,379 @@ int     ret = 0; // return value
 } // FeatureFineMatching()
 
 
+/************************************************************************/
+// Func: MatchRowsSad()
+// Desc: SAD of base rows m0..m1-1 against the Ref block at pRef
+//   In: pBase              - [in] Base block, stride wid0
+//       pRef               - [in] Ref block top-left, stride nRefStride
+//       wid0               - [in] Base block width, multiple of 16 in the vector path
+//       nRefStride         - [in] Ref stride (pixels)
+//       m0, m1             - [in] rows
+//  Out: return             - SAD
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+static RK_U32 MatchRowsSad(const RK_U16* pBase, const RK_U16* pRef, int wid0, int nRefStride, int m0, int m1)
+{
+    RK_U32          sad = 0;
+#ifndef CEVA_CHIP_CODE_REGISTER
+    const RK_U16*   pTmpBase;
+    const RK_U16*   pTmpRef;
+
+    for (int m=m0; m < m1; m++)
+    {
+        pTmpBase = pBase + m * wid0;
+        pTmpRef  = pRef + m * nRefStride;
+        for (int n=0; n < wid0; n++)
+        {
+            sad += ABS_U16(pTmpBase[n] - pTmpRef[n]);
+        }
+    }
+#else
+    // 16 lanes of 32bit partial sums, one horizontal sum per call
+    uint16  acc = ( uint16 )( 0 );
+
+    for (int m=m0; m < m1; m++)
+    {
+        for (int n=0; n < wid0; n += 16)
+        {
+            acc = vabssubacc( *( ushort16* )( pBase + m * wid0 + n ), *( ushort16* )( pRef + m * nRefStride + n ), acc );
+        }
+    }
+    sad = vintrasum( vunpack_lo( acc ) ) + vintrasum( vunpack_hi( acc ) );
+#endif
+    return sad;
+
+} // MatchRowsSad()
+
+
+/************************************************************************/
+// Func: MatchSadFast()
+// Desc: Min SAD position of the nRows x nCols search, exhaustive result:
+//       lowest SAD, then lowest col group of nTieCols, row, col. The predicted
+//       position (nRow0, nCol0) goes first; a position is skipped when the
+//       block-sum bound |sum(Base) - sum(Ref)| <= SAD (successive
+//       elimination) already loses to the best, and its SAD stops every
+//       MATCH_PDE_ROWS rows once the partial sum loses (partial distortion
+//       elimination)
+//   In: pBase              - [in] Base block hgt0 x wid0, stride wid0
+//       pRef               - [in] Ref block of position (0,0), stride nRefStride
+//       nRows, nCols       - [in] search positions, nRows*nCols <= MATCH_FAST_MAX_CANDS,
+//                                 nCols+wid0-1 <= MATCH_FAST_MAX_SPAN
+//       nRow0, nCol0       - [in] predicted position
+//       nTieCols           - [in] tie order: nCols-raster order, 8-the vswsad kernels,
+//                                 whose upper 8 cols win on a lower SAD only
+//  Out: row, col, cost     - [out] Match Result
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+CODE_MFNR_EX
+static void MatchSadFast(const RK_U16* pBase, int hgt0, int wid0, const RK_U16* pRef, int nRefStride,
+    int nRows, int nCols, int nRow0, int nCol0, int nTieCols, RK_U16& row, RK_U16& col, RK_U16& cost)
+{
+    RK_U32          bound[MATCH_FAST_MAX_CANDS];        // successive elimination bound of each position
+    RK_U32          colSum[MATCH_FAST_MAX_SPAN];        // Ref col sums of hgt0 rows
+    RK_U32          baseSum = 0;
+    RK_U32          refSum, minSAD, curSAD;
+    int             nSpan = nCols + wid0 - 1;
+    int             nNum  = nRows * nCols;
+    int             minPos, minRank, p, r, m;
+
+    //---- Block sums: Base once, Ref by sliding col sums
+    for (int i=0; i < hgt0 * wid0; i++)
+    {
+        baseSum += pBase[i];
+    }
+    for (int j=0; j < nSpan; j++)
+    {
+        colSum[j] = 0;
+        for (int m=0; m < hgt0; m++)
+        {
+            colSum[j] += pRef[m * nRefStride + j];
+        }
+    }
+    for (int i=0; i < nRows; i++)
+    {
+        if (i > 0)
+        {
+            for (int j=0; j < nSpan; j++)
+            {
+                colSum[j] += pRef[(i + hgt0 - 1) * nRefStride + j];
+                colSum[j] -= pRef[(i - 1) * nRefStride + j];
+            }
+        }
+        refSum = 0;
+        for (int j=0; j < wid0; j++)
+        {
+            refSum += colSum[j];
+        }
+        for (int j=0; j < nCols; j++)
+        {
+            bound[i * nCols + j] = baseSum > refSum ? baseSum - refSum : refSum - baseSum;
+            if (j + 1 < nCols)
+            {
+                refSum += colSum[j + wid0] - colSum[j];
+            }
+        }
+    }
+
+    //---- Search: predicted position, then raster order; a tie goes to the lower rank
+    minSAD  = 0xFFFFFFFF; // 2^32 - 1
+    minPos  = nNum;
+    minRank = nNum;
+    for (int n=-1; n < nNum; n++)
+    {
+        p = n < 0 ? nRow0 * nCols + nCol0 : n;
+        if (n >= 0 && p == nRow0 * nCols + nCol0)
+        {
+            continue; // done first
+        }
+        r = (p % nCols) / nTieCols * nRows * nTieCols + (p / nCols) * nTieCols + (p % nCols) % nTieCols;
+        if (bound[p] > minSAD || (bound[p] == minSAD && r > minRank))
+        {
+            continue;
+        }
+        const RK_U16* pTmpRef = pRef + (p / nCols) * nRefStride + p % nCols;
+        curSAD = 0;
+        for (m=0; m < hgt0; m += MATCH_PDE_ROWS)
+        {
+            curSAD += MatchRowsSad(pBase, pTmpRef, wid0, nRefStride, m, MIN(m + MATCH_PDE_ROWS, hgt0));
+            if (curSAD > minSAD || (curSAD == minSAD && r > minRank))
+            {
+                break;
+            }
+        }
+        if (m >= hgt0 && (curSAD < minSAD || (curSAD == minSAD && r < minRank)))
+        {
+            minSAD  = curSAD;
+            minPos  = p;
+            minRank = r;
+        }
+    }
+
+    // Matching Min SAD
+    row  = minPos / nCols;
+    col  = minPos % nCols;
+    cost = minSAD & 0xFFFF;
+
+} // MatchSadFast()
+
+
+/************************************************************************/
+// Func: FeatureCoarseMatchingFast()
+// Desc: Feature Coarse Matching, early-terminating (MatchSadFast) over the
+//       positions FeatureCoarseMatching() searches, the zero-motion one
+//       first: same row, col & cost
+//   In: as FeatureCoarseMatching()
+//  Out: row, col, cost     - [out] Match Result
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+RK_CPU_CLONES(FeatureCoarseMatchingFast)
+CODE_MFNR_EX
+int FeatureCoarseMatchingFast(
+    RK_U16* pThumbBase, RK_U16 hgt0, RK_U16 wid0, 
+    RK_U16* pThumbRef, RK_U16 hgt1, RK_U16 wid1, 
+    RK_U16 stride1, RK_U16& row, RK_U16& col, RK_U16& cost)
+{
+    // host: AVX2 clone picked at startup (cpu/cpu.h)
+    RK_CPU_DISPATCH(FeatureCoarseMatchingFast, (pThumbBase, hgt0, wid0, pThumbRef, hgt1, wid1, stride1, row, col, cost));
+
+    //
+    int     ret = 0; // return value
+#ifndef CEVA_CHIP_CODE_REGISTER
+    int     nRows = hgt1 - hgt0;
+    int     nCols = wid1 - wid0;
+    int     nTie  = nCols;                      // raster order
+#else
+    int     nRows = ((hgt1 - hgt0) >> 2) * 4;   // FeatureCoarseMatching_Vec_vswsad: 4 rows a loop, 16 cols
+    int     nCols = 16;
+    int     nTie  = 8;                          // vintramin of each 8 cols, upper 8 on a lower SAD only
+#endif
+
+    if (hgt0 != COARSE_MATCH_WIN_SIZE || wid0 != COARSE_MATCH_WIN_SIZE)
+    {
+        ret = -1;
+        return ret;
+    }
+    if (nRows <= 0 || nCols <= 0 || nRows * nCols > MATCH_FAST_MAX_CANDS || nCols + wid0 - 1 > MATCH_FAST_MAX_SPAN)
+    {
+        return FeatureCoarseMatching(pThumbBase, hgt0, wid0, pThumbRef, hgt1, wid1, stride1, row, col, cost);
+    }
+
+    MatchSadFast(pThumbBase, hgt0, wid0, pThumbRef, stride1, nRows, nCols,
+        MIN(COARSE_MATCH_RADIUS, nRows - 1), MIN(COARSE_MATCH_RADIUS, nCols - 1), nTie, row, col, cost);
+
+    //
+    return ret;
+
+} // FeatureCoarseMatchingFast()
+
+
+/************************************************************************/
+// Func: FeatureFineMatchingFast()
+// Desc: Feature Fine Matching, early-terminating (MatchSadFast) over the
+//       positions FeatureFineMatching() searches, the Coarse Match one
+//       (FINE_LUMA_RADIUS in) first: same row, col & cost
+//   In: as FeatureFineMatching()
+//  Out: row, col, cost     - [out] Match Result
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+RK_CPU_CLONES(FeatureFineMatchingFast)
+CODE_MFNR_EX
+int FeatureFineMatchingFast(
+    RK_U16* pLumaBase, RK_U16 hgt0, RK_U16 wid0, 
+    RK_U16* pLumaRef, RK_U16 hgt1, RK_U16 wid1, 
+    RK_U16 col_st, RK_U16 wid_ref, 
+    RK_U16& row, RK_U16& col, RK_U16& cost)
+{
+    // host: AVX2 clone picked at startup (cpu/cpu.h)
+    RK_CPU_DISPATCH(FeatureFineMatchingFast, (pLumaBase, hgt0, wid0, pLumaRef, hgt1, wid1, col_st, wid_ref, row, col, cost));
+
+    //
+    int     ret = 0; // return value
+#ifndef CEVA_CHIP_CODE_REGISTER
+    int     nRows = hgt1 - hgt0 + 1;
+    int     nCols = wid_ref - wid0 + 1;
+    int     nTie  = nCols;                      // raster order
+#else
+    int     nRows = ((hgt1 - hgt0) + 2) / 3 * 3;    // FeatureFineMatching_Vec_vswsad: 3 rows a loop, 11 cols
+    int     nCols = 2 * FINE_LUMA_RADIUS + 1;
+    int     nTie  = 8;                          // vintramin of each 8 cols, upper 8 on a lower SAD only
+#endif
+
+    if (hgt0 != FINE_MATCH_WIN_SIZE/2 || wid0 != FINE_MATCH_WIN_SIZE/2)
+    {
+        ret = -1;
+        return ret;
+    }
+    if (nRows <= 0 || nCols <= 0 || nRows * nCols > MATCH_FAST_MAX_CANDS || nCols + wid0 - 1 > MATCH_FAST_MAX_SPAN)
+    {
+        return FeatureFineMatching(pLumaBase, hgt0, wid0, pLumaRef, hgt1, wid1, col_st, wid_ref, row, col, cost);
+    }
+
+    MatchSadFast(pLumaBase, hgt0, wid0, pLumaRef + col_st, wid1, nRows, nCols,
+        MIN(FINE_LUMA_RADIUS, nRows - 1), MIN(FINE_LUMA_RADIUS, nCols - 1), nTie, row, col, cost);
+    col += col_st;
+
+    //
+    return ret;
+
+} // FeatureFineMatchingFast()
+
+
+/************************************************************************/
+// Func: ThumbPyramidBox()
+// Desc: One Pyramid top row from SCALER_FACTOR_T2P Thumb rows: each top
+//       pixel is the rounded mean of its 4x4 Thumb block, so it keeps the
+//       Thumb scale (8x8 Raw sums) & FeaturePyramidMatching() runs on
+//       either level
+//   In: pThumb             - [in] 4 Thumb rows
+//       nStride            - [in] Thumb row stride (pixels)
+//       nPyrWid            - [in] top pixels, 4*nPyrWid Thumb pixels a row
+//  Out: pPyr               - [out] top pixels
+//
+// Date: Created 20261017
+//
+/*************************************************************************/
+CODE_MFNR_EX
+int ThumbPyramidBox(const RK_U16* pThumb, int nStride, int nPyrWid, RK_U16* pPyr)
+{
+    //
+    int     ret = 0; // return value
+#ifndef CEVA_CHIP_CODE_REGISTER
+    RK_U32          sum;
+
+    for (int j=0; j < nPyrWid; j++)
+    {
+        sum = 0;
+        for (int y=0; y < SCALER_FACTOR_T2P; y++)
+        {
+            for (int x=j * SCALER_FACTOR_T2P; x < (j + 1) * SCALER_FACTOR_T2P; x++)
+            {
+                sum += pThumb[y * nStride + x];
+            }
+        }
+        pPyr[j] = (RK_U16)((sum + 8) >> 4);
+    }
+#else
+    // 4 Thumb pixels = one 64bit load, pixels 0/2 and 1/3 masked into two
+    // lanes 32 bits apart & added, 8 pixels a lane (8*65535 < 2^32)
+    const RK_U64    mask = 0x0000FFFF0000FFFFULL;
+    const RK_U16*   p;
+    RK_U64          g, acc;
+
+    for (int j=0; j < nPyrWid; j++)
+    {
+        acc = 0;
+        p   = pThumb + j * SCALER_FACTOR_T2P;
+        for (int y=0; y < SCALER_FACTOR_T2P; y++)
+        {
+            memcpy(&g, p, sizeof(g));
+            acc += (g & mask) + ((g >> 16) & mask);
+            p   += nStride;
+        }
+        pPyr[j] = (RK_U16)(((acc & 0xFFFFFFFF) + (acc >> 32) + 8) >> 4);
+    }
+#endif
+
+    //
+    return ret;
+
+} // ThumbPyramidBox()
+
+
+/************************************************************************/
+// Func: FeaturePyramidMatching()
+// Desc: Feature Matching of one Pyramid level: every position of the Ref
+//       window, early-terminating (MatchSadFast) from the position the
+//       level above predicts; ties go to raster order in the C & vector
+//       paths alike
+//   In: pBase              - [in] Base block hgt0 x wid0, wid0 multiple of 16
+//       pRef               - [in] Ref window hgt1 x wid1, stride stride1
+//       row0, col0         - [in] predicted position in the Ref window
+//  Out: row, col, cost     - [out] Match Result
+// 
+// Date: Created 20261017
+// 
+/*************************************************************************/
+RK_CPU_CLONES(FeaturePyramidMatching)
+CODE_MFNR_EX
+int FeaturePyramidMatching(
+    RK_U16* pBase, RK_U16 hgt0, RK_U16 wid0, 
+    RK_U16* pRef, RK_U16 hgt1, RK_U16 wid1, 
+    RK_U16 stride1, RK_U16 row0, RK_U16 col0, RK_U16& row, RK_U16& col, RK_U16& cost)
+{
+    // host: AVX2 clone picked at startup (cpu/cpu.h)
+    RK_CPU_DISPATCH(FeaturePyramidMatching, (pBase, hgt0, wid0, pRef, hgt1, wid1, stride1, row0, col0, row, col, cost));
+
+    //
+    int     ret = 0; // return value
+    int     nRows = hgt1 - hgt0 + 1;
+    int     nCols = wid1 - wid0 + 1;
+
+    if (wid0 % 16 != 0 || nRows <= 0 || nCols <= 0 || nRows * nCols > MATCH_FAST_MAX_CANDS
+        || nCols + wid0 - 1 > MATCH_FAST_MAX_SPAN)
+    {
+        ret = -1;
+        return ret;
+    }
+
+    MatchSadFast(pBase, hgt0, wid0, pRef, stride1, nRows, nCols,
+        MIN(row0, nRows - 1), MIN(col0, nCols - 1), nCols, row, col, cost);
+
+    //
+    return ret;
+
+} // FeaturePyramidMatching()
+
+
 /************************************************************************/
 // Func: MvHistFilter()
 // Desc: MV Hist Filter
@@ -1004,7 +1671,7 @@ int CreateCoefficient(RK_U16* pPoints4, RK_F32* pMatA, RK_F32* pVecB)
 CODE_MFNR_EX
 int ComputePerspectMatrix(RK_F32* pMatA, RK_F32* pVecB, RK_F32* pVecX)
 {
-#ifndef CEVA_CHIP_CODE_REGISTER
+#if !defined(CEVA_CHIP_CODE_REGISTER) || defined(VEC_C_HOST)
     //
     int     ret = 0; // return value
 // #if MY_DEBUG_PRINTF == 1
@@ -1198,7 +1865,7 @@ int ComputeHomographyError(
     RK_F32* pRefPoint,   // [in] abs(pRefPoint - pProjPoint)
     RK_U32& error)       // [out] Correct Project Count / Sum Project Errors
 {
-#ifndef CEVA_CHIP_CODE_REGISTER
+#if !defined(CEVA_CHIP_CODE_REGISTER) || defined(VEC_C_HOST)
     //
     int     ret = 0; // return value
 
@@ -2042,6 +2709,7 @@ void Scaler_Raw2Luma_Vec( RK_U16 *p_s16Src,   // <<! [ in ]: src raw data
 
 }
 
+#ifndef VEC_C_HOST // host builds keep the C homography kernels
 CODE_MFNR_EX
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // add by shm @2016.08.30
@@ -2547,4 +3215,6 @@ void ComputeHomographyError_Vec_uint( RK_S32 type,              // <<! [ in ]: t
 	}
 }
 
+#endif // VEC_C_HOST
 
+MFNR_ISA_END
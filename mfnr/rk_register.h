@@ -41,6 +41,8 @@
 #define     SCALER_FACTOR_R2R       2               // Raw to Raw
 #define     SCALER_FACTOR_R2L       2               // Raw to Luma
 #define     SCALER_FACTOR_R2T       8               // Raw to Thumbnail
+#define     THUMB_BUILD_COLS        128             // ThumbBuild: Thumb cols per Raw chunk, 8 rows x 1280B packed RAW10
+#define     SCALER_FACTOR_T2P       4               // Thumb to Pyramid top (Raw 1/32)
 
 //---- Compute Grad Params Setting
 //#define     USE_MAX_GRAD            0               // 1-use max grad truncation, 0-not use
@@ -61,20 +63,34 @@
 #define     COARSE_MATCH_WIN_SIZE   16              // Coarse Matching Win size in Thumb
 #define     MAX_OFFSET              64//100             // max offset of each 2 frames
 #define     COARSE_MATCH_RADIUS    (CEIL(MAX_OFFSET * 1.0 / SCALER_FACTOR_R2T)) // Coarse Matching Radius
+#define     COARSE_BATCH_FEATURES   8               // Coarse Matching batch: max Features sharing one Ref strip
+#define     COARSE_STRIP_HGT       (2*COARSE_MATCH_WIN_SIZE + 2*COARSE_MATCH_RADIUS) // Ref strip max height: Features one Win apart
+#define     COARSE_STRIP_WID       (3*COARSE_MATCH_WIN_SIZE + 2*COARSE_MATCH_RADIUS) // Ref strip max width: Features two Win apart
+#define     COARSE_THUMB_STRIP_HGT (NUM_LINE_DDR2DSP_THUMB + 2*COARSE_MATCH_RADIUS) // Ref strip height of a FeatureDetect strip (useThumbStrip)
+#define     PYR_MATCH_WIN_SIZE      16              // Pyramid Matching Win size, both levels
+#define     PYR_MATCH_RADIUS        6               // Pyramid Matching Radius at the top: 6*32=192 Raw
+#define     PYR_THUMB_RADIUS        3               // Pyramid Matching Radius in Thumb around the top Match: 4/2+1
+#define     PYR_BUILD_ROWS         (NUM_LINE_DDR2DSP_THUMB / SCALER_FACTOR_T2P) // PyramidBuild: top rows of one Thumb strip
+#define     THUMB_SCAN_COLS         256             // ThumbStripScan column chunk: one light filter row on the stack
+#define     THUMB_SCAN_CELLS       (THUMB_SCAN_COLS / 32 + 1) // CalcuHist cells touched by one column chunk
+#define     WDR_HIST_BINS           9               // light bins of the WDR statistic tables: (light + 1024) >> 11
 
 //---- Divide Image
 #define     NUM_DIVIDE_IMAGE        4               // Divide Image into 4x4 Region
 
 //---- Fine Matching Params Setting
 #define     FINE_MATCH_WIN_SIZE     64              // Fine Matching Win size in Raw
+#define     MATCH_PDE_ROWS          4               // Feature*MatchingFast: base rows between two early-exit checks
+#define     MATCH_FAST_MAX_CANDS    256             // Feature*MatchingFast: search positions, 16x16 Coarse
+#define     MATCH_FAST_MAX_SPAN     64              // Feature*MatchingFast: Ref cols under the positions of a row
 #define     FINE_LUMA_RADIUS        5               // search radius in Luma: 8=SCALER_FACTOR_RAW2THUMB, 2=SCALER_FACTOR_RAW2LUMA, Radius=(8/2+1)
 
 //---- Homography Computation Params Setting
 //#define     USE_MV_HIST_FILTRATE    1               // 1-use MV Hist Filtrate, 0-not use
 #define		MAX_NUM_MATCH_FEATURE   512             // Max Num of Match Feature <-- 32x16 Segments at most in Thumb (Raw:8192x4096)    
 #if USE_MV_HIST_FILTRATE == 1
-    #define HALF_LEN_MV_HIST        (COARSE_MATCH_RADIUS * SCALER_FACTOR_R2T / SCALER_FACTOR_R2L + FINE_LUMA_RADIUS) // Half Length of MV Hist: 13*8/2+5=57
-    #define LEN_MV_HIST             (HALF_LEN_MV_HIST*2+1) // Length of MV Hist: 57*2+1=115
+    #define HALF_LEN_MV_HIST      ((PYR_MATCH_RADIUS * SCALER_FACTOR_T2P + PYR_THUMB_RADIUS) * SCALER_FACTOR_R2T / SCALER_FACTOR_R2L + FINE_LUMA_RADIUS) // Half Length of MV Hist: (6*4+3)*8/2+5=113, covers Coarse 8*8/2+5=37
+    #define LEN_MV_HIST             (HALF_LEN_MV_HIST*2+1) // Length of MV Hist: 113*2+1=227
     #define VALID_FEATURE_RATIO     0.1//0.01            // Valid Feature Ratio
 #endif
 #define     NUM_R4IT_CHOICE         1810            // nchoosek(16,4) - 10(in line)
@@ -95,6 +111,10 @@
 
 //////////////////////////////////////////////////////////////////////////
 ////-------- Function Declaration
+MFNR_ISA_BEGIN
+
+// Thumb row from SCALER_FACTOR_R2T packed RAW10 rows
+int ThumbRaw10Box(const RK_U8* pRaw10, int nStride, int nThumbWid, RK_U16* pThumb);
 
 // Feature Detect
 int FeatureDetect(RK_U16* pThumbData, int nWid, int nHgt, int nStride, int rowSeg, int numFeature, RK_U16* pFeatPoints[], RK_U16* pFeatValues);
@@ -115,13 +135,17 @@ void GetWdrWeightTable( RK_U16* pThumbData,      // <<! [in]
                         int 	statisticWidth,
                         int 	statisticHeight);   // <<! [out]  
 
+// FeatureDetect & GetWdrWeightTable in one pass
+int ThumbStripScan(RK_U16* pThumbData, int nWid, int nHgt, int rowSeg, int numFeature, RK_U16* pFeatPoints[], RK_U16* pFeatValues,
+    RK_U32* pWdrWeightMat, RK_U16* pWdrThumbWgtTable, int statisticWidth);
+
 // Feature Filter
 int FeatureFilter(RK_U16* pFeatPoints[], RK_U16* pFeatValues, int numFeature, int nThumbWid, int nThumbHgt, 
     int& numValidFeature);
 
 // Feature Coarse Matching
 int FeatureCoarseMatching(RK_U16* pThumbBase, RK_U16 hgt0, RK_U16 wid0, RK_U16* pThumbRef, RK_U16 hgt1, RK_U16 wid1, 
-    RK_U16& row, RK_U16& col, RK_U16& cost);
+    RK_U16 stride1, RK_U16& row, RK_U16& col, RK_U16& cost);
 
 // Scaler Raw to Luma
 int Scaler_Raw2Luma(RK_U16* pRawData, int nRawWid, int nRawHgt, int nLumaWid, int nLumaHgt, 
@@ -133,6 +157,21 @@ int FeatureFineMatching(RK_U16* pLumaBase, RK_U16 hgt0, RK_U16 wid0,
     RK_U16 col_st, RK_U16 wid_ref, 
     RK_U16& row, RK_U16& col, RK_U16& cost);
 
+// Feature Coarse & Fine Matching, early-terminating: same Match as the exhaustive search
+int FeatureCoarseMatchingFast(RK_U16* pThumbBase, RK_U16 hgt0, RK_U16 wid0, RK_U16* pThumbRef, RK_U16 hgt1, RK_U16 wid1, 
+    RK_U16 stride1, RK_U16& row, RK_U16& col, RK_U16& cost);
+int FeatureFineMatchingFast(RK_U16* pLumaBase, RK_U16 hgt0, RK_U16 wid0, 
+    RK_U16* pLumaRef, RK_U16 hgt1, RK_U16 wid1, 
+    RK_U16 col_st, RK_U16 wid_ref, 
+    RK_U16& row, RK_U16& col, RK_U16& cost);
+
+// Pyramid top row from SCALER_FACTOR_T2P Thumb rows
+int ThumbPyramidBox(const RK_U16* pThumb, int nStride, int nPyrWid, RK_U16* pPyr);
+
+// Feature Pyramid Matching: early-terminating, predicted position first
+int FeaturePyramidMatching(RK_U16* pBase, RK_U16 hgt0, RK_U16 wid0, RK_U16* pRef, RK_U16 hgt1, RK_U16 wid1, 
+    RK_U16 stride1, RK_U16 row0, RK_U16 col0, RK_U16& row, RK_U16& col, RK_U16& cost);
+
 
 // MV Hist Filter
 int MvHistFilter(RK_U16* pMatchPtsY[], RK_U16* pMatchPtsX[], int numValidFeature,
@@ -225,6 +264,8 @@ void ComputeHomographyError_Vec_uint( RK_S32 type,              // <<! [ in ]: t
 									  RK_U32 u32Cols,           // <<! [ in ]: points num
 									  RK_U32 &error );          // <<! [ out ]: correct num or sum error
 
+MFNR_ISA_END
+
 #endif // _RK_REGISTER_H
 
 
@@ -0,0 +1,138 @@
+//
+//////////////////////////////////////////////////////////////////////////
+// File: rk_trace.h
+// Desc: Trace-event spans of MFNR_Process for chrome://tracing / Perfetto
+//
+// Date: Created 20261017
+//
+//////////////////////////////////////////////////////////////////////////
+//
+// Switch: MFNR_TRACE (rk_global.h, or -DMFNR_TRACE=1)
+//   0 - TRACE_* expand to nothing, no state is kept
+//   1 - every TRACE_BEGIN/TRACE_END pair records one span with up to
+//       TRACE_MAX_ARGS integer args; RK_MFNR_WriteTrace() writes them as
+//       trace-event JSON ("ph":"X")
+//
+// Tracks (tid in the JSON):
+//   TRACE_TRACK_DSP  - the DSP core: tiles, features, kernels, DMA issue
+//                      & wait
+//   TRACE_TRACK_DMA  - the transfer itself, from rdma_transf() to the
+//                      return of its rdma_sync(); a transfer that overlaps
+//                      DSP work shows up next to a DSP span, a blocking one
+//                      sits on top of a dma_wait span
+//
+// Spans are kept in a buffer of TRACE_MAX_EVENTS allocated by MFNR_Process;
+// when it is full later spans are dropped and counted in nDropped.
+//
+#pragma once
+#ifndef _RK_TRACE_H
+#define _RK_TRACE_H
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Header files
+//
+#include "rk_typedef.h"                 // Type definition
+#include "rk_global.h"                  // Global definition
+#include "rk_profile.h"                 // RK_ProfileTick()
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Macro Definition
+//
+#ifndef TRACE_MAX_EVENTS
+#define     TRACE_MAX_EVENTS        (1 << 18)       // spans per MFNR_Process
+#endif
+#define     TRACE_MAX_ARGS          4               // integer args per span
+
+#define     TRACE_TRACK_DSP         0               // tid of the DSP core
+#define     TRACE_TRACK_DMA         1               // tid of the rdma engine
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Type Defines
+//
+////---- struct TraceEvent
+typedef struct tag_RK_TraceEvent
+{
+    const char*     pName;                          // span name
+    RK_U8           nTrack;                         // TRACE_TRACK_*
+    RK_U8           nArgs;                          // used args
+    RK_U64          nBegin;                         // RK_ProfileTick() at TRACE_BEGIN
+    RK_U64          nEnd;                           // RK_ProfileTick() at TRACE_END, 0 while open
+    const char*     pArgKeys[TRACE_MAX_ARGS];       // arg names
+    RK_S32          nArgVals[TRACE_MAX_ARGS];       // arg values
+}RK_TraceEvent;
+
+////---- struct TraceBuf
+typedef struct tag_RK_TraceBuf
+{
+    RK_TraceEvent*  pEvents;                        // TRACE_MAX_EVENTS spans
+    RK_U32          nCount;                         // recorded spans
+    RK_U32          nDropped;                       // spans lost to a full buffer
+    RK_U64          nOrigin;                        // tick of ts = 0
+}RK_TraceBuf;
+
+
+//////////////////////////////////////////////////////////////////////////
+////-------- Functions Definition
+//
+#if MFNR_TRACE == 1
+
+static inline int RK_TraceBegin(RK_TraceBuf* pTrace, const char* pName, int nTrack)
+{
+    RK_TraceEvent*  pEvent;
+    if (pTrace->pEvents == NULL || pTrace->nCount >= TRACE_MAX_EVENTS)
+    {
+        pTrace->nDropped++;
+        return -1;
+    }
+    pEvent         = &pTrace->pEvents[pTrace->nCount];
+    pEvent->pName  = pName;
+    pEvent->nTrack = (RK_U8)nTrack;
+    pEvent->nArgs  = 0;
+    pEvent->nEnd   = 0;
+    pEvent->nBegin = RK_ProfileTick();
+    return (int)pTrace->nCount++;
+}
+
+static inline void RK_TraceArg(RK_TraceBuf* pTrace, int nEvent, const char* pKey, RK_S32 nVal)
+{
+    RK_TraceEvent*  pEvent;
+    if (nEvent < 0 || pTrace->pEvents[nEvent].nArgs >= TRACE_MAX_ARGS)
+    {
+        return;
+    }
+    pEvent = &pTrace->pEvents[nEvent];
+    pEvent->pArgKeys[pEvent->nArgs] = pKey;
+    pEvent->nArgVals[pEvent->nArgs] = nVal;
+    pEvent->nArgs++;
+}
+
+static inline void RK_TraceEnd(RK_TraceBuf* pTrace, int nEvent)
+{
+    if (nEvent >= 0)
+    {
+        pTrace->pEvents[nEvent].nEnd = RK_ProfileTick();
+    }
+}
+
+#define     TRACE_BEGIN(trace, ev, name, track)                         \
+    int ev = RK_TraceBegin(&(trace), name, track)
+#define     TRACE_ARG(trace, ev, key, val)                              \
+    RK_TraceArg(&(trace), ev, key, (RK_S32)(val))
+#define     TRACE_END(trace, ev)                                        \
+    RK_TraceEnd(&(trace), ev)
+
+#else
+
+#define     TRACE_BEGIN(trace, ev, name, track)
+#define     TRACE_ARG(trace, ev, key, val)
+#define     TRACE_END(trace, ev)
+
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+
+#endif // _RK_TRACE_H
@@ -11,6 +11,8 @@
 #ifndef _RK_TYPEDEF_H
 #define _RK_TYPEDEF_H
 
+#include <stddef.h>
+
 
 //////////////////////////////////////////////////////////////////////////
 ////-------- Type Defines
@@ -23,10 +25,12 @@ typedef     signed   short          RK_S16;         // s16bit
 typedef     unsigned short          RK_U16;         // u16bit
 typedef     signed   int            RK_S32;         // s32bit
 typedef     unsigned int            RK_U32;         // u32bit
+typedef     unsigned long long      RK_U64;         // u64bit
 typedef     float                   RK_F32;         // f32bit
 typedef     double                  RK_D64;         // d64bit
 typedef     void                    RK_RawType;     // RawDataType
 typedef     void                    RK_ThumbType;   // ThumbDataType
+typedef     size_t                  RK_Addr;        // pointer-width address (DMA src/dst)
 
 //////////////////////////////////////////////////////////////////////////
 